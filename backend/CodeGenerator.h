@@ -45,6 +45,15 @@ public:
         this->showLinearIR = show;
     }
 
+    ///
+    /// @brief 设置优化级别，-O1及以上时后端进行相应的优化
+    /// @param level 优化级别
+    ///
+    void setOptLevel(int level)
+    {
+        this->optLevel = level;
+    }
+
 protected:
     /// @brief 代码产生器运行，结果保存到指定的文件中
     /// @param fp 输出内容所在文件的指针
@@ -63,4 +72,9 @@ protected:
     /// @brief 显示IR指令内容
     ///
     bool showLinearIR = false;
+
+    ///
+    /// @brief 优化级别
+    ///
+    int optLevel = 0;
 };
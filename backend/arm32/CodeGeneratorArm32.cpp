@@ -13,11 +13,14 @@
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// </table>
 ///
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <string>
 #include <vector>
 #include <iostream>
+#include <queue>
+#include <set>
 
 #include "Function.h"
 #include "Module.h"
@@ -26,10 +29,17 @@
 #include "InstSelectorArm32.h"
 #include "SimpleRegisterAllocator.h"
 #include "ILocArm32.h"
+#include "GraphColoringRegisterAllocator.h"
+#include "LinearScanRegisterAllocator.h"
 #include "RegVariable.h"
 #include "FuncCallInstruction.h"
 #include "ArgInstruction.h"
 #include "MoveInstruction.h"
+#include "OptUtils.h"
+#include "ControlFlowGraph.h"
+#include "GotoInstruction.h"
+#include "Liveness.h"
+#include "Profile.h"
 
 /// @brief 构造函数
 /// @param tab 符号表
@@ -131,10 +141,25 @@ void CodeGeneratorArm32::genCodeSection(Function * func)
     ILocArm32 iloc(module);
 
     // 指令选择生成汇编指令
+    // 分配给变量的寄存器与R10不能再作为指令选择的临时寄存器
+    for (auto regno: func->getProtectedReg()) {
+        if (regno < ARM32_TMP_REG_NO) {
+            simpleRegisterAllocator.Allocate(regno);
+        }
+    }
+    simpleRegisterAllocator.Allocate(ARM32_TMP_REG_NO);
+
     InstSelectorArm32 instSelector(IrInsts, iloc, func, simpleRegisterAllocator);
     instSelector.setShowLinearIR(this->showLinearIR);
     instSelector.run();
 
+    for (auto regno: func->getProtectedReg()) {
+        if (regno < ARM32_TMP_REG_NO) {
+            simpleRegisterAllocator.free(regno);
+        }
+    }
+    simpleRegisterAllocator.free(ARM32_TMP_REG_NO);
+
     // 删除无用的Label指令
     iloc.deleteUnusedLabel();
 
@@ -190,27 +215,70 @@ void CodeGeneratorArm32::registerAllocation(Function * func)
     // SP寄存器预留，不需要保护，但需要保证值的正确性
     // R4-R10, fp(11), lx(14)都需要保护，没有函数调用的函数可不用保护lx寄存器
     // 被保留的寄存器主要有：
-    //  (1) FP寄存器用于栈寻址，即R11
+    //  (1) FP寄存器用于栈寻址，即R11。栈帧为空时不需要
     //  (2) LX寄存器用于函数调用，即R14。没有函数调用的函数可不用保护lx寄存器
-    //  (3) R10寄存器用于立即数过大时要通过寄存器寻址，这里简化处理进行预留
+    //  (3) R10寄存器用于立即数过大时要通过寄存器寻址，以及保存全局变量，只在需要时预留
+
+    // 优化可能删除了全部或部分函数调用，按剩下的调用指令重新统计
+    func->updateFuncCallInfo();
 
-    // 至少有FP和LX寄存器需要保护
+    // 有函数调用时需要保护LX寄存器，其它寄存器在栈空间分配后确定
     std::vector<int32_t> & protectedRegNo = func->getProtectedReg();
     protectedRegNo.clear();
-    protectedRegNo.push_back(ARM32_TMP_REG_NO);
-    protectedRegNo.push_back(ARM32_FP_REG_NO);
     if (func->getExistFuncCall()) {
         protectedRegNo.push_back(ARM32_LX_REG_NO);
     }
 
+    // 有剖面数据时冷的基本块移到函数的最后，热的路径上减少跳转
+    if (optLevel >= 1) {
+        placeColdBlocks(func);
+    }
+
+    // 尾调用拆除栈帧后直接跳转到被调用函数，被调用函数返回到当前函数的调用者
+    if (optLevel >= 1) {
+        markTailCalls(func);
+    }
+
     // 调整函数调用指令，主要是前四个寄存器传值，后面用栈传递
     // 为了更好的进行寄存器分配，可以进行对函数调用的指令进行预处理
     // 当然也可以不做处理，不过性能更差。这个处理是可选的。
     adjustFuncCallInsts(func);
 
+    // O2时图着色把局部变量与临时变量分配到r0-r9中，O1时线性扫描分配到r4-r9中，
+    // 用到的被调用者保存的寄存器在函数入口保护
+    if (optLevel >= 2) {
+        GraphColoringRegisterAllocator allocator(func);
+        allocator.run();
+        const std::vector<int32_t> & usedRegs = allocator.getUsedRegs();
+        protectedRegNo.insert(protectedRegNo.begin(), usedRegs.begin(), usedRegs.end());
+    } else if (optLevel >= 1) {
+        LinearScanRegisterAllocator allocator(func);
+        allocator.run();
+        const std::vector<int32_t> & usedRegs = allocator.getUsedRegs();
+        protectedRegNo.insert(protectedRegNo.begin(), usedRegs.begin(), usedRegs.end());
+    }
+
+    // 运算结果直接保存到赋值的目的变量，减少一次读写栈
+    coalescedTemps.clear();
+    if (optLevel >= 1) {
+        coalesceMoves(func);
+    }
+
     // 为局部变量和临时变量在栈内分配空间，指定偏移，进行栈空间的分配
     stackAlloc(func);
 
+    // 栈帧为空时不建立帧指针，栈传递的形参通过SP寻址
+    if (func->getMaxDep() > 0) {
+        protectedRegNo.push_back(ARM32_FP_REG_NO);
+    }
+
+    if (needTmpReg(func)) {
+        protectedRegNo.push_back(ARM32_TMP_REG_NO);
+    }
+
+    // 保护的寄存器按编号升序入栈
+    std::sort(protectedRegNo.begin(), protectedRegNo.end());
+
     // 函数形参要求前四个寄存器分配，后面的参数采用栈传递，实现实参的值传递给形参
     // 这一步是必须的
     adjustFormalParamInsts(func);
@@ -240,10 +308,15 @@ void CodeGeneratorArm32::adjustFormalParamInsts(Function * func)
     }
 
     // 根据ARM版C语言的调用约定，除前4个外的实参进行值传递，逆序入栈
-    int64_t fp_esp = func->getProtectedReg().size() * 4;
+    // 没有帧指针时SP在函数内保持为保护寄存器入栈后的值，与有帧指针时的FP相同
+    auto & protectedRegNo = func->getProtectedReg();
+    bool hasFramePointer = std::find(protectedRegNo.begin(), protectedRegNo.end(), ARM32_FP_REG_NO) != protectedRegNo.end();
+    int32_t baseRegNo = hasFramePointer ? ARM32_FP_REG_NO : ARM32_SP_REG_NO;
+
+    int64_t fp_esp = protectedRegNo.size() * 4;
     for (int k = 4; k < (int) params.size(); k++) {
 
-        params[k]->setMemoryAddr(ARM32_FP_REG_NO, fp_esp);
+        params[k]->setMemoryAddr(baseRegNo, fp_esp);
 
         // 增加4字节，目前只支持int类型
         fp_esp += params[k]->getType()->getSize();
@@ -292,7 +365,7 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
                 esp += 4;
 
                 // 引入赋值指令，把实参的值保存到内存变量上
-                Instruction * assignInst = new MoveInstruction(func, newVal, arg);
+                Instruction * assignInst = new (func) MoveInstruction(func, newVal, arg);
 
                 // 更换实参变量为内存变量
                 callInst->setOperand(k, newVal);
@@ -310,7 +383,7 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
 
                 auto arg = callInst->getOperand(k);
 
-                Instruction * assignInst = new MoveInstruction(func, PlatformArm32::intRegVal[k], arg);
+                Instruction * assignInst = new (func) MoveInstruction(func, PlatformArm32::intRegVal[k], arg);
 
                 callInst->setOperand(k, PlatformArm32::intRegVal[k]);
 
@@ -325,7 +398,7 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
                 auto arg = callInst->getOperand(k);
 
                 // 产生ARG指令
-                pIter = insts.insert(pIter, new ArgInstruction(func, arg));
+                pIter = insts.insert(pIter, new (func) ArgInstruction(func, arg));
                 pIter++;
             }
 #endif
@@ -333,8 +406,8 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
             // 有arg指令后可不用参数，展示不删除
             // args.clear();
 
-            // 赋值指令
-            if (callInst->hasResultValue()) {
+            // 赋值指令，尾调用的结果由被调用函数直接返回
+            if (callInst->hasResultValue() && !callInst->tailCall) {
 
                 if (callInst->getRegId() == 0) {
                     // 结果变量的寄存器和返回值寄存器一样，则什么都不需要做
@@ -342,7 +415,7 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
                 } else {
                     // 其它情况，需要产生赋值指令
                     // 新建一个赋值操作
-                    Instruction * assignInst = new MoveInstruction(func, callInst, PlatformArm32::intRegVal[0]);
+                    Instruction * assignInst = new (func) MoveInstruction(func, callInst, PlatformArm32::intRegVal[0]);
 
                     // 函数调用指令的下一个指令的前面插入指令，因为有Exit指令，+1肯定有效
                     pIter = insts.insert(pIter + 1, assignInst);
@@ -352,6 +425,164 @@ void CodeGeneratorArm32::adjustFuncCallInsts(Function * func)
     }
 }
 
+/// @brief 根据剖面数据调整基本块的布局，冷的基本块移到出口指令之后，热的基本块连续存放
+/// @param func 要处理的函数
+void CodeGeneratorArm32::placeColdBlocks(Function * func)
+{
+    if (func->getEntryCount() < 0) {
+        return;
+    }
+
+    ControlFlowGraph cfg(func);
+    std::vector<BasicBlock *> & blocks = cfg.getBlocks();
+    BasicBlock * exitBlock = cfg.getBlockOfLabel(func->getExitLabel());
+
+    // 冷热按函数内的最大执行次数判断，整个函数都很少执行时布局没有意义
+    int64_t funcMaxCount = 0;
+    for (auto bb: blocks) {
+        funcMaxCount = std::max(funcMaxCount, getBlockCount(func, bb));
+    }
+
+    // 入口与出口基本块保持原位，出口指令之后的代码只能通过跳转到达
+    std::vector<BasicBlock *> order;
+    std::vector<BasicBlock *> coldBlocks;
+
+    for (auto bb: blocks) {
+        if (bb != blocks.front() && bb != exitBlock && isColdCount(getBlockCount(func, bb), funcMaxCount)) {
+            coldBlocks.push_back(bb);
+        } else {
+            order.push_back(bb);
+        }
+    }
+
+    if (coldBlocks.empty()) {
+        return;
+    }
+
+    order.insert(order.end(), coldBlocks.begin(), coldBlocks.end());
+
+    // 原来顺序执行进入的后继不再紧随其后时，需要显式跳转
+    for (size_t k = 0; k < order.size(); ++k) {
+
+        BasicBlock * bb = order[k];
+        if (bb->getTerminator() || bb->getSuccs().empty()) {
+            continue;
+        }
+
+        BasicBlock * succ = bb->getSuccs()[0];
+        if ((k + 1 == order.size() || order[k + 1] != succ) && succ->getLabel()) {
+            bb->getInsts().push_back(new (func) GotoInstruction(func, succ->getLabel()));
+        }
+    }
+
+    blocks.swap(order);
+    cfg.writeBack();
+}
+
+/// @brief 标记可以用b指令跳转的尾调用，要求实参都通过寄存器传递
+/// @param func 要处理的函数
+void CodeGeneratorArm32::markTailCalls(Function * func)
+{
+    for (auto inst: func->getInterCode().getInsts()) {
+
+        Instanceof(callInst, FuncCallInstruction *, inst);
+        if (callInst == nullptr || callInst->isDead()) {
+            continue;
+        }
+
+        // 栈传递的实参位于当前函数的栈帧内，拆除栈帧后不能再传递
+        Instruction * retMove;
+        if (callInst->getOperandsNum() > 4 || !isTailCall(func, callInst, retMove)) {
+            continue;
+        }
+
+        callInst->tailCall = true;
+
+        // 调用之后的返回值赋值不会再执行
+        if (retMove) {
+            retMove->setDead();
+        }
+    }
+}
+
+/// @brief 赋值合并，临时变量与赋值的目的局部变量共用栈空间
+/// @param func 要处理的函数
+void CodeGeneratorArm32::coalesceMoves(Function * func)
+{
+    std::vector<Instruction *> & insts = func->getInterCode().getInsts();
+
+    for (size_t k = 0; k < insts.size(); ++k) {
+
+        Instruction * move = insts[k];
+        if (move->isDead() || move->getOp() != IRInstOperator::IRINST_OP_ASSIGN) {
+            continue;
+        }
+
+        Value * dst = move->getOperand(0);
+        Instanceof(src, Instruction *, move->getOperand(1));
+
+        if (!isLocalVariable(dst) || dst->getRegId() != -1 || src == nullptr || !src->hasResultValue() ||
+            src->getRegId() != -1 || src->getType()->getSize() > 4 || coalescedTemps.count(src)) {
+            continue;
+        }
+
+        // 临时变量只被这条赋值读取，函数调用结果从r0的赋值是对它的定值
+        bool onlyUse = true;
+        for (auto use: src->getUses()) {
+            Instanceof(user, Instruction *, use->getUser());
+            bool isDef = user->getOp() == IRInstOperator::IRINST_OP_ASSIGN && user->getOperand(0) == src;
+            if (user != move && !isDef) {
+                onlyUse = false;
+                break;
+            }
+        }
+
+        if (!onlyUse) {
+            continue;
+        }
+
+        // 从赋值向前扫描到临时变量的定义，中间不能有控制流，也不能读写目的变量，否则生存期冲突
+        bool interfere = true;
+        for (size_t j = k; j-- > 0;) {
+
+            Instruction * inst = insts[j];
+            if (inst->isDead()) {
+                continue;
+            }
+
+            if (inst == src) {
+                interfere = false;
+                break;
+            }
+
+            IRInstOperator op = inst->getOp();
+            if (op == IRInstOperator::IRINST_OP_LABEL || op == IRInstOperator::IRINST_OP_GOTO ||
+                op == IRInstOperator::IRINST_OP_ENTRY || op == IRInstOperator::IRINST_OP_EXIT) {
+                break;
+            }
+
+            bool touchDst = false;
+            for (int32_t m = 0; m < inst->getOperandsNum(); ++m) {
+                if (inst->getOperand(m) == dst) {
+                    touchDst = true;
+                    break;
+                }
+            }
+
+            if (touchDst) {
+                break;
+            }
+        }
+
+        if (interfere) {
+            continue;
+        }
+
+        coalescedTemps[src] = dst;
+        move->setDead();
+    }
+}
+
 /// @brief 栈空间分配
 /// @param func 要处理的函数
 void CodeGeneratorArm32::stackAlloc(Function * func)
@@ -375,9 +606,10 @@ void CodeGeneratorArm32::stackAlloc(Function * func)
 
     // 这里对临时变量和局部变量都在栈上进行分配，采用FP+偏移的寻址方式，偏移为负数
 
-    int32_t sp_esp = 0;
+    // 没有寄存器的标量按活跃区间共用栈槽，放在靠近fp的位置，小的栈帧偏移都在ldr/str的立即数范围内
+    int32_t sp_esp = colorStackSlots(func);
 
-    // 遍历函数变量列表
+    // 遍历函数变量列表，剩下的是数组等超过一个字的变量
     for (auto var: func->getVarValues()) {
 
         // 对于简单类型的寄存器分配策略，假定临时变量和局部变量都保存在栈中，属于内存
@@ -386,7 +618,8 @@ void CodeGeneratorArm32::stackAlloc(Function * func)
 
         // regId不为-1，则说明该变量分配为寄存器
         // baseRegNo不等于-1，则说明该变量肯定在栈上，属于内存变量，之前肯定已经分配过
-        if ((var->getRegId() == -1) && (!var->getMemoryAddr())) {
+        // 没有被有效指令引用的标量不需要栈空间
+        if ((var->getRegId() == -1) && (!var->getMemoryAddr()) && var->getType()->getSize() > 4) {
 
             // 该变量没有分配寄存器
 
@@ -408,10 +641,11 @@ void CodeGeneratorArm32::stackAlloc(Function * func)
         }
     }
 
-    // 遍历包含有值的指令，也就是临时变量
+    // 遍历包含有值的指令，也就是临时变量，超过一个字的才没有分配栈槽
     for (auto inst: func->getInterCode().getInsts()) {
 
-        if (inst->hasResultValue() && (inst->getRegId() == -1)) {
+        if (inst->hasResultValue() && (inst->getRegId() == -1) && !inst->getMemoryAddr() &&
+            inst->getType()->getSize() > 4) {
             // 有值，并且没有分配寄存器
 
             int32_t size = inst->getType()->getSize();
@@ -444,3 +678,120 @@ void CodeGeneratorArm32::stackAlloc(Function * func)
     // 设置函数的最大栈帧深度，没有考虑寄存器保护的空间大小
     func->setMaxDep(sp_esp);
 }
+
+/// @brief 是否需要预留R10作为临时寄存器：栈帧大小不是合法的立即数、栈内偏移超出ldr/str的范围，或者保存全局变量
+/// @param func 要处理的函数
+/// @return true 需要 false 不需要
+bool CodeGeneratorArm32::needTmpReg(Function * func)
+{
+    int32_t frameSize = func->getMaxDep();
+    if (!PlatformArm32::constExpr(frameSize)) {
+        return true;
+    }
+
+    // 形参的偏移按全部寄存器都保护估计
+    int32_t maxOffset = frameSize + (PlatformArm32::maxRegNum + (int32_t) func->getParams().size()) * 4;
+    if (!PlatformArm32::isDisp(maxOffset)) {
+        return true;
+    }
+
+    for (auto inst: func->getInterCode().getInsts()) {
+        if (!inst->isDead() && inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN && !inst->hasResultValue() &&
+            isa<GlobalVariable>(inst->getOperand(0))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// @brief 栈槽着色：没有寄存器的标量按活跃区间分配栈槽，活跃区间不重叠的值共用同一个栈槽
+/// @param func 要处理的函数
+/// @return int32_t 栈槽占用的空间大小
+int32_t CodeGeneratorArm32::colorStackSlots(Function * func)
+{
+    ControlFlowGraph cfg(func);
+    Liveness live(cfg);
+
+    // 分配的单位，与局部变量合并的临时变量和局部变量共用栈槽，活跃区间取并集
+    struct SlotUnit {
+        LiveInterval interval;
+        std::vector<Value *> members;
+    };
+
+    std::vector<SlotUnit> units;
+    std::unordered_map<Value *, size_t> unitIndex;
+
+    auto addMember = [&](Value * owner, Value * val) {
+        auto iter = unitIndex.find(owner);
+        if (iter == unitIndex.end()) {
+            iter = unitIndex.emplace(owner, units.size()).first;
+            units.push_back(SlotUnit{LiveInterval(owner), {}});
+        }
+
+        SlotUnit & unit = units[iter->second];
+        unit.members.push_back(val);
+
+        LiveInterval * interval = live.getInterval(val);
+        if (interval) {
+            for (auto & range: interval->getRanges()) {
+                unit.interval.addRange(range.start, range.end);
+            }
+        }
+    };
+
+    for (auto var: func->getVarValues()) {
+        if (var->getRegId() == -1 && !var->getMemoryAddr() && var->getType()->getSize() <= 4) {
+            addMember(var, var);
+        }
+    }
+
+    for (auto inst: func->getInterCode().getInsts()) {
+        if (!inst->isDead() && inst->hasResultValue() && inst->getRegId() == -1 && inst->getType()->getSize() <= 4) {
+            auto coalesced = coalescedTemps.find(inst);
+            addMember(coalesced != coalescedTemps.end() ? coalesced->second : inst, inst);
+        }
+    }
+
+    // 没有被有效指令引用的值不需要栈槽
+    std::vector<SlotUnit *> order;
+    for (auto & unit: units) {
+        if (!unit.interval.empty()) {
+            order.push_back(&unit);
+        }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [](const SlotUnit * a, const SlotUnit * b) {
+        return a->interval.start() < b->interval.start();
+    });
+
+    // 按起始位置线性扫描，结束位置不晚于当前起始位置的单位释放栈槽，优先复用编号小的栈槽
+    using SlotEnd = std::pair<int32_t, int32_t>;
+    std::priority_queue<SlotEnd, std::vector<SlotEnd>, std::greater<SlotEnd>> active;
+    std::set<int32_t> freeSlots;
+    int32_t slotNum = 0;
+
+    for (auto unit: order) {
+
+        while (!active.empty() && active.top().first <= unit->interval.start()) {
+            freeSlots.insert(active.top().second);
+            active.pop();
+        }
+
+        int32_t slot;
+        if (freeSlots.empty()) {
+            slot = slotNum++;
+        } else {
+            slot = *freeSlots.begin();
+            freeSlots.erase(freeSlots.begin());
+        }
+
+        active.emplace(unit->interval.end(), slot);
+
+        for (auto val: unit->members) {
+            val->setMemoryAddr(ARM32_FP_REG_NO, -4 * (slot + 1));
+        }
+    }
+
+    return slotNum * 4;
+}
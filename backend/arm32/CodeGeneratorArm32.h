@@ -13,6 +13,8 @@
 /// <tr><td>2024-11-21 <td>1.0     <td>zenglj  <td>新做
 /// </table>
 ///
+#include <unordered_map>
+
 #include "CodeGeneratorAsm.h"
 #include "SimpleRegisterAllocator.h"
 
@@ -45,10 +47,33 @@ protected:
     /// @param func 要处理的函数
     void stackAlloc(Function * func);
 
+    /// @brief 是否需要预留R10作为临时寄存器：栈帧大小不是合法的立即数、栈内偏移超出ldr/str的范围，或者保存全局变量
+    /// @param func 要处理的函数
+    /// @return true 需要 false 不需要
+    bool needTmpReg(Function * func);
+
+    /// @brief 栈槽着色：没有寄存器的标量按活跃区间分配栈槽，活跃区间不重叠的值共用同一个栈槽
+    /// @param func 要处理的函数
+    /// @return int32_t 栈槽占用的空间大小
+    int32_t colorStackSlots(Function * func);
+
     /// @brief 寄存器分配前对函数内的指令进行调整，以便方便寄存器分配
     /// @param func 要处理的函数
     void adjustFuncCallInsts(Function * func);
 
+    /// @brief 根据剖面数据调整基本块的布局，冷的基本块移到出口指令之后，热的基本块连续存放
+    /// @param func 要处理的函数
+    void placeColdBlocks(Function * func);
+
+    /// @brief 标记可以用b指令跳转的尾调用，要求实参都通过寄存器传递
+    /// @param func 要处理的函数
+    void markTailCalls(Function * func);
+
+    /// @brief 赋值合并：临时变量只被紧随其后的赋值读取且与目的变量的生存期不冲突时，
+    /// 临时变量与目的局部变量共用栈空间，运算结果直接保存到目的变量，赋值指令删除
+    /// @param func 要处理的函数
+    void coalesceMoves(Function * func);
+
     /// @brief 寄存器分配前对形参指令调整，便于栈内空间分配以及寄存器分配
     /// @param func 要处理的函数
     void adjustFormalParamInsts(Function * func);
@@ -64,4 +89,9 @@ private:
     /// @brief 简单的朴素寄存器分配方法
     ///
     SimpleRegisterAllocator simpleRegisterAllocator;
+
+    ///
+    /// @brief 与局部变量合并的临时变量，值为共用栈空间的局部变量
+    ///
+    std::unordered_map<Instruction *, Value *> coalescedTemps;
 };
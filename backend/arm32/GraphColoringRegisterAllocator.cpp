@@ -0,0 +1,832 @@
+///
+/// @file GraphColoringRegisterAllocator.cpp
+/// @brief 迭代合并的图着色寄存器分配器
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+#include "GraphColoringRegisterAllocator.h"
+#include "Common.h"
+#include "InstSelectorArm32.h"
+#include "MoveInstruction.h"
+#include "Profile.h"
+
+/// @brief 构造函数
+/// @param _func 要分配的函数
+GraphColoringRegisterAllocator::GraphColoringRegisterAllocator(Function * _func) : func(_func)
+{}
+
+/// @brief 值是否参与寄存器分配
+/// @param val 值
+/// @return true 参与 false 不参与
+bool GraphColoringRegisterAllocator::isAllocatable(Value * val) const
+{
+    // 形参通过入口的赋值复制到局部变量，本身不参与分配
+    if (!isa<LocalVariable>(val)) {
+        Instanceof(inst, Instruction *, val);
+        if (!inst || !inst->hasResultValue()) {
+            return false;
+        }
+    }
+
+    // 数组等超过一个字的变量只能在栈中
+    return val->getRegId() == -1 && !val->getMemoryAddr() && val->getType()->getSize() <= 4 &&
+           !spilledValues.count(val);
+}
+
+/// @brief 执行寄存器分配，变量的寄存器通过setRegId设置，合并后多余的赋值指令从函数中删除
+void GraphColoringRegisterAllocator::run()
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    // 先删除死指令，指令编号只包含有效的指令
+    {
+        ControlFlowGraph deadCfg(func);
+        deadCfg.writeBack();
+    }
+
+    copyRegisterParams();
+
+    int32_t roundCount = 0;
+    int32_t spillCount = 0;
+    int32_t rematCount = 0;
+    int32_t removedMoveCount = 0;
+
+    // 有实际溢出时改写后重新构造冲突图，每轮至少减少一个结点
+    while (true) {
+
+        ++roundCount;
+
+        ControlFlowGraph cfg(func);
+        Liveness live(cfg);
+
+        build(live);
+        makeWorklist();
+
+        while (true) {
+            if (!simplifyWorklist.empty()) {
+                simplify();
+            } else if (!coalesce() && !freeze() && !selectSpill()) {
+                break;
+            }
+        }
+
+        assignColors();
+
+        if (spilledNodes.empty()) {
+            removedMoveCount = writeColors(cfg);
+            break;
+        }
+
+        spillCount += (int32_t) spilledNodes.size();
+        rematCount += rewriteProgram();
+    }
+
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    minic_log(LOG_INFO,
+              "函数%s: 图着色寄存器分配%d轮，合并删除%d条赋值，溢出%d个变量（%d个重新物化为常量），用时%.3fms",
+              func->getName().c_str(),
+              roundCount,
+              removedMoveCount,
+              spillCount,
+              rematCount,
+              elapsed);
+}
+
+/// @brief 前四个形参在入口复制到新的局部变量，函数内使用局部变量，形参的寄存器可在调用前后复用
+void GraphColoringRegisterAllocator::copyRegisterParams()
+{
+    std::vector<Instruction *> & insts = func->getInterCode().getInsts();
+    if (insts.empty() || insts[0]->getOp() != IRInstOperator::IRINST_OP_ENTRY) {
+        return;
+    }
+
+    auto & params = func->getParams();
+
+    std::vector<Instruction *> copies;
+
+    for (int32_t k = 0; k < (int32_t) params.size() && k < PRECOLORED_NUM; ++k) {
+
+        FormalParam * param = params[k];
+        if (param->getUses().empty()) {
+            continue;
+        }
+
+        // 形参的使用都改为局部变量，复制的赋值与r0-r3合并时被删除
+        LocalVariable * copy = func->newLocalVarValue(param->getType());
+        param->replaceAllUsesWith(copy);
+
+        copies.push_back(new (func) MoveInstruction(func, copy, param));
+    }
+
+    insts.insert(insts.begin() + 1, copies.begin(), copies.end());
+}
+
+/// @brief 获取值对应的结点
+/// @param val 值
+/// @return int32_t 结点，不参与分配时为-1
+int32_t GraphColoringRegisterAllocator::nodeOf(Value * val) const
+{
+    auto iter = nodeIndex.find(val);
+    if (iter != nodeIndex.end()) {
+        return iter->second;
+    }
+
+    // 传递实参与返回值的寄存器
+    Instanceof(regVal, RegVariable *, val);
+    if (regVal && regVal->getRegId() >= 0 && regVal->getRegId() < PRECOLORED_NUM) {
+        return regVal->getRegId();
+    }
+
+    return -1;
+}
+
+/// @brief 构造冲突图与赋值列表，累计溢出代价
+/// @param live 活跃性分析
+void GraphColoringRegisterAllocator::build(Liveness & live)
+{
+    ControlFlowGraph & cfg = live.getCFG();
+    const std::vector<Value *> & values = live.getValues();
+
+    // 结点编号：r0-r3，然后是参与分配的值
+    nodeValues.assign(PRECOLORED_NUM, nullptr);
+    nodeIndex.clear();
+
+    auto & params = func->getParams();
+    for (int32_t k = 0; k < (int32_t) params.size() && k < PRECOLORED_NUM; ++k) {
+        nodeIndex.emplace(params[k], k);
+    }
+
+    for (auto val: values) {
+        if (isAllocatable(val)) {
+            nodeIndex.emplace(val, (int32_t) nodeValues.size());
+            nodeValues.push_back(val);
+        }
+    }
+
+    auto nodeNum = (int32_t) nodeValues.size();
+
+    adjSet.clear();
+    adjList.assign(nodeNum, {});
+    degree.assign(nodeNum, 0);
+    spillCost.assign(nodeNum, 0);
+    nodeState.assign(nodeNum, NodeState::Simplify);
+    alias.resize(nodeNum);
+    color.assign(nodeNum, -1);
+    moveList.assign(nodeNum, {});
+    rematConst.assign(nodeNum, nullptr);
+    visitMark.assign(nodeNum, 0);
+    visitStamp = 0;
+
+    for (int32_t n = 0; n < nodeNum; ++n) {
+        alias[n] = n;
+    }
+
+    // 预着色结点的度数视为无穷大
+    for (int32_t k = 0; k < PRECOLORED_NUM; ++k) {
+        degree[k] = INT_MAX / 2;
+        nodeState[k] = NodeState::Precolored;
+        color[k] = k;
+    }
+
+    moves.clear();
+    simplifyWorklist.clear();
+    freezeWorklist.clear();
+    spillWorklist.clear();
+    worklistMoves.clear();
+    selectStack.clear();
+    spilledNodes.clear();
+    coalescedMoveCount = 0;
+
+    std::vector<bool> notRemat(nodeNum, false);
+    std::vector<double> frequency = getBlockFrequencies(func, cfg);
+
+    // 参与分配或预着色的值翻译时不需要临时寄存器
+    auto inReg = [this](Value * val) { return nodeOf(val) >= 0; };
+
+    BitSet liveNow((uint32_t) nodeNum);
+    std::vector<int32_t> uses;
+    std::vector<int32_t> defs;
+
+    for (auto bb: cfg.getBlocks()) {
+
+        double freq = frequency[bb->getIndex()];
+
+        liveNow.clear();
+        for (auto index: live.getLiveOut(bb)) {
+            int32_t n = nodeOf(values[index]);
+            if (n >= 0) {
+                liveNow.set(n);
+            }
+        }
+
+        std::vector<Instruction *> & insts = bb->getInsts();
+
+        for (auto iter = insts.rbegin(); iter != insts.rend(); ++iter) {
+
+            Instruction * inst = *iter;
+            if (inst->isDead()) {
+                continue;
+            }
+
+            IRInstOperator op = inst->getOp();
+            bool isMove = op == IRInstOperator::IRINST_OP_ASSIGN && !inst->hasResultValue();
+
+            uses.clear();
+            defs.clear();
+
+            for (int32_t k = isMove ? 1 : 0; k < inst->getOperandsNum(); ++k) {
+                int32_t n = nodeOf(inst->getOperand(k));
+                if (n >= 0) {
+                    uses.push_back(n);
+                }
+            }
+
+            // 函数调用的结果由其后从r0的赋值定值，调用本身只破坏r0-r3
+            int32_t defNode = -1;
+            if (isMove) {
+                defNode = nodeOf(inst->getOperand(0));
+            } else if (inst->hasResultValue() && op != IRInstOperator::IRINST_OP_FUNC_CALL) {
+                defNode = nodeOf(inst);
+            }
+
+            if (defNode >= 0) {
+                defs.push_back(defNode);
+
+                // 重新物化要求所有的定值都是同一个常量的赋值
+                Instanceof(constVal, ConstInt *, isMove ? inst->getOperand(1) : nullptr);
+                if (defNode >= PRECOLORED_NUM && !notRemat[defNode]) {
+                    if (constVal && (!rematConst[defNode] || rematConst[defNode]->getVal() == constVal->getVal())) {
+                        rematConst[defNode] = constVal;
+                    } else {
+                        rematConst[defNode] = nullptr;
+                        notRemat[defNode] = true;
+                    }
+                }
+            }
+
+            for (auto n: uses) {
+                spillCost[n] += freq;
+            }
+            if (defNode >= PRECOLORED_NUM) {
+                spillCost[defNode] += freq;
+            }
+
+            // 两端都是结点的赋值可以合并，源与目的不因这条赋值冲突
+            int32_t moveSrc = -1;
+            if (isMove && defNode >= 0 && !uses.empty()) {
+                moveSrc = uses[0];
+                liveNow.reset(moveSrc);
+            } else if (op == IRInstOperator::IRINST_OP_EXIT && !uses.empty()) {
+                // 返回值通过r0传递
+                defNode = 0;
+                moveSrc = uses[0];
+            }
+
+            if (moveSrc >= 0) {
+                auto m = (int32_t) moves.size();
+                moves.push_back(MoveInfo{defNode, moveSrc, inst, MoveState::Worklist});
+                moveList[defNode].push_back(m);
+                moveList[moveSrc].push_back(m);
+                worklistMoves.push_back(m);
+            }
+
+            // 函数调用破坏r0-r3，需要临时寄存器的指令破坏用到的临时寄存器，临时寄存器还不能与操作数的寄存器相同
+            int32_t scratch = op == IRInstOperator::IRINST_OP_FUNC_CALL ? 0 : InstSelectorArm32::scratchRegsNeeded(inst, inReg);
+            int32_t clobberNum = op == IRInstOperator::IRINST_OP_FUNC_CALL ? PRECOLORED_NUM : scratch;
+            for (int32_t k = 0; k < clobberNum; ++k) {
+                defs.push_back(k);
+            }
+
+            for (auto d: defs) {
+                liveNow.set(d);
+            }
+
+            for (auto d: defs) {
+                for (auto l: liveNow) {
+                    addEdge((int32_t) l, d);
+                }
+            }
+
+            if (scratch > 0) {
+                for (auto u: uses) {
+                    for (int32_t k = 0; k < scratch; ++k) {
+                        addEdge(u, k);
+                    }
+                }
+            }
+
+            // 求余先计算商再计算余数，结果不能与操作数共用寄存器
+            if (op == IRInstOperator::IRINST_OP_MOD_I && defNode >= 0) {
+                for (auto u: uses) {
+                    addEdge(u, defNode);
+                }
+            }
+
+            for (auto d: defs) {
+                liveNow.reset(d);
+            }
+
+            for (auto u: uses) {
+                liveNow.set(u);
+            }
+        }
+    }
+
+    // 重新物化省去了定值处的保存
+    for (int32_t n = PRECOLORED_NUM; n < nodeNum; ++n) {
+        if (rematConst[n]) {
+            spillCost[n] /= 2;
+        }
+    }
+}
+
+/// @brief 加入冲突边
+/// @param u 结点
+/// @param v 结点
+void GraphColoringRegisterAllocator::addEdge(int32_t u, int32_t v)
+{
+    if (u == v || hasEdge(u, v)) {
+        return;
+    }
+
+    adjSet.insert(((uint64_t) std::min(u, v) << 32) | (uint32_t) std::max(u, v));
+
+    if (u >= PRECOLORED_NUM) {
+        adjList[u].push_back(v);
+        degree[u]++;
+    }
+
+    if (v >= PRECOLORED_NUM) {
+        adjList[v].push_back(u);
+        degree[v]++;
+    }
+}
+
+/// @brief 两个结点之间是否有冲突边
+/// @param u 结点
+/// @param v 结点
+/// @return true 有 false 没有
+bool GraphColoringRegisterAllocator::hasEdge(int32_t u, int32_t v) const
+{
+    return adjSet.count(((uint64_t) std::min(u, v) << 32) | (uint32_t) std::max(u, v)) != 0;
+}
+
+/// @brief 按度数与是否与赋值相关把结点放入简化、冻结或溢出工作表
+void GraphColoringRegisterAllocator::makeWorklist()
+{
+    for (auto n = (int32_t) nodeValues.size() - 1; n >= PRECOLORED_NUM; --n) {
+        if (degree[n] >= COLOR_NUM) {
+            nodeState[n] = NodeState::Spill;
+            spillWorklist.push_back(n);
+        } else if (moveRelated(n)) {
+            nodeState[n] = NodeState::Freeze;
+            freezeWorklist.push_back(n);
+        } else {
+            nodeState[n] = NodeState::Simplify;
+            simplifyWorklist.push_back(n);
+        }
+    }
+}
+
+/// @brief 结点是否还与未处理的赋值相关
+/// @param n 结点
+/// @return true 相关 false 不相关
+bool GraphColoringRegisterAllocator::moveRelated(int32_t n) const
+{
+    for (auto m: moveList[n]) {
+        if (moves[m].state == MoveState::Active || moves[m].state == MoveState::Worklist) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// @brief 对结点执行函数，跳过已入栈与已合并的邻接结点
+/// @tparam F 函数类型
+/// @param n 结点
+/// @param fn 函数
+template <typename F>
+void GraphColoringRegisterAllocator::forEachAdjacent(int32_t n, F fn) const
+{
+    for (auto t: adjList[n]) {
+        if (nodeState[t] != NodeState::Selected && nodeState[t] != NodeState::Coalesced) {
+            fn(t);
+        }
+    }
+}
+
+/// @brief 简化：度数小于颜色数且与赋值无关的结点入栈
+void GraphColoringRegisterAllocator::simplify()
+{
+    int32_t n = simplifyWorklist.back();
+    simplifyWorklist.pop_back();
+
+    nodeState[n] = NodeState::Selected;
+    selectStack.push_back(n);
+
+    forEachAdjacent(n, [this](int32_t t) { decrementDegree(t); });
+}
+
+/// @brief 结点度数减一，降到颜色数以下时它及其邻接结点的赋值可以再尝试合并
+/// @param n 结点
+void GraphColoringRegisterAllocator::decrementDegree(int32_t n)
+{
+    if (n < PRECOLORED_NUM) {
+        return;
+    }
+
+    int32_t d = degree[n]--;
+
+    if (d == COLOR_NUM && nodeState[n] == NodeState::Spill) {
+
+        enableMoves(n);
+        forEachAdjacent(n, [this](int32_t t) { enableMoves(t); });
+
+        if (moveRelated(n)) {
+            nodeState[n] = NodeState::Freeze;
+            freezeWorklist.push_back(n);
+        } else {
+            nodeState[n] = NodeState::Simplify;
+            simplifyWorklist.push_back(n);
+        }
+    }
+}
+
+/// @brief 激活结点相关的赋值
+/// @param n 结点
+void GraphColoringRegisterAllocator::enableMoves(int32_t n)
+{
+    for (auto m: moveList[n]) {
+        if (moves[m].state == MoveState::Active) {
+            moves[m].state = MoveState::Worklist;
+            worklistMoves.push_back(m);
+        }
+    }
+}
+
+/// @brief 合并一条赋值的两端
+/// @return true 处理了一条赋值 false 没有待合并的赋值
+bool GraphColoringRegisterAllocator::coalesce()
+{
+    // 离开工作表的赋值没有删除，按状态跳过
+    while (!worklistMoves.empty() && moves[worklistMoves.back()].state != MoveState::Worklist) {
+        worklistMoves.pop_back();
+    }
+
+    if (worklistMoves.empty()) {
+        return false;
+    }
+
+    MoveInfo & move = moves[worklistMoves.back()];
+    worklistMoves.pop_back();
+
+    int32_t x = getAlias(move.src);
+    int32_t y = getAlias(move.dst);
+
+    // 有预着色结点时作为u
+    int32_t u = x;
+    int32_t v = y;
+    if (y < PRECOLORED_NUM) {
+        u = y;
+        v = x;
+    }
+
+    if (u == v) {
+        move.state = MoveState::Coalesced;
+        coalescedMoveCount++;
+        addWorkList(u);
+    } else if (v < PRECOLORED_NUM || hasEdge(u, v)) {
+        move.state = MoveState::Constrained;
+        addWorkList(u);
+        addWorkList(v);
+    } else {
+
+        bool ok;
+        if (u < PRECOLORED_NUM) {
+            ok = true;
+            forEachAdjacent(v, [this, u, &ok](int32_t t) {
+                if (!georgeOK(t, u)) {
+                    ok = false;
+                }
+            });
+        } else {
+            ok = briggsOK(u, v);
+        }
+
+        if (ok) {
+            move.state = MoveState::Coalesced;
+            coalescedMoveCount++;
+            combine(u, v);
+            addWorkList(u);
+        } else {
+            move.state = MoveState::Active;
+        }
+    }
+
+    return true;
+}
+
+/// @brief 结点不再与赋值相关且度数小于颜色数时放入简化工作表
+/// @param n 结点
+void GraphColoringRegisterAllocator::addWorkList(int32_t n)
+{
+    if (n >= PRECOLORED_NUM && nodeState[n] == NodeState::Freeze && !moveRelated(n) && degree[n] < COLOR_NUM) {
+        nodeState[n] = NodeState::Simplify;
+        simplifyWorklist.push_back(n);
+    }
+}
+
+/// @brief George准则：t的邻接结点都可以与预着色结点r合并
+/// @param t 结点
+/// @param r 预着色结点
+/// @return true 可以 false 不可以
+bool GraphColoringRegisterAllocator::georgeOK(int32_t t, int32_t r) const
+{
+    return degree[t] < COLOR_NUM || t < PRECOLORED_NUM || hasEdge(t, r);
+}
+
+/// @brief Briggs准则：合并后度数不小于颜色数的邻接结点少于颜色数
+/// @param u 结点
+/// @param v 结点
+/// @return true 可以 false 不可以
+bool GraphColoringRegisterAllocator::briggsOK(int32_t u, int32_t v)
+{
+    ++visitStamp;
+
+    int32_t count = 0;
+    auto countHigh = [this, &count](int32_t t) {
+        if (visitMark[t] != visitStamp) {
+            visitMark[t] = visitStamp;
+            if (degree[t] >= COLOR_NUM) {
+                count++;
+            }
+        }
+    };
+
+    forEachAdjacent(u, countHigh);
+    forEachAdjacent(v, countHigh);
+
+    return count < COLOR_NUM;
+}
+
+/// @brief 获取合并后的代表结点
+/// @param n 结点
+/// @return int32_t 代表结点
+int32_t GraphColoringRegisterAllocator::getAlias(int32_t n) const
+{
+    while (nodeState[n] == NodeState::Coalesced) {
+        n = alias[n];
+    }
+
+    return n;
+}
+
+/// @brief 把结点v合并到结点u
+/// @param u 结点
+/// @param v 结点
+void GraphColoringRegisterAllocator::combine(int32_t u, int32_t v)
+{
+    // v离开冻结或溢出工作表
+    nodeState[v] = NodeState::Coalesced;
+    alias[v] = u;
+
+    moveList[u].insert(moveList[u].end(), moveList[v].begin(), moveList[v].end());
+    enableMoves(v);
+
+    if (u >= PRECOLORED_NUM) {
+        spillCost[u] += spillCost[v];
+    }
+
+    forEachAdjacent(v, [this, u](int32_t t) {
+        addEdge(t, u);
+        decrementDegree(t);
+    });
+
+    if (degree[u] >= COLOR_NUM && nodeState[u] == NodeState::Freeze) {
+        nodeState[u] = NodeState::Spill;
+        spillWorklist.push_back(u);
+    }
+}
+
+/// @brief 冻结：放弃一个度数小的结点的赋值合并，使其可以被简化
+/// @return true 冻结了一个结点 false 冻结工作表为空
+bool GraphColoringRegisterAllocator::freeze()
+{
+    while (!freezeWorklist.empty() && nodeState[freezeWorklist.back()] != NodeState::Freeze) {
+        freezeWorklist.pop_back();
+    }
+
+    if (freezeWorklist.empty()) {
+        return false;
+    }
+
+    int32_t u = freezeWorklist.back();
+    freezeWorklist.pop_back();
+
+    nodeState[u] = NodeState::Simplify;
+    simplifyWorklist.push_back(u);
+    freezeMoves(u);
+
+    return true;
+}
+
+/// @brief 冻结结点相关的赋值
+/// @param u 结点
+void GraphColoringRegisterAllocator::freezeMoves(int32_t u)
+{
+    for (auto m: moveList[u]) {
+
+        MoveInfo & move = moves[m];
+        if (move.state != MoveState::Active && move.state != MoveState::Worklist) {
+            continue;
+        }
+
+        move.state = MoveState::Frozen;
+
+        int32_t v = getAlias(move.dst) == getAlias(u) ? getAlias(move.src) : getAlias(move.dst);
+
+        if (v >= PRECOLORED_NUM && nodeState[v] == NodeState::Freeze && !moveRelated(v) && degree[v] < COLOR_NUM) {
+            nodeState[v] = NodeState::Simplify;
+            simplifyWorklist.push_back(v);
+        }
+    }
+}
+
+/// @brief 按溢出代价与度数之比选择溢出候选，乐观地放入简化工作表
+/// @return true 选择了一个结点 false 溢出工作表为空
+bool GraphColoringRegisterAllocator::selectSpill()
+{
+    // 去掉已离开的结点
+    auto last = std::remove_if(spillWorklist.begin(), spillWorklist.end(), [this](int32_t n) {
+        return nodeState[n] != NodeState::Spill;
+    });
+    spillWorklist.erase(last, spillWorklist.end());
+
+    if (spillWorklist.empty()) {
+        return false;
+    }
+
+    auto best = spillWorklist.begin();
+    for (auto iter = spillWorklist.begin(); iter != spillWorklist.end(); ++iter) {
+        if (spillCost[*iter] / degree[*iter] < spillCost[*best] / degree[*best]) {
+            best = iter;
+        }
+    }
+
+    int32_t n = *best;
+    spillWorklist.erase(best);
+
+    // 乐观着色：先简化，着色时没有可用颜色才实际溢出
+    nodeState[n] = NodeState::Simplify;
+    simplifyWorklist.push_back(n);
+    freezeMoves(n);
+
+    return true;
+}
+
+/// @brief 按出栈次序着色，没有可用颜色的结点实际溢出
+void GraphColoringRegisterAllocator::assignColors()
+{
+    while (!selectStack.empty()) {
+
+        int32_t n = selectStack.back();
+        selectStack.pop_back();
+
+        uint32_t okColors = (1u << COLOR_NUM) - 1;
+
+        for (auto w: adjList[n]) {
+            int32_t a = getAlias(w);
+            if (nodeState[a] == NodeState::Colored || nodeState[a] == NodeState::Precolored) {
+                okColors &= ~(1u << color[a]);
+            }
+        }
+
+        if (okColors == 0) {
+            nodeState[n] = NodeState::Spilled;
+            spilledNodes.push_back(n);
+            continue;
+        }
+
+        // 优先选择赋值另一端已有的颜色，其次是不需要保护的r0-r3与编号小的寄存器
+        int32_t c = -1;
+        for (auto m: moveList[n]) {
+            int32_t other = getAlias(moves[m].dst) == n ? getAlias(moves[m].src) : getAlias(moves[m].dst);
+            bool colored = nodeState[other] == NodeState::Colored || nodeState[other] == NodeState::Precolored;
+            if (colored && (okColors & (1u << color[other]))) {
+                c = color[other];
+                break;
+            }
+        }
+
+        if (c == -1) {
+            c = 0;
+            while (!(okColors & (1u << c))) {
+                c++;
+            }
+        }
+
+        nodeState[n] = NodeState::Colored;
+        color[n] = c;
+    }
+
+    for (auto n = PRECOLORED_NUM; n < (int32_t) nodeValues.size(); ++n) {
+        if (nodeState[n] == NodeState::Coalesced) {
+            color[n] = color[getAlias(n)];
+        }
+    }
+}
+
+/// @brief 实际溢出的变量保留在栈中，只被同一个常量赋值的变量的使用替换为常量
+/// @return int32_t 重新物化的变量个数
+int32_t GraphColoringRegisterAllocator::rewriteProgram()
+{
+    int32_t rematCount = 0;
+
+    for (auto n: spilledNodes) {
+
+        Value * val = nodeValues[n];
+        ConstInt * constVal = rematConst[n];
+
+        spilledValues.insert(val);
+
+        if (!constVal) {
+            continue;
+        }
+
+        std::vector<Instruction *> users;
+        for (auto use: val->getUses()) {
+            Instanceof(user, Instruction *, use->getUser());
+            if (user && !user->isDead()) {
+                users.push_back(user);
+            }
+        }
+
+        // 常量的赋值删除，使用处直接加载常量
+        for (auto user: users) {
+
+            if (user->getOp() == IRInstOperator::IRINST_OP_ASSIGN && user->getOperand(0) == val) {
+                user->setDead();
+                continue;
+            }
+
+            for (int32_t k = 0; k < user->getOperandsNum(); ++k) {
+                if (user->getOperand(k) == val) {
+                    user->setOperand(k, constVal);
+                }
+            }
+        }
+
+        rematCount++;
+    }
+
+    return rematCount;
+}
+
+/// @brief 写回分配结果：设置寄存器，删除两端寄存器相同的赋值
+/// @param cfg 控制流图
+/// @return int32_t 删除的赋值个数
+int32_t GraphColoringRegisterAllocator::writeColors(ControlFlowGraph & cfg)
+{
+    uint32_t usedMask = 0;
+
+    for (auto n = PRECOLORED_NUM; n < (int32_t) nodeValues.size(); ++n) {
+        nodeValues[n]->setRegId(color[n]);
+        usedMask |= 1u << color[n];
+    }
+
+    int32_t removedCount = 0;
+
+    for (auto & move: moves) {
+        if (move.inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN && color[move.dst] == color[move.src]) {
+            move.inst->setDead();
+            removedCount++;
+        }
+    }
+
+    cfg.writeBack();
+
+    usedRegs.clear();
+    for (int32_t reg = PRECOLORED_NUM; reg < COLOR_NUM; ++reg) {
+        if (usedMask & (1u << reg)) {
+            usedRegs.push_back(reg);
+        }
+    }
+
+    return removedCount;
+}
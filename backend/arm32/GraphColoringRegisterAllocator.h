@@ -0,0 +1,388 @@
+///
+/// @file GraphColoringRegisterAllocator.h
+/// @brief 迭代合并的图着色寄存器分配器
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ControlFlowGraph.h"
+#include "Function.h"
+#include "Liveness.h"
+
+class ConstInt;
+
+///
+/// @brief 迭代合并的图着色寄存器分配器（George与Appel的算法）。
+/// 按活跃性分析构造冲突图，r0-r3作为预着色结点，形参、实参与返回值的赋值可与之合并；
+/// 赋值相连的结点按Briggs与George准则保守合并，度数不小于颜色数时乐观地选择溢出候选，
+/// 着色失败的结点溢出到栈中后重新构造冲突图。只被同一个常量赋值的变量溢出时重新物化为常量。
+/// 函数调用破坏r0-r3，需要临时寄存器的指令破坏从r0开始用到的临时寄存器，其间活跃的值与之冲突
+///
+class GraphColoringRegisterAllocator {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _func 要分配的函数
+    ///
+    explicit GraphColoringRegisterAllocator(Function * _func);
+
+    ///
+    /// @brief 执行寄存器分配，变量的寄存器通过setRegId设置，合并后多余的赋值指令从函数中删除
+    ///
+    void run();
+
+    ///
+    /// @brief 获取分配使用过的被调用者保存的寄存器编号，升序排列，函数入口需要保护
+    /// @return const std::vector<int32_t>& 寄存器编号
+    ///
+    [[nodiscard]] const std::vector<int32_t> & getUsedRegs() const
+    {
+        return usedRegs;
+    }
+
+    ///
+    /// @brief 预着色的寄存器个数，即参数与返回值使用的r0-r3
+    ///
+    static constexpr int32_t PRECOLORED_NUM = 4;
+
+    ///
+    /// @brief 颜色数，可分配r0-r9，r10为临时寄存器
+    ///
+    static constexpr int32_t COLOR_NUM = 10;
+
+private:
+    ///
+    /// @brief 结点所在的集合
+    ///
+    enum class NodeState : int8_t {
+        Precolored,
+        Simplify,
+        Freeze,
+        Spill,
+        Spilled,
+        Coalesced,
+        Colored,
+        Selected,
+    };
+
+    ///
+    /// @brief 赋值指令所在的集合
+    ///
+    enum class MoveState : int8_t {
+        Coalesced,
+        Constrained,
+        Frozen,
+        Worklist,
+        Active,
+    };
+
+    ///
+    /// @brief 两端都是结点的赋值，返回值的传递也作为赋值
+    ///
+    struct MoveInfo {
+
+        /// @brief 目的结点
+        int32_t dst;
+
+        /// @brief 源结点
+        int32_t src;
+
+        /// @brief 赋值指令，返回值的传递为出口指令
+        Instruction * inst;
+
+        /// @brief 所在的集合
+        MoveState state;
+    };
+
+    ///
+    /// @brief 值是否参与寄存器分配
+    /// @param val 值
+    /// @return true 参与 false 不参与
+    ///
+    bool isAllocatable(Value * val) const;
+
+    ///
+    /// @brief 前四个形参在入口复制到新的局部变量，函数内使用局部变量，形参的寄存器可在调用前后复用
+    ///
+    void copyRegisterParams();
+
+    ///
+    /// @brief 构造冲突图与赋值列表，累计溢出代价
+    /// @param live 活跃性分析
+    ///
+    void build(Liveness & live);
+
+    ///
+    /// @brief 获取值对应的结点
+    /// @param val 值
+    /// @return int32_t 结点，不参与分配时为-1
+    ///
+    int32_t nodeOf(Value * val) const;
+
+    ///
+    /// @brief 加入冲突边
+    /// @param u 结点
+    /// @param v 结点
+    ///
+    void addEdge(int32_t u, int32_t v);
+
+    ///
+    /// @brief 两个结点之间是否有冲突边
+    /// @param u 结点
+    /// @param v 结点
+    /// @return true 有 false 没有
+    ///
+    [[nodiscard]] bool hasEdge(int32_t u, int32_t v) const;
+
+    ///
+    /// @brief 按度数与是否与赋值相关把结点放入简化、冻结或溢出工作表
+    ///
+    void makeWorklist();
+
+    ///
+    /// @brief 结点是否还与未处理的赋值相关
+    /// @param n 结点
+    /// @return true 相关 false 不相关
+    ///
+    bool moveRelated(int32_t n) const;
+
+    ///
+    /// @brief 对结点执行函数，跳过已入栈与已合并的邻接结点
+    /// @tparam F 函数类型
+    /// @param n 结点
+    /// @param fn 函数
+    ///
+    template <typename F>
+    void forEachAdjacent(int32_t n, F fn) const;
+
+    ///
+    /// @brief 简化：度数小于颜色数且与赋值无关的结点入栈
+    ///
+    void simplify();
+
+    ///
+    /// @brief 结点度数减一，降到颜色数以下时它及其邻接结点的赋值可以再尝试合并
+    /// @param n 结点
+    ///
+    void decrementDegree(int32_t n);
+
+    ///
+    /// @brief 激活结点相关的赋值
+    /// @param n 结点
+    ///
+    void enableMoves(int32_t n);
+
+    ///
+    /// @brief 合并一条赋值的两端
+    /// @return true 处理了一条赋值 false 没有待合并的赋值
+    ///
+    bool coalesce();
+
+    ///
+    /// @brief 结点不再与赋值相关且度数小于颜色数时放入简化工作表
+    /// @param n 结点
+    ///
+    void addWorkList(int32_t n);
+
+    ///
+    /// @brief George准则：t的邻接结点都可以与预着色结点r合并
+    /// @param t 结点
+    /// @param r 预着色结点
+    /// @return true 可以 false 不可以
+    ///
+    bool georgeOK(int32_t t, int32_t r) const;
+
+    ///
+    /// @brief Briggs准则：合并后度数不小于颜色数的邻接结点少于颜色数
+    /// @param u 结点
+    /// @param v 结点
+    /// @return true 可以 false 不可以
+    ///
+    bool briggsOK(int32_t u, int32_t v);
+
+    ///
+    /// @brief 获取合并后的代表结点
+    /// @param n 结点
+    /// @return int32_t 代表结点
+    ///
+    int32_t getAlias(int32_t n) const;
+
+    ///
+    /// @brief 把结点v合并到结点u
+    /// @param u 结点
+    /// @param v 结点
+    ///
+    void combine(int32_t u, int32_t v);
+
+    ///
+    /// @brief 冻结：放弃一个度数小的结点的赋值合并，使其可以被简化
+    /// @return true 冻结了一个结点 false 冻结工作表为空
+    ///
+    bool freeze();
+
+    ///
+    /// @brief 冻结结点相关的赋值
+    /// @param u 结点
+    ///
+    void freezeMoves(int32_t u);
+
+    ///
+    /// @brief 按溢出代价与度数之比选择溢出候选，乐观地放入简化工作表
+    /// @return true 选择了一个结点 false 溢出工作表为空
+    ///
+    bool selectSpill();
+
+    ///
+    /// @brief 按出栈次序着色，没有可用颜色的结点实际溢出
+    ///
+    void assignColors();
+
+    ///
+    /// @brief 实际溢出的变量保留在栈中，只被同一个常量赋值的变量的使用替换为常量
+    /// @return int32_t 重新物化的变量个数
+    ///
+    int32_t rewriteProgram();
+
+    ///
+    /// @brief 写回分配结果：设置寄存器，删除两端寄存器相同的赋值
+    /// @param cfg 控制流图
+    /// @return int32_t 删除的赋值个数
+    ///
+    int32_t writeColors(ControlFlowGraph & cfg);
+
+    ///
+    /// @brief 函数
+    ///
+    Function * func;
+
+    ///
+    /// @brief 实际溢出到栈中的值
+    ///
+    std::unordered_set<Value *> spilledValues;
+
+    ///
+    /// @brief 结点对应的值，预着色结点为空
+    ///
+    std::vector<Value *> nodeValues;
+
+    ///
+    /// @brief 值到结点的映射，前四个形参映射到预着色结点
+    ///
+    std::unordered_map<Value *, int32_t> nodeIndex;
+
+    ///
+    /// @brief 冲突边，两个结点编号组成的键
+    ///
+    std::unordered_set<uint64_t> adjSet;
+
+    ///
+    /// @brief 邻接表，预着色结点没有邻接表
+    ///
+    std::vector<std::vector<int32_t>> adjList;
+
+    ///
+    /// @brief 结点的度数
+    ///
+    std::vector<int32_t> degree;
+
+    ///
+    /// @brief 结点的溢出代价，引用按所在基本块的执行频度累加
+    ///
+    std::vector<double> spillCost;
+
+    ///
+    /// @brief 结点所在的集合
+    ///
+    std::vector<NodeState> nodeState;
+
+    ///
+    /// @brief 合并到的结点
+    ///
+    std::vector<int32_t> alias;
+
+    ///
+    /// @brief 结点的颜色，即寄存器编号
+    ///
+    std::vector<int32_t> color;
+
+    ///
+    /// @brief 结点相关的赋值
+    ///
+    std::vector<std::vector<int32_t>> moveList;
+
+    ///
+    /// @brief 只被这个常量赋值的结点可重新物化，其它为空
+    ///
+    std::vector<ConstInt *> rematConst;
+
+    ///
+    /// @brief 两端都是结点的赋值
+    ///
+    std::vector<MoveInfo> moves;
+
+    ///
+    /// @brief 简化工作表
+    ///
+    std::vector<int32_t> simplifyWorklist;
+
+    ///
+    /// @brief 冻结工作表，结点离开后不删除，出表时按状态跳过
+    ///
+    std::vector<int32_t> freezeWorklist;
+
+    ///
+    /// @brief 溢出工作表，结点离开后不删除，选择时按状态跳过
+    ///
+    std::vector<int32_t> spillWorklist;
+
+    ///
+    /// @brief 待合并的赋值，离开后不删除，出表时按状态跳过
+    ///
+    std::vector<int32_t> worklistMoves;
+
+    ///
+    /// @brief 简化的结点栈
+    ///
+    std::vector<int32_t> selectStack;
+
+    ///
+    /// @brief 本轮实际溢出的结点
+    ///
+    std::vector<int32_t> spilledNodes;
+
+    ///
+    /// @brief Briggs准则统计邻接结点时的访问标记
+    ///
+    std::vector<int32_t> visitMark;
+
+    ///
+    /// @brief 当前的访问标记
+    ///
+    int32_t visitStamp = 0;
+
+    ///
+    /// @brief 本轮合并的赋值个数
+    ///
+    int32_t coalescedMoveCount = 0;
+
+    ///
+    /// @brief 使用过的被调用者保存的寄存器编号
+    ///
+    std::vector<int32_t> usedRegs;
+};
@@ -511,12 +511,12 @@ void ILocArm32::allocStack(Function * func, int tmp_reg_no)
     // 计算栈帧大小
     int off = func->getMaxDep();
 
-    // 不需要在栈内额外分配空间，则什么都不做
+    // 不需要在栈内额外分配空间，也没有建立帧指针
     if (0 == off) {
         return;
     }
 
-    // 保存SP寄存器到FP寄存器中
+    // 保存SP寄存器到FP寄存器中，出口通过FP恢复SP
     mov_reg(ARM32_FP_REG_NO, ARM32_SP_REG_NO);
 
     if (PlatformArm32::constExpr(off)) {
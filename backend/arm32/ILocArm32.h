@@ -20,8 +20,6 @@
 
 #include "Module.h"
 
-#define Instanceof(res, type, var) auto res = dynamic_cast<type>(var)
-
 /// @brief 底层汇编指令：ARM32
 struct ArmInst {
 
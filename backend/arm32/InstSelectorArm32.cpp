@@ -14,8 +14,10 @@
 /// </table>
 ///
 #include <cstdio>
+#include <map>
 
 #include "Common.h"
+#include "DispatchTable.h"
 #include "ILocArm32.h"
 #include "InstSelectorArm32.h"
 #include "PlatformArm32.h"
@@ -28,6 +30,40 @@
 #include "GotoInstruction.h"
 #include "FuncCallInstruction.h"
 #include "MoveInstruction.h"
+#include "BinaryInstruction.h"
+
+/// @brief IR动作处理函数表，以指令操作码为下标，每个指令操作码都要有翻译函数
+constexpr std::array<InstSelectorArm32::translate_handler, InstSelectorArm32::IRINST_OP_COUNT>
+    InstSelectorArm32::translator_handlers =
+        makeDispatchTable<IRInstOperator, InstSelectorArm32::translate_handler, InstSelectorArm32::IRINST_OP_COUNT>({
+            {IRInstOperator::IRINST_OP_ENTRY, &InstSelectorArm32::translate_entry},
+            {IRInstOperator::IRINST_OP_EXIT, &InstSelectorArm32::translate_exit},
+
+            {IRInstOperator::IRINST_OP_LABEL, &InstSelectorArm32::translate_label},
+            {IRInstOperator::IRINST_OP_GOTO, &InstSelectorArm32::translate_goto},
+
+            {IRInstOperator::IRINST_OP_ASSIGN, &InstSelectorArm32::translate_assign},
+
+            {IRInstOperator::IRINST_OP_ADD_I, &InstSelectorArm32::translate_add_int32},
+            {IRInstOperator::IRINST_OP_SUB_I, &InstSelectorArm32::translate_sub_int32},
+            {IRInstOperator::IRINST_OP_MUL_I, &InstSelectorArm32::translate_mul_int32},
+            {IRInstOperator::IRINST_OP_DIV_I, &InstSelectorArm32::translate_div_int32},
+            {IRInstOperator::IRINST_OP_MOD_I, &InstSelectorArm32::translate_mod_int32},
+            {IRInstOperator::IRINST_OP_NEG_I, &InstSelectorArm32::translate_neg_int32},
+
+            // 条件分支统一用条件跳转的GOTO指令表示，没有单独的翻译
+            {IRInstOperator::IRINST_OP_BRANCH, &InstSelectorArm32::translate_unsupported},
+
+            {IRInstOperator::IRINST_OP_LT_I, &InstSelectorArm32::translate_lt_int32},
+            {IRInstOperator::IRINST_OP_GT_I, &InstSelectorArm32::translate_gt_int32},
+            {IRInstOperator::IRINST_OP_LE_I, &InstSelectorArm32::translate_le_int32},
+            {IRInstOperator::IRINST_OP_GE_I, &InstSelectorArm32::translate_ge_int32},
+            {IRInstOperator::IRINST_OP_EQ_I, &InstSelectorArm32::translate_eq_int32},
+            {IRInstOperator::IRINST_OP_NE_I, &InstSelectorArm32::translate_ne_int32},
+
+            {IRInstOperator::IRINST_OP_FUNC_CALL, &InstSelectorArm32::translate_call},
+            {IRInstOperator::IRINST_OP_ARG, &InstSelectorArm32::translate_arg},
+        });
 
 /// @brief 构造函数
 /// @param _irCode 指令
@@ -38,35 +74,7 @@ InstSelectorArm32::InstSelectorArm32(vector<Instruction *> & _irCode,
                                      Function * _func,
                                      SimpleRegisterAllocator & allocator)
     : ir(_irCode), iloc(_iloc), func(_func), simpleRegisterAllocator(allocator)
-{
-    translator_handlers[IRInstOperator::IRINST_OP_ENTRY] = &InstSelectorArm32::translate_entry;
-    translator_handlers[IRInstOperator::IRINST_OP_EXIT] = &InstSelectorArm32::translate_exit;
-
-    translator_handlers[IRInstOperator::IRINST_OP_LABEL] = &InstSelectorArm32::translate_label;
-    translator_handlers[IRInstOperator::IRINST_OP_GOTO] = &InstSelectorArm32::translate_goto;
-
-    translator_handlers[IRInstOperator::IRINST_OP_ASSIGN] = &InstSelectorArm32::translate_assign;
-
-    translator_handlers[IRInstOperator::IRINST_OP_ADD_I] = &InstSelectorArm32::translate_add_int32;
-    translator_handlers[IRInstOperator::IRINST_OP_SUB_I] = &InstSelectorArm32::translate_sub_int32;
-	
-	///在构造函数中添加新的处理函数映射-lxg
-	translator_handlers[IRInstOperator::IRINST_OP_MUL_I] = &InstSelectorArm32::translate_mul_int32;
-	translator_handlers[IRInstOperator::IRINST_OP_DIV_I] = &InstSelectorArm32::translate_div_int32;
-	translator_handlers[IRInstOperator::IRINST_OP_MOD_I] = &InstSelectorArm32::translate_mod_int32;
-	translator_handlers[IRInstOperator::IRINST_OP_NEG_I] = &InstSelectorArm32::translate_neg_int32;
-
-	// 添加关系运算符的处理函数映射-lxg
-	translator_handlers[IRInstOperator::IRINST_OP_LT_I] = &InstSelectorArm32::translate_lt_int32;
-	translator_handlers[IRInstOperator::IRINST_OP_GT_I] = &InstSelectorArm32::translate_gt_int32;
-	translator_handlers[IRInstOperator::IRINST_OP_LE_I] = &InstSelectorArm32::translate_le_int32;
-	translator_handlers[IRInstOperator::IRINST_OP_GE_I] = &InstSelectorArm32::translate_ge_int32;
-	translator_handlers[IRInstOperator::IRINST_OP_EQ_I] = &InstSelectorArm32::translate_eq_int32;
-	translator_handlers[IRInstOperator::IRINST_OP_NE_I] = &InstSelectorArm32::translate_ne_int32;
-
-    translator_handlers[IRInstOperator::IRINST_OP_FUNC_CALL] = &InstSelectorArm32::translate_call;
-    translator_handlers[IRInstOperator::IRINST_OP_ARG] = &InstSelectorArm32::translate_arg;
-}
+{}
 
 ///
 /// @brief 析构函数
@@ -77,7 +85,9 @@ InstSelectorArm32::~InstSelectorArm32()
 /// @brief 指令选择执行
 void InstSelectorArm32::run()
 {
-    for (auto inst: ir) {
+    for (currentPos = 0; currentPos < ir.size(); ++currentPos) {
+
+        Instruction * inst = ir[currentPos];
 
         // 逐个指令进行翻译
         if (!inst->isDead()) {
@@ -86,6 +96,144 @@ void InstSelectorArm32::run()
     }
 }
 
+/// @brief 获取指定位置之后第一条没有删除的IR指令
+/// @param pos IR指令的位置
+/// @return Instruction* 没有时返回nullptr
+Instruction * InstSelectorArm32::nextLiveInst(size_t pos)
+{
+    for (size_t k = pos + 1; k < ir.size(); ++k) {
+        if (!ir[k]->isDead()) {
+            return ir[k];
+        }
+    }
+
+    return nullptr;
+}
+
+/// @brief 比较指令的结果是否只被紧随其后的条件跳转使用，这时比较与跳转可融合
+/// @param inst 比较指令
+/// @return true 可融合 false 不可融合
+bool InstSelectorArm32::isFusedCompare(Instruction * inst)
+{
+    Instanceof(gotoInst, GotoInstruction *, nextLiveInst(currentPos));
+
+    return gotoInst && gotoInst->isConditionalBranch() && gotoInst->getOperand(0) == inst &&
+           inst->getUses().size() == 1;
+}
+
+/// @brief 获取条件码的相反条件码
+/// @param condition 条件码
+/// @return string 相反的条件码
+string InstSelectorArm32::invertCondition(const string & condition)
+{
+    static const map<string, string> inverted = {
+        {"eq", "ne"},
+        {"ne", "eq"},
+        {"lt", "ge"},
+        {"ge", "lt"},
+        {"gt", "le"},
+        {"le", "gt"},
+    };
+
+    return inverted.at(condition);
+}
+
+/// @brief 比较的第二个操作数是否是可编码的立即数，是时不需要加载到寄存器
+/// @param operand 操作数
+/// @return true 是 false 不是
+bool InstSelectorArm32::isImmCompareOperand(Value * operand)
+{
+    Instanceof(constVal, ConstInt *, operand);
+
+    return constVal && PlatformArm32::constExpr(constVal->getVal());
+}
+
+/// @brief 除法与求余是否可翻译为移位与按位与，要求被除数非负、除数为2的幂
+/// @param inst 除法或求余指令
+/// @return int32_t 除数以2为底的对数，不满足条件时为-1
+int32_t InstSelectorArm32::pow2DivisorShift(Instruction * inst)
+{
+    Instanceof(binaryInst, BinaryInstruction *, inst);
+    Instanceof(divisor, ConstInt *, inst->getOperand(1));
+
+    if (binaryInst == nullptr || !binaryInst->nonNegativeDividend || divisor == nullptr) {
+        return -1;
+    }
+
+    int32_t val = divisor->getVal();
+    if (val < 2 || (val & (val - 1)) != 0) {
+        return -1;
+    }
+
+    int32_t shift = 0;
+    while ((1 << shift) != val) {
+        shift++;
+    }
+
+    return shift;
+}
+
+/// @brief 指令翻译时需要的临时寄存器个数，临时寄存器从r0开始依次分配。
+/// 寄存器分配器据此确定指令破坏的寄存器，规则须与各翻译函数一致
+/// @param inst IR指令，函数调用不在此列
+/// @param inReg 值是否分配了寄存器
+/// @return int32_t 个数
+int32_t InstSelectorArm32::scratchRegsNeeded(Instruction * inst, const std::function<bool(Value *)> & inReg)
+{
+    switch (inst->getOp()) {
+        case IRInstOperator::IRINST_OP_ASSIGN:
+            // 内存到内存的赋值借助临时寄存器
+            return !inReg(inst->getOperand(0)) && !inReg(inst->getOperand(1)) ? 1 : 0;
+
+        case IRInstOperator::IRINST_OP_GOTO:
+            return inst->getOperandsNum() > 0 && !inReg(inst->getOperand(0)) ? 1 : 0;
+
+        case IRInstOperator::IRINST_OP_ADD_I:
+        case IRInstOperator::IRINST_OP_SUB_I:
+        case IRInstOperator::IRINST_OP_MUL_I:
+        case IRInstOperator::IRINST_OP_DIV_I:
+        case IRInstOperator::IRINST_OP_MOD_I:
+        case IRInstOperator::IRINST_OP_NEG_I:
+        case IRInstOperator::IRINST_OP_LT_I:
+        case IRInstOperator::IRINST_OP_GT_I:
+        case IRInstOperator::IRINST_OP_LE_I:
+        case IRInstOperator::IRINST_OP_GE_I:
+        case IRInstOperator::IRINST_OP_EQ_I:
+        case IRInstOperator::IRINST_OP_NE_I: {
+
+            IRInstOperator op = inst->getOp();
+            bool isDivMod = op == IRInstOperator::IRINST_OP_DIV_I || op == IRInstOperator::IRINST_OP_MOD_I;
+
+            int32_t num = inReg(inst) ? 0 : 1;
+
+            for (int32_t k = 0; k < inst->getOperandsNum(); ++k) {
+
+                // 同一个值只加载一次
+                Value * operand = inst->getOperand(k);
+                if (inReg(operand) || (k == 1 && operand == inst->getOperand(0))) {
+                    continue;
+                }
+
+                // 比较的第二个操作数可以是立即数，除数为2的幂时用移位与按位与翻译
+                if (k == 1 && op >= IRInstOperator::IRINST_OP_LT_I && isImmCompareOperand(operand)) {
+                    continue;
+                }
+
+                if (k == 1 && isDivMod && pow2DivisorShift(inst) >= 0) {
+                    continue;
+                }
+
+                num++;
+            }
+
+            return num;
+        }
+
+        default:
+            return 0;
+    }
+}
+
 /// @brief 指令翻译成ARM32汇编
 /// @param inst IR指令
 void InstSelectorArm32::translate(Instruction * inst)
@@ -93,20 +241,14 @@ void InstSelectorArm32::translate(Instruction * inst)
     // 操作符
     IRInstOperator op = inst->getOp();
 
-    map<IRInstOperator, translate_handler>::const_iterator pIter;
-    pIter = translator_handlers.find(op);
-    if (pIter == translator_handlers.end()) {
-        // 没有找到，则说明当前不支持
-        printf("Translate: Operator(%d) not support", (int) op);
-        return;
-    }
+    translate_handler handler = translator_handlers[(std::size_t) op];
 
     // 开启时输出IR指令作为注释
-    if (showLinearIR) {
+    if (showLinearIR && handler != &InstSelectorArm32::translate_unsupported) {
         outputIRInstruction(inst);
     }
 
-    (this->*(pIter->second))(inst);
+    (this->*handler)(inst);
 }
 
 ///
@@ -121,6 +263,13 @@ void InstSelectorArm32::outputIRInstruction(Instruction * inst)
     }
 }
 
+/// @brief 不支持的IR指令，只输出提示
+/// @param inst IR指令
+void InstSelectorArm32::translate_unsupported(Instruction * inst)
+{
+    printf("Translate: Operator(%d) not support", (int) inst->getOp());
+}
+
 /// @brief NOP翻译成ARM32汇编
 /// @param inst IR指令
 void InstSelectorArm32::translate_nop(Instruction * inst)
@@ -142,35 +291,55 @@ void InstSelectorArm32::translate_label(Instruction * inst)
 /// @param inst IR指令
 void InstSelectorArm32::translate_goto(Instruction * inst)
 {
-    // Instanceof(gotoInst, GotoInstruction *, inst);
-
-    // // 无条件跳转
-    // iloc.jump(gotoInst->getTarget()->getName());
 	// 新增有条件跳转-lxg
 	Instanceof(gotoInst, GotoInstruction *, inst);
+
+    // 跳转目标是紧随其后的Label时可直接顺序执行，不需要跳转
+    Instanceof(nextLabel, LabelInstruction *, nextLiveInst(currentPos));
+
     // 检查是否是条件跳转
     if (gotoInst->getOperandsNum() > 0) {
         // 这是条件跳转
-        Value* condition = gotoInst->getOperand(0);
         std::string trueLabel = gotoInst->getTarget()->getName();
         std::string falseLabel = gotoInst->getFalseTarget()->getName();
-        
-        // 加载条件到寄存器中
-        int condRegNo = simpleRegisterAllocator.Allocate(condition);
-        iloc.load_var(condRegNo, condition);
-        
-        // 比较与0
-        iloc.inst("cmp", PlatformArm32::regName[condRegNo], "#0");
-        
-        // 如果不等于0，跳转到trueLabel
-        iloc.inst("bne", trueLabel);
-        
-        // 否则跳转到falseLabel
-        iloc.inst("b", falseLabel);
-        
-        // 释放条件寄存器
-        simpleRegisterAllocator.free(condition);
-    } else {
+        std::string condition;
+
+        if (fusedBranch == inst) {
+
+            // 前面的比较指令已设置标志位
+            condition = fusedCondition;
+            fusedBranch = nullptr;
+        } else {
+
+            Value * cond = gotoInst->getOperand(0);
+
+            // 条件不在寄存器中时加载到寄存器中
+            int condRegNo = cond->getRegId();
+            if (condRegNo == -1) {
+                condRegNo = simpleRegisterAllocator.Allocate(cond);
+                iloc.load_var(condRegNo, cond);
+            }
+
+            // 比较与0
+            iloc.inst("cmp", PlatformArm32::regName[condRegNo], "#0");
+
+            // 释放条件寄存器
+            simpleRegisterAllocator.free(cond);
+
+            condition = "ne";
+        }
+
+        if (nextLabel == gotoInst->getFalseTarget()) {
+            // 条件不满足时顺序执行到假分支
+            iloc.inst("b" + condition, trueLabel);
+        } else if (nextLabel == gotoInst->getTarget()) {
+            // 条件满足时顺序执行到真分支
+            iloc.inst("b" + invertCondition(condition), falseLabel);
+        } else {
+            iloc.inst("b" + condition, trueLabel);
+            iloc.inst("b", falseLabel);
+        }
+    } else if (nextLabel != gotoInst->getTarget()) {
         // 无条件跳转
         iloc.jump(gotoInst->getTarget()->getName());
     }
@@ -214,16 +383,35 @@ void InstSelectorArm32::translate_exit(Instruction * inst)
         iloc.load_var(0, retVal);
     }
 
-    // 恢复栈空间
-    iloc.inst("mov", "sp", "fp");
+    // 入栈的LR直接出栈到PC返回，没有保护LR时通过LR返回
+    auto & protectedRegNo = func->getProtectedReg();
+    bool savedLR = !protectedRegNo.empty() && protectedRegNo.back() == ARM32_LX_REG_NO;
+
+    restoreFrame(savedLR);
+
+    if (!savedLR) {
+        iloc.inst("bx", "lr");
+    }
+}
+
+/// @brief 拆除栈帧，恢复SP与被保护的寄存器
+/// @param popToPC 入栈的LR是否出栈到PC直接返回
+void InstSelectorArm32::restoreFrame(bool popToPC)
+{
+    // 恢复栈空间，栈帧为空时没有建立帧指针
+    if (func->getMaxDep() > 0) {
+        iloc.inst("mov", "sp", "fp");
+    }
 
     // 保护寄存器的恢复
-    auto & protectedRegStr = func->getProtectedRegStr();
+    std::string protectedRegStr = func->getProtectedRegStr();
+    if (popToPC) {
+        protectedRegStr.replace(protectedRegStr.rfind("lr"), 2, "pc");
+    }
+
     if (!protectedRegStr.empty()) {
         iloc.inst("pop", "{" + protectedRegStr + "}");
     }
-
-    iloc.inst("bx", "lr");
 }
 
 /// @brief 赋值指令翻译成ARM32汇编
@@ -331,6 +519,64 @@ void InstSelectorArm32::translate_two_operator(Instruction * inst, string operat
     simpleRegisterAllocator.free(result);
 }
 
+/// @brief 被除数非负、除数为2的幂的除法与求余翻译为移位与按位与，值范围分析已经证明被除数非负
+/// @param inst 除法或求余指令
+/// @param isMod 是否是求余
+/// @return true 已翻译 false 条件不满足，需按照sdiv翻译
+bool InstSelectorArm32::translate_pow2_div_mod(Instruction * inst, bool isMod)
+{
+    int32_t shift = pow2DivisorShift(inst);
+    if (shift < 0) {
+        return false;
+    }
+
+    int32_t val = 1 << shift;
+
+    Value * result = inst;
+    Value * arg1 = inst->getOperand(0);
+
+    int32_t arg1_reg_no = arg1->getRegId();
+    int32_t result_reg_no = inst->getRegId();
+    int32_t load_result_reg_no, load_arg1_reg_no;
+
+    if (arg1_reg_no == -1) {
+        load_arg1_reg_no = simpleRegisterAllocator.Allocate(arg1);
+        iloc.load_var(load_arg1_reg_no, arg1);
+    } else {
+        load_arg1_reg_no = arg1_reg_no;
+    }
+
+    if (result_reg_no == -1) {
+        load_result_reg_no = simpleRegisterAllocator.Allocate(result);
+    } else {
+        load_result_reg_no = result_reg_no;
+    }
+
+    std::string rd = PlatformArm32::regName[load_result_reg_no];
+    std::string rs = PlatformArm32::regName[load_arg1_reg_no];
+
+    if (!isMod) {
+        // 非负数的商即右移
+        iloc.inst("asr", rd, rs, "#" + std::to_string(shift));
+    } else if (PlatformArm32::constExpr(val - 1)) {
+        // 非负数的余数即低位
+        iloc.inst("and", rd, rs, "#" + std::to_string(val - 1));
+    } else {
+        // 掩码不能编码为立即数时，左移再逻辑右移清除高位
+        iloc.inst("lsl", rd, rs, "#" + std::to_string(32 - shift));
+        iloc.inst("lsr", rd, rd, "#" + std::to_string(32 - shift));
+    }
+
+    if (result_reg_no == -1) {
+        iloc.store_var(load_result_reg_no, result, ARM32_TMP_REG_NO);
+    }
+
+    simpleRegisterAllocator.free(arg1);
+    simpleRegisterAllocator.free(result);
+
+    return true;
+}
+
 /// @brief 整数加法指令翻译成ARM32汇编
 /// @param inst IR指令
 void InstSelectorArm32::translate_add_int32(Instruction * inst)
@@ -349,7 +595,7 @@ void InstSelectorArm32::translate_sub_int32(Instruction * inst)
 /// @param inst IR指令
 void InstSelectorArm32::translate_call(Instruction * inst)
 {
-    FuncCallInstruction * callInst = dynamic_cast<FuncCallInstruction *>(inst);
+    FuncCallInstruction * callInst = dyn_cast<FuncCallInstruction>(inst);
 
     int32_t operandNum = callInst->getOperandsNum();
 
@@ -376,12 +622,21 @@ void InstSelectorArm32::translate_call(Instruction * inst)
 
             auto arg = callInst->getOperand(k);
 
+            // 实参已经通过赋值指令保存到栈中的对应位置时不需要再复制，
+            // 否则r0-r3被占用时临时寄存器会用到被调用者保存的寄存器
+            int32_t argBaseRegId;
+            int64_t argOffset;
+            if (arg->getMemoryAddr(&argBaseRegId, &argOffset) && argBaseRegId == ARM32_SP_REG_NO && argOffset == esp) {
+                esp += 4;
+                continue;
+            }
+
             // 新建一个内存变量，用于栈传值到形参变量中
             MemVariable * newVal = func->newMemVariable((Type *) PointerType::get(arg->getType()));
             newVal->setMemoryAddr(ARM32_SP_REG_NO, esp);
             esp += 4;
 
-            Instruction * assignInst = new MoveInstruction(func, newVal, arg);
+            Instruction * assignInst = new (func) MoveInstruction(func, newVal, arg);
 
             // 翻译赋值指令
             translate_assign(assignInst);
@@ -397,7 +652,7 @@ void InstSelectorArm32::translate_call(Instruction * inst)
             // 如果是临时变量，该变量可更改为寄存器变量即可，或者设置寄存器号
             // 如果不是，则必须开辟一个寄存器变量，然后赋值即可
 
-            Instruction * assignInst = new MoveInstruction(func, PlatformArm32::intRegVal[k], arg);
+            Instruction * assignInst = new (func) MoveInstruction(func, PlatformArm32::intRegVal[k], arg);
 
             // 翻译赋值指令
             translate_assign(assignInst);
@@ -406,6 +661,23 @@ void InstSelectorArm32::translate_call(Instruction * inst)
         }
     }
 
+    if (callInst->tailCall) {
+
+        // 尾调用：实参已在寄存器中，拆除栈帧后跳转，被调用函数直接返回到当前函数的调用者
+        restoreFrame();
+        iloc.inst("b", callInst->getName());
+
+        if (operandNum) {
+            simpleRegisterAllocator.free(0);
+            simpleRegisterAllocator.free(1);
+            simpleRegisterAllocator.free(2);
+            simpleRegisterAllocator.free(3);
+        }
+
+        realArgCount = 0;
+        return;
+    }
+
     iloc.call_fun(callInst->getName());
 
     if (operandNum) {
@@ -415,17 +687,7 @@ void InstSelectorArm32::translate_call(Instruction * inst)
         simpleRegisterAllocator.free(3);
     }
 
-    // 赋值指令
-    if (callInst->hasResultValue()) {
-
-        // 新建一个赋值操作
-        Instruction * assignInst = new MoveInstruction(func, callInst, PlatformArm32::intRegVal[0]);
-
-        // 翻译赋值指令
-        translate_assign(assignInst);
-
-        delete assignInst;
-    }
+    // 结果从r0的赋值已由adjustFuncCallInsts插入到调用之后，这里不再重复
 
     // 函数调用后清零，使得下次可正常统计
     realArgCount = 0;
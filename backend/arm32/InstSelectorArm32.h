@@ -15,9 +15,11 @@
 ///
 #pragma once
 
-#include <map>
+#include <array>
+#include <functional>
 #include <vector>
 
+#include "ConstInt.h"
 #include "Function.h"
 #include "ILocArm32.h"
 #include "Instruction.h"
@@ -48,6 +50,10 @@ protected:
     /// @param inst IR指令
     void translate_nop(Instruction * inst);
 
+    /// @brief 不支持的IR指令，只输出提示
+    /// @param inst IR指令
+    void translate_unsupported(Instruction * inst);
+
     /// @brief 函数入口指令翻译成ARM32汇编
     /// @param inst IR指令
     void translate_entry(Instruction * inst);
@@ -56,6 +62,10 @@ protected:
     /// @param inst IR指令
     void translate_exit(Instruction * inst);
 
+    /// @brief 拆除栈帧，恢复SP与被保护的寄存器，用于函数出口与尾调用
+    /// @param popToPC 入栈的LR是否出栈到PC直接返回
+    void restoreFrame(bool popToPC = false);
+
     /// @brief 赋值指令翻译成ARM32汇编
     /// @param inst IR指令
     void translate_assign(Instruction * inst);
@@ -88,6 +98,10 @@ protected:
 	/// @param inst IR指令
 	void translate_div_int32(Instruction * inst)
 	{
+		if (translate_pow2_div_mod(inst, false)) {
+			return;
+		}
+
 		translate_two_operator(inst, "sdiv");
 	}
 
@@ -95,6 +109,10 @@ protected:
 	/// @param inst IR指令
 	void translate_mod_int32(Instruction * inst)
 	{
+		if (translate_pow2_div_mod(inst, true)) {
+			return;
+		}
+
 		Value * result = inst;
 		Value * arg1 = inst->getOperand(0);
 		Value * arg2 = inst->getOperand(1);
@@ -124,8 +142,11 @@ protected:
 			load_arg2_reg_no = arg2_reg_no;
 		}
 
+		// 结果寄存器与操作数相同时，求商会覆盖还要使用的操作数，也在临时寄存器中计算
+		bool overlap = result_reg_no == load_arg1_reg_no || result_reg_no == load_arg2_reg_no;
+
 		// 看结果变量是否是寄存器，若不是则需要分配一个新的寄存器来保存运算的结果
-		if (result_reg_no == -1) {
+		if (result_reg_no == -1 || overlap) {
 			// 分配一个寄存器r10，用于暂存结果
 			load_result_reg_no = simpleRegisterAllocator.Allocate(result);
 		} else {
@@ -154,6 +175,8 @@ protected:
 		if (result_reg_no == -1) {
 			// r10 -> result
 			iloc.store_var(load_result_reg_no, result, ARM32_TMP_REG_NO);
+		} else if (overlap) {
+			iloc.mov_reg(result_reg_no, load_result_reg_no);
 		}
 
 		// 释放寄存器
@@ -210,6 +233,7 @@ protected:
 
 	//添加关系运算符的处理函数实现-lxg
 	/// @brief 整数关系运算指令翻译成ARM32汇编(统一处理函数)
+	/// 比较结果只被紧随其后的条件跳转使用时，只设置标志位，由条件跳转直接使用条件码
 	/// @param inst IR指令
 	/// @param condition ARM的条件码(eq,ne,lt,gt,le,ge)
 	void translate_cmp_int32(Instruction * inst, const string& condition)
@@ -231,34 +255,44 @@ protected:
 			load_arg1_reg_no = arg1_reg_no;
 		}
 
-		// 加载第二个操作数
-		if (arg2_reg_no == -1) {
+		// 第二个操作数是可编码的立即数时直接使用立即数
+		std::string arg2_str;
+		if (isImmCompareOperand(arg2)) {
+			arg2_str = "#" + std::to_string(((ConstInt *) arg2)->getVal());
+		} else if (arg2_reg_no == -1) {
 			load_arg2_reg_no = simpleRegisterAllocator.Allocate(arg2);
 			iloc.load_var(load_arg2_reg_no, arg2);
+			arg2_str = PlatformArm32::regName[load_arg2_reg_no];
 		} else {
-			load_arg2_reg_no = arg2_reg_no;
-		}
-
-		// 为结果分配寄存器
-		if (result_reg_no == -1) {
-			load_result_reg_no = simpleRegisterAllocator.Allocate(result);
-		} else {
-			load_result_reg_no = result_reg_no;
+			arg2_str = PlatformArm32::regName[arg2_reg_no];
 		}
 
 		// 比较两个操作数（cmp只接受两个参数）
-		iloc.inst("cmp", 
-				PlatformArm32::regName[load_arg1_reg_no],
-				PlatformArm32::regName[load_arg2_reg_no]);
-		
-		// 根据条件设置结果为0或1
-		// 使用mov{条件}指令，条件满足时设为1，否则设为0
-		iloc.inst("mov", PlatformArm32::regName[load_result_reg_no], "#0");  // 默认为0
-		iloc.inst("mov" + condition, PlatformArm32::regName[load_result_reg_no], "#1");  // 条件满足时为1
+		iloc.inst("cmp", PlatformArm32::regName[load_arg1_reg_no], arg2_str);
 
-		// 保存结果
-		if (result_reg_no == -1) {
-			iloc.store_var(load_result_reg_no, result, ARM32_TMP_REG_NO);
+		if (isFusedCompare(inst)) {
+
+			// 标志位留给紧随其后的条件跳转使用，不需要产生0/1的值
+			fusedBranch = nextLiveInst(currentPos);
+			fusedCondition = condition;
+		} else {
+
+			// 为结果分配寄存器
+			if (result_reg_no == -1) {
+				load_result_reg_no = simpleRegisterAllocator.Allocate(result);
+			} else {
+				load_result_reg_no = result_reg_no;
+			}
+
+			// 根据条件设置结果为0或1
+			// 使用mov{条件}指令，条件满足时设为1，否则设为0
+			iloc.inst("mov", PlatformArm32::regName[load_result_reg_no], "#0");  // 默认为0
+			iloc.inst("mov" + condition, PlatformArm32::regName[load_result_reg_no], "#1");  // 条件满足时为1
+
+			// 保存结果
+			if (result_reg_no == -1) {
+				iloc.store_var(load_result_reg_no, result, ARM32_TMP_REG_NO);
+			}
 		}
 
 		// 释放寄存器
@@ -315,6 +349,12 @@ protected:
     /// @param operator_name 操作码
     void translate_two_operator(Instruction * inst, string operator_name);
 
+    /// @brief 被除数非负、除数为2的幂的除法与求余翻译为移位与按位与
+    /// @param inst 除法或求余指令
+    /// @param isMod 是否是求余
+    /// @return true 已翻译 false 条件不满足，需按照sdiv翻译
+    bool translate_pow2_div_mod(Instruction * inst, bool isMod);
+
     /// @brief 函数调用指令翻译成ARM32汇编
     /// @param inst IR指令
     void translate_call(Instruction * inst);
@@ -330,11 +370,49 @@ protected:
     ///
     void outputIRInstruction(Instruction * inst);
 
+    ///
+    /// @brief 获取指定位置之后第一条没有删除的IR指令
+    /// @param pos IR指令的位置
+    /// @return Instruction* 没有时返回nullptr
+    ///
+    Instruction * nextLiveInst(size_t pos);
+
+    ///
+    /// @brief 比较指令的结果是否只被紧随其后的条件跳转使用，这时比较与跳转可融合
+    /// @param inst 比较指令
+    /// @return true 可融合 false 不可融合
+    ///
+    bool isFusedCompare(Instruction * inst);
+
+    ///
+    /// @brief 获取条件码的相反条件码
+    /// @param condition 条件码
+    /// @return string 相反的条件码
+    ///
+    static string invertCondition(const string & condition);
+
+    ///
+    /// @brief 比较的第二个操作数是否是可编码的立即数，是时不需要加载到寄存器
+    /// @param operand 操作数
+    /// @return true 是 false 不是
+    ///
+    static bool isImmCompareOperand(Value * operand);
+
+    ///
+    /// @brief 除法与求余是否可翻译为移位与按位与，要求被除数非负、除数为2的幂
+    /// @param inst 除法或求余指令
+    /// @return int32_t 除数以2为底的对数，不满足条件时为-1
+    ///
+    static int32_t pow2DivisorShift(Instruction * inst);
+
     /// @brief IR翻译动作函数原型
     typedef void (InstSelectorArm32::*translate_handler)(Instruction *);
 
-    /// @brief IR动作处理函数清单
-    map<IRInstOperator, translate_handler> translator_handlers;
+    /// @brief IR指令操作码的个数，即动作处理函数表的大小
+    static constexpr std::size_t IRINST_OP_COUNT = (std::size_t) IRInstOperator::IRINST_OP_MAX;
+
+    /// @brief IR动作处理函数表，以指令操作码为下标，编译期构造
+    static const std::array<translate_handler, IRINST_OP_COUNT> translator_handlers;
 
     ///
     /// @brief 简单的朴素寄存器分配方法
@@ -349,6 +427,15 @@ protected:
     /// @brief 累计的实参个数
     int32_t realArgCount = 0;
 
+    /// @brief 当前翻译的IR指令的位置
+    size_t currentPos = 0;
+
+    /// @brief 与前面的比较指令融合的条件跳转指令
+    Instruction * fusedBranch = nullptr;
+
+    /// @brief 融合的比较指令的条件码
+    string fusedCondition;
+
     ///
     /// @brief 显示IR指令内容
     ///
@@ -380,4 +467,13 @@ public:
 
     /// @brief 指令选择
     void run();
+
+    ///
+    /// @brief 指令翻译时需要的临时寄存器个数，临时寄存器从r0开始依次分配。
+    /// 寄存器分配器据此确定指令破坏的寄存器，规则须与各翻译函数一致
+    /// @param inst IR指令，函数调用不在此列
+    /// @param inReg 值是否分配了寄存器
+    /// @return int32_t 个数
+    ///
+    static int32_t scratchRegsNeeded(Instruction * inst, const std::function<bool(Value *)> & inReg);
 };
@@ -0,0 +1,609 @@
+///
+/// @file LinearScanRegisterAllocator.cpp
+/// @brief 基于活跃区间的线性扫描寄存器分配器
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+#include <climits>
+
+#include "LinearScanRegisterAllocator.h"
+#include "GotoInstruction.h"
+#include "LabelInstruction.h"
+#include "MoveInstruction.h"
+#include "Profile.h"
+
+/// @brief 构造函数
+/// @param _func 要分配的函数
+LinearScanRegisterAllocator::LinearScanRegisterAllocator(Function * _func) : func(_func)
+{}
+
+/// @brief 值是否参与寄存器分配
+/// @param val 值
+/// @return true 参与 false 不参与
+bool LinearScanRegisterAllocator::isAllocatable(Value * val)
+{
+    // 形参的位置由调用约定确定，不参与分配
+    if (!isa<LocalVariable>(val)) {
+        Instanceof(inst, Instruction *, val);
+        if (!inst || !inst->hasResultValue()) {
+            return false;
+        }
+    }
+
+    // 数组等超过一个字的变量只能在栈中
+    return val->getRegId() == -1 && !val->getMemoryAddr() && val->getType()->getSize() <= 4;
+}
+
+/// @brief 执行寄存器分配，变量的寄存器通过setRegId设置，分裂与连接的赋值指令写回到函数中
+void LinearScanRegisterAllocator::run()
+{
+    // 先删除死指令，指令编号只包含有效的指令
+    {
+        ControlFlowGraph deadCfg(func);
+        deadCfg.writeBack();
+    }
+
+    ControlFlowGraph graph(func);
+    Liveness live(graph);
+
+    cfg = &graph;
+    liveness = &live;
+
+    computeFrequency();
+
+    for (auto & interval: live.getIntervals()) {
+
+        Value * val = interval.getValue();
+        if (interval.empty() || !isAllocatable(val)) {
+            continue;
+        }
+
+        AllocInterval * allocInterval = newInterval(interval);
+        allocInterval->location = val;
+        valueIntervals.emplace(val, allocInterval);
+        unhandled.push(allocInterval);
+    }
+
+    linearScan();
+
+    resolve();
+
+    std::sort(usedRegs.begin(), usedRegs.end());
+
+    cfg = nullptr;
+    liveness = nullptr;
+}
+
+/// @brief 按指令编号记录所在基本块的执行频度
+void LinearScanRegisterAllocator::computeFrequency()
+{
+    std::vector<double> frequency = getBlockFrequencies(func, *cfg);
+
+    for (auto bb: cfg->getBlocks()) {
+
+        double freq = frequency[bb->getIndex()];
+
+        int32_t end = liveness->getBlockEnd(bb);
+        instFrequency.resize(std::max((int32_t) instFrequency.size(), end / 2));
+
+        for (int32_t pos = liveness->getBlockStart(bb); pos < end; pos += 2) {
+            instFrequency[pos / 2] = freq;
+        }
+    }
+}
+
+/// @brief 计算区间的溢出代价
+/// @param interval 区间
+/// @param from 只累计不小于from的引用
+/// @return double 代价
+double LinearScanRegisterAllocator::spillWeight(const AllocInterval * interval, int32_t from) const
+{
+    double weight = 0;
+
+    for (auto pos: interval->live.getReferences()) {
+        if (pos >= from) {
+            weight += instFrequency[pos / 2];
+        }
+    }
+
+    return weight;
+}
+
+/// @brief 新建分配区间
+/// @param live 活跃区间
+/// @return AllocInterval* 分配区间
+LinearScanRegisterAllocator::AllocInterval * LinearScanRegisterAllocator::newInterval(const LiveInterval & live)
+{
+    AllocInterval & interval = intervals.emplace_back(live);
+
+    interval.id = (int32_t) intervals.size() - 1;
+    interval.weight = spillWeight(&interval);
+
+    return &interval;
+}
+
+/// @brief 在位置pos处分裂区间，返回后一部分
+/// @param interval 区间
+/// @param pos 分裂位置，为指令的使用位置，即指令之前
+/// @return AllocInterval* 后一部分
+LinearScanRegisterAllocator::AllocInterval * LinearScanRegisterAllocator::split(AllocInterval * interval, int32_t pos)
+{
+    AllocInterval * tail = newInterval(interval->live.splitAt(pos));
+
+    tail->splitPos = pos;
+    tail->next = interval->next;
+    interval->next = tail;
+    interval->weight = spillWeight(interval);
+
+    return tail;
+}
+
+/// @brief 扫描全部区间分配寄存器
+void LinearScanRegisterAllocator::linearScan()
+{
+    while (!unhandled.empty()) {
+
+        AllocInterval * cur = unhandled.top();
+        unhandled.pop();
+
+        int32_t pos = cur->live.start();
+
+        // 已结束的区间释放寄存器，处于洞中的区间暂时让出寄存器
+        for (size_t k = 0; k < active.size();) {
+            AllocInterval * interval = active[k];
+            if (interval->live.end() <= pos) {
+                active.erase(active.begin() + (int32_t) k);
+            } else if (!interval->live.covers(pos)) {
+                inactive.push_back(interval);
+                active.erase(active.begin() + (int32_t) k);
+            } else {
+                ++k;
+            }
+        }
+
+        for (size_t k = 0; k < inactive.size();) {
+            AllocInterval * interval = inactive[k];
+            if (interval->live.end() <= pos) {
+                inactive.erase(inactive.begin() + (int32_t) k);
+            } else if (interval->live.covers(pos)) {
+                active.push_back(interval);
+                inactive.erase(inactive.begin() + (int32_t) k);
+            } else {
+                ++k;
+            }
+        }
+
+        if (!tryAllocateFreeReg(cur)) {
+            allocateBlockedReg(cur);
+        }
+
+        if (cur->reg != -1) {
+            active.push_back(cur);
+            if (std::find(usedRegs.begin(), usedRegs.end(), cur->reg) == usedRegs.end()) {
+                usedRegs.push_back(cur->reg);
+            }
+        }
+    }
+}
+
+/// @brief 寻找整个区间或区间前一部分空闲的寄存器
+/// @param cur 当前区间
+/// @return true 分配成功 false 没有空闲的寄存器
+bool LinearScanRegisterAllocator::tryAllocateFreeReg(AllocInterval * cur)
+{
+    // 各寄存器空闲到的位置
+    int32_t freeUntil[LAST_REG_NO + 1];
+    std::fill(freeUntil, freeUntil + LAST_REG_NO + 1, INT32_MAX);
+
+    for (auto interval: active) {
+        freeUntil[interval->reg] = 0;
+    }
+
+    for (auto interval: inactive) {
+        int32_t pos = interval->live.firstIntersection(cur->live);
+        if (pos >= 0) {
+            freeUntil[interval->reg] = std::min(freeUntil[interval->reg], pos);
+        }
+    }
+
+    int32_t start = cur->live.start();
+    int32_t end = cur->live.end();
+
+    // 优先使用赋值相连的区间的寄存器，可以消除赋值指令
+    int32_t reg = getHint(cur);
+    if (reg == -1 || freeUntil[reg] < end) {
+
+        // 整个区间空闲的寄存器中优先用已经使用过的，减少入口保护的寄存器；否则选空闲最久的寄存器
+        reg = -1;
+        for (int32_t regno = FIRST_REG_NO; regno <= LAST_REG_NO; ++regno) {
+            if (reg == -1 || freeUntil[regno] > freeUntil[reg]) {
+                reg = regno;
+            } else if (freeUntil[regno] >= end && freeUntil[reg] >= end) {
+                bool used = std::find(usedRegs.begin(), usedRegs.end(), regno) != usedRegs.end();
+                bool regUsed = std::find(usedRegs.begin(), usedRegs.end(), reg) != usedRegs.end();
+                if (used && !regUsed) {
+                    reg = regno;
+                }
+            }
+        }
+    }
+
+    if (freeUntil[reg] <= start) {
+        return false;
+    }
+
+    if (freeUntil[reg] >= end) {
+        cur->reg = reg;
+        return true;
+    }
+
+    // 寄存器只在区间的前一部分空闲，在被占用的指令之前分裂
+    int32_t splitPos = freeUntil[reg] & ~1;
+    const std::vector<int32_t> & refs = cur->live.getReferences();
+    if (splitPos <= start || refs.empty() || refs.front() >= splitPos) {
+        // 前一部分没有引用时分配寄存器没有收益
+        return false;
+    }
+
+    unhandled.push(split(cur, splitPos));
+    cur->reg = reg;
+
+    return true;
+}
+
+/// @brief 没有空闲寄存器时，比较当前区间与占用各寄存器的区间的溢出代价，溢出代价小的一方
+/// @param cur 当前区间
+void LinearScanRegisterAllocator::allocateBlockedReg(AllocInterval * cur)
+{
+    int32_t pos = cur->live.start();
+
+    // 占用寄存器的区间从当前位置开始溢出的代价，按长度折算，短而引用密集的区间优先占用寄存器
+    double cost[LAST_REG_NO + 1] = {};
+
+    for (auto interval: active) {
+        cost[interval->reg] += spillWeight(interval, pos) / (interval->live.end() - pos);
+    }
+
+    for (auto interval: inactive) {
+        if (interval->live.overlaps(cur->live)) {
+            cost[interval->reg] += spillWeight(interval, pos) / (interval->live.end() - pos);
+        }
+    }
+
+    int32_t reg = FIRST_REG_NO;
+    for (int32_t regno = FIRST_REG_NO + 1; regno <= LAST_REG_NO; ++regno) {
+        if (cost[regno] < cost[reg]) {
+            reg = regno;
+        }
+    }
+
+    if (cost[reg] >= cur->weight / (cur->live.end() - pos)) {
+        // 当前区间的代价最小，整个溢出到栈中
+        cur->reg = -1;
+        return;
+    }
+
+    // 占用寄存器的区间从当前位置开始溢出，当前区间取得寄存器
+    std::vector<AllocInterval *> conflicts;
+    for (auto interval: active) {
+        if (interval->reg == reg) {
+            conflicts.push_back(interval);
+        }
+    }
+    for (auto interval: inactive) {
+        if (interval->reg == reg && interval->live.overlaps(cur->live)) {
+            conflicts.push_back(interval);
+        }
+    }
+
+    for (auto interval: conflicts) {
+        splitAndSpill(interval, pos);
+    }
+
+    cur->reg = reg;
+}
+
+/// @brief 从位置pos开始溢出区间，pos之前的部分保留寄存器
+/// @param interval 区间
+/// @param pos 位置
+void LinearScanRegisterAllocator::splitAndSpill(AllocInterval * interval, int32_t pos)
+{
+    int32_t splitPos = pos & ~1;
+
+    AllocInterval * spilled = interval;
+
+    if (splitPos > interval->live.start()) {
+        // 后一部分在栈中
+        spilled = split(interval, splitPos);
+    } else {
+        // 整个区间溢出
+        active.erase(std::remove(active.begin(), active.end(), interval), active.end());
+        inactive.erase(std::remove(inactive.begin(), inactive.end(), interval), inactive.end());
+    }
+
+    // 溢出的部分不再参与分配
+    spilled->reg = -1;
+}
+
+/// @brief 获取提示的寄存器：与当前区间通过赋值指令相连的区间已分配的寄存器
+/// @param cur 当前区间
+/// @return int32_t 寄存器编号，没有时为-1
+int32_t LinearScanRegisterAllocator::getHint(AllocInterval * cur)
+{
+    Value * val = cur->live.getValue();
+    int32_t start = cur->live.start();
+
+    // 区间从赋值指令的定值开始，使用源操作数的寄存器
+    if (start % 2 == 1) {
+        Instruction * inst = liveness->getInstAt(start);
+        if (inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN && inst->getOperand(0) == val) {
+            AllocInterval * src = intervalAt(inst->getOperand(1), start - 1);
+            if (src && src->reg != -1) {
+                return src->reg;
+            }
+        }
+    }
+
+    // 区间中的值赋值给其它变量，使用目的操作数的寄存器
+    for (auto pos: cur->live.getReferences()) {
+
+        if (pos % 2 == 1) {
+            continue;
+        }
+
+        Instruction * inst = liveness->getInstAt(pos);
+        if (inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN && inst->getOperand(1) == val &&
+            inst->getOperand(0) != val) {
+            AllocInterval * dst = intervalAt(inst->getOperand(0), pos + 1);
+            if (dst && dst->reg != -1) {
+                return dst->reg;
+            }
+        }
+    }
+
+    return -1;
+}
+
+/// @brief 获取值在位置pos所在的分配区间
+/// @param val 值
+/// @param pos 位置
+/// @return AllocInterval* 分配区间，值在pos不活跃时为空
+LinearScanRegisterAllocator::AllocInterval * LinearScanRegisterAllocator::intervalAt(Value * val, int32_t pos)
+{
+    auto iter = valueIntervals.find(val);
+    if (iter == valueIntervals.end()) {
+        return nullptr;
+    }
+
+    for (AllocInterval * interval = iter->second; interval; interval = interval->next) {
+        if (interval->live.covers(pos)) {
+            return interval;
+        }
+    }
+
+    return nullptr;
+}
+
+/// @brief 把分配结果写回：设置寄存器，分裂的部分改用新的局部变量，插入连接各部分的赋值指令
+void LinearScanRegisterAllocator::resolve()
+{
+    // 按值的序号处理，保证新建局部变量的次序确定
+    for (auto val: liveness->getValues()) {
+
+        auto iter = valueIntervals.find(val);
+        if (iter == valueIntervals.end()) {
+            continue;
+        }
+
+        for (AllocInterval * interval = iter->second; interval; interval = interval->next) {
+            if (interval != iter->second) {
+                interval->location = func->newLocalVarValue(val->getType());
+            }
+            if (interval->reg != -1) {
+                interval->location->setRegId(interval->reg);
+            }
+        }
+    }
+
+    rewriteOperands();
+    insertSplitMoves();
+    insertEdgeMoves();
+
+    cfg->writeBack();
+}
+
+/// @brief 替换指令中对值的引用为分裂后对应部分的局部变量
+void LinearScanRegisterAllocator::rewriteOperands()
+{
+    for (auto val: liveness->getValues()) {
+
+        auto iter = valueIntervals.find(val);
+        if (iter == valueIntervals.end()) {
+            continue;
+        }
+
+        for (AllocInterval * interval = iter->second->next; interval; interval = interval->next) {
+            for (auto pos: interval->live.getReferences()) {
+
+                Instruction * inst = liveness->getInstAt(pos);
+
+                if (pos % 2 == 1) {
+                    // 定值只能是赋值指令的目的操作数
+                    inst->setOperand(0, interval->location);
+                    continue;
+                }
+
+                int32_t first = inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN ? 1 : 0;
+                for (int32_t k = first; k < inst->getOperandsNum(); ++k) {
+                    if (inst->getOperand(k) == val) {
+                        inst->setOperand(k, interval->location);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// @brief 在基本块内的分裂位置插入赋值指令
+void LinearScanRegisterAllocator::insertSplitMoves()
+{
+    // 同一条指令之前的赋值同时进行
+    std::unordered_map<int32_t, std::vector<std::pair<Value *, Value *>>> splitMoves;
+    std::vector<int32_t> positions;
+
+    // 基本块入口的位置由控制流边上的赋值处理
+    std::vector<bool> blockEntry(instFrequency.size() + 1, false);
+    for (auto bb: cfg->getBlocks()) {
+        blockEntry[liveness->getBlockStart(bb) / 2] = true;
+    }
+
+    for (auto val: liveness->getValues()) {
+
+        auto iter = valueIntervals.find(val);
+        if (iter == valueIntervals.end()) {
+            continue;
+        }
+
+        for (AllocInterval * interval = iter->second->next; interval; interval = interval->next) {
+
+            int32_t pos = interval->splitPos;
+            if (blockEntry[pos / 2] || !interval->live.covers(pos)) {
+                continue;
+            }
+
+            AllocInterval * prev = intervalAt(val, pos - 1);
+            if (!prev || (prev->reg != -1 && prev->reg == interval->reg)) {
+                continue;
+            }
+
+            if (splitMoves.find(pos) == splitMoves.end()) {
+                positions.push_back(pos);
+            }
+            splitMoves[pos].emplace_back(interval->location, prev->location);
+        }
+    }
+
+    for (auto pos: positions) {
+
+        Instruction * before = liveness->getInstAt(pos);
+        BasicBlock * bb = cfg->getBlockOfInst(before);
+        std::vector<Instruction *> & insts = bb->getInsts();
+
+        std::vector<Instruction *> moves = sequentializeMoves(splitMoves[pos]);
+        insts.insert(std::find(insts.begin(), insts.end(), before), moves.begin(), moves.end());
+    }
+}
+
+/// @brief 在控制流边上插入赋值指令，使前驱出口与后继入口的位置一致
+void LinearScanRegisterAllocator::insertEdgeMoves()
+{
+    // 关键边上新建的基本块加在最后，只处理原有的基本块
+    std::vector<BasicBlock *> blocks = cfg->getBlocks();
+    const std::vector<Value *> & values = liveness->getValues();
+
+    for (auto bb: blocks) {
+
+        for (auto pred: bb->getPreds()) {
+
+            std::vector<std::pair<Value *, Value *>> moves;
+
+            for (auto index: liveness->getLiveIn(bb)) {
+
+                AllocInterval * from = intervalAt(values[index], liveness->getBlockEnd(pred) - 1);
+                AllocInterval * to = intervalAt(values[index], liveness->getBlockStart(bb));
+
+                if (from && to && from != to && (from->reg == -1 || from->reg != to->reg)) {
+                    moves.emplace_back(to->location, from->location);
+                }
+            }
+
+            if (moves.empty()) {
+                continue;
+            }
+
+            std::vector<Instruction *> insts = sequentializeMoves(moves);
+
+            Instanceof(gotoInst, GotoInstruction *, pred->getTerminator());
+
+            if (pred->getSuccs().size() == 1 && !(gotoInst && gotoInst->isConditionalBranch())) {
+                // 前驱只有一个后继，放在前驱的跳转之前
+                for (auto inst: insts) {
+                    pred->insertBeforeTerminator(inst);
+                }
+            } else if (bb->getPreds().size() == 1) {
+                // 后继只有一个前驱，放在后继的标签之后
+                std::vector<Instruction *> & bbInsts = bb->getInsts();
+                bbInsts.insert(bbInsts.begin() + 1, insts.begin(), insts.end());
+            } else {
+                // 关键边，新建基本块放置赋值，前驱的跳转改到新的基本块
+                auto * label = new (func) LabelInstruction(func);
+                auto * edgeBlock = new BasicBlock((int32_t) cfg->getBlocks().size());
+
+                edgeBlock->getInsts().push_back(label);
+                edgeBlock->getInsts().insert(edgeBlock->getInsts().end(), insts.begin(), insts.end());
+                edgeBlock->getInsts().push_back(new (func) GotoInstruction(func, bb->getLabel()));
+                cfg->getBlocks().push_back(edgeBlock);
+
+                if (gotoInst->getTarget() == bb->getLabel()) {
+                    gotoInst->setTarget(label);
+                } else {
+                    gotoInst->setFalseTarget(label);
+                }
+            }
+        }
+    }
+}
+
+/// @brief 按依赖次序排列一组同时进行的赋值，目的寄存器被其它赋值读取时先执行读取的赋值，循环依赖借助栈中的变量打破
+/// @param moves 赋值的目的与源
+/// @return std::vector<Instruction *> 赋值指令
+std::vector<Instruction *> LinearScanRegisterAllocator::sequentializeMoves(std::vector<std::pair<Value *, Value *>> moves)
+{
+    std::vector<Instruction *> insts;
+
+    while (!moves.empty()) {
+
+        bool emitted = false;
+
+        for (size_t k = 0; k < moves.size(); ++k) {
+
+            // 目的在栈中时不会覆盖其它赋值的源
+            int32_t dstReg = moves[k].first->getRegId();
+
+            bool blocked = false;
+            for (size_t j = 0; j < moves.size() && dstReg != -1; ++j) {
+                if (j != k && moves[j].second->getRegId() == dstReg) {
+                    blocked = true;
+                    break;
+                }
+            }
+
+            if (!blocked) {
+                insts.push_back(new (func) MoveInstruction(func, moves[k].first, moves[k].second));
+                moves.erase(moves.begin() + (int32_t) k);
+                emitted = true;
+                break;
+            }
+        }
+
+        if (!emitted) {
+            // 寄存器之间循环赋值，先把一个源保存到栈中
+            LocalVariable * tmp = func->newLocalVarValue(moves.front().second->getType());
+            insts.push_back(new (func) MoveInstruction(func, tmp, moves.front().second));
+            moves.front().second = tmp;
+        }
+    }
+
+    return insts;
+}
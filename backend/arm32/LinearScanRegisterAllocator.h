@@ -0,0 +1,263 @@
+///
+/// @file LinearScanRegisterAllocator.h
+/// @brief 基于活跃区间的线性扫描寄存器分配器
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "ControlFlowGraph.h"
+#include "Function.h"
+#include "Liveness.h"
+
+///
+/// @brief 线性扫描寄存器分配器。局部变量与指令的临时变量按活跃区间的起始位置依次分配被调用者保存的寄存器r4-r9，
+/// 区间在洞中时寄存器可给其它区间使用；寄存器只在区间的前一部分空闲时分裂区间，
+/// 寄存器不够时按溢出代价（引用次数按循环深度或剖面计数加权）选择溢出的区间。
+/// 分裂出的各部分用新的局部变量表示，在分裂位置以及控制流边上插入赋值指令连接。
+/// 没有分配到寄存器的变量仍由栈空间分配处理，指令选择时加载到临时寄存器r0-r3中
+///
+class LinearScanRegisterAllocator {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _func 要分配的函数
+    ///
+    explicit LinearScanRegisterAllocator(Function * _func);
+
+    ///
+    /// @brief 执行寄存器分配，变量的寄存器通过setRegId设置，分裂与连接的赋值指令写回到函数中
+    ///
+    void run();
+
+    ///
+    /// @brief 获取分配使用过的寄存器编号，升序排列，函数入口需要保护
+    /// @return const std::vector<int32_t>& 寄存器编号
+    ///
+    [[nodiscard]] const std::vector<int32_t> & getUsedRegs() const
+    {
+        return usedRegs;
+    }
+
+    ///
+    /// @brief 可分配的第一个寄存器r4
+    ///
+    static constexpr int32_t FIRST_REG_NO = 4;
+
+    ///
+    /// @brief 可分配的最后一个寄存器r9，r10为临时寄存器
+    ///
+    static constexpr int32_t LAST_REG_NO = 9;
+
+private:
+    ///
+    /// @brief 分配的单位。值的活跃区间分裂后，每一部分为一个分配区间，按位置先后用next连接
+    ///
+    struct AllocInterval {
+
+        /// @brief 活跃区间
+        LiveInterval live;
+
+        /// @brief 分配的寄存器，-1表示溢出到栈中
+        int32_t reg = -1;
+
+        /// @brief 溢出代价，引用按所在基本块的执行频度累加
+        double weight = 0;
+
+        /// @brief 创建的次序，起始位置相同时先创建的先分配
+        int32_t id = 0;
+
+        /// @brief 分裂位置，第一部分为-1
+        int32_t splitPos = -1;
+
+        /// @brief 表示本部分的值，第一部分为原来的值，其余为新建的局部变量
+        Value * location = nullptr;
+
+        /// @brief 同一个值的下一部分
+        AllocInterval * next = nullptr;
+
+        explicit AllocInterval(const LiveInterval & _live) : live(_live)
+        {}
+    };
+
+    ///
+    /// @brief 未处理的区间按起始位置从小到大出队
+    ///
+    struct LaterStart {
+        bool operator()(const AllocInterval * a, const AllocInterval * b) const
+        {
+            if (a->live.start() != b->live.start()) {
+                return a->live.start() > b->live.start();
+            }
+            return a->id > b->id;
+        }
+    };
+
+    ///
+    /// @brief 值是否参与寄存器分配
+    /// @param val 值
+    /// @return true 参与 false 不参与
+    ///
+    static bool isAllocatable(Value * val);
+
+    ///
+    /// @brief 按指令编号记录所在基本块的执行频度，基本块的频度由getBlockFrequencies估计
+    ///
+    void computeFrequency();
+
+    ///
+    /// @brief 计算区间的溢出代价
+    /// @param interval 区间
+    /// @param from 只累计不小于from的引用
+    /// @return double 代价
+    ///
+    double spillWeight(const AllocInterval * interval, int32_t from = 0) const;
+
+    ///
+    /// @brief 新建分配区间
+    /// @param live 活跃区间
+    /// @return AllocInterval* 分配区间
+    ///
+    AllocInterval * newInterval(const LiveInterval & live);
+
+    ///
+    /// @brief 在位置pos处分裂区间，返回后一部分
+    /// @param interval 区间
+    /// @param pos 分裂位置，为指令的使用位置，即指令之前
+    /// @return AllocInterval* 后一部分
+    ///
+    AllocInterval * split(AllocInterval * interval, int32_t pos);
+
+    ///
+    /// @brief 扫描全部区间分配寄存器
+    ///
+    void linearScan();
+
+    ///
+    /// @brief 寻找整个区间或区间前一部分空闲的寄存器
+    /// @param cur 当前区间
+    /// @return true 分配成功 false 没有空闲的寄存器
+    ///
+    bool tryAllocateFreeReg(AllocInterval * cur);
+
+    ///
+    /// @brief 没有空闲寄存器时，比较当前区间与占用各寄存器的区间的溢出代价，溢出代价小的一方
+    /// @param cur 当前区间
+    ///
+    void allocateBlockedReg(AllocInterval * cur);
+
+    ///
+    /// @brief 从位置pos开始溢出区间，pos之前的部分保留寄存器
+    /// @param interval 区间
+    /// @param pos 位置
+    ///
+    void splitAndSpill(AllocInterval * interval, int32_t pos);
+
+    ///
+    /// @brief 获取提示的寄存器：与当前区间通过赋值指令相连的区间已分配的寄存器
+    /// @param cur 当前区间
+    /// @return int32_t 寄存器编号，没有时为-1
+    ///
+    int32_t getHint(AllocInterval * cur);
+
+    ///
+    /// @brief 获取值在位置pos所在的分配区间
+    /// @param val 值
+    /// @param pos 位置
+    /// @return AllocInterval* 分配区间，值在pos不活跃时为空
+    ///
+    AllocInterval * intervalAt(Value * val, int32_t pos);
+
+    ///
+    /// @brief 把分配结果写回：设置寄存器，分裂的部分改用新的局部变量，插入连接各部分的赋值指令
+    ///
+    void resolve();
+
+    ///
+    /// @brief 替换指令中对值的引用为分裂后对应部分的局部变量
+    ///
+    void rewriteOperands();
+
+    ///
+    /// @brief 在基本块内的分裂位置插入赋值指令
+    ///
+    void insertSplitMoves();
+
+    ///
+    /// @brief 在控制流边上插入赋值指令，使前驱出口与后继入口的位置一致
+    ///
+    void insertEdgeMoves();
+
+    ///
+    /// @brief 按依赖次序排列一组同时进行的赋值，目的寄存器被其它赋值读取时先执行读取的赋值，循环依赖借助栈中的变量打破
+    /// @param moves 赋值的目的与源
+    /// @return std::vector<Instruction *> 赋值指令
+    ///
+    std::vector<Instruction *> sequentializeMoves(std::vector<std::pair<Value *, Value *>> moves);
+
+    ///
+    /// @brief 函数
+    ///
+    Function * func;
+
+    ///
+    /// @brief 控制流图，删除死指令后构建
+    ///
+    ControlFlowGraph * cfg = nullptr;
+
+    ///
+    /// @brief 活跃性分析
+    ///
+    Liveness * liveness = nullptr;
+
+    ///
+    /// @brief 按指令编号记录所在基本块的执行频度
+    ///
+    std::vector<double> instFrequency;
+
+    ///
+    /// @brief 全部的分配区间
+    ///
+    std::deque<AllocInterval> intervals;
+
+    ///
+    /// @brief 值到第一部分分配区间的映射
+    ///
+    std::unordered_map<Value *, AllocInterval *> valueIntervals;
+
+    ///
+    /// @brief 未处理的区间
+    ///
+    std::priority_queue<AllocInterval *, std::vector<AllocInterval *>, LaterStart> unhandled;
+
+    ///
+    /// @brief 当前位置活跃并占用寄存器的区间
+    ///
+    std::vector<AllocInterval *> active;
+
+    ///
+    /// @brief 已分配寄存器但当前位置在洞中的区间
+    ///
+    std::vector<AllocInterval *> inactive;
+
+    ///
+    /// @brief 使用过的寄存器编号
+    ///
+    std::vector<int32_t> usedRegs;
+};
@@ -21,6 +21,8 @@
 #include "AST.h"
 #include "AttrType.h"
 
+// ANTLR的语法树结点没有类别标记，这里仍然使用dynamic_cast
+#undef Instanceof
 #define Instanceof(res, type, var) auto res = dynamic_cast<type>(var)
 
 /// @brief 构造函数
@@ -37,8 +37,20 @@ class Constant : public User {
 protected:
     ///
     /// @brief 构造函数
+    /// @param _kind  具体类别
     /// @param _type  类型
     ///
-    Constant(Type * _type) : User(_type)
+    Constant(ValueKind _kind, Type * _type) : User(_kind, _type)
     {}
+
+public:
+    ///
+    /// @brief 是否是常量，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * v)
+    {
+        return v->getValueKind() >= FirstConstantVal && v->getValueKind() <= LastConstantVal;
+    }
 };
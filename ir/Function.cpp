@@ -25,7 +25,7 @@
 /// @param _type 函数类型
 /// @param _builtin 是否是内置函数
 Function::Function(std::string _name, FunctionType * _type, bool _builtin)
-    : GlobalValue(_type, _name), builtIn(_builtin)
+    : GlobalValue(FunctionVal, _type, _name), builtIn(_builtin)
 {
     returnType = _type->getReturnType();
 
@@ -234,6 +234,25 @@ void Function::setExistFuncCall(bool exist)
     funcCallExist = exist;
 }
 
+/// @brief 按函数内未删除的函数调用指令重新统计是否存在函数调用以及参数个数的最大值，
+/// 内联、尾递归消除与死代码删除去掉调用后，IR生成时的统计不再准确
+void Function::updateFuncCallInfo()
+{
+    funcCallExist = false;
+    maxFuncCallArgCnt = 0;
+
+    for (auto inst: this->getInterCode().getInsts()) {
+        if (inst->isDead() || inst->getOp() != IRInstOperator::IRINST_OP_FUNC_CALL) {
+            continue;
+        }
+
+        funcCallExist = true;
+        if (inst->getOperandsNum() > maxFuncCallArgCnt) {
+            maxFuncCallArgCnt = inst->getOperandsNum();
+        }
+    }
+}
+
 /// @brief 新建变量型Value。先检查是否存在，不存在则创建，否则失败
 /// @param name 变量ID
 /// @param type 变量类型
@@ -241,7 +260,7 @@ void Function::setExistFuncCall(bool exist)
 LocalVariable * Function::newLocalVarValue(Type * type, std::string name, int32_t scope_level)
 {
     // 创建变量并加入符号表
-    LocalVariable * varValue = new LocalVariable(type, name, scope_level);
+    LocalVariable * varValue = new (arena) LocalVariable(type, name, scope_level, &arena);
 
     // varsVector表中可能存在变量重名的信息
     varsVector.push_back(varValue);
@@ -255,7 +274,7 @@ LocalVariable * Function::newLocalVarValue(Type * type, std::string name, int32_
 MemVariable * Function::newMemVariable(Type * type)
 {
     // 肯定唯一存在，直接插入即可
-    MemVariable * memValue = new MemVariable(type);
+    MemVariable * memValue = new (arena) MemVariable(type, &arena);
 
     memVector.push_back(memValue);
 
@@ -265,15 +284,16 @@ MemVariable * Function::newMemVariable(Type * type)
 /// @brief 清理函数内申请的资源
 void Function::Delete()
 {
-    // 清理IR指令
-    code.Delete();
-
-    // 清理Value
-    for (auto & var: varsVector) {
-        delete var;
+    // 指令与变量都在内存区中，只需从函数外的Value的链表中取消，不再逐个析构，内存区整体归还
+    for (auto inst: code.getInsts()) {
+        inst->dropExternalUses();
     }
 
+    code.getInsts().clear();
     varsVector.clear();
+    memVector.clear();
+
+    arena.release();
 }
 
 ///
@@ -15,9 +15,11 @@
 ///
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
+#include "Arena.h"
 #include "GlobalValue.h"
 #include "FunctionType.h"
 #include "FormalParam.h"
@@ -47,6 +49,16 @@ public:
     /// @brief 注意：IR指令代码并未释放，需要手动释放
     ~Function();
 
+    ///
+    /// @brief 是否是函数，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * v)
+    {
+        return v->getValueKind() == FunctionVal;
+    }
+
     /// @brief 获取函数返回类型
     /// @return 返回类型
     Type * getReturnType();
@@ -59,6 +71,15 @@ public:
     /// @return IR指令代码
     InterCode & getInterCode();
 
+    ///
+    /// @brief 获取函数的内存区，函数内的指令、局部变量与内存变量都在其中创建
+    /// @return Arena& 内存区
+    ///
+    Arena & getArena()
+    {
+        return arena;
+    }
+
     /// @brief 判断该函数是否是内置函数
     /// @return true: 内置函数，false：用户自定义
     bool isBuiltin();
@@ -131,6 +152,10 @@ public:
     /// @param exist true: 存在 false: 不存在
     void setExistFuncCall(bool exist);
 
+    /// @brief 按函数内未删除的函数调用指令重新统计是否存在函数调用以及参数个数的最大值，
+    /// 内联、尾递归消除与死代码删除去掉调用后，IR生成时的统计不再准确
+    void updateFuncCallInfo();
+
     /// @brief 获取本函数需要保护的寄存器
     /// @return 要保护的寄存器
     std::vector<int32_t> & getProtectedReg();
@@ -218,6 +243,59 @@ public:
         return extraData;
     }
 
+    ///
+    /// @brief 过程间分析得到的函数属性，默认值是保守的
+    ///
+    struct Attributes {
+        /// @brief 不读取全局变量
+        bool noGlobalReads = false;
+
+        /// @brief 不修改全局变量
+        bool noGlobalWrites = false;
+
+        /// @brief 纯函数，不访问全局变量且没有输入输出等副作用，结果只取决于实参
+        bool pure = false;
+
+        /// @brief 不直接或间接地递归调用自身
+        bool noRecurse = false;
+
+        /// @brief 一定会返回，没有循环与递归
+        bool willReturn = false;
+
+        /// @brief 总是返回同一个常量
+        bool returnsConst = false;
+
+        /// @brief 返回的常量
+        int32_t constValue = 0;
+    };
+
+    ///
+    /// @brief 获取函数属性
+    /// @return Attributes& 函数属性
+    ///
+    Attributes & getAttributes()
+    {
+        return attributes;
+    }
+
+    ///
+    /// @brief 获取剖面数据中函数的执行次数，即入口基本块的执行次数
+    /// @return int64_t 执行次数，-1表示没有剖面数据
+    ///
+    int64_t getEntryCount()
+    {
+        return entryCount;
+    }
+
+    ///
+    /// @brief 设置剖面数据中函数的执行次数
+    /// @param count 执行次数
+    ///
+    void setEntryCount(int64_t count)
+    {
+        entryCount = count;
+    }
+
 private:
     ///
     /// @brief 函数的返回值类型，有点冗余，可删除，直接从type中取得即可
@@ -243,6 +321,11 @@ private:
     ///
     Instruction* continueLabel = nullptr;
 
+    ///
+    /// @brief 内存区，函数内的指令、局部变量与内存变量都在其中创建，函数释放时整体归还
+    ///
+    Arena arena;
+
     ///
     /// @brief 线性IR指令块，可包含多条IR指令
     ///
@@ -312,4 +395,14 @@ private:
     
     /// @brief 用于在函数间传递临时指令的额外数据
     ExtraData extraData;
+
+    ///
+    /// @brief 函数属性
+    ///
+    Attributes attributes;
+
+    ///
+    /// @brief 剖面数据中函数的执行次数，-1表示没有剖面数据
+    ///
+    int64_t entryCount = -1;
 };
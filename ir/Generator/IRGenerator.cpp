@@ -16,7 +16,6 @@
 ///
 #include <cstdint>
 #include <cstdio>
-#include <unordered_map>
 #include <vector>
 #include <iostream>
 
@@ -34,67 +33,73 @@
 #include "MoveInstruction.h"
 #include "GotoInstruction.h"
 #include "ConstInt.h" //添加ConstInt-lxg
+#include "DispatchTable.h"
+/// @brief AST节点运算符与动作函数关联的表，以运算符为下标，每个运算符都要有翻译函数
+constexpr std::array<IRGenerator::ast2ir_handler_t, IRGenerator::AST_OP_COUNT> IRGenerator::ast2ir_handlers =
+    makeDispatchTable<ast_operator_type, IRGenerator::ast2ir_handler_t, IRGenerator::AST_OP_COUNT>({
+        /* 叶子节点 */
+        {ast_operator_type::AST_OP_LEAF_LITERAL_UINT, &IRGenerator::ir_leaf_node_uint},
+        {ast_operator_type::AST_OP_LEAF_LITERAL_FLOAT, &IRGenerator::ir_default},
+        {ast_operator_type::AST_OP_LEAF_VAR_ID, &IRGenerator::ir_leaf_node_var_id},
+        {ast_operator_type::AST_OP_LEAF_TYPE, &IRGenerator::ir_leaf_node_type},
+
+        /* 表达式运算， 加减乘除余 */
+        {ast_operator_type::AST_OP_SUB, &IRGenerator::ir_sub},
+        {ast_operator_type::AST_OP_ADD, &IRGenerator::ir_add},
+        {ast_operator_type::AST_OP_MUL, &IRGenerator::ir_mul},
+        {ast_operator_type::AST_OP_DIV, &IRGenerator::ir_div},
+        {ast_operator_type::AST_OP_MOD, &IRGenerator::ir_mod},
+        {ast_operator_type::AST_OP_NEG, &IRGenerator::ir_neg},
+
+        /* 关系运算 */
+        {ast_operator_type::AST_OP_LT, &IRGenerator::ir_lt},
+        {ast_operator_type::AST_OP_GT, &IRGenerator::ir_gt},
+        {ast_operator_type::AST_OP_LE, &IRGenerator::ir_le},
+        {ast_operator_type::AST_OP_GE, &IRGenerator::ir_ge},
+        {ast_operator_type::AST_OP_EQ, &IRGenerator::ir_eq},
+        {ast_operator_type::AST_OP_NE, &IRGenerator::ir_ne},
+
+        /* 逻辑运算 */
+        {ast_operator_type::AST_OP_LOGIC_AND, &IRGenerator::ir_logic_and},
+        {ast_operator_type::AST_OP_LOGIC_OR, &IRGenerator::ir_logic_or},
+        {ast_operator_type::AST_OP_LOGIC_NOT, &IRGenerator::ir_logic_not},
+
+        /* 控制流语句 */
+        {ast_operator_type::AST_OP_IF, &IRGenerator::ir_if},
+        {ast_operator_type::AST_OP_IF_ELSE, &IRGenerator::ir_if_else},
+        {ast_operator_type::AST_OP_WHILE, &IRGenerator::ir_while},
+        {ast_operator_type::AST_OP_BREAK, &IRGenerator::ir_break},
+        {ast_operator_type::AST_OP_CONTINUE, &IRGenerator::ir_continue},
+
+        /* 语句 */
+        {ast_operator_type::AST_OP_ASSIGN, &IRGenerator::ir_assign},
+        {ast_operator_type::AST_OP_RETURN, &IRGenerator::ir_return},
+
+        /* 函数调用，实参由函数调用节点处理 */
+        {ast_operator_type::AST_OP_FUNC_CALL, &IRGenerator::ir_function_call},
+        {ast_operator_type::AST_OP_FUNC_REAL_PARAMS, &IRGenerator::ir_default},
+
+        /* 函数定义，单个形参由形参列表节点处理 */
+        {ast_operator_type::AST_OP_FUNC_DEF, &IRGenerator::ir_function_define},
+        {ast_operator_type::AST_OP_FUNC_FORMAL_PARAMS, &IRGenerator::ir_function_formal_params},
+        {ast_operator_type::AST_OP_FUNC_FORMAL_PARAM, &IRGenerator::ir_default},
+
+        /* 变量定义语句 */
+        {ast_operator_type::AST_OP_DECL_STMT, &IRGenerator::ir_declare_statment},
+        {ast_operator_type::AST_OP_VAR_DECL, &IRGenerator::ir_variable_declare},
+
+        /* 语句块 */
+        {ast_operator_type::AST_OP_BLOCK, &IRGenerator::ir_block},
+
+        /* 编译单元 */
+        {ast_operator_type::AST_OP_COMPILE_UNIT, &IRGenerator::ir_compile_unit},
+    });
+
 /// @brief 构造函数
 /// @param _root AST的根
 /// @param _module 符号表
 IRGenerator::IRGenerator(ast_node * _root, Module * _module) : root(_root), module(_module)
-{
-    /* 叶子节点 */
-    ast2ir_handlers[ast_operator_type::AST_OP_LEAF_LITERAL_UINT] = &IRGenerator::ir_leaf_node_uint;
-    ast2ir_handlers[ast_operator_type::AST_OP_LEAF_VAR_ID] = &IRGenerator::ir_leaf_node_var_id;
-    ast2ir_handlers[ast_operator_type::AST_OP_LEAF_TYPE] = &IRGenerator::ir_leaf_node_type;
-
-    /* 表达式运算， 加减 */
-	/* 表达式运算， 加减乘除余-lxg */
-    ast2ir_handlers[ast_operator_type::AST_OP_SUB] = &IRGenerator::ir_sub;
-    ast2ir_handlers[ast_operator_type::AST_OP_ADD] = &IRGenerator::ir_add;
-	ast2ir_handlers[ast_operator_type::AST_OP_MUL] = &IRGenerator::ir_mul; 	// 添加乘法处理
-	ast2ir_handlers[ast_operator_type::AST_OP_DIV] = &IRGenerator::ir_div;  // 添加除法处理
-    ast2ir_handlers[ast_operator_type::AST_OP_MOD] = &IRGenerator::ir_mod;  // 添加求余处理
-	ast2ir_handlers[ast_operator_type::AST_OP_NEG] = &IRGenerator::ir_neg;  // 添加负号处理
-
-	/*关系运算,控制流和逻辑运算-lxg*/
-	// 添加关系运算符处理函数映射
-    ast2ir_handlers[ast_operator_type::AST_OP_LT] = &IRGenerator::ir_lt;
-    ast2ir_handlers[ast_operator_type::AST_OP_GT] = &IRGenerator::ir_gt;
-    ast2ir_handlers[ast_operator_type::AST_OP_LE] = &IRGenerator::ir_le;
-    ast2ir_handlers[ast_operator_type::AST_OP_GE] = &IRGenerator::ir_ge;
-    ast2ir_handlers[ast_operator_type::AST_OP_EQ] = &IRGenerator::ir_eq;
-    ast2ir_handlers[ast_operator_type::AST_OP_NE] = &IRGenerator::ir_ne;
-    
-    // 添加逻辑运算符处理函数映射
-    ast2ir_handlers[ast_operator_type::AST_OP_LOGIC_AND] = &IRGenerator::ir_logic_and;
-    ast2ir_handlers[ast_operator_type::AST_OP_LOGIC_OR] = &IRGenerator::ir_logic_or;
-    ast2ir_handlers[ast_operator_type::AST_OP_LOGIC_NOT] = &IRGenerator::ir_logic_not;
-    
-    // 添加控制流语句处理函数映射
-    ast2ir_handlers[ast_operator_type::AST_OP_IF] = &IRGenerator::ir_if;
-    ast2ir_handlers[ast_operator_type::AST_OP_IF_ELSE] = &IRGenerator::ir_if_else;
-    ast2ir_handlers[ast_operator_type::AST_OP_WHILE] = &IRGenerator::ir_while;
-    ast2ir_handlers[ast_operator_type::AST_OP_BREAK] = &IRGenerator::ir_break;
-    ast2ir_handlers[ast_operator_type::AST_OP_CONTINUE] = &IRGenerator::ir_continue;
-
-    /* 语句 */
-    ast2ir_handlers[ast_operator_type::AST_OP_ASSIGN] = &IRGenerator::ir_assign;
-    ast2ir_handlers[ast_operator_type::AST_OP_RETURN] = &IRGenerator::ir_return;
-
-    /* 函数调用 */
-    ast2ir_handlers[ast_operator_type::AST_OP_FUNC_CALL] = &IRGenerator::ir_function_call;
-
-    /* 函数定义 */
-    ast2ir_handlers[ast_operator_type::AST_OP_FUNC_DEF] = &IRGenerator::ir_function_define;
-    ast2ir_handlers[ast_operator_type::AST_OP_FUNC_FORMAL_PARAMS] = &IRGenerator::ir_function_formal_params;
-
-    /* 变量定义语句 */
-    ast2ir_handlers[ast_operator_type::AST_OP_DECL_STMT] = &IRGenerator::ir_declare_statment;
-    ast2ir_handlers[ast_operator_type::AST_OP_VAR_DECL] = &IRGenerator::ir_variable_declare;
-
-    /* 语句块 */
-    ast2ir_handlers[ast_operator_type::AST_OP_BLOCK] = &IRGenerator::ir_block;
-
-    /* 编译单元 */
-    ast2ir_handlers[ast_operator_type::AST_OP_COMPILE_UNIT] = &IRGenerator::ir_compile_unit;
-}
+{}
 
 /// @brief 遍历抽象语法树产生线性IR，保存到IRCode中
 /// @param root 抽象语法树
@@ -120,16 +125,7 @@ ast_node * IRGenerator::ir_visit_ast_node(ast_node * node)
         return nullptr;
     }
 
-    bool result;
-
-    std::unordered_map<ast_operator_type, ast2ir_handler_t>::const_iterator pIter;
-    pIter = ast2ir_handlers.find(node->node_type);
-    if (pIter == ast2ir_handlers.end()) {
-        // 没有找到，则说明当前不支持
-        result = (this->ir_default)(node);
-    } else {
-        result = (this->*(pIter->second))(node);
-    }
+    bool result = (this->*ast2ir_handlers[(std::size_t) node->node_type])(node);
 
     if (!result) {
         // 语义解析错误，则出错返回
@@ -305,10 +301,10 @@ bool IRGenerator::ir_function_define(ast_node * node)
     // 这里也可增加一个函数入口Label指令，便于后续基本块划分
 
     // 创建并加入Entry入口指令
-    irCode.addInst(new EntryInstruction(newFunc));
+    irCode.addInst(new (newFunc) EntryInstruction(newFunc));
 
     // 创建出口指令并不加入出口指令，等函数内的指令处理完毕后加入出口指令
-    LabelInstruction * exitLabelInst = new LabelInstruction(newFunc);
+    LabelInstruction * exitLabelInst = new (newFunc) LabelInstruction(newFunc);
 
     // 函数出口指令保存到函数信息中，因为在语义分析函数体时return语句需要跳转到函数尾部，需要这个label指令
     newFunc->setExitLabel(exitLabelInst);
@@ -353,7 +349,7 @@ bool IRGenerator::ir_function_define(ast_node * node)
     irCode.addInst(exitLabelInst);
 
     // 函数出口指令
-    irCode.addInst(new ExitInstruction(newFunc, retValue));
+    irCode.addInst(new (newFunc) ExitInstruction(newFunc, retValue));
 
     // 恢复成外部函数
     module->setCurrentFunction(nullptr);
@@ -426,7 +422,7 @@ bool IRGenerator::ir_function_formal_params(ast_node * node)
         Value* paramValue = param;
         
         // 3. 创建赋值指令，将形参值复制到局部变量
-        MoveInstruction* moveInst = new MoveInstruction(currentFunc, 
+        MoveInstruction* moveInst = new (currentFunc) MoveInstruction(currentFunc, 
                                                        static_cast<LocalVariable*>(localParam), 
                                                        paramValue);
         
@@ -601,7 +597,8 @@ bool IRGenerator::ir_function_call(ast_node * node)
     // 返回调用有返回值，则需要分配临时变量，用于保存函数调用的返回值
     Type * type = calledFunction->getReturnType();
 
-    FuncCallInstruction * funcCallInst = new FuncCallInstruction(currentFunc, calledFunction, realParams, type);
+    FuncCallInstruction * funcCallInst =
+        new (currentFunc) FuncCallInstruction(currentFunc, calledFunction, realParams, type);
 
     // 创建函数调用指令
     node->blockInsts.addInst(funcCallInst);
@@ -670,11 +667,12 @@ bool IRGenerator::ir_add(ast_node * node)
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
 
-    BinaryInstruction * addInst = new BinaryInstruction(module->getCurrentFunction(),
-                                                        IRInstOperator::IRINST_OP_ADD_I,
-                                                        left->val,
-                                                        right->val,
-                                                        IntegerType::getTypeInt());
+    Function * currentFunc = module->getCurrentFunction();
+    BinaryInstruction * addInst = new (currentFunc) BinaryInstruction(currentFunc,
+                                                                      IRInstOperator::IRINST_OP_ADD_I,
+                                                                      left->val,
+                                                                      right->val,
+                                                                      IntegerType::getTypeInt());
 
     // 创建临时变量保存IR的值，以及线性IR指令
     node->blockInsts.addInst(left->blockInsts);
@@ -712,11 +710,12 @@ bool IRGenerator::ir_sub(ast_node * node)
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
 
-    BinaryInstruction * subInst = new BinaryInstruction(module->getCurrentFunction(),
-                                                        IRInstOperator::IRINST_OP_SUB_I,
-                                                        left->val,
-                                                        right->val,
-                                                        IntegerType::getTypeInt());
+    Function * currentFunc = module->getCurrentFunction();
+    BinaryInstruction * subInst = new (currentFunc) BinaryInstruction(currentFunc,
+                                                                      IRInstOperator::IRINST_OP_SUB_I,
+                                                                      left->val,
+                                                                      right->val,
+                                                                      IntegerType::getTypeInt());
 
     // 创建临时变量保存IR的值，以及线性IR指令
     node->blockInsts.addInst(left->blockInsts);
@@ -767,11 +766,12 @@ bool IRGenerator::ir_mul(ast_node * node)
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
 
-    BinaryInstruction * mulInst = new BinaryInstruction(module->getCurrentFunction(),
-                                                        IRInstOperator::IRINST_OP_MUL_I,
-                                                        left->val,
-                                                        right->val,
-                                                        IntegerType::getTypeInt());
+    Function * currentFunc = module->getCurrentFunction();
+    BinaryInstruction * mulInst = new (currentFunc) BinaryInstruction(currentFunc,
+                                                                      IRInstOperator::IRINST_OP_MUL_I,
+                                                                      left->val,
+                                                                      right->val,
+                                                                      IntegerType::getTypeInt());
 
     // 创建临时变量保存IR的值，以及线性IR指令
     node->blockInsts.addInst(left->blockInsts);
@@ -809,11 +809,12 @@ bool IRGenerator::ir_div(ast_node * node)
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
 
-    BinaryInstruction * divInst = new BinaryInstruction(module->getCurrentFunction(),
-                                                        IRInstOperator::IRINST_OP_DIV_I,
-                                                        left->val,
-                                                        right->val,
-                                                        IntegerType::getTypeInt());
+    Function * currentFunc = module->getCurrentFunction();
+    BinaryInstruction * divInst = new (currentFunc) BinaryInstruction(currentFunc,
+                                                                      IRInstOperator::IRINST_OP_DIV_I,
+                                                                      left->val,
+                                                                      right->val,
+                                                                      IntegerType::getTypeInt());
 
     // 创建临时变量保存IR的值，以及线性IR指令
     node->blockInsts.addInst(left->blockInsts);
@@ -851,11 +852,12 @@ bool IRGenerator::ir_mod(ast_node * node)
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
 
-    BinaryInstruction * modInst = new BinaryInstruction(module->getCurrentFunction(),
-                                                        IRInstOperator::IRINST_OP_MOD_I,
-                                                        left->val,
-                                                        right->val,
-                                                        IntegerType::getTypeInt());
+    Function * currentFunc = module->getCurrentFunction();
+    BinaryInstruction * modInst = new (currentFunc) BinaryInstruction(currentFunc,
+                                                                      IRInstOperator::IRINST_OP_MOD_I,
+                                                                      left->val,
+                                                                      right->val,
+                                                                      IntegerType::getTypeInt());
 
     // 创建临时变量保存IR的值，以及线性IR指令
     node->blockInsts.addInst(left->blockInsts);
@@ -883,11 +885,12 @@ bool IRGenerator::ir_neg(ast_node * node)
     }
     
     // 创建一元负号指令
-    BinaryInstruction * negInst = new BinaryInstruction(module->getCurrentFunction(),
-                                                      IRInstOperator::IRINST_OP_NEG_I,
-                                                      operand->val,
-                                                      nullptr,  // 一元运算符第二个操作数为空
-                                                      IntegerType::getTypeInt());
+    Function * currentFunc = module->getCurrentFunction();
+    BinaryInstruction * negInst = new (currentFunc) BinaryInstruction(currentFunc,
+                                                                      IRInstOperator::IRINST_OP_NEG_I,
+                                                                      operand->val,
+                                                                      nullptr,  // 一元运算符第二个操作数为空
+                                                                      IntegerType::getTypeInt());
     
     // 将操作数的指令和负号指令添加到当前节点
     node->blockInsts.addInst(operand->blockInsts);
@@ -922,21 +925,15 @@ bool IRGenerator::ir_lt(ast_node* node)
     node->blockInsts.addInst(left_node->blockInsts);
     node->blockInsts.addInst(right_node->blockInsts);
     
-    // 创建临时变量存储比较结果 - 使用布尔类型
-    LocalVariable* result = static_cast<LocalVariable*>(module->newVarValue(IntegerType::getTypeBool()));
-    
-    // 添加比较指令 - 使用布尔类型
-    BinaryInstruction* ltInst = new BinaryInstruction(func, 
+    // 比较指令的结果为布尔类型，直接作为表达式的值，条件跳转可直接使用，不再复制到临时变量
+    BinaryInstruction* ltInst = new (func) BinaryInstruction(func, 
                                                IRInstOperator::IRINST_OP_LT_I, 
                                                left,
                                                right, 
                                                IntegerType::getTypeBool());
     node->blockInsts.addInst(ltInst);
     
-    // 将结果移动到临时变量中
-    node->blockInsts.addInst(new MoveInstruction(func, result, ltInst));
-    
-    node->val = result;
+    node->val = ltInst;
     return true;
 }
 
@@ -962,21 +959,15 @@ bool IRGenerator::ir_gt(ast_node* node)
     node->blockInsts.addInst(left_node->blockInsts);
     node->blockInsts.addInst(right_node->blockInsts);
     
-    // 使用布尔类型
-    LocalVariable* result = static_cast<LocalVariable*>(module->newVarValue(IntegerType::getTypeBool()));
-    
-    // 使用布尔类型
-    BinaryInstruction* gtInst = new BinaryInstruction(func, 
+    // 使用布尔类型，比较结果直接作为表达式的值
+    BinaryInstruction* gtInst = new (func) BinaryInstruction(func, 
                                                IRInstOperator::IRINST_OP_GT_I, 
                                                left, 
                                                right, 
                                                IntegerType::getTypeBool());
     node->blockInsts.addInst(gtInst);
     
-    // 将结果移动到临时变量中
-    node->blockInsts.addInst(new MoveInstruction(func, result, gtInst));
-    
-    node->val = result;
+    node->val = gtInst;
     return true;
 }
 
@@ -1002,21 +993,15 @@ bool IRGenerator::ir_le(ast_node* node)
     node->blockInsts.addInst(left_node->blockInsts);
     node->blockInsts.addInst(right_node->blockInsts);
     
-    // 使用布尔类型
-    LocalVariable* result = static_cast<LocalVariable*>(module->newVarValue(IntegerType::getTypeBool()));
-    
-    // 使用布尔类型
-    BinaryInstruction* leInst = new BinaryInstruction(func, 
+    // 使用布尔类型，比较结果直接作为表达式的值
+    BinaryInstruction* leInst = new (func) BinaryInstruction(func, 
                                                IRInstOperator::IRINST_OP_LE_I, 
                                                left, 
                                                right, 
                                                IntegerType::getTypeBool());
     node->blockInsts.addInst(leInst);
     
-    // 将结果移动到临时变量中
-    node->blockInsts.addInst(new MoveInstruction(func, result, leInst));
-    
-    node->val = result;
+    node->val = leInst;
     return true;
 }
 
@@ -1042,21 +1027,15 @@ bool IRGenerator::ir_ge(ast_node* node)
     node->blockInsts.addInst(left_node->blockInsts);
     node->blockInsts.addInst(right_node->blockInsts);
     
-    // 使用布尔类型
-    LocalVariable* result = static_cast<LocalVariable*>(module->newVarValue(IntegerType::getTypeBool()));
-    
-    // 使用布尔类型
-    BinaryInstruction* geInst = new BinaryInstruction(func, 
+    // 使用布尔类型，比较结果直接作为表达式的值
+    BinaryInstruction* geInst = new (func) BinaryInstruction(func, 
                                                IRInstOperator::IRINST_OP_GE_I, 
                                                left, 
                                                right, 
                                                IntegerType::getTypeBool());
     node->blockInsts.addInst(geInst);
     
-    // 将结果移动到临时变量中
-    node->blockInsts.addInst(new MoveInstruction(func, result, geInst));
-    
-    node->val = result;
+    node->val = geInst;
     return true;
 }
 
@@ -1082,21 +1061,15 @@ bool IRGenerator::ir_eq(ast_node* node)
     node->blockInsts.addInst(left_node->blockInsts);
     node->blockInsts.addInst(right_node->blockInsts);
     
-    // 使用布尔类型
-    LocalVariable* result = static_cast<LocalVariable*>(module->newVarValue(IntegerType::getTypeBool()));
-    
-    // 使用布尔类型
-    BinaryInstruction* eqInst = new BinaryInstruction(func, 
+    // 使用布尔类型，比较结果直接作为表达式的值
+    BinaryInstruction* eqInst = new (func) BinaryInstruction(func, 
                                                IRInstOperator::IRINST_OP_EQ_I, 
                                                left, 
                                                right, 
                                                IntegerType::getTypeBool());
     node->blockInsts.addInst(eqInst);
     
-    // 将结果移动到临时变量中
-    node->blockInsts.addInst(new MoveInstruction(func, result, eqInst));
-    
-    node->val = result;
+    node->val = eqInst;
     return true;
 }
 
@@ -1122,212 +1095,195 @@ bool IRGenerator::ir_ne(ast_node* node)
     node->blockInsts.addInst(left_node->blockInsts);
     node->blockInsts.addInst(right_node->blockInsts);
     
-    // 使用布尔类型
-    LocalVariable* result = static_cast<LocalVariable*>(module->newVarValue(IntegerType::getTypeBool()));
-    
-    // 使用布尔类型
-    BinaryInstruction* neInst = new BinaryInstruction(func, 
+    // 使用布尔类型，比较结果直接作为表达式的值
+    BinaryInstruction* neInst = new (func) BinaryInstruction(func, 
                                                IRInstOperator::IRINST_OP_NE_I, 
                                                left, 
                                                right, 
                                                IntegerType::getTypeBool());
     node->blockInsts.addInst(neInst);
     
-    // 将结果移动到临时变量中
-    node->blockInsts.addInst(new MoveInstruction(func, result, neInst));
-    
-    node->val = result;
+    node->val = neInst;
     return true;
 }
 
 ///实现逻辑运算符，特别需要实现短路求值-lxg
-// 逻辑与 &&，带短路求值
-bool IRGenerator::ir_logic_and(ast_node* node)
+/// @brief 条件表达式翻译成跳转代码，条件为真时跳转到trueLabel，否则跳转到falseLabel。
+/// 逻辑与、逻辑或把真假出口传递给操作数实现短路求值，逻辑非交换真假出口，都不产生0/1的值
+/// @param node 条件表达式的AST节点，生成的指令放在该节点的blockInsts中
+/// @param trueLabel 条件为真时的跳转目标
+/// @param falseLabel 条件为假时的跳转目标
+/// @return 翻译是否成功，true：成功，false：失败
+bool IRGenerator::generateConditionCode(ast_node* node, Instruction* trueLabel, Instruction* falseLabel)
 {
-    if (!module) return false;
     Function* func = module->getCurrentFunction();
-    if (!func) return false;
-    
-    // 检查子节点数量
-    if (node->sons.size() < 2) {
-        minic_log(LOG_ERROR, "逻辑与运算需要两个操作数");
+    if (!func || !node) return false;
+
+    switch (node->node_type) {
+        case ast_operator_type::AST_OP_LOGIC_AND:
+        case ast_operator_type::AST_OP_LOGIC_OR: {
+
+            if (node->sons.size() < 2) {
+                minic_log(LOG_ERROR, "逻辑运算需要两个操作数");
+                return false;
+            }
+
+            ast_node* leftNode = node->sons[0];
+            ast_node* rightNode = node->sons[1];
+
+            // 右操作数的入口，左操作数不能决定结果时才计算右操作数
+            LabelInstruction* rightLabel = new (func) LabelInstruction(func);
+
+            bool isAnd = node->node_type == ast_operator_type::AST_OP_LOGIC_AND;
+            if (!generateConditionCode(leftNode,
+                                       isAnd ? rightLabel : trueLabel,
+                                       isAnd ? falseLabel : rightLabel)) {
+                return false;
+            }
+
+            if (!generateConditionCode(rightNode, trueLabel, falseLabel)) {
+                return false;
+            }
+
+            node->blockInsts.addInst(leftNode->blockInsts);
+            node->blockInsts.addInst(rightLabel);
+            node->blockInsts.addInst(rightNode->blockInsts);
+            return true;
+        }
+
+        case ast_operator_type::AST_OP_LOGIC_NOT: {
+
+            if (node->sons.empty()) {
+                minic_log(LOG_ERROR, "逻辑非运算需要一个操作数");
+                return false;
+            }
+
+            // 交换真假出口即可
+            ast_node* operandNode = node->sons[0];
+            if (!generateConditionCode(operandNode, falseLabel, trueLabel)) {
+                return false;
+            }
+
+            node->blockInsts.addInst(operandNode->blockInsts);
+            return true;
+        }
+
+        default:
+            break;
+    }
+
+    // 其它表达式先求值再跳转
+    if (!ir_visit_ast_node(node) || !node->val) {
         return false;
     }
-    
-    // 创建标签
-    LabelInstruction* secondOpLabel = new LabelInstruction(func);
-    LabelInstruction* falseLabel = new LabelInstruction(func);
-    LabelInstruction* endLabel = new LabelInstruction(func);
-    
-    // 为结果创建临时变量
-    LocalVariable* result = static_cast<LocalVariable*>(module->newVarValue(IntegerType::getTypeInt()));
-    if (!result) return false;
-    
-    // 生成左操作数代码
-    ast_node* leftNode = ir_visit_ast_node(node->sons[0]);
-    if (!leftNode || !leftNode->val) return false;
-    
-    // 添加左操作数指令
-    node->blockInsts.addInst(leftNode->blockInsts);
-    
-    // 将左操作数转换为布尔值
-    Value* leftBool;
-    if (!int_to_bool(leftNode->val, &leftBool)) return false;
-    
-    // 添加布尔转换指令
-    if (func->getExtraData().boolCheckInst) {
-        node->blockInsts.addInst(func->getExtraData().boolCheckInst);
-        if (func->getExtraData().moveInst) {
-            node->blockInsts.addInst(func->getExtraData().moveInst);
-        }
-        func->getExtraData().boolCheckInst = nullptr;
-        func->getExtraData().moveInst = nullptr;
+
+    Value* condVal = node->val;
+
+    // 常量条件直接跳转
+    Instanceof(constVal, ConstInt *, condVal);
+    if (constVal) {
+        node->blockInsts.addInst(new (func) GotoInstruction(func, constVal->getVal() ? trueLabel : falseLabel));
+        return true;
     }
-    
-    // 条件跳转：如果leftBool为真，转到secondOpLabel，否则转到falseLabel
-    node->blockInsts.addInst(new GotoInstruction(func, leftBool, secondOpLabel, falseLabel));
-    
-    // 第二个操作数标签
-    node->blockInsts.addInst(secondOpLabel);
-    
-    // 生成右操作数代码
-    ast_node* rightNode = ir_visit_ast_node(node->sons[1]);
-    if (!rightNode || !rightNode->val) return false;
-    
-    // 添加右操作数指令
-    node->blockInsts.addInst(rightNode->blockInsts);
-    
-    // 右操作数结果存入result
-    node->blockInsts.addInst(new MoveInstruction(func, result, rightNode->val));
-    
-    // 跳转到结束
-    node->blockInsts.addInst(new GotoInstruction(func, endLabel));
-    
-    // 处理短路情况（左操作数为假）
-    node->blockInsts.addInst(falseLabel);
-    node->blockInsts.addInst(new MoveInstruction(func, result, module->newConstInt(0)));
-    
-    // 结束标签
-    node->blockInsts.addInst(endLabel);
-    
-    // 设置节点的值
-    node->val = result;
+
+    // 整数值与0比较得到布尔值，关系运算的结果已经是布尔值
+    if (!condVal->getType()->isInt1Byte()) {
+        BinaryInstruction* neZeroInst = new (func) BinaryInstruction(func,
+                                                                     IRInstOperator::IRINST_OP_NE_I,
+                                                                     condVal,
+                                                                     module->newConstInt(0),
+                                                                     IntegerType::getTypeBool());
+        node->blockInsts.addInst(neZeroInst);
+        condVal = neZeroInst;
+    }
+
+    node->blockInsts.addInst(new (func) GotoInstruction(func, condVal, trueLabel, falseLabel));
     return true;
 }
 
-// 逻辑或 ||，带短路求值
-bool IRGenerator::ir_logic_or(ast_node* node)
+/// @brief 逻辑与、逻辑或需要整数值时，在跳转代码的真假出口分别赋值1和0
+/// @param node 逻辑与、逻辑或的AST节点
+/// @return 翻译是否成功，true：成功，false：失败
+bool IRGenerator::ir_logic_value(ast_node* node)
 {
     if (!module) return false;
     Function* func = module->getCurrentFunction();
     if (!func) return false;
-    
-    // 检查子节点数量
-    if (node->sons.size() < 2) {
-        minic_log(LOG_ERROR, "逻辑或运算需要两个操作数");
-        return false;
-    }
-    
+
     // 创建标签
-    LabelInstruction* secondOpLabel = new LabelInstruction(func);
-    LabelInstruction* trueLabel = new LabelInstruction(func);
-    LabelInstruction* endLabel = new LabelInstruction(func);
-    
+    LabelInstruction* trueLabel = new (func) LabelInstruction(func);
+    LabelInstruction* falseLabel = new (func) LabelInstruction(func);
+    LabelInstruction* endLabel = new (func) LabelInstruction(func);
+
     // 为结果创建临时变量
     LocalVariable* result = static_cast<LocalVariable*>(module->newVarValue(IntegerType::getTypeInt()));
     if (!result) return false;
-    
-    // 生成左操作数代码
-    ast_node* leftNode = ir_visit_ast_node(node->sons[0]);
-    if (!leftNode || !leftNode->val) return false;
-    
-    // 添加左操作数指令
-    node->blockInsts.addInst(leftNode->blockInsts);
-    
-    // 将左操作数转换为布尔值
-    Value* leftBool;
-    if (!int_to_bool(leftNode->val, &leftBool)) return false;
-    
-    // 添加布尔转换指令
-    if (func->getExtraData().boolCheckInst) {
-        node->blockInsts.addInst(func->getExtraData().boolCheckInst);
-        if (func->getExtraData().moveInst) {
-            node->blockInsts.addInst(func->getExtraData().moveInst);
-        }
-        func->getExtraData().boolCheckInst = nullptr;
-        func->getExtraData().moveInst = nullptr;
+
+    if (!generateConditionCode(node, trueLabel, falseLabel)) {
+        return false;
     }
-    
-    // 条件跳转：如果leftBool为真，转到trueLabel，否则转到secondOpLabel
-    node->blockInsts.addInst(new GotoInstruction(func, leftBool, trueLabel, secondOpLabel));
-    
-    // 第二个操作数标签
-    node->blockInsts.addInst(secondOpLabel);
-    
-    // 生成右操作数代码
-    ast_node* rightNode = ir_visit_ast_node(node->sons[1]);
-    if (!rightNode || !rightNode->val) return false;
-    
-    // 添加右操作数指令
-    node->blockInsts.addInst(rightNode->blockInsts);
-    
-    // 右操作数结果存入result
-    node->blockInsts.addInst(new MoveInstruction(func, result, rightNode->val));
-    
-    // 跳转到结束
-    node->blockInsts.addInst(new GotoInstruction(func, endLabel));
-    
-    // 处理短路情况（左操作数为真）
+
+    // 条件为真
     node->blockInsts.addInst(trueLabel);
-    node->blockInsts.addInst(new MoveInstruction(func, result, module->newConstInt(1)));
-    
+    node->blockInsts.addInst(new (func) MoveInstruction(func, result, module->newConstInt(1)));
+    node->blockInsts.addInst(new (func) GotoInstruction(func, endLabel));
+
+    // 条件为假
+    node->blockInsts.addInst(falseLabel);
+    node->blockInsts.addInst(new (func) MoveInstruction(func, result, module->newConstInt(0)));
+
     // 结束标签
     node->blockInsts.addInst(endLabel);
-    
+
     // 设置节点的值
     node->val = result;
     return true;
 }
 
+// 逻辑与 &&，带短路求值
+bool IRGenerator::ir_logic_and(ast_node* node)
+{
+    return ir_logic_value(node);
+}
+
+// 逻辑或 ||，带短路求值
+bool IRGenerator::ir_logic_or(ast_node* node)
+{
+    return ir_logic_value(node);
+}
+
 // 逻辑非 !
 bool IRGenerator::ir_logic_not(ast_node* node)
 {
     if (!module) return false;
     Function* func = module->getCurrentFunction();
     if (!func) return false;
-    
+
     // 检查子节点数量
     if (node->sons.empty()) {
         minic_log(LOG_ERROR, "逻辑非运算需要一个操作数");
         return false;
     }
-    
+
     // 生成操作数代码
     ast_node* operandNode = ir_visit_ast_node(node->sons[0]);
     if (!operandNode || !operandNode->val) return false;
-    
+
     // 添加操作数指令
     node->blockInsts.addInst(operandNode->blockInsts);
-    
-    // 为结果创建临时变量
-    LocalVariable* result = static_cast<LocalVariable*>(module->newVarValue(IntegerType::getTypeInt()));
-    if (!result) return false;
-    
+
     // 创建比较指令：检查整数值是否等于0
-    BinaryInstruction* eqZeroInst = new BinaryInstruction(func, 
-                                        IRInstOperator::IRINST_OP_EQ_I, 
-                                        operandNode->val, 
-                                        module->newConstInt(0), 
+    BinaryInstruction* eqZeroInst = new (func) BinaryInstruction(func,
+                                        IRInstOperator::IRINST_OP_EQ_I,
+                                        operandNode->val,
+                                        module->newConstInt(0),
                                         IntegerType::getTypeBool());
-    
+
     // 添加比较指令
     node->blockInsts.addInst(eqZeroInst);
-    
-    // 将比较结果移到临时变量中
-    node->blockInsts.addInst(new MoveInstruction(func, result, eqZeroInst));
-    
-    // 设置节点的值
-    node->val = result;
+
+    // 比较结果直接作为表达式的值
+    node->val = eqZeroInst;
     return true;
 }
 
@@ -1338,22 +1294,16 @@ bool IRGenerator::ir_if(ast_node* node)
     if (!func) return false;
     
     // 创建标签
-    LabelInstruction* thenLabel = new LabelInstruction(func);
-    LabelInstruction* endLabel = new LabelInstruction(func);
+    LabelInstruction* thenLabel = new (func) LabelInstruction(func);
+    LabelInstruction* endLabel = new (func) LabelInstruction(func);
     
-    // 生成条件表达式代码
-    ast_node* cond_node = ir_visit_ast_node(node->sons[0]);
-    if (!cond_node) return false;
-    
-    Value* condVal = cond_node->val;
-    if (!condVal) return false;
+    // 生成条件表达式的跳转代码
+    ast_node* cond_node = node->sons[0];
+    if (!generateConditionCode(cond_node, thenLabel, endLabel)) return false;
     
     // 添加条件表达式生成的指令到指令流
     node->blockInsts.addInst(cond_node->blockInsts);
     
-    // 直接使用条件值，不再转换为"不等于0"形式
-    node->blockInsts.addInst(new GotoInstruction(func, condVal, thenLabel, endLabel));
-    
     // 生成then部分代码
     node->blockInsts.addInst(thenLabel);
     ast_node* then_node = ir_visit_ast_node(node->sons[1]);
@@ -1373,23 +1323,17 @@ bool IRGenerator::ir_if_else(ast_node* node)
     if (!func) return false;
     
     // 创建标签
-    LabelInstruction* thenLabel = new LabelInstruction(func);
-    LabelInstruction* elseLabel = new LabelInstruction(func);
-    LabelInstruction* endLabel = new LabelInstruction(func);
+    LabelInstruction* thenLabel = new (func) LabelInstruction(func);
+    LabelInstruction* elseLabel = new (func) LabelInstruction(func);
+    LabelInstruction* endLabel = new (func) LabelInstruction(func);
     
-    // 生成条件表达式代码
-    ast_node* cond_node = ir_visit_ast_node(node->sons[0]);
-    if (!cond_node) return false;
-    
-    Value* condVal = cond_node->val;
-    if (!condVal) return false;
+    // 生成条件表达式的跳转代码
+    ast_node* cond_node = node->sons[0];
+    if (!generateConditionCode(cond_node, thenLabel, elseLabel)) return false;
     
     // 添加条件表达式生成的指令到指令流
     node->blockInsts.addInst(cond_node->blockInsts);
     
-    // 直接使用条件值
-    node->blockInsts.addInst(new GotoInstruction(func, condVal, thenLabel, elseLabel));
-    
     // 生成then部分代码
     node->blockInsts.addInst(thenLabel);
     ast_node* then_node = ir_visit_ast_node(node->sons[1]);
@@ -1397,7 +1341,7 @@ bool IRGenerator::ir_if_else(ast_node* node)
     node->blockInsts.addInst(then_node->blockInsts);
     
     // then部分执行完后跳转到结束
-    node->blockInsts.addInst(new GotoInstruction(func, endLabel));
+    node->blockInsts.addInst(new (func) GotoInstruction(func, endLabel));
     
     // 生成else部分代码
     node->blockInsts.addInst(elseLabel);
@@ -1418,9 +1362,9 @@ bool IRGenerator::ir_while(ast_node* node)
     if (!func) return false;
     
     // 创建标签
-    LabelInstruction* condLabel = new LabelInstruction(func);   // 循环的入口label
-    LabelInstruction* bodyLabel = new LabelInstruction(func);   // 循环体的入口label
-    LabelInstruction* endLabel = new LabelInstruction(func);    // 循环的出口label
+    LabelInstruction* condLabel = new (func) LabelInstruction(func);   // 循环的入口label
+    LabelInstruction* bodyLabel = new (func) LabelInstruction(func);   // 循环体的入口label
+    LabelInstruction* endLabel = new (func) LabelInstruction(func);    // 循环的出口label
     
     // 进入循环前，保存当前break和continue标签
     Instruction* oldBreakLabel = func->getBreakLabel();
@@ -1433,19 +1377,13 @@ bool IRGenerator::ir_while(ast_node* node)
     // 从循环条件开始
     node->blockInsts.addInst(condLabel);
     
-    // 生成条件表达式代码
-    ast_node* cond_node = ir_visit_ast_node(node->sons[0]);
-    if (!cond_node) return false;
-    
-    Value* condVal = cond_node->val;
-    if (!condVal) return false;
+    // 生成条件表达式的跳转代码
+    ast_node* cond_node = node->sons[0];
+    if (!generateConditionCode(cond_node, bodyLabel, endLabel)) return false;
     
     // 添加条件表达式生成的指令到指令流
     node->blockInsts.addInst(cond_node->blockInsts);
     
-    // 直接使用条件值
-    node->blockInsts.addInst(new GotoInstruction(func, condVal, bodyLabel, endLabel));
-    
     // 生成循环体代码
     node->blockInsts.addInst(bodyLabel);
     ast_node* body_node = ir_visit_ast_node(node->sons[1]);
@@ -1453,7 +1391,7 @@ bool IRGenerator::ir_while(ast_node* node)
     node->blockInsts.addInst(body_node->blockInsts);
     
     // 循环体执行完后跳回条件判断
-    node->blockInsts.addInst(new GotoInstruction(func, condLabel));
+    node->blockInsts.addInst(new (func) GotoInstruction(func, condLabel));
     
     // 循环结束标签
     node->blockInsts.addInst(endLabel);
@@ -1480,7 +1418,7 @@ bool IRGenerator::ir_break(ast_node* node)
     }
     
     // 生成跳转到break标签的指令
-    node->blockInsts.addInst(new GotoInstruction(func, breakLabel));
+    node->blockInsts.addInst(new (func) GotoInstruction(func, breakLabel));
     
     return true;
 }
@@ -1500,7 +1438,7 @@ bool IRGenerator::ir_continue(ast_node* node)
     }
     
     // 生成跳转到continue标签的指令
-    node->blockInsts.addInst(new GotoInstruction(func, continueLabel));
+    node->blockInsts.addInst(new (func) GotoInstruction(func, continueLabel));
     
     return true;
 }
@@ -1533,7 +1471,7 @@ bool IRGenerator::int_to_bool(Value* val, Value** bool_val)
     if (!zeroConst) return false;
     
     // 创建比较指令：检查整数值是否不等于0
-    BinaryInstruction* boolCheck = new BinaryInstruction(func, 
+    BinaryInstruction* boolCheck = new (func) BinaryInstruction(func, 
                                         IRInstOperator::IRINST_OP_NE_I, 
                                         val, 
                                         zeroConst, 
@@ -1541,7 +1479,7 @@ bool IRGenerator::int_to_bool(Value* val, Value** bool_val)
     if (!boolCheck) return false;
     
     // 创建移动指令：将比较结果移到临时变量
-    MoveInstruction* moveInst = new MoveInstruction(func, result, boolCheck);
+    MoveInstruction* moveInst = new (func) MoveInstruction(func, result, boolCheck);
     if (!moveInst) {
         delete boolCheck; // 避免内存泄漏
         return false;
@@ -1593,7 +1531,8 @@ bool IRGenerator::ir_assign(ast_node * node)
 
     // 这里只处理整型的数据，如需支持实数，则需要针对类型进行处理
 
-    MoveInstruction * movInst = new MoveInstruction(module->getCurrentFunction(), left->val, right->val);
+    Function * currentFunc = module->getCurrentFunction();
+    MoveInstruction * movInst = new (currentFunc) MoveInstruction(currentFunc, left->val, right->val);
 
     // 创建临时变量保存IR的值，以及线性IR指令
     node->blockInsts.addInst(right->blockInsts);
@@ -1637,7 +1576,8 @@ bool IRGenerator::ir_return(ast_node * node)
         node->blockInsts.addInst(right->blockInsts);
 
         // 返回值赋值到函数返回值变量上，然后跳转到函数的尾部
-        node->blockInsts.addInst(new MoveInstruction(currentFunc, currentFunc->getReturnValue(), right->val));
+        node->blockInsts.addInst(
+            new (currentFunc) MoveInstruction(currentFunc, currentFunc->getReturnValue(), right->val));
 
         node->val = right->val;
     } else {
@@ -1646,7 +1586,7 @@ bool IRGenerator::ir_return(ast_node * node)
     }
 
     // 跳转到函数的尾部出口指令上
-    node->blockInsts.addInst(new GotoInstruction(currentFunc, currentFunc->getExitLabel()));
+    node->blockInsts.addInst(new (currentFunc) GotoInstruction(currentFunc, currentFunc->getExitLabel()));
 
     return true;
 }
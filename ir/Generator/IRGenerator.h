@@ -16,7 +16,7 @@
 ///
 #pragma once
 
-#include <unordered_map>
+#include <array>
 
 #include "AST.h"
 #include "Module.h"
@@ -121,8 +121,10 @@ protected:
 	bool ir_continue(ast_node* node);
 
 	/// 辅助函数
-	/// 生成条件跳转代码
-	Value* generateConditionCode(ast_node* node, Instruction* trueLabel, Instruction* falseLabel);
+	/// 生成条件跳转代码，逻辑运算不产生值，条件为真跳转到trueLabel，否则跳转到falseLabel
+	bool generateConditionCode(ast_node* node, Instruction* trueLabel, Instruction* falseLabel);
+	/// 逻辑与、逻辑或需要整数值时由跳转代码产生0/1
+	bool ir_logic_value(ast_node* node);
 	/// 整数转布尔值
 	bool int_to_bool(Value* val, Value** bool_val);
 	/// 布尔值转整数
@@ -181,8 +183,11 @@ protected:
     /// @brief AST的节点操作函数
     typedef bool (IRGenerator::*ast2ir_handler_t)(ast_node *);
 
-    /// @brief AST节点运算符与动作函数关联的映射表
-    std::unordered_map<ast_operator_type, ast2ir_handler_t> ast2ir_handlers;
+    /// @brief AST节点运算符的个数，即动作函数表的大小
+    static constexpr std::size_t AST_OP_COUNT = (std::size_t) ast_operator_type::AST_OP_MAX;
+
+    /// @brief AST节点运算符与动作函数关联的表，以运算符为下标，编译期构造
+    static const std::array<ast2ir_handler_t, AST_OP_COUNT> ast2ir_handlers;
 
 private:
     /// @brief 抽象语法树的根
@@ -60,20 +60,31 @@ class GlobalValue : public Constant {
 public:
     ///
     /// @brief 构造函数
+    /// @param _kind  具体类别
     /// @param _type  类型
     /// @param _name  全局符号名
     ///
-    GlobalValue(Type * _type, std::string _name) : Constant(_type)
+    GlobalValue(ValueKind _kind, Type * _type, std::string _name) : Constant(_kind, _type)
     {
-        this->name = _name;
-        this->IRName = IR_GLOBAL_VARNAME_PREFIX + this->name;
+        setName(_name);
+        setIRName(IR_GLOBAL_VARNAME_PREFIX + _name);
+    }
+
+    ///
+    /// @brief 是否是全局对象，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * v)
+    {
+        return v->getValueKind() >= FirstGlobalVal && v->getValueKind() <= LastGlobalVal;
     }
 
     /// @brief 获取名字
     /// @return 变量名
     [[nodiscard]] std::string getIRName() const override
     {
-        return IRName;
+        return Value::getIRName();
     }
 
     ///
@@ -23,9 +23,20 @@
 /// @param result
 /// @param srcVal1
 /// @param srcVal2
-Instruction::Instruction(Function * _func, IRInstOperator _op, Type * _type) : User(_type), op(_op), func(_func)
+/// @param _kind 指令的具体类别
+Instruction::Instruction(Function * _func, IRInstOperator _op, Type * _type, ValueKind _kind)
+    : User(_kind, _type, &_func->getArena()), op(_op), func(_func)
 {}
 
+/// @brief 在函数的内存区中分配指令
+/// @param size 字节数
+/// @param func 指令所属的函数
+/// @return void* 内存地址
+void * Instruction::operator new(std::size_t size, Function * func)
+{
+    return func->getArena().allocate(size);
+}
+
 /// @brief 获取指令操作码
 /// @return 指令操作码
 IRInstOperator Instruction::getOp()
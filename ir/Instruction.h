@@ -79,19 +79,45 @@ enum class IRInstOperator : std::int8_t {
 };
 
 ///
-/// @brief IR指令的基类, 指令自带值，也就是常说的临时变量
+/// @brief IR指令的基类, 指令自带值，也就是常说的临时变量。
+/// 指令在所属函数的内存区中创建，即new (func) XxxInstruction(func, ...)，随函数一起释放
 ///
-class Instruction : public User {
+class Instruction : public User, public ArenaObject {
 
 public:
     /// @brief 构造函数
     /// @param op
     /// @param result
-    explicit Instruction(Function * _func, IRInstOperator op, Type * _type);
+    /// @param _kind 指令的具体类别
+    Instruction(Function * _func, IRInstOperator op, Type * _type, ValueKind _kind);
+
+    ///
+    /// @brief 是否是指令，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * v)
+    {
+        return v->getValueKind() >= FirstInstVal && v->getValueKind() <= LastInstVal;
+    }
 
     /// @brief 析构函数
     virtual ~Instruction() = default;
 
+    ///
+    /// @brief 在函数的内存区中分配指令
+    /// @param size 字节数
+    /// @param func 指令所属的函数
+    /// @return void* 内存地址
+    ///
+    static void * operator new(std::size_t size, Function * func);
+
+    /// @brief 构造函数抛出异常时调用，内存随内存区一起释放
+    static void operator delete(void *, Function *) noexcept
+    {}
+
+    using ArenaObject::operator delete;
+
     /// @brief 获取指令操作码
     /// @return 指令操作码
     IRInstOperator getOp();
@@ -122,73 +148,6 @@ public:
     ///
     bool hasResultValue();
 
-    ///
-    /// @brief 获得分配的寄存器编号或ID
-    /// @return int32_t 寄存器编号
-    ///
-    int32_t getRegId() override
-    {
-        return regId;
-    }
-
-    ///
-    /// @brief @brief 如是内存变量型Value，则获取基址寄存器和偏移
-    /// @param regId 寄存器编号
-    /// @param offset 相对偏移
-    /// @return true 是内存型变量
-    /// @return false 不是内存型变量
-    ///
-    bool getMemoryAddr(int32_t * _regId = nullptr, int64_t * _offset = nullptr) override
-    {
-        // 内存寻址时，必须要指定基址寄存器
-
-        // 没有指定基址寄存器则返回false
-        if (this->baseRegNo == -1) {
-            return false;
-        }
-
-        // 设置基址寄存器
-        if (_regId) {
-            *_regId = this->baseRegNo;
-        }
-
-        // 设置偏移
-        if (_offset) {
-            *_offset = this->offset;
-        }
-
-        return true;
-    }
-
-    ///
-    /// @brief 设置内存寻址的基址寄存器和偏移
-    /// @param _regId 基址寄存器编号
-    /// @param _offset 偏移
-    ///
-    void setMemoryAddr(int32_t _regId, int64_t _offset)
-    {
-        baseRegNo = _regId;
-        offset = _offset;
-    }
-
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
-    ///
-    int32_t getLoadRegId() override
-    {
-        return this->loadRegNo;
-    }
-
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
-    ///
-    void setLoadRegId(int32_t regId) override
-    {
-        this->loadRegNo = regId;
-    }
-
 protected:
     ///
     /// @brief IR指令操作码
@@ -204,29 +163,4 @@ protected:
     /// @brief 当前指令属于哪个函数
     ///
     Function * func = nullptr;
-
-    ///
-    /// @brief 寄存器编号，-1表示没有分配寄存器，大于等于0代表是寄存器型Value
-    ///
-    int32_t regId = -1;
-
-    ///
-    /// @brief 变量在栈内的偏移量，对于全局变量默认为0，临时变量没有意义
-    ///
-    int32_t offset = 0;
-
-    ///
-    /// @brief 栈内寻找时基址寄存器编号
-    ///
-    int32_t baseRegNo = -1;
-
-    ///
-    /// @brief 栈内寻找时基址寄存器名字
-    ///
-    std::string baseRegName;
-
-    ///
-    /// @brief 变量加载到寄存器中时对应的寄存器编号
-    ///
-    int32_t loadRegNo = -1;
 };
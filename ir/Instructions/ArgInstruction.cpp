@@ -21,7 +21,7 @@
 /// @brief 函数实参指令
 /// @param target 跳转目标
 ArgInstruction::ArgInstruction(Function * _func, Value * src)
-    : Instruction(_func, IRInstOperator::IRINST_OP_ARG, VoidType::getType())
+    : Instruction(_func, IRInstOperator::IRINST_OP_ARG, VoidType::getType(), ArgInstVal)
 {
     this->addOperand(src);
 }
@@ -28,6 +28,16 @@ public:
     /// @param src 实参结果变量
     ArgInstruction(Function * _func, Value * src);
 
+    ///
+    /// @brief 是否是实参指令，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * v)
+    {
+        return v->getValueKind() == ArgInstVal;
+    }
+
     /// @brief 转换成字符串
     void toString(std::string & str) override;
 };
@@ -26,7 +26,7 @@ BinaryInstruction::BinaryInstruction(Function * _func,
                                      Value * _srcVal1,
                                      Value * _srcVal2,
                                      Type * _type)
-    : Instruction(_func, _op, _type)
+    : Instruction(_func, _op, _type, BinaryInstVal)
 {
     // addOperand(_srcVal1);
     // addOperand(_srcVal2);
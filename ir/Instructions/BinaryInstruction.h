@@ -23,6 +23,12 @@
 ///
 class BinaryInstruction : public Instruction {
 
+public:
+    ///
+    /// @brief 被除数是否一定非负，由值范围分析设置。除数为2的幂时后端可用移位与按位与代替除法
+    ///
+    bool nonNegativeDividend = false;
+
 public:
     /// @brief 构造函数
     /// @param _op 操作符
@@ -31,6 +37,16 @@ public:
     /// @param _srcVal2 源操作数2
     BinaryInstruction(Function * _func, IRInstOperator _op, Value * _srcVal1, Value * _srcVal2, Type * _type);
 
+    ///
+    /// @brief 是否是二元运算指令，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * v)
+    {
+        return v->getValueKind() == BinaryInstVal;
+    }
+
     /// @brief 转换成字符串
     void toString(std::string & str) override;
 };
@@ -18,7 +18,7 @@
 
 /// @brief return语句指令
 EntryInstruction::EntryInstruction(Function * _func)
-    : Instruction(_func, IRInstOperator::IRINST_OP_ENTRY, VoidType::getType())
+    : Instruction(_func, IRInstOperator::IRINST_OP_ENTRY, VoidType::getType(), EntryInstVal)
 {}
 
 /// @brief 转换成字符串
@@ -29,6 +29,16 @@ public:
     ///
     EntryInstruction(Function * _func);
 
+    ///
+    /// @brief 是否是入口指令，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * v)
+    {
+        return v->getValueKind() == EntryInstVal;
+    }
+
     ///
     /// @brief 转换成IR指令字符串
     ///
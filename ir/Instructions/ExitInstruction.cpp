@@ -21,7 +21,7 @@
 /// @brief return语句指令
 /// @param _result 返回结果值
 ExitInstruction::ExitInstruction(Function * _func, Value * _result)
-    : Instruction(_func, IRInstOperator::IRINST_OP_EXIT, VoidType::getType())
+    : Instruction(_func, IRInstOperator::IRINST_OP_EXIT, VoidType::getType(), ExitInstVal)
 {
     if (_result != nullptr) {
         addOperand(_result);
@@ -30,6 +30,16 @@ public:
     /// @param result 函数的返回值
     ExitInstruction(Function * _func, Value * result = nullptr);
 
+    ///
+    /// @brief 是否是出口指令，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * v)
+    {
+        return v->getValueKind() == ExitInstVal;
+    }
+
     /// @brief 转换成字符串
     void toString(std::string & str) override;
 };
@@ -25,9 +25,9 @@ FuncCallInstruction::FuncCallInstruction(Function * _func,
                                          Function * calledFunc,
                                          std::vector<Value *> & _srcVal,
                                          Type * _type)
-    : Instruction(_func, IRInstOperator::IRINST_OP_FUNC_CALL, _type), calledFunction(calledFunc)
+    : Instruction(_func, IRInstOperator::IRINST_OP_FUNC_CALL, _type, FuncCallInstVal), calledFunction(calledFunc)
 {
-    name = calledFunc->getName();
+    setName(calledFunc->getName());
 
     // 实参拷贝
     for (auto & val: _srcVal) {
@@ -34,12 +34,27 @@ public:
     ///
     Function * calledFunction = nullptr;
 
+    ///
+    /// @brief 是否作为尾调用翻译，由后端在栈帧拆除后用b跳转到被调用函数
+    ///
+    bool tailCall = false;
+
 public:
     /// @brief 含有参数的函数调用
     /// @param srcVal 函数的实参Value
     /// @param result 保存返回值的Value
     FuncCallInstruction(Function * _func, Function * calledFunc, std::vector<Value *> & _srcVal, Type * _type);
 
+    ///
+    /// @brief 是否是函数调用指令，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * v)
+    {
+        return v->getValueKind() == FuncCallInstVal;
+    }
+
     ///
     /// @brief 转换成IR指令文本
     /// @param str IR指令
@@ -24,7 +24,7 @@
 /// @param target 跳转目标
 ///
 GotoInstruction::GotoInstruction(Function * _func, Instruction * _target)
-    : Instruction(_func, IRInstOperator::IRINST_OP_GOTO, VoidType::getType())
+    : Instruction(_func, IRInstOperator::IRINST_OP_GOTO, VoidType::getType(), GotoInstVal)
 {
     // // 真假目标一样，则无条件跳转
     // target = static_cast<LabelInstruction *>(_target);
@@ -42,7 +42,7 @@ GotoInstruction::GotoInstruction(Function * _func, Instruction * _target)
 ///
 GotoInstruction::GotoInstruction(Function * _func, Value * _condition, 
                                 Instruction * _trueTarget, Instruction * _falseTarget)
-    : Instruction(_func, IRInstOperator::IRINST_OP_GOTO, VoidType::getType())
+    : Instruction(_func, IRInstOperator::IRINST_OP_GOTO, VoidType::getType(), GotoInstVal)
 {
     // 条件分支
     addOperand(_condition); // 添加条件作为操作数
@@ -82,3 +82,24 @@ LabelInstruction * GotoInstruction::getFalseTarget() const
 {
     return falseTarget;
 }
+
+/// @brief 是否是条件跳转指令
+/// @return true 条件跳转 false 无条件跳转
+bool GotoInstruction::isConditionalBranch() const
+{
+    return isConditional;
+}
+
+/// @brief 修改跳转目标Label指令
+/// @param _target 新的跳转目标
+void GotoInstruction::setTarget(LabelInstruction * _target)
+{
+    target = _target;
+}
+
+/// @brief 修改假分支目标Label指令
+/// @param _target 新的假分支目标
+void GotoInstruction::setFalseTarget(LabelInstruction * _target)
+{
+    falseTarget = _target;
+}
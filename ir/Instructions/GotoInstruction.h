@@ -43,6 +43,16 @@ public:
 	GotoInstruction(Function * _func, Value * _condition, 
 					Instruction * _trueTarget, Instruction * _falseTarget);
 
+    ///
+    /// @brief 是否是跳转指令，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * v)
+    {
+        return v->getValueKind() == GotoInstVal;
+    }
+
 	/// @brief 获取假分支目标Label指令
 	[[nodiscard]] LabelInstruction * getFalseTarget() const;
 
@@ -55,6 +65,24 @@ public:
     ///
     [[nodiscard]] LabelInstruction * getTarget() const;
 
+    ///
+    /// @brief 是否是条件跳转指令，条件跳转时第一个操作数为条件值
+    /// @return true 条件跳转 false 无条件跳转
+    ///
+    [[nodiscard]] bool isConditionalBranch() const;
+
+    ///
+    /// @brief 修改跳转目标Label指令，条件跳转时为真分支目标
+    /// @param _target 新的跳转目标
+    ///
+    void setTarget(LabelInstruction * _target);
+
+    ///
+    /// @brief 修改假分支目标Label指令，仅对条件跳转有效
+    /// @param _target 新的假分支目标
+    ///
+    void setFalseTarget(LabelInstruction * _target);
+
 
 private:
     ///
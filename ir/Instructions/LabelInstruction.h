@@ -16,6 +16,7 @@
 ///
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 #include "Instruction.h"
@@ -34,9 +35,24 @@ public:
     ///
     explicit LabelInstruction(Function * _func);
 
+    ///
+    /// @brief 是否是Label指令，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * v)
+    {
+        return v->getValueKind() == LabelInstVal;
+    }
+
     ///
     /// @brief 转换成字符串
     /// @param str 返回指令字符串
     ///
     void toString(std::string & str) override;
+
+    ///
+    /// @brief 剖面数据中Label开始的基本块的执行次数，-1表示没有剖面数据
+    ///
+    int64_t profileCount = -1;
 };
@@ -37,6 +37,16 @@ public:
     ///
     MoveInstruction(Function * _func, Value * result, Value * srcVal1);
 
+    ///
+    /// @brief 是否是赋值指令，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * v)
+    {
+        return v->getValueKind() == MoveInstVal;
+    }
+
     /// @brief 转换成字符串
     void toString(std::string & str) override;
 };
@@ -19,7 +19,7 @@
 
 #include <string>
 
-#define Instanceof(res, type, var) auto res = dynamic_cast<type>(var)
+#include "Casting.h"
 
 class Type {
 
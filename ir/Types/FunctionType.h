@@ -29,9 +29,20 @@ public:
     /// @param retType 函数返回值类型
     /// @param argTypes 函数形参类型
     ///
-    FunctionType(Type * _retType, std::vector<Type *> _argTypes) : retType{_retType}, argTypes{std::move(_argTypes)}
+    FunctionType(Type * _retType, std::vector<Type *> _argTypes)
+        : Type(FunctionTyID), retType{_retType}, argTypes{std::move(_argTypes)}
     {}
 
+    ///
+    /// @brief 是否是函数类型，供isa/cast/dyn_cast使用
+    /// @param t 类型
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Type * t)
+    {
+        return t->getTypeID() == FunctionTyID;
+    }
+
     ///
     /// @brief 函数类型的IR字符串
     /// @return std::string
@@ -36,6 +36,16 @@ public:
     ///
     static IntegerType * getTypeInt();
 
+    ///
+    /// @brief 是否是整数类型，供isa/cast/dyn_cast使用
+    /// @param t 类型
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Type * t)
+    {
+        return t->getTypeID() == IntegerTyID;
+    }
+
     ///
     /// @brief 获取类型的IR标识符
     /// @return std::string IR标识符void
@@ -78,6 +78,16 @@ public:
         }
     }
 
+    ///
+    /// @brief 是否是指针类型，供isa/cast/dyn_cast使用
+    /// @param t 类型
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Type * t)
+    {
+        return t->getTypeID() == PointerTyID;
+    }
+
     ///
     /// @brief 返回根类型，也就是连续解引用后的类型
     /// @return const Type*
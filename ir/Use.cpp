@@ -18,6 +18,52 @@
 #include "Use.h"
 #include "User.h"
 
+///
+/// @brief 移动构造，User的操作数存储扩容时Use对象被移动，新对象接替原对象在链表中的位置
+/// @param other 原对象
+///
+Use::Use(Use && other) noexcept : usee(other.usee), user(other.user), prev(other.prev), next(other.next)
+{
+    if (usee) {
+        usee->relinkUse(&other, this);
+    }
+
+    other.usee = nullptr;
+    other.prev = nullptr;
+    other.next = nullptr;
+}
+
+///
+/// @brief 移动赋值，删除操作数时后面的Use前移，本对象原来的边先取消
+/// @param other 原对象
+/// @return Use& 本对象
+///
+Use & Use::operator=(Use && other) noexcept
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    if (usee) {
+        usee->removeUse(this);
+    }
+
+    usee = other.usee;
+    user = other.user;
+    prev = other.prev;
+    next = other.next;
+
+    if (usee) {
+        usee->relinkUse(&other, this);
+    }
+
+    other.usee = nullptr;
+    other.prev = nullptr;
+    other.next = nullptr;
+
+    return *this;
+}
+
 ///
 /// @brief 不再使用Use原来的Value，更新为新的Value，导致删除原来的边，新加一条边
 /// @param newVal 新的Value
@@ -31,10 +77,11 @@ void Use::setUsee(Value * newVal)
 
 ///
 /// @brief 移除def-use边，需要两头分别清理
-/// ! 请注意该函数并没有删除Use，需要自行清理资源
+/// ! Use对象存放在User的操作数中，删除后本对象不能再访问
 ///
 void Use::remove()
 {
     usee->removeUse(this);
+    usee = nullptr;
     user->removeOperandRaw(this);
-}
\ No newline at end of file
+}
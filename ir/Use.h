@@ -16,8 +16,9 @@
 ///
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <vector>
+#include <iterator>
 
 class User;
 class Value;
@@ -29,11 +30,14 @@ class Value;
 /// Use可以跟踪每个Value的所有使用情况，并且当Value被修改或删除时，可以更新所有引用它的地方
 ///
 /// User和Use之间存在一个双向关系：
-/// User持有一个Use链表(成员uses)，每个Use指向一个Value
-/// Value持有一个User链表(成员uses)，每个User指向一个使用该Value的User对象
+/// User的操作数(成员operands)直接存放Use对象，每个Use指向一个Value
+/// Value持有一个侵入式的Use双向链表(成员firstUse与lastUse)，链表的结点就是User中的Use对象，
+/// 增加或删除一条边都是O(1)的
 ///
 class Use {
 
+    friend class Value;
+
 protected:
     ///
     /// @brief 指向要使用的value
@@ -45,6 +49,16 @@ protected:
     ///
     User * user = nullptr;
 
+    ///
+    /// @brief usee的Use链表中的前一条边
+    ///
+    Use * prev = nullptr;
+
+    ///
+    /// @brief usee的Use链表中的后一条边
+    ///
+    Use * next = nullptr;
+
 public:
     /**
      * 构建函数，构建一条define-use的边
@@ -57,6 +71,22 @@ public:
     Use(Value * _value, User * _user) : usee(_value), user(_user)
     {}
 
+    Use(const Use &) = delete;
+    Use & operator=(const Use &) = delete;
+
+    ///
+    /// @brief 移动构造，User的操作数存储扩容时Use对象被移动，新对象接替原对象在链表中的位置
+    /// @param other 原对象
+    ///
+    Use(Use && other) noexcept;
+
+    ///
+    /// @brief 移动赋值，删除操作数时后面的Use前移，本对象原来的边先取消
+    /// @param other 原对象
+    /// @return Use& 本对象
+    ///
+    Use & operator=(Use && other) noexcept;
+
     ///
     /// @brief 获取值
     /// @return Value *
@@ -84,6 +114,15 @@ public:
         return usee;
     }
 
+    ///
+    /// @brief 获取被使用者的下一条边
+    /// @return Use* 下一条边，没有时为空
+    ///
+    [[nodiscard]] Use * getNext() const
+    {
+        return next;
+    }
+
     ///
     /// @brief 不再使用Use原来的Value，更新为新的Value
     /// @param newVal 新的Value
@@ -91,7 +130,108 @@ public:
     void setUsee(Value * newVal);
 
     ///
-    /// @brief def-use边取消，但不会删除该Use
+    /// @brief def-use边取消，并从User的操作数中删除，Use对象随之释放
     ///
     void remove();
-};
\ No newline at end of file
+};
+
+///
+/// @brief Value的所有Use，用于遍历。遍历时预先取得下一条边，
+/// 因此循环体内可以修改或删除当前的Use，但不能修改其它的Use
+///
+class UseList {
+
+public:
+    class iterator {
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Use *;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Use **;
+        using reference = Use *;
+
+        explicit iterator(Use * _cur) : cur(_cur), nxt(_cur ? _cur->getNext() : nullptr)
+        {}
+
+        Use * operator*() const
+        {
+            return cur;
+        }
+
+        iterator & operator++()
+        {
+            cur = nxt;
+            nxt = cur ? cur->getNext() : nullptr;
+            return *this;
+        }
+
+        bool operator==(const iterator & other) const
+        {
+            return cur == other.cur;
+        }
+
+        bool operator!=(const iterator & other) const
+        {
+            return cur != other.cur;
+        }
+
+    private:
+        ///
+        /// @brief 当前的边
+        ///
+        Use * cur;
+
+        ///
+        /// @brief 预先取得的下一条边
+        ///
+        Use * nxt;
+    };
+
+    ///
+    /// @brief 构造函数
+    /// @param _first 第一条边
+    /// @param _size 边数
+    ///
+    UseList(Use * _first, int32_t _size) : first(_first), count(_size)
+    {}
+
+    [[nodiscard]] iterator begin() const
+    {
+        return iterator(first);
+    }
+
+    [[nodiscard]] iterator end() const
+    {
+        return iterator(nullptr);
+    }
+
+    ///
+    /// @brief 是否没有使用
+    /// @return true 没有 false 有
+    ///
+    [[nodiscard]] bool empty() const
+    {
+        return first == nullptr;
+    }
+
+    ///
+    /// @brief 获取使用的个数
+    /// @return size_t 个数
+    ///
+    [[nodiscard]] size_t size() const
+    {
+        return (size_t) count;
+    }
+
+private:
+    ///
+    /// @brief 第一条边
+    ///
+    Use * first;
+
+    ///
+    /// @brief 边数
+    ///
+    int32_t count;
+};
@@ -15,17 +15,25 @@
 /// </table>
 ///
 
-#include <algorithm>
-
 #include "User.h"
 
 ///
 /// @brief 构造函数
+/// @param _kind  具体类别
 /// @param _type  类型
+/// @param _arena 所属函数的内存区，为空时不在内存区中
 ///
-User::User(Type * _type) : Value(_type)
+User::User(ValueKind _kind, Type * _type, Arena * _arena) : Value(_kind, _type, _arena), operands(_arena)
 {}
 
+///
+/// @brief 析构函数，操作数中的Use是各操作数链表中的结点，释放前必须从链表中取消
+///
+User::~User()
+{
+    clearOperands();
+}
+
 ///
 /// @brief 更新指定Pos的Value
 /// @param pos 位置
@@ -34,7 +42,7 @@ User::User(Type * _type) : Value(_type)
 void User::setOperand(int32_t pos, Value * val)
 {
     if (pos < (int32_t) operands.size()) {
-        operands[pos]->setUsee(val);
+        operands[pos].setUsee(val);
     }
 }
 
@@ -50,14 +58,11 @@ void User::addOperand(Value * val)
         return;  // 或者抛出异常、记录错误
     }
 
-    // If not, add the given Value as a new use.
-    auto use = new Use(val, this);
-
-    // 增加到操作数中
-    operands.push_back(use);
+    // 增加到操作数中，扩容时已有的Use移动后仍在各自的链表中
+    operands.emplace_back(val, this);
 
     // 该val被使用
-    val->addUse(use);
+    val->addUse(&operands.back());
 }
 
 ///
@@ -67,10 +72,9 @@ void User::addOperand(Value * val)
 void User::removeOperand(Value * val)
 {
     for (auto & use: operands) {
-        if (use->getUsee() == val) {
+        if (use.getUsee() == val) {
             // 找到了就删除这个Use
-            use->remove();
-            delete use;
+            use.remove();
             break;
         }
     }
@@ -84,25 +88,22 @@ void User::removeOperand(int pos)
 {
     // 检索并清除边，使得边的两头都会自动减少
     if (pos < (int32_t) operands.size()) {
-
-        // 必须先暂存后释放，不能直接delete uses[pos]
-        // 这是因为use->remove会删除operands的元素，使得operands[pos]的对象不再是原来的对象
-        Use * use = operands[pos];
-        use->remove();
-        delete use;
+        operands[pos].remove();
     }
 }
 
 ///
-/// @brief 清除指定的操作数
-/// @param pos 操作数的索引
+/// @brief 直接清除操作数的元素，要求def-use边已经取消
+/// @param use 指定的元素use
 ///
 void User::removeOperandRaw(Use * use)
 {
-    auto pIter = std::find(operands.begin(), operands.end(), use);
-    if (pIter != operands.end()) {
-        operands.erase(pIter);
+    if (operands.empty() || use < &operands.front() || use > &operands.back()) {
+        return;
     }
+
+    // 后面的Use前移，移动赋值会维护各自的链表
+    operands.erase(operands.begin() + (use - operands.data()));
 }
 
 ///
@@ -111,8 +112,7 @@ void User::removeOperandRaw(Use * use)
 ///
 void User::removeUse(Use * use)
 {
-    auto pIter = std::find(operands.begin(), operands.end(), use);
-    if (pIter != operands.end()) {
+    if (!operands.empty() && use >= &operands.front() && use <= &operands.back()) {
         use->remove();
     }
 }
@@ -122,21 +122,31 @@ void User::removeUse(Use * use)
 ///
 void User::clearOperands()
 {
-    for (int32_t pos = 0; pos < (int32_t) operands.size();) {
+    for (auto & use: operands) {
+        use.getUsee()->removeUse(&use);
+    }
 
-        // 必须先暂存后释放，不能直接delete uses[pos]
-        // 这是因为use->remove会删除operands的元素，使得operands[pos]的对象不再是原来的对象
+    operands.clear();
+}
 
-        Use * use = operands[pos];
-        use->remove();
-        delete use;
+///
+/// @brief 函数整体释放前，从不在函数内存区中的操作数（全局变量、常量、形参等）的链表中取消，
+/// 内存区中操作数的链表随内存区一起释放，不需要逐个取消
+///
+void User::dropExternalUses()
+{
+    for (auto & use: operands) {
+        if (!use.getUsee()->isArenaAllocated()) {
+            use.getUsee()->removeUse(&use);
+        }
     }
 }
+
 ///
 /// @brief Get the Operands object
-/// @return std::vector<Use *>&
+/// @return OperandList&
 ///
-std::vector<Use *> & User::getOperands()
+User::OperandList & User::getOperands()
 {
     return operands;
 }
@@ -149,7 +159,7 @@ std::vector<Value *> User::getOperandsValue()
 {
     std::vector<Value *> operandsVec;
     for (auto & use: operands) {
-        operandsVec.emplace_back(use->getUsee());
+        operandsVec.emplace_back(use.getUsee());
     }
     return operandsVec;
 }
@@ -171,7 +181,7 @@ int32_t User::getOperandsNum()
 Value * User::getOperand(int32_t pos)
 {
     if (pos < (int32_t) operands.size()) {
-        return operands[pos]->getUsee();
+        return operands[pos].getUsee();
     }
 
     return nullptr;
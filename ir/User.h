@@ -16,8 +16,7 @@
 ///
 #pragma once
 
-#include <unordered_map>
-#include <list>
+#include <vector>
 
 #include "Value.h"
 #include "Use.h"
@@ -31,24 +30,48 @@
 ///
 class User : public Value {
 
+public:
+    ///
+    /// @brief 操作数列表，指令的操作数与指令在同一个内存区中
+    ///
+    using OperandList = std::vector<Use, ArenaAllocator<Use>>;
+
+private:
     ///
-    /// @brief 操作数列表，指向当前Value的所有操作数
+    /// @brief 操作数列表，直接存放Use对象，每个Use同时是操作数的define-use链表中的结点，
+    /// 扩容或删除时Use对象的移动会维护链表
     ///
-    std::vector<Use *> operands;
+    OperandList operands;
 
 public:
     ///
     /// @brief 构造函数
+    /// @param _kind  具体类别
     /// @param _type  类型
-    /// @param _name  名称
+    /// @param _arena 所属函数的内存区，为空时不在内存区中
+    ///
+    User(ValueKind _kind, Type * _type, Arena * _arena = nullptr);
+
+    ///
+    /// @brief 是否是User，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
     ///
-    User(Type * _type);
+    static bool classof(const Value * v)
+    {
+        return v->getValueKind() >= FirstUserVal && v->getValueKind() <= LastUserVal;
+    }
+
+    ///
+    /// @brief 析构函数，操作数中的Use是各操作数链表中的结点，释放前必须从链表中取消
+    ///
+    ~User() override;
 
     ///
     /// @brief Get the Operands object
-    /// @return std::vector<Use *>&
+    /// @return OperandList&
     ///
-    std::vector<Use *> & getOperands();
+    OperandList & getOperands();
 
     ///
     /// @brief 取得操作数
@@ -96,7 +119,7 @@ public:
     void removeOperand(Value * val);
 
     ///
-    /// @brief 直接清除操作数的元素
+    /// @brief 直接清除操作数的元素，要求def-use边已经取消
     /// @param use 指定的元素use
     ///
     void removeOperandRaw(Use * use);
@@ -111,4 +134,10 @@ public:
     /// @brief 清除所有的操作数
     ///
     void clearOperands();
+
+    ///
+    /// @brief 函数整体释放前，从不在函数内存区中的操作数（全局变量、常量、形参等）的链表中取消，
+    /// 内存区中操作数的链表随内存区一起释放，不需要逐个取消
+    ///
+    void dropExternalUses();
 };
\ No newline at end of file
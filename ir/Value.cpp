@@ -15,14 +15,15 @@
 /// </table>
 ///
 
-#include <algorithm>
-
 #include "Value.h"
 #include "Use.h"
 
 /// @brief 构造函数
+/// @param _kind 具体类别
 /// @param _type
-Value::Value(Type * _type) : type(_type)
+/// @param _arena 所属函数的内存区，名字从中分配，为空时不在内存区中
+Value::Value(ValueKind _kind, Type * _type, Arena * _arena)
+    : name(_arena), IRName(_arena), type(_type), valueKind(_kind)
 {
     // 不需要增加代码
 }
@@ -37,7 +38,7 @@ Value::~Value()
 /// @return 变量名
 std::string Value::getName() const
 {
-    return name;
+    return std::string(name.data(), name.size());
 }
 
 ///
@@ -46,14 +47,14 @@ std::string Value::getName() const
 ///
 void Value::setName(std::string _name)
 {
-    this->name = _name;
+    this->name.assign(_name.data(), _name.size());
 }
 
 /// @brief 获取名字
 /// @return 变量名
 std::string Value::getIRName() const
 {
-    return IRName;
+    return std::string(IRName.data(), IRName.size());
 }
 
 ///
@@ -62,7 +63,7 @@ std::string Value::getIRName() const
 ///
 void Value::setIRName(std::string _name)
 {
-    this->IRName = _name;
+    this->IRName.assign(_name.data(), _name.size());
 }
 
 /// @brief 获取类型
@@ -78,67 +79,110 @@ Type * Value::getType()
 ///
 void Value::addUse(Use * use)
 {
-    uses.push_back(use);
+    use->prev = lastUse;
+    use->next = nullptr;
+
+    if (lastUse) {
+        lastUse->next = use;
+    } else {
+        firstUse = use;
+    }
+
+    lastUse = use;
+    useCount++;
 }
 
 ///
-/// @brief 消除一条边，减少Value被使用次数
+/// @brief 消除一条边，减少Value被使用次数，不在链表中的边忽略
 /// @param use
 ///
 void Value::removeUse(Use * use)
 {
-    auto pIter = std::find(uses.begin(), uses.end(), use);
-    if (pIter != uses.end()) {
-        uses.erase(pIter);
+    if (use->prev == nullptr && firstUse != use) {
+        return;
+    }
+
+    if (use->prev) {
+        use->prev->next = use->next;
+    } else {
+        firstUse = use->next;
+    }
+
+    if (use->next) {
+        use->next->prev = use->prev;
+    } else {
+        lastUse = use->prev;
     }
+
+    use->prev = nullptr;
+    use->next = nullptr;
+    useCount--;
 }
 
 ///
-/// @brief 取得变量所在的作用域层级
-/// @return int32_t 层级
+/// @brief Use对象被移动后，链表中指向原对象的指针改为指向新对象
+/// @param oldUse 原对象
+/// @param newUse 新对象，已经复制了原对象的前后指针
 ///
-int32_t Value::getScopeLevel()
+void Value::relinkUse(Use * oldUse, Use * newUse)
 {
-    return -1;
+    if (newUse->prev) {
+        newUse->prev->next = newUse;
+    } else if (firstUse == oldUse) {
+        firstUse = newUse;
+    }
+
+    if (newUse->next) {
+        newUse->next->prev = newUse;
+    } else if (lastUse == oldUse) {
+        lastUse = newUse;
+    }
 }
 
 ///
-/// @brief 获得分配的寄存器编号或ID
-/// @return int32_t 寄存器编号 -1代表无效的寄存器编号
+/// @brief 获取define-use链，即该Value被使用的所有边
+/// @return UseList 所有边，按照加入的次序
 ///
-int32_t Value::getRegId()
+UseList Value::getUses()
 {
-    return -1;
+    return UseList(firstUse, useCount);
 }
 
 ///
-/// @brief @brief 如是内存变量型Value，则获取基址寄存器和偏移
-/// @param regId 寄存器编号
-/// @param offset 相对偏移
-/// @return true 是内存型变量
-/// @return false 不是内存型变量
+/// @brief 把对该Value的所有使用改为使用newVal，整条链表接到newVal的链表之后，
+/// 时间与被移动的边数成正比
+/// @param newVal 新的Value
 ///
-bool Value::getMemoryAddr(int32_t * regId, int64_t * offset)
+void Value::replaceAllUsesWith(Value * newVal)
 {
-    (void) regId;
-    (void) offset;
-    return false;
+    if (newVal == this || firstUse == nullptr) {
+        return;
+    }
+
+    for (Use * use = firstUse; use; use = use->next) {
+        use->usee = newVal;
+    }
+
+    if (newVal->lastUse) {
+        newVal->lastUse->next = firstUse;
+        firstUse->prev = newVal->lastUse;
+    } else {
+        newVal->firstUse = firstUse;
+    }
+
+    newVal->lastUse = lastUse;
+    newVal->useCount += useCount;
+
+    firstUse = nullptr;
+    lastUse = nullptr;
+    useCount = 0;
 }
 
 ///
-/// @brief 对该Value进行Load用的寄存器编号
-/// @return int32_t 寄存器编号
+/// @brief 取得变量所在的作用域层级
+/// @return int32_t 层级
 ///
-int32_t Value::getLoadRegId()
+int32_t Value::getScopeLevel()
 {
     return -1;
 }
-
-///
-/// @brief 对该Value进行Load用的寄存器编号
-/// @return int32_t 寄存器编号
-///
-void Value::setLoadRegId(int32_t regId)
-{
-    (void) regId;
-}
\ No newline at end of file
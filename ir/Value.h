@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <string>
 
+#include "Arena.h"
 #include "Use.h"
 #include "Type.h"
 
@@ -31,27 +32,110 @@
 ///
 class Value {
 
+    friend class Use;
+
+public:
+    ///
+    /// @brief Value的具体类别，isa/cast/dyn_cast据此判断，不需要RTTI。
+    /// 同一基类的子类连续编号，基类按区间判断
+    ///
+    enum ValueKind {
+        // User的子类，先是常量，然后是指令
+        ConstIntVal,       ///< 整数常量
+        GlobalVariableVal, ///< 全局变量
+        FunctionVal,       ///< 函数
+        BinaryInstVal,     ///< 二元运算与比较指令
+        ArgInstVal,        ///< 实参指令
+        EntryInstVal,      ///< 函数入口指令
+        ExitInstVal,       ///< 函数出口指令
+        FuncCallInstVal,   ///< 函数调用指令
+        GotoInstVal,       ///< 跳转指令
+        LabelInstVal,      ///< Label指令
+        MoveInstVal,       ///< 赋值指令
+
+        // 其它Value
+        FormalParamVal,   ///< 形参
+        LocalVariableVal, ///< 局部变量
+        MemVariableVal,   ///< 内存变量
+        RegVariableVal,   ///< 寄存器
+
+        FirstConstantVal = ConstIntVal,
+        LastConstantVal = FunctionVal,
+        FirstGlobalVal = GlobalVariableVal,
+        LastGlobalVal = FunctionVal,
+        FirstInstVal = BinaryInstVal,
+        LastInstVal = MoveInstVal,
+        FirstUserVal = ConstIntVal,
+        LastUserVal = MoveInstVal,
+    };
+
 protected:
     /// @brief 变量名，函数名等原始的名字，可能为空串
-    std::string name;
+    ArenaString name;
 
     ///
     /// @brief IR名字，用于文本IR的输出
     ///
-    std::string IRName;
+    ArenaString IRName;
 
     /// @brief 类型
     Type * type;
 
     ///
-    /// @brief define-use链，这个定值被使用的所有边，即所有的User
+    /// @brief define-use链的第一条边，链表的结点是User操作数中的Use对象
     ///
-    std::vector<Use *> uses;
+    Use * firstUse = nullptr;
+
+    ///
+    /// @brief define-use链的最后一条边，新的边追加在这里
+    ///
+    Use * lastUse = nullptr;
+
+    ///
+    /// @brief define-use链的边数，即被使用的次数
+    ///
+    int32_t useCount = 0;
+
+    ///
+    /// @brief Value的具体类别
+    ///
+    ValueKind valueKind;
+
+    ///
+    /// @brief 寄存器编号，-1表示没有分配寄存器，大于等于0代表是寄存器型Value
+    ///
+    int32_t regId = -1;
+
+    ///
+    /// @brief 栈内寻址时的基址寄存器编号，-1表示不在栈内
+    ///
+    int32_t baseRegNo = -1;
+
+    ///
+    /// @brief 栈内寻址时相对基址寄存器的偏移
+    ///
+    int64_t offset = 0;
+
+    ///
+    /// @brief 变量加载到寄存器中时对应的寄存器编号
+    ///
+    int32_t loadRegNo = -1;
 
 public:
     /// @brief 构造函数
+    /// @param _kind 具体类别
     /// @param _type
-    explicit Value(Type * _type);
+    /// @param _arena 所属函数的内存区，名字从中分配，为空时不在内存区中
+    Value(ValueKind _kind, Type * _type, Arena * _arena = nullptr);
+
+    ///
+    /// @brief 获取具体类别
+    /// @return ValueKind 类别
+    ///
+    [[nodiscard]] ValueKind getValueKind() const
+    {
+        return valueKind;
+    }
 
     /// @brief 析构函数
     virtual ~Value();
@@ -80,6 +164,15 @@ public:
     /// @return 变量名
     virtual Type * getType();
 
+    ///
+    /// @brief 是否在函数的内存区中创建，即指令与局部变量，随函数一起释放
+    /// @return true 是 false 不是
+    ///
+    [[nodiscard]] bool isArenaAllocated() const
+    {
+        return name.get_allocator().getArena() != nullptr;
+    }
+
     ///
     /// @brief 增加一条边，增加Value被使用次数
     /// @param use
@@ -87,11 +180,24 @@ public:
     void addUse(Use * use);
 
     ///
-    /// @brief 消除一条边，减少Value被使用次数
+    /// @brief 消除一条边，减少Value被使用次数，不在链表中的边忽略
     /// @param use
     ///
     void removeUse(Use * use);
 
+    ///
+    /// @brief 获取define-use链，即该Value被使用的所有边
+    /// @return UseList 所有边，按照加入的次序
+    ///
+    UseList getUses();
+
+    ///
+    /// @brief 把对该Value的所有使用改为使用newVal，整条链表接到newVal的链表之后，
+    /// 时间与被移动的边数成正比
+    /// @param newVal 新的Value
+    ///
+    void replaceAllUsesWith(Value * newVal);
+
     ///
     /// @brief 取得变量所在的作用域层级
     /// @return int32_t 层级
@@ -100,28 +206,80 @@ public:
 
     ///
     /// @brief 获得分配的寄存器编号或ID
-    /// @return int32_t 寄存器编号
+    /// @return int32_t 寄存器编号，-1代表没有分配寄存器
+    ///
+    int32_t getRegId() const
+    {
+        return regId;
+    }
+
+    ///
+    /// @brief 设置寄存器编号
+    /// @param _regId 寄存器编号
     ///
-    virtual int32_t getRegId();
+    void setRegId(int32_t _regId)
+    {
+        regId = _regId;
+    }
 
     ///
-    /// @brief @brief 如是内存变量型Value，则获取基址寄存器和偏移
-    /// @param regId 寄存器编号
-    /// @param offset 相对偏移
+    /// @brief 如是内存变量型Value，则获取基址寄存器和偏移。内存变量总是内存寻址，
+    /// 其它Value在设置了基址寄存器后才是
+    /// @param _regId 寄存器编号
+    /// @param _offset 相对偏移
     /// @return true 是内存型变量
     /// @return false 不是内存型变量
     ///
-    virtual bool getMemoryAddr(int32_t * regId = nullptr, int64_t * offset = nullptr);
+    bool getMemoryAddr(int32_t * _regId = nullptr, int64_t * _offset = nullptr) const
+    {
+        if (baseRegNo == -1 && valueKind != MemVariableVal) {
+            return false;
+        }
+
+        if (_regId) {
+            *_regId = baseRegNo;
+        }
+        if (_offset) {
+            *_offset = offset;
+        }
+
+        return true;
+    }
+
+    ///
+    /// @brief 设置内存寻址的基址寄存器和偏移
+    /// @param _regId 基址寄存器编号
+    /// @param _offset 偏移
+    ///
+    void setMemoryAddr(int32_t _regId, int64_t _offset)
+    {
+        baseRegNo = _regId;
+        offset = _offset;
+    }
 
     ///
     /// @brief 对该Value进行Load用的寄存器编号
     /// @return int32_t 寄存器编号
     ///
-    virtual int32_t getLoadRegId();
+    int32_t getLoadRegId() const
+    {
+        return loadRegNo;
+    }
 
     ///
     /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
+    /// @param _regId 寄存器编号
+    ///
+    void setLoadRegId(int32_t _regId)
+    {
+        loadRegNo = _regId;
+    }
+
+private:
+    ///
+    /// @brief Use对象被移动后，链表中指向原对象的指针改为指向新对象
+    /// @param oldUse 原对象
+    /// @param newUse 新对象，已经复制了原对象的前后指针
     ///
-    virtual void setLoadRegId(int32_t regId);
+    void relinkUse(Use * oldUse, Use * newUse);
 };
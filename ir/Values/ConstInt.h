@@ -30,17 +30,27 @@ public:
     ///
     /// @brief 指定值的常量
     /// \param val
-    explicit ConstInt(int32_t val) : Constant(IntegerType::getTypeInt())
+    explicit ConstInt(int32_t val) : Constant(ConstIntVal, IntegerType::getTypeInt())
     {
-        name = std::to_string(val);
+        setName(std::to_string(val));
         intVal = val;
     }
 
+    ///
+    /// @brief 是否是整型常量，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * v)
+    {
+        return v->getValueKind() == ConstIntVal;
+    }
+
     /// @brief 获取名字
     /// @return 变量名
     [[nodiscard]] std::string getIRName() const override
     {
-        return name;
+        return getName();
     }
 
     ///
@@ -52,32 +62,9 @@ public:
         return intVal;
     }
 
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
-    ///
-    int32_t getLoadRegId() override
-    {
-        return this->loadRegNo;
-    }
-
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
-    ///
-    void setLoadRegId(int32_t regId) override
-    {
-        this->loadRegNo = regId;
-    }
-
 private:
     ///
     /// @brief 整数值
     ///
     int32_t intVal;
-
-    ///
-    /// @brief 变量加载到寄存器中时对应的寄存器编号
-    ///
-    int32_t loadRegNo = -1;
 };
\ No newline at end of file
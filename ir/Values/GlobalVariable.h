@@ -30,12 +30,22 @@ public:
     /// @param _type 类型
     /// @param _name 名字
     ///
-    explicit GlobalVariable(Type * _type, std::string _name) : GlobalValue(_type, _name)
+    explicit GlobalVariable(Type * _type, std::string _name) : GlobalValue(GlobalVariableVal, _type, _name)
     {
         // 设置对齐大小
         setAlignment(4);
     }
 
+    ///
+    /// @brief 是否是全局变量，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
+    ///
+    static bool classof(const Value * v)
+    {
+        return v->getValueKind() == GlobalVariableVal;
+    }
+
     ///
     /// @brief  检查是否是函数
     /// @return true 是函数
@@ -65,24 +75,6 @@ public:
         return 0;
     }
 
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
-    ///
-    int32_t getLoadRegId() override
-    {
-        return this->loadRegNo;
-    }
-
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
-    ///
-    void setLoadRegId(int32_t regId) override
-    {
-        this->loadRegNo = regId;
-    }
-
     ///
     /// @brief Declare指令IR显示
     /// @param str
@@ -93,11 +85,6 @@ public:
     }
 
 private:
-    ///
-    /// @brief 变量加载到寄存器中时对应的寄存器编号
-    ///
-    int32_t loadRegNo = -1;
-
     ///
     /// @brief 默认全局变量在BSS段，没有初始化，或者即使初始化过，但都值都为0
     ///
@@ -22,7 +22,7 @@
 ///
 /// @brief 局部变量的Value
 ///
-class LocalVariable : public Value {
+class LocalVariable : public Value, public ArenaObject {
 
     friend class Function;
 
@@ -32,82 +32,32 @@ private:
     /// @param _type 类型
     /// @param _name 名称
     /// @param _scope_level 作用域层级
+    /// @param _arena 所属函数的内存区
     ///
-    explicit LocalVariable(Type * _type, std::string _name, int32_t _scope_level)
-        : Value(_type), scope_level(_scope_level)
+    LocalVariable(Type * _type, std::string _name, int32_t _scope_level, Arena * _arena)
+        : Value(LocalVariableVal, _type, _arena), scope_level(_scope_level)
     {
-        this->name = _name;
+        setName(_name);
     }
 
 public:
     ///
-    /// @brief 取得变量所在的作用域层级
-    /// @return int32_t 层级
-    ///
-    int32_t getScopeLevel() override
-    {
-        return scope_level;
-    }
-
+    /// @brief 是否是局部变量，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
     ///
-    /// @brief 获得分配的寄存器编号或ID
-    /// @return int32_t 寄存器编号
-    ///
-    int32_t getRegId() override
+    static bool classof(const Value * v)
     {
-        return regId;
+        return v->getValueKind() == LocalVariableVal;
     }
 
     ///
-    /// @brief @brief 如是内存变量型Value，则获取基址寄存器和偏移
-    /// @param regId 寄存器编号
-    /// @param offset 相对偏移
-    /// @return true 是内存型变量
-    /// @return false 不是内存型变量
-    ///
-    bool getMemoryAddr(int32_t * _regId = nullptr, int64_t * _offset = nullptr) override
-    {
-        if (this->baseRegNo == -1) {
-            return false;
-        }
-
-        if (_regId) {
-            *_regId = this->baseRegNo;
-        }
-        if (_offset) {
-            *_offset = this->offset;
-        }
-
-        return true;
-    }
-
-    ///
-    /// @brief 设置内存寻址的基址寄存器和偏移
-    /// @param _regId 基址寄存器编号
-    /// @param _offset 偏移
-    ///
-    void setMemoryAddr(int32_t _regId, int64_t _offset)
-    {
-        baseRegNo = _regId;
-        offset = _offset;
-    }
-
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
-    ///
-    int32_t getLoadRegId() override
-    {
-        return this->loadRegNo;
-    }
-
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
+    /// @brief 取得变量所在的作用域层级
+    /// @return int32_t 层级
     ///
-    void setLoadRegId(int32_t regId) override
+    int32_t getScopeLevel() override
     {
-        this->loadRegNo = regId;
+        return scope_level;
     }
 
 private:
@@ -115,21 +65,4 @@ private:
     /// @brief 当前变量所在作用域的层号，全局变量在第0层
     ///
     int scope_level = -1;
-
-    /// @brief 寄存器编号，-1表示没有分配寄存器，大于等于0代表是寄存器型Value
-    int32_t regId = -1;
-
-    /// @brief 变量在栈内的偏移量，对于全局变量默认为0，临时变量没有意义
-    int32_t offset = 0;
-
-    /// @brief 栈内寻找时基址寄存器编号
-    int32_t baseRegNo = -1;
-
-    /// @brief 栈内寻找时基址寄存器名字
-    std::string baseRegName;
-
-    ///
-    /// @brief 变量加载到寄存器中时对应的寄存器编号
-    ///
-    int32_t loadRegNo = -1;
 };
@@ -20,79 +20,25 @@
 #include "IRConstant.h"
 
 /// @brief 内存值，必须在内存中
-class MemVariable : public Value {
+class MemVariable : public Value, public ArenaObject {
 
     friend class Function;
 
 private:
     /// @brief 创建内存Value
     /// \param val
-    explicit MemVariable(Type * _type) : Value(_type)
+    /// @param _arena 所属函数的内存区
+    MemVariable(Type * _type, Arena * _arena) : Value(MemVariableVal, _type, _arena)
     {}
 
 public:
     ///
-    /// @brief @brief 如是内存变量型Value，则获取基址寄存器和偏移
-    /// @param regId 寄存器编号
-    /// @param offset 相对偏移
-    /// @return true 是内存型变量
-    /// @return false 不是内存型变量
+    /// @brief 是否是内存变量，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
     ///
-    bool getMemoryAddr(int32_t * _regId = nullptr, int64_t * _offset = nullptr) override
+    static bool classof(const Value * v)
     {
-        // 肯定是内存地址
-
-        if (_regId) {
-            *_regId = this->baseRegNo;
-        }
-        if (_offset) {
-            *_offset = this->offset;
-        }
-
-        return true;
-    }
-
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
-    ///
-    int32_t getLoadRegId() override
-    {
-        return this->loadRegNo;
-    }
-
-    ///
-    /// @brief 对该Value进行Load用的寄存器编号
-    /// @return int32_t 寄存器编号
-    ///
-    void setLoadRegId(int32_t regId) override
-    {
-        this->loadRegNo = regId;
+        return v->getValueKind() == MemVariableVal;
     }
-
-    ///
-    /// @brief 设置内存寻址的基址寄存器和偏移
-    /// @param _regId 基址寄存器编号
-    /// @param _offset 偏移
-    ///
-    void setMemoryAddr(int32_t _regId, int64_t _offset)
-    {
-        baseRegNo = _regId;
-        offset = _offset;
-    }
-
-private:
-    /// @brief 变量在栈内的偏移量，对于全局变量默认为0，临时变量没有意义
-    int32_t offset = 0;
-
-    /// @brief 栈内寻找时基址寄存器编号
-    int32_t baseRegNo = -1;
-
-    /// @brief 栈内寻找时基址寄存器名字
-    std::string baseRegName;
-
-    ///
-    /// @brief 变量加载到寄存器中时对应的寄存器编号
-    ///
-    int32_t loadRegNo = -1;
 };
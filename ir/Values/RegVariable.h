@@ -24,29 +24,26 @@ class RegVariable : public Value {
 public:
     /// @brief 整型寄存器型Value
     /// \param val
-    explicit RegVariable(Type * _type, std::string _name, int32_t _reg_no) : Value(_type)
+    explicit RegVariable(Type * _type, std::string _name, int32_t _reg_no) : Value(RegVariableVal, _type)
     {
         this->name = _name;
-        regId = _reg_no;
+        setRegId(_reg_no);
     }
 
     ///
-    /// @brief 获得分配的寄存器编号或ID
-    /// @return int32_t 寄存器编号
+    /// @brief 是否是寄存器，供isa/cast/dyn_cast使用
+    /// @param v Value
+    /// @return true 是 false 不是
     ///
-    int32_t getRegId() override
+    static bool classof(const Value * v)
     {
-        return regId;
+        return v->getValueKind() == RegVariableVal;
     }
 
     /// @brief 获取名字
     /// @return 变量名
     [[nodiscard]] std::string getIRName() const override
     {
-        return name;
+        return getName();
     }
-
-private:
-    /// @brief 寄存器编号，-1表示没有分配寄存器，大于等于0代表是寄存器型Value
-    int32_t regId = -1;
 };
@@ -28,6 +28,8 @@
 #include "IRGenerator.h"
 #include "RecursiveDescentExecutor.h"
 #include "Module.h"
+#include "Optimizer.h"
+#include "Profile.h"
 
 ///
 /// @brief 是否显示帮助信息
@@ -77,6 +79,15 @@ static bool gAsmAlsoShowIR = false;
 /// @brief 优化的级别，即-O后面的数字，默认为0
 static int gOptLevel = 0;
 
+/// @brief 循环展开后的最大指令数，只有长选项--unroll-threshold，默认-1表示按优化级别取值，0表示不展开
+static int gUnrollThreshold = -1;
+
+/// @brief 是否插桩产生剖面数据，即-fprofile-generate
+static bool gProfileGenerate = false;
+
+/// @brief 剖面数据文件，即-fprofile-use=FILE，非空时根据剖面数据进行优化
+static std::string gProfileUseFile;
+
 /// @brief 指定CPU目标架构，这里默认为ARM32
 static std::string gCPUTarget = "ARM32";
 
@@ -97,6 +108,7 @@ static struct option long_options[] = {
     {"optimize", required_argument, 0, 'O'},
     {"target", required_argument, 0, 't'},
     {"asmir", no_argument, 0, 'c'},
+    {"unroll-threshold", required_argument, 0, 'u'},
     {0, 0, 0, 0}
 };
 
@@ -116,6 +128,9 @@ static void showHelp(const std::string & exeName)
     std::cout << "  -O, --optimize=LEVEL       Set optimization level\n";
     std::cout << "  -t, --target=CPU           Specify target CPU architecture\n";
     std::cout << "  -c, --asmir                Show IR instructions as comments in assembly output\n";
+    std::cout << "  --unroll-threshold=N       Set the loop unrolling size limit, 0 disables unrolling\n";
+    std::cout << "  -fprofile-generate         Instrument basic blocks, link with tests/profile.c to dump the counts\n";
+    std::cout << "  -fprofile-use=FILE         Use the basic block counts in FILE to guide the optimizations\n";
 }
 
 /// @brief 参数解析与有效性检查
@@ -134,7 +149,8 @@ static int ArgsAnalysis(int argc, char * argv[])
     // -O要求必须带有附加整数，指明优化的级别
     // -t要求必须带有目标CPU，指明目标CPU的汇编
     // -c选项在输出汇编时有效，附带输出IR指令内容
-    const char options[] = "ho:STIADO:t:c";
+    // -f要求必须带有附加参数，可识别-fprofile-generate与-fprofile-use=FILE
+    const char options[] = "ho:STIADO:t:cf:";
     int option_index = 0;
 
     opterr = 1;
@@ -172,7 +188,7 @@ lb_check:
                 gFrontEndRecursiveDescentParsing = true;
                 break;
             case 'O':
-                // 优化级别分析，暂时没有用，如开启优化时请使用
+                // 优化级别分析，-O1及以上时进行中间IR优化
                 gOptLevel = std::stoi(optarg);
                 break;
             case 't':
@@ -181,6 +197,22 @@ lb_check:
             case 'c':
                 gAsmAlsoShowIR = true;
                 break;
+            case 'u':
+                // 循环展开的阈值
+                gUnrollThreshold = std::stoi(optarg);
+                break;
+            case 'f': {
+                // 剖面数据的产生与使用
+                std::string arg = optarg;
+                if (arg == "profile-generate") {
+                    gProfileGenerate = true;
+                } else if (arg.rfind("profile-use=", 0) == 0 && arg.size() > 12) {
+                    gProfileUseFile = arg.substr(12);
+                } else {
+                    return -1;
+                }
+                break;
+            }
             default:
                 return -1;
                 break; /* no break */
@@ -266,7 +298,7 @@ static int compile(std::string inputFile, std::string outputFile)
         // 编译过程主要包括：
         // 1）词法语法分析生成AST
         // 2) 遍历AST生成线性IR
-        // 3) 对线性IR进行优化：目前不支持
+        // 3) 对线性IR进行优化
         // 4) 把线性IR转换成汇编
 
         // 创建词法语法分析器
@@ -333,6 +365,29 @@ static int compile(std::string inputFile, std::string outputFile)
         // 清理抽象语法树
         free_ast(astRoot);
 
+        // 剖面插桩与剖面数据的读取要在优化之前，两者看到的基本块编号一致
+        if (gProfileGenerate) {
+            ProfileInstrumenter instrumenter(module);
+            if (!instrumenter.run()) {
+                minic_log(LOG_ERROR, "剖面插桩错误：没有main函数");
+                break;
+            }
+        } else if (!gProfileUseFile.empty()) {
+            ProfileLoader loader(module);
+            if (!loader.load(gProfileUseFile)) {
+                minic_log(LOG_ERROR, "剖面数据文件(%s)读取失败，忽略剖面数据", gProfileUseFile.c_str());
+            }
+        }
+
+        // 中间代码优化，体系结构无关，-O1及以上时有效
+        Optimizer optimizer(module, gOptLevel, gUnrollThreshold);
+        if (!optimizer.run()) {
+
+            minic_log(LOG_ERROR, "中间IR优化错误");
+
+            break;
+        }
+
         if (gShowLineIR) {
 
             // 对IR的名字重命名
@@ -353,8 +408,6 @@ static int compile(std::string inputFile, std::string outputFile)
             module->renameIR();
         }
 
-        // 这里可追加中间代码优化，体系结果无关的优化等
-
         // 后端处理，体系结果相关的操作
         // 这里提供一种面向ARM32的汇编产生器CodeGeneratorArm32作为参考
         // 需要时可根据需要修改或追加新的目标体系架构
@@ -366,6 +419,7 @@ static int compile(std::string inputFile, std::string outputFile)
                 // 输出面向ARM32的汇编指令
                 generator = new CodeGeneratorArm32(module);
                 generator->setShowLinearIR(gAsmAlsoShowIR);
+                generator->setOptLevel(gOptLevel);
                 generator->run(outputFile);
             } else {
                 // 不支持指定的CPU架构
@@ -0,0 +1,142 @@
+///
+/// @file CallGraph.cpp
+/// @brief 函数调用图，以及按强连通分量自底向上的函数次序
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+
+#include "CallGraph.h"
+
+/// @brief 构造函数，根据当前的IR建立调用图
+/// @param _module 符号表
+CallGraph::CallGraph(Module * _module) : module(_module)
+{
+    for (auto func: module->getFunctionList()) {
+
+        if (func->isBuiltin()) {
+            continue;
+        }
+
+        std::vector<Function *> & funcCallees = callees[func];
+        std::vector<FuncCallInstruction *> & funcCallInsts = callInsts[func];
+
+        for (auto inst: func->getInterCode().getInsts()) {
+
+            if (inst->isDead() || inst->getOp() != IRInstOperator::IRINST_OP_FUNC_CALL) {
+                continue;
+            }
+
+            FuncCallInstruction * callInst = static_cast<FuncCallInstruction *>(inst);
+            funcCallInsts.push_back(callInst);
+
+            Function * callee = callInst->calledFunction;
+            if (callee->isBuiltin()) {
+                continue;
+            }
+
+            if (callee == func) {
+                selfCalls.insert(func);
+            }
+
+            if (std::find(funcCallees.begin(), funcCallees.end(), callee) == funcCallees.end()) {
+                funcCallees.push_back(callee);
+            }
+        }
+    }
+
+    for (auto func: module->getFunctionList()) {
+        if (!func->isBuiltin() && !dfsNum.count(func)) {
+            visit(func);
+        }
+    }
+
+    dfsNum.clear();
+    lowLink.clear();
+}
+
+/// @brief Tarjan算法求强连通分量，分量完成的次序即被调用者在前的次序
+/// @param func 当前访问的函数
+void CallGraph::visit(Function * func)
+{
+    int32_t num = (int32_t) dfsNum.size();
+    dfsNum[func] = num;
+    lowLink[func] = num;
+    stack.push_back(func);
+    onStack.insert(func);
+
+    for (auto callee: callees[func]) {
+        if (!dfsNum.count(callee)) {
+            visit(callee);
+            lowLink[func] = std::min(lowLink[func], lowLink[callee]);
+        } else if (onStack.count(callee)) {
+            lowLink[func] = std::min(lowLink[func], dfsNum[callee]);
+        }
+    }
+
+    if (lowLink[func] != dfsNum[func]) {
+        return;
+    }
+
+    // func是分量的根，栈中func及其以上的函数构成一个强连通分量
+    std::vector<Function *> scc;
+    Function * member;
+    do {
+        member = stack.back();
+        stack.pop_back();
+        onStack.erase(member);
+        sccIndex[member] = (int32_t) sccs.size();
+        scc.push_back(member);
+    } while (member != func);
+
+    sccs.push_back(scc);
+}
+
+/// @brief 获取函数调用的非内置函数，不重复
+/// @param func 函数
+/// @return std::vector<Function *>& 被调用的函数
+std::vector<Function *> & CallGraph::getCallees(Function * func)
+{
+    return callees[func];
+}
+
+/// @brief 获取函数内的函数调用指令，包括对内置函数的调用
+/// @param func 函数
+/// @return std::vector<FuncCallInstruction *>& 函数调用指令
+std::vector<FuncCallInstruction *> & CallGraph::getCallInsts(Function * func)
+{
+    return callInsts[func];
+}
+
+/// @brief 获取函数所在的强连通分量的编号
+/// @param func 函数
+/// @return int32_t 编号，内置函数为-1
+int32_t CallGraph::getSCCIndex(Function * func)
+{
+    auto iter = sccIndex.find(func);
+    return iter == sccIndex.end() ? -1 : iter->second;
+}
+
+/// @brief 函数是否直接或间接地递归调用自身
+/// @param func 函数
+/// @return true 递归 false 不递归
+bool CallGraph::isRecursive(Function * func)
+{
+    int32_t index = getSCCIndex(func);
+    if (index < 0) {
+        return false;
+    }
+
+    return sccs[index].size() > 1 || selfCalls.count(func);
+}
@@ -0,0 +1,134 @@
+///
+/// @file CallGraph.h
+/// @brief 函数调用图，以及按强连通分量自底向上的函数次序
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "FuncCallInstruction.h"
+#include "Function.h"
+#include "Module.h"
+
+///
+/// @brief 函数调用图。结点是非内置函数，内置函数没有函数体，不作为结点。
+/// 强连通分量按被调用者在前的次序排列，同一个分量内的函数互相递归
+///
+class CallGraph {
+
+public:
+    ///
+    /// @brief 构造函数，根据当前的IR建立调用图
+    /// @param _module 符号表
+    ///
+    explicit CallGraph(Module * _module);
+
+    ///
+    /// @brief 获取函数调用的非内置函数，不重复
+    /// @param func 函数
+    /// @return std::vector<Function *>& 被调用的函数
+    ///
+    std::vector<Function *> & getCallees(Function * func);
+
+    ///
+    /// @brief 获取函数内的函数调用指令，包括对内置函数的调用
+    /// @param func 函数
+    /// @return std::vector<FuncCallInstruction *>& 函数调用指令
+    ///
+    std::vector<FuncCallInstruction *> & getCallInsts(Function * func);
+
+    ///
+    /// @brief 获取强连通分量，被调用者所在的分量在前
+    /// @return std::vector<std::vector<Function *>>& 强连通分量
+    ///
+    std::vector<std::vector<Function *>> & getSCCs()
+    {
+        return sccs;
+    }
+
+    ///
+    /// @brief 获取函数所在的强连通分量的编号
+    /// @param func 函数
+    /// @return int32_t 编号，内置函数为-1
+    ///
+    int32_t getSCCIndex(Function * func);
+
+    ///
+    /// @brief 函数是否直接或间接地递归调用自身
+    /// @param func 函数
+    /// @return true 递归 false 不递归
+    ///
+    bool isRecursive(Function * func);
+
+private:
+    ///
+    /// @brief Tarjan算法求强连通分量，分量完成的次序即被调用者在前的次序
+    /// @param func 当前访问的函数
+    ///
+    void visit(Function * func);
+
+    ///
+    /// @brief 符号表
+    ///
+    Module * module;
+
+    ///
+    /// @brief 每个函数调用的非内置函数
+    ///
+    std::unordered_map<Function *, std::vector<Function *>> callees;
+
+    ///
+    /// @brief 每个函数内的函数调用指令
+    ///
+    std::unordered_map<Function *, std::vector<FuncCallInstruction *>> callInsts;
+
+    ///
+    /// @brief 强连通分量
+    ///
+    std::vector<std::vector<Function *>> sccs;
+
+    ///
+    /// @brief 函数所在的强连通分量的编号
+    ///
+    std::unordered_map<Function *, int32_t> sccIndex;
+
+    ///
+    /// @brief 直接调用自身的函数
+    ///
+    std::unordered_set<Function *> selfCalls;
+
+    ///
+    /// @brief Tarjan算法的访问序号
+    ///
+    std::unordered_map<Function *, int32_t> dfsNum;
+
+    ///
+    /// @brief Tarjan算法能到达的最小访问序号
+    ///
+    std::unordered_map<Function *, int32_t> lowLink;
+
+    ///
+    /// @brief Tarjan算法的栈
+    ///
+    std::vector<Function *> stack;
+
+    ///
+    /// @brief 在Tarjan算法栈中的函数
+    ///
+    std::unordered_set<Function *> onStack;
+};
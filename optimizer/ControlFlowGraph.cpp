@@ -0,0 +1,265 @@
+///
+/// @file ControlFlowGraph.cpp
+/// @brief 基于线性IR构建的基本块与控制流图
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+
+#include "ControlFlowGraph.h"
+#include "GotoInstruction.h"
+
+/// @brief 获取基本块开始的Label指令
+/// @return LabelInstruction* Label指令，没有时为空
+LabelInstruction * BasicBlock::getLabel()
+{
+    if (insts.empty() || insts.front()->getOp() != IRInstOperator::IRINST_OP_LABEL) {
+        return nullptr;
+    }
+
+    return static_cast<LabelInstruction *>(insts.front());
+}
+
+/// @brief 获取基本块的结束指令
+/// @return Instruction* 跳转或出口指令，没有时为空
+Instruction * BasicBlock::getTerminator()
+{
+    // 跳过尾部已经被删除的指令
+    for (auto iter = insts.rbegin(); iter != insts.rend(); ++iter) {
+
+        Instruction * inst = *iter;
+        if (inst->isDead()) {
+            continue;
+        }
+
+        IRInstOperator op = inst->getOp();
+        if (op == IRInstOperator::IRINST_OP_GOTO || op == IRInstOperator::IRINST_OP_EXIT) {
+            return inst;
+        }
+
+        break;
+    }
+
+    return nullptr;
+}
+
+/// @brief 在基本块的结束指令之前插入指令
+/// @param inst 指令
+void BasicBlock::insertBeforeTerminator(Instruction * inst)
+{
+    Instruction * term = getTerminator();
+    if (term == nullptr) {
+        insts.push_back(inst);
+    } else {
+        insts.insert(std::find(insts.begin(), insts.end(), term), inst);
+    }
+}
+
+/// @brief 构造函数，根据函数的线性IR构建控制流图
+/// @param _func 函数
+ControlFlowGraph::ControlFlowGraph(Function * _func) : func(_func)
+{
+    build();
+}
+
+/// @brief 析构函数，释放基本块，指令不释放
+ControlFlowGraph::~ControlFlowGraph()
+{
+    for (auto bb: blocks) {
+        delete bb;
+    }
+    blocks.clear();
+}
+
+/// @brief 根据线性IR划分基本块并建立前驱后继关系
+void ControlFlowGraph::build()
+{
+    BasicBlock * cur = nullptr;
+
+    for (auto inst: func->getInterCode().getInsts()) {
+
+        // Label指令开始一个新的基本块，前一个基本块若没有结束则顺序执行进入
+        if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL || cur == nullptr) {
+            if (cur == nullptr || !cur->insts.empty()) {
+                cur = new BasicBlock((int32_t) blocks.size());
+                blocks.push_back(cur);
+            }
+        }
+
+        cur->insts.push_back(inst);
+        instBlockMap[inst] = cur;
+
+        if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
+            labelBlockMap[inst] = cur;
+        }
+
+        // 跳转指令或出口指令结束基本块，后续的指令属于新的基本块
+        if (inst->getOp() == IRInstOperator::IRINST_OP_GOTO || inst->getOp() == IRInstOperator::IRINST_OP_EXIT) {
+            cur = new BasicBlock((int32_t) blocks.size());
+            blocks.push_back(cur);
+        }
+    }
+
+    // 最后一个基本块可能是空的，删除
+    if (!blocks.empty() && blocks.back()->insts.empty()) {
+        delete blocks.back();
+        blocks.pop_back();
+    }
+
+    // 建立前驱后继关系
+    for (size_t k = 0; k < blocks.size(); ++k) {
+
+        BasicBlock * bb = blocks[k];
+        Instruction * term = bb->getTerminator();
+
+        if (term == nullptr) {
+            // 顺序执行到下一个基本块
+            if (k + 1 < blocks.size()) {
+                bb->succs.push_back(blocks[k + 1]);
+            }
+        } else if (term->getOp() == IRInstOperator::IRINST_OP_GOTO) {
+
+            GotoInstruction * gotoInst = static_cast<GotoInstruction *>(term);
+
+            BasicBlock * trueBlock = getBlockOfLabel(gotoInst->getTarget());
+            if (trueBlock) {
+                bb->succs.push_back(trueBlock);
+            }
+
+            if (gotoInst->isConditionalBranch()) {
+                BasicBlock * falseBlock = getBlockOfLabel(gotoInst->getFalseTarget());
+                if (falseBlock && falseBlock != trueBlock) {
+                    bb->succs.push_back(falseBlock);
+                }
+            }
+        }
+
+        for (auto succ: bb->succs) {
+            succ->preds.push_back(bb);
+        }
+    }
+}
+
+/// @brief 获取入口基本块
+/// @return BasicBlock* 入口基本块
+BasicBlock * ControlFlowGraph::getEntry()
+{
+    return blocks.empty() ? nullptr : blocks.front();
+}
+
+/// @brief 获取Label指令开始的基本块
+/// @param label Label指令
+/// @return BasicBlock* 基本块，找不到时为空
+BasicBlock * ControlFlowGraph::getBlockOfLabel(Instruction * label)
+{
+    auto pIter = labelBlockMap.find(label);
+    if (pIter == labelBlockMap.end()) {
+        return nullptr;
+    }
+
+    return pIter->second;
+}
+
+/// @brief 获取指令所在的基本块
+/// @param inst 指令
+/// @return BasicBlock* 基本块，找不到时为空
+BasicBlock * ControlFlowGraph::getBlockOfInst(Instruction * inst)
+{
+    auto pIter = instBlockMap.find(inst);
+    if (pIter == instBlockMap.end()) {
+        return nullptr;
+    }
+
+    return pIter->second;
+}
+
+/// @brief 获取从入口可达的基本块的逆后序
+/// @return std::vector<BasicBlock *> 逆后序的基本块
+std::vector<BasicBlock *> ControlFlowGraph::reversePostOrder()
+{
+    std::vector<BasicBlock *> order;
+
+    if (blocks.empty()) {
+        return order;
+    }
+
+    // 非递归的深度优先遍历，避免函数很大时栈溢出
+    std::vector<char> visited(blocks.size(), 0);
+    std::vector<std::pair<BasicBlock *, size_t>> stack;
+
+    stack.emplace_back(getEntry(), 0);
+    visited[getEntry()->index] = 1;
+
+    while (!stack.empty()) {
+
+        auto & top = stack.back();
+        BasicBlock * bb = top.first;
+
+        if (top.second < bb->succs.size()) {
+            BasicBlock * succ = bb->succs[top.second++];
+            if (!visited[succ->index]) {
+                visited[succ->index] = 1;
+                stack.emplace_back(succ, 0);
+            }
+        } else {
+            order.push_back(bb);
+            stack.pop_back();
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+
+    return order;
+}
+
+/// @brief 按照基本块的次序把指令写回到函数中，Dead指令会被删除并释放
+void ControlFlowGraph::writeBack()
+{
+    std::vector<Instruction *> & code = func->getInterCode().getInsts();
+    std::vector<Instruction *> deadInsts;
+
+    code.clear();
+
+    for (auto bb: blocks) {
+        for (auto inst: bb->insts) {
+            if (inst->isDead()) {
+                deadInsts.push_back(inst);
+            } else {
+                code.push_back(inst);
+            }
+        }
+    }
+
+    // 不能直接删除指令，需要先清除操作数
+    for (auto inst: deadInsts) {
+        inst->clearOperands();
+    }
+
+    for (auto inst: deadInsts) {
+        if (inst == func->getExitLabel()) {
+            func->setExitLabel(nullptr);
+        }
+        delete inst;
+    }
+
+    // 指令已经变化，重新划分基本块
+    for (auto bb: blocks) {
+        delete bb;
+    }
+    blocks.clear();
+    labelBlockMap.clear();
+    instBlockMap.clear();
+
+    build();
+}
@@ -0,0 +1,210 @@
+///
+/// @file ControlFlowGraph.h
+/// @brief 基于线性IR构建的基本块与控制流图
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Function.h"
+#include "Instruction.h"
+#include "LabelInstruction.h"
+
+///
+/// @brief 基本块，由Label指令开始，以跳转或出口指令结束的一段线性IR指令
+///
+class BasicBlock {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _index 基本块在函数内的序号
+    ///
+    explicit BasicBlock(int32_t _index) : index(_index)
+    {}
+
+    ///
+    /// @brief 获取基本块序号
+    /// @return int32_t 序号
+    ///
+    [[nodiscard]] int32_t getIndex() const
+    {
+        return index;
+    }
+
+    ///
+    /// @brief 获取基本块开始的Label指令，没有Label时为空
+    /// @return LabelInstruction* Label指令
+    ///
+    LabelInstruction * getLabel();
+
+    ///
+    /// @brief 获取基本块的结束指令，只有跳转指令或出口指令才算作结束指令
+    /// @return Instruction* 结束指令，没有时为空，此时会顺序执行到下一个基本块
+    ///
+    Instruction * getTerminator();
+
+    ///
+    /// @brief 在基本块的结束指令之前插入指令，没有结束指令时追加到末尾
+    /// @param inst 指令
+    ///
+    void insertBeforeTerminator(Instruction * inst);
+
+    ///
+    /// @brief 获取基本块内的指令
+    /// @return std::vector<Instruction *>& 指令序列
+    ///
+    std::vector<Instruction *> & getInsts()
+    {
+        return insts;
+    }
+
+    ///
+    /// @brief 获取前驱基本块
+    /// @return std::vector<BasicBlock *>& 前驱
+    ///
+    std::vector<BasicBlock *> & getPreds()
+    {
+        return preds;
+    }
+
+    ///
+    /// @brief 获取后继基本块，条件跳转时第一个为真分支
+    /// @return std::vector<BasicBlock *>& 后继
+    ///
+    std::vector<BasicBlock *> & getSuccs()
+    {
+        return succs;
+    }
+
+private:
+    ///
+    /// @brief 基本块序号，按照线性IR中的先后次序编号
+    ///
+    int32_t index;
+
+    ///
+    /// @brief 基本块内的指令，含开始的Label指令
+    ///
+    std::vector<Instruction *> insts;
+
+    ///
+    /// @brief 前驱基本块
+    ///
+    std::vector<BasicBlock *> preds;
+
+    ///
+    /// @brief 后继基本块
+    ///
+    std::vector<BasicBlock *> succs;
+
+    friend class ControlFlowGraph;
+};
+
+///
+/// @brief 函数的控制流图。IR本身是线性的，这里只是对线性IR的划分，
+/// 优化修改指令后需要通过writeBack写回到函数中
+///
+class ControlFlowGraph {
+
+public:
+    ///
+    /// @brief 构造函数，根据函数的线性IR构建控制流图
+    /// @param _func 函数
+    ///
+    explicit ControlFlowGraph(Function * _func);
+
+    ///
+    /// @brief 析构函数，释放基本块，指令不释放
+    ///
+    ~ControlFlowGraph();
+
+    ///
+    /// @brief 获取全部的基本块，次序与线性IR的次序一致
+    /// @return std::vector<BasicBlock *>& 基本块
+    ///
+    std::vector<BasicBlock *> & getBlocks()
+    {
+        return blocks;
+    }
+
+    ///
+    /// @brief 获取入口基本块
+    /// @return BasicBlock* 入口基本块
+    ///
+    BasicBlock * getEntry();
+
+    ///
+    /// @brief 获取Label指令开始的基本块
+    /// @param label Label指令
+    /// @return BasicBlock* 基本块，找不到时为空
+    ///
+    BasicBlock * getBlockOfLabel(Instruction * label);
+
+    ///
+    /// @brief 获取指令所在的基本块
+    /// @param inst 指令
+    /// @return BasicBlock* 基本块，找不到时为空
+    ///
+    BasicBlock * getBlockOfInst(Instruction * inst);
+
+    ///
+    /// @brief 获取从入口可达的基本块的逆后序
+    /// @return std::vector<BasicBlock *> 逆后序的基本块
+    ///
+    std::vector<BasicBlock *> reversePostOrder();
+
+    ///
+    /// @brief 按照基本块的次序把指令写回到函数中，Dead指令会被删除并释放
+    ///
+    void writeBack();
+
+    ///
+    /// @brief 获取所属函数
+    /// @return Function* 函数
+    ///
+    Function * getFunction()
+    {
+        return func;
+    }
+
+private:
+    ///
+    /// @brief 根据线性IR划分基本块并建立前驱后继关系
+    ///
+    void build();
+
+    ///
+    /// @brief 所属函数
+    ///
+    Function * func;
+
+    ///
+    /// @brief 基本块，次序与线性IR一致
+    ///
+    std::vector<BasicBlock *> blocks;
+
+    ///
+    /// @brief Label指令到基本块的映射
+    ///
+    std::unordered_map<Instruction *, BasicBlock *> labelBlockMap;
+
+    ///
+    /// @brief 指令到基本块的映射
+    ///
+    std::unordered_map<Instruction *, BasicBlock *> instBlockMap;
+};
@@ -0,0 +1,233 @@
+///
+/// @file CopyPropagation.cpp
+/// @brief 基于可用复制分析的复制传播
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include "CopyPropagation.h"
+#include "Common.h"
+#include "OptUtils.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _func 要优化的函数
+CopyPropagation::CopyPropagation(Module * _module, Function * _func) : FunctionPass(_module, _func), cfg(_func)
+{}
+
+/// @brief 获取指令定值的值，赋值指令为目的操作数，有结果的指令为其自身
+/// @param inst 指令
+/// @return Value* 定值的值，没有时为空
+Value * CopyPropagation::getDef(Instruction * inst)
+{
+    if (inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN) {
+        return inst->getOperand(0);
+    }
+
+    return inst->hasResultValue() ? inst : nullptr;
+}
+
+/// @brief 收集函数内的复制指令，以及每个值涉及的复制
+void CopyPropagation::collectCopies()
+{
+    for (auto bb: cfg.getBlocks()) {
+        for (auto inst: bb->getInsts()) {
+
+            if (inst->isDead() || inst->getOp() != IRInstOperator::IRINST_OP_ASSIGN) {
+                continue;
+            }
+
+            Value * dst = inst->getOperand(0);
+            Value * src = inst->getOperand(1);
+
+            // 全局变量可能被函数调用修改，不作为复制的两端。
+            // 形参只在入口处复制到局部变量，后端的形参位于r0-r3，函数调用后不再有效，因此也不传播
+            Instanceof(srcInst, Instruction *, src);
+            bool srcOk = isLocalVariable(src) || (srcInst && srcInst->hasResultValue());
+
+            if (!isLocalVariable(dst) || !srcOk || dst == src || dst->getType() != src->getType()) {
+                continue;
+            }
+
+            int32_t index = (int32_t) copies.size();
+            copies.push_back(inst);
+            copySources.push_back(src);
+            copyIndex[inst] = index;
+            copiesOf[dst].push_back(index);
+            copiesOf[src].push_back(index);
+        }
+    }
+}
+
+/// @brief 指令执行后更新可用复制集合
+/// @param inst 指令
+/// @param avail 可用复制集合
+void CopyPropagation::transfer(Instruction * inst, BitSet & avail)
+{
+    // 定值使得涉及该值的复制都不再可用，包括复制指令自身的目的操作数
+    Value * def = getDef(inst);
+    if (def) {
+        auto iter = copiesOf.find(def);
+        if (iter != copiesOf.end()) {
+            for (auto index: iter->second) {
+                avail.reset(index);
+            }
+        }
+    }
+
+    auto iter = copyIndex.find(inst);
+    if (iter != copyIndex.end()) {
+        avail.set(iter->second);
+    }
+}
+
+/// @brief 前向数据流迭代求各基本块入口的可用复制
+void CopyPropagation::computeAvailable()
+{
+    std::vector<BasicBlock *> & blocks = cfg.getBlocks();
+    size_t copyNum = copies.size();
+
+    // 求交的数据流，入口基本块之外初始为全集
+    availIn.assign(blocks.size(), BitSet(copyNum, true));
+    std::vector<BitSet> availOut(blocks.size(), BitSet(copyNum, true));
+
+    BasicBlock * entry = cfg.getEntry();
+    std::vector<BasicBlock *> order = cfg.reversePostOrder();
+
+    BitSet in(copyNum);
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        for (auto bb: order) {
+
+            if (bb == entry) {
+                in.clear();
+            } else {
+                in.setAll();
+            }
+
+            for (auto pred: bb->getPreds()) {
+                in &= availOut[pred->getIndex()];
+            }
+
+            availIn[bb->getIndex()] = in;
+
+            for (auto inst: bb->getInsts()) {
+                if (!inst->isDead()) {
+                    transfer(inst, in);
+                }
+            }
+
+            if (in != availOut[bb->getIndex()]) {
+                availOut[bb->getIndex()] = in;
+                changed = true;
+            }
+        }
+    }
+}
+
+/// @brief 把使用替换为可用复制的源操作数
+/// @return true 有替换 false 没有
+bool CopyPropagation::rewrite()
+{
+    bool changed = false;
+
+    for (auto bb: cfg.reversePostOrder()) {
+
+        BitSet avail = availIn[bb->getIndex()];
+
+        for (auto inst: bb->getInsts()) {
+
+            if (inst->isDead()) {
+                continue;
+            }
+
+            // 返回值保持在返回值变量中，尾调用与内联都依赖这一点
+            if (inst->getOp() != IRInstOperator::IRINST_OP_EXIT) {
+
+                int32_t firstSrc = (inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN) ? 1 : 0;
+
+                for (int32_t k = firstSrc; k < inst->getOperandsNum(); ++k) {
+
+                    auto iter = copiesOf.find(inst->getOperand(k));
+                    if (iter == copiesOf.end()) {
+                        continue;
+                    }
+
+                    // 同一个目的变量的复制互相杀死，可用的至多一个
+                    for (auto index: iter->second) {
+                        if (avail.test(index) && copies[index]->getOperand(0) == inst->getOperand(k)) {
+                            inst->setOperand(k, copySources[index]);
+                            replacedCount++;
+                            changed = true;
+                            break;
+                        }
+                    }
+                }
+
+                // 替换后成为自身赋值的删除
+                if (firstSrc == 1 && inst->getOperand(0) == inst->getOperand(1)) {
+                    inst->setDead();
+                    inst->clearOperands();
+                    continue;
+                }
+            }
+
+            transfer(inst, avail);
+        }
+    }
+
+    return changed;
+}
+
+/// @brief 执行优化
+/// @return true 函数的IR发生了变化 false 没有变化
+bool CopyPropagation::run()
+{
+    if (cfg.getBlocks().empty()) {
+        return false;
+    }
+
+    // 复制链 a = b; c = a 每轮向前传播一步，迭代到不动点
+    bool changed = false;
+
+    for (;;) {
+
+        copies.clear();
+        copySources.clear();
+        copyIndex.clear();
+        copiesOf.clear();
+
+        collectCopies();
+        if (copies.empty()) {
+            break;
+        }
+
+        computeAvailable();
+        if (!rewrite()) {
+            break;
+        }
+
+        changed = true;
+    }
+
+    if (changed) {
+        cfg.writeBack();
+
+        minic_log(LOG_INFO, "函数%s: 复制传播替换%d处使用", func->getName().c_str(), replacedCount);
+    }
+
+    return changed;
+}
@@ -0,0 +1,113 @@
+///
+/// @file CopyPropagation.h
+/// @brief 基于可用复制分析的复制传播
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "BitSet.h"
+#include "ControlFlowGraph.h"
+#include "Pass.h"
+
+///
+/// @brief 复制传播。局部变量的赋值 x = y (y为局部变量或临时变量，类型相同) 是一个复制，
+/// 前向数据流分析求出各处可用的复制(所有路径上复制之后x与y都没有被重新定值)，
+/// x的使用改为y，之后没有使用的复制由死代码删除清理。出口指令的返回值保持不变
+///
+class CopyPropagation : public FunctionPass {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    /// @param _func 要优化的函数
+    ///
+    CopyPropagation(Module * _module, Function * _func);
+
+    ///
+    /// @brief 执行优化
+    /// @return true 函数的IR发生了变化 false 没有变化
+    ///
+    bool run() override;
+
+private:
+    ///
+    /// @brief 收集函数内的复制指令，以及每个值涉及的复制
+    ///
+    void collectCopies();
+
+    ///
+    /// @brief 获取指令定值的值，赋值指令为目的操作数，有结果的指令为其自身
+    /// @param inst 指令
+    /// @return Value* 定值的值，没有时为空
+    ///
+    static Value * getDef(Instruction * inst);
+
+    ///
+    /// @brief 指令执行后更新可用复制集合
+    /// @param inst 指令
+    /// @param avail 可用复制集合
+    ///
+    void transfer(Instruction * inst, BitSet & avail);
+
+    ///
+    /// @brief 前向数据流迭代求各基本块入口的可用复制
+    ///
+    void computeAvailable();
+
+    ///
+    /// @brief 把使用替换为可用复制的源操作数
+    /// @return true 有替换 false 没有
+    ///
+    bool rewrite();
+
+    ///
+    /// @brief 控制流图
+    ///
+    ControlFlowGraph cfg;
+
+    ///
+    /// @brief 复制指令，下标为复制的编号
+    ///
+    std::vector<Instruction *> copies;
+
+    ///
+    /// @brief 复制的源操作数，收集时记录，替换过程中复制指令本身的源操作数可能被修改
+    ///
+    std::vector<Value *> copySources;
+
+    ///
+    /// @brief 复制指令到编号的映射
+    ///
+    std::unordered_map<Instruction *, int32_t> copyIndex;
+
+    ///
+    /// @brief 值到以其为目的或源操作数的复制编号的映射，值被重新定值时这些复制不再可用
+    ///
+    std::unordered_map<Value *, std::vector<int32_t>> copiesOf;
+
+    ///
+    /// @brief 各基本块入口的可用复制
+    ///
+    std::vector<BitSet> availIn;
+
+    ///
+    /// @brief 替换的使用数
+    ///
+    int32_t replacedCount = 0;
+};
@@ -0,0 +1,258 @@
+///
+/// @file DeadCodeElimination.cpp
+/// @brief 基于定值-使用链的死代码删除与死存储删除
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+
+#include "DeadCodeElimination.h"
+#include "BitSet.h"
+#include "Common.h"
+#include "FuncCallInstruction.h"
+#include "OptUtils.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _func 要优化的函数
+DeadCodeElimination::DeadCodeElimination(Module * _module, Function * _func)
+    : FunctionPass(_module, _func), cfg(_func)
+{}
+
+/// @brief 删除指令，并立即解除其对操作数的使用
+/// @param inst 指令
+void DeadCodeElimination::killInst(Instruction * inst)
+{
+    inst->setDead();
+    inst->clearOperands();
+    removedCount++;
+}
+
+/// @brief 指令是否没有副作用，结果不使用时可以删除
+/// @param inst 指令
+/// @return true 没有副作用 false 有
+bool DeadCodeElimination::isSideEffectFree(Instruction * inst)
+{
+    if (isArithOp(inst->getOp())) {
+        return true;
+    }
+
+    // 纯函数且一定返回的函数调用，结果不使用时可以删除
+    if (inst->getOp() == IRInstOperator::IRINST_OP_FUNC_CALL) {
+        Function::Attributes & attrs = static_cast<FuncCallInstruction *>(inst)->calledFunction->getAttributes();
+        return attrs.pure && attrs.willReturn;
+    }
+
+    return false;
+}
+
+/// @brief 删除没有使用的无副作用指令
+/// @return true 有删除 false 没有
+bool DeadCodeElimination::removeUnusedInsts()
+{
+    bool changed = false;
+
+    std::vector<Instruction *> worklist;
+
+    for (auto bb: cfg.getBlocks()) {
+        for (auto inst: bb->getInsts()) {
+            if (!inst->isDead() && isSideEffectFree(inst)) {
+                worklist.push_back(inst);
+            }
+        }
+    }
+
+    while (!worklist.empty()) {
+
+        Instruction * inst = worklist.back();
+        worklist.pop_back();
+
+        if (inst->isDead() || !inst->getUses().empty()) {
+            continue;
+        }
+
+        // 删除前记录操作数，删除后操作数的使用减少，可能也变为死代码
+        std::vector<Value *> operands = inst->getOperandsValue();
+
+        killInst(inst);
+        changed = true;
+
+        for (auto operand: operands) {
+            Instanceof(operandInst, Instruction *, operand);
+            if (operandInst && !operandInst->isDead() && isSideEffectFree(operandInst) &&
+                operandInst->getUses().empty()) {
+                worklist.push_back(operandInst);
+            }
+        }
+    }
+
+    return changed;
+}
+
+/// @brief 通过局部变量的活跃性分析删除死存储
+/// @return true 有删除 false 没有
+bool DeadCodeElimination::removeDeadStores()
+{
+    std::vector<BasicBlock *> & blocks = cfg.getBlocks();
+    size_t varNum = varIndex.size();
+
+    // 各基本块的use与def集合，use为定值前被读取的局部变量
+    std::vector<BitSet> useSets(blocks.size(), BitSet(varNum));
+    std::vector<BitSet> defSets(blocks.size(), BitSet(varNum));
+
+    for (auto bb: blocks) {
+
+        BitSet & useSet = useSets[bb->getIndex()];
+        BitSet & defSet = defSets[bb->getIndex()];
+
+        for (auto inst: bb->getInsts()) {
+
+            if (inst->isDead()) {
+                continue;
+            }
+
+            bool isMove = inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN;
+
+            for (int32_t k = isMove ? 1 : 0; k < inst->getOperandsNum(); ++k) {
+                auto iter = varIndex.find(inst->getOperand(k));
+                if (iter != varIndex.end() && !defSet.test(iter->second)) {
+                    useSet.set(iter->second);
+                }
+            }
+
+            if (isMove) {
+                auto iter = varIndex.find(inst->getOperand(0));
+                if (iter != varIndex.end()) {
+                    defSet.set(iter->second);
+                }
+            }
+        }
+    }
+
+    // 反向数据流迭代求活跃变量，按逆后序的逆序处理收敛较快
+    std::vector<BitSet> liveIn(blocks.size(), BitSet(varNum));
+    std::vector<BitSet> liveOut(blocks.size(), BitSet(varNum));
+
+    std::vector<BasicBlock *> order = cfg.reversePostOrder();
+    std::reverse(order.begin(), order.end());
+
+    // in = use ∪ (out - def)，逐字运算
+    BitSet in(varNum);
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        for (auto bb: order) {
+
+            BitSet & out = liveOut[bb->getIndex()];
+            for (auto succ: bb->getSuccs()) {
+                out |= liveIn[succ->getIndex()];
+            }
+
+            in = out;
+            in -= defSets[bb->getIndex()];
+            in |= useSets[bb->getIndex()];
+
+            if (liveIn[bb->getIndex()].unionWith(in)) {
+                changed = true;
+            }
+        }
+    }
+
+    // 每个基本块从出口反向扫描，赋值时目的变量不活跃则是死存储
+    bool removed = false;
+
+    for (auto bb: order) {
+
+        BitSet live = liveOut[bb->getIndex()];
+        std::vector<Instruction *> & insts = bb->getInsts();
+
+        for (auto iter = insts.rbegin(); iter != insts.rend(); ++iter) {
+
+            Instruction * inst = *iter;
+            if (inst->isDead()) {
+                continue;
+            }
+
+            bool isMove = inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN;
+
+            if (isMove) {
+                auto dstIter = varIndex.find(inst->getOperand(0));
+                if (dstIter != varIndex.end()) {
+                    if (!live.test(dstIter->second)) {
+                        killInst(inst);
+                        removed = true;
+                        continue;
+                    }
+                    live.reset(dstIter->second);
+                }
+            }
+
+            for (int32_t k = isMove ? 1 : 0; k < inst->getOperandsNum(); ++k) {
+                auto srcIter = varIndex.find(inst->getOperand(k));
+                if (srcIter != varIndex.end()) {
+                    live.set(srcIter->second);
+                }
+            }
+        }
+    }
+
+    return removed;
+}
+
+/// @brief 删除函数中不再使用的局部变量，返回值变量保留
+void DeadCodeElimination::removeUnusedVars()
+{
+    std::vector<LocalVariable *> & vars = func->getVarValues();
+
+    auto last = std::remove_if(vars.begin(), vars.end(), [this](LocalVariable * var) {
+        if (var == func->getReturnValue() || !var->getUses().empty()) {
+            return false;
+        }
+        delete var;
+        return true;
+    });
+
+    vars.erase(last, vars.end());
+}
+
+/// @brief 执行优化
+/// @return true 函数的IR发生了变化 false 没有变化
+bool DeadCodeElimination::run()
+{
+    if (cfg.getBlocks().empty()) {
+        return false;
+    }
+
+    for (auto var: func->getVarValues()) {
+        varIndex[var] = (int32_t) varIndex.size();
+    }
+
+    // 两种删除互相影响：删除死存储会减少临时变量的使用，删除指令会减少局部变量的读取
+    bool changed = true;
+    while (changed) {
+        changed = removeUnusedInsts();
+        changed = removeDeadStores() || changed;
+    }
+
+    if (removedCount > 0) {
+        cfg.writeBack();
+        removeUnusedVars();
+
+        minic_log(LOG_INFO, "函数%s: 死代码删除%d条指令", func->getName().c_str(), removedCount);
+    }
+
+    return removedCount > 0;
+}
@@ -0,0 +1,100 @@
+///
+/// @file DeadCodeElimination.h
+/// @brief 基于定值-使用链的死代码删除与死存储删除
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "ControlFlowGraph.h"
+#include "Pass.h"
+
+///
+/// @brief 死代码删除。没有使用的无副作用指令通过工作表沿着Value::uses删除，
+/// 对局部变量的赋值若之后不会再被读取(局部变量活跃性分析)则作为死存储删除，两者交替迭代到不动点
+///
+class DeadCodeElimination : public FunctionPass {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    /// @param _func 要优化的函数
+    ///
+    DeadCodeElimination(Module * _module, Function * _func);
+
+    ///
+    /// @brief 执行优化
+    /// @return true 函数的IR发生了变化 false 没有变化
+    ///
+    bool run() override;
+
+    ///
+    /// @brief 获取删除的指令数
+    /// @return int32_t 指令数
+    ///
+    [[nodiscard]] int32_t getRemovedCount() const
+    {
+        return removedCount;
+    }
+
+private:
+    ///
+    /// @brief 删除指令，并立即解除其对操作数的使用，使得操作数的uses保持准确
+    /// @param inst 指令
+    ///
+    void killInst(Instruction * inst);
+
+    ///
+    /// @brief 指令是否没有副作用，结果不使用时可以删除
+    /// @param inst 指令
+    /// @return true 没有副作用 false 有
+    ///
+    static bool isSideEffectFree(Instruction * inst);
+
+    ///
+    /// @brief 删除没有使用的无副作用指令
+    /// @return true 有删除 false 没有
+    ///
+    bool removeUnusedInsts();
+
+    ///
+    /// @brief 通过局部变量的活跃性分析删除死存储
+    /// @return true 有删除 false 没有
+    ///
+    bool removeDeadStores();
+
+    ///
+    /// @brief 删除函数中不再使用的局部变量
+    ///
+    void removeUnusedVars();
+
+    ///
+    /// @brief 控制流图
+    ///
+    ControlFlowGraph cfg;
+
+    ///
+    /// @brief 局部变量到编号的映射
+    ///
+    std::unordered_map<Value *, int32_t> varIndex;
+
+    ///
+    /// @brief 删除的指令数
+    ///
+    int32_t removedCount = 0;
+};
@@ -0,0 +1,155 @@
+///
+/// @file DominatorTree.cpp
+/// @brief 控制流图的支配树
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <utility>
+
+#include "DominatorTree.h"
+
+/// @brief 构造函数，根据控制流图计算支配树
+/// @param _cfg 控制流图
+DominatorTree::DominatorTree(ControlFlowGraph & _cfg) : cfg(_cfg)
+{
+    size_t blockNum = cfg.getBlocks().size();
+
+    rpo = cfg.reversePostOrder();
+    rpoIndex.assign(blockNum, -1);
+    idoms.assign(blockNum, -1);
+    children.assign(blockNum, {});
+    enterTime.assign(blockNum, -1);
+    leaveTime.assign(blockNum, -1);
+
+    if (rpo.empty()) {
+        return;
+    }
+
+    for (size_t k = 0; k < rpo.size(); ++k) {
+        rpoIndex[rpo[k]->getIndex()] = (int32_t) k;
+    }
+
+    int32_t entry = rpo[0]->getIndex();
+    idoms[entry] = entry;
+
+    // 按逆后序迭代直到不动点
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        for (size_t k = 1; k < rpo.size(); ++k) {
+
+            BasicBlock * bb = rpo[k];
+            int32_t newIdom = -1;
+
+            for (auto pred: bb->getPreds()) {
+                if (idoms[pred->getIndex()] == -1) {
+                    // 前驱还没有处理或者不可达
+                    continue;
+                }
+                newIdom = (newIdom == -1) ? pred->getIndex() : intersect(pred->getIndex(), newIdom);
+            }
+
+            if (newIdom != idoms[bb->getIndex()]) {
+                idoms[bb->getIndex()] = newIdom;
+                changed = true;
+            }
+        }
+    }
+
+    for (size_t k = 1; k < rpo.size(); ++k) {
+        BasicBlock * bb = rpo[k];
+        children[idoms[bb->getIndex()]].push_back(bb);
+    }
+
+    // 非递归先序遍历，记录进入与离开的时间
+    int32_t clock = 0;
+    std::vector<std::pair<BasicBlock *, size_t>> stack;
+    stack.emplace_back(rpo[0], 0);
+    enterTime[entry] = clock++;
+
+    while (!stack.empty()) {
+        auto & top = stack.back();
+        std::vector<BasicBlock *> & kids = children[top.first->getIndex()];
+        if (top.second < kids.size()) {
+            BasicBlock * child = kids[top.second++];
+            enterTime[child->getIndex()] = clock++;
+            stack.emplace_back(child, 0);
+        } else {
+            leaveTime[top.first->getIndex()] = clock++;
+            stack.pop_back();
+        }
+    }
+}
+
+/// @brief 求两个结点在支配树上的最近公共祖先
+/// @param a 基本块序号
+/// @param b 基本块序号
+/// @return int32_t 公共祖先的序号
+int32_t DominatorTree::intersect(int32_t a, int32_t b)
+{
+    while (a != b) {
+        while (rpoIndex[a] > rpoIndex[b]) {
+            a = idoms[a];
+        }
+        while (rpoIndex[b] > rpoIndex[a]) {
+            b = idoms[b];
+        }
+    }
+
+    return a;
+}
+
+/// @brief 获取直接支配结点
+/// @param bb 基本块
+/// @return BasicBlock* 直接支配结点，入口或不可达的基本块为空
+BasicBlock * DominatorTree::getIdom(BasicBlock * bb)
+{
+    int32_t idom = idoms[bb->getIndex()];
+    if (idom == -1 || idom == bb->getIndex()) {
+        return nullptr;
+    }
+
+    return cfg.getBlocks()[idom];
+}
+
+/// @brief 获取支配树上的孩子结点
+/// @param bb 基本块
+/// @return std::vector<BasicBlock *>& 孩子结点
+std::vector<BasicBlock *> & DominatorTree::getChildren(BasicBlock * bb)
+{
+    return children[bb->getIndex()];
+}
+
+/// @brief 基本块a是否支配基本块b
+/// @param a 基本块
+/// @param b 基本块
+/// @return true 支配 false 不支配
+bool DominatorTree::dominates(BasicBlock * a, BasicBlock * b)
+{
+    if (!isReachable(a) || !isReachable(b)) {
+        return false;
+    }
+
+    return enterTime[a->getIndex()] <= enterTime[b->getIndex()] &&
+           leaveTime[b->getIndex()] <= leaveTime[a->getIndex()];
+}
+
+/// @brief 基本块是否从入口可达
+/// @param bb 基本块
+/// @return true 可达 false 不可达
+bool DominatorTree::isReachable(BasicBlock * bb)
+{
+    return rpoIndex[bb->getIndex()] != -1;
+}
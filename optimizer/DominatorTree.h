@@ -0,0 +1,112 @@
+///
+/// @file DominatorTree.h
+/// @brief 控制流图的支配树
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <vector>
+
+#include "ControlFlowGraph.h"
+
+///
+/// @brief 支配树，采用Cooper-Harvey-Kennedy的迭代算法计算直接支配结点。
+/// 从入口不可达的基本块不在支配树中
+///
+class DominatorTree {
+
+public:
+    ///
+    /// @brief 构造函数，根据控制流图计算支配树
+    /// @param _cfg 控制流图
+    ///
+    explicit DominatorTree(ControlFlowGraph & _cfg);
+
+    ///
+    /// @brief 获取直接支配结点
+    /// @param bb 基本块
+    /// @return BasicBlock* 直接支配结点，入口或不可达的基本块为空
+    ///
+    BasicBlock * getIdom(BasicBlock * bb);
+
+    ///
+    /// @brief 获取支配树上的孩子结点
+    /// @param bb 基本块
+    /// @return std::vector<BasicBlock *>& 孩子结点
+    ///
+    std::vector<BasicBlock *> & getChildren(BasicBlock * bb);
+
+    ///
+    /// @brief 基本块a是否支配基本块b，基本块支配自身
+    /// @param a 基本块
+    /// @param b 基本块
+    /// @return true 支配 false 不支配
+    ///
+    bool dominates(BasicBlock * a, BasicBlock * b);
+
+    ///
+    /// @brief 基本块是否从入口可达
+    /// @param bb 基本块
+    /// @return true 可达 false 不可达
+    ///
+    bool isReachable(BasicBlock * bb);
+
+    ///
+    /// @brief 获取可达基本块的逆后序
+    /// @return std::vector<BasicBlock *>& 逆后序
+    ///
+    std::vector<BasicBlock *> & getReversePostOrder()
+    {
+        return rpo;
+    }
+
+private:
+    ///
+    /// @brief 求两个结点在支配树上的最近公共祖先
+    /// @param a 基本块序号
+    /// @param b 基本块序号
+    /// @return int32_t 公共祖先的序号
+    ///
+    int32_t intersect(int32_t a, int32_t b);
+
+    ///
+    /// @brief 控制流图
+    ///
+    ControlFlowGraph & cfg;
+
+    ///
+    /// @brief 可达基本块的逆后序
+    ///
+    std::vector<BasicBlock *> rpo;
+
+    ///
+    /// @brief 基本块在逆后序中的位置，不可达的为-1
+    ///
+    std::vector<int32_t> rpoIndex;
+
+    ///
+    /// @brief 直接支配结点的基本块序号，入口为自身，不可达的为-1
+    ///
+    std::vector<int32_t> idoms;
+
+    ///
+    /// @brief 支配树上的孩子结点
+    ///
+    std::vector<std::vector<BasicBlock *>> children;
+
+    ///
+    /// @brief 支配树先序遍历的进入与离开时间，用于O(1)判断支配关系
+    ///
+    std::vector<int32_t> enterTime, leaveTime;
+};
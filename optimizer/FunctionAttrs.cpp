@@ -0,0 +1,187 @@
+///
+/// @file FunctionAttrs.cpp
+/// @brief 函数属性推导：纯函数、不修改全局变量、不递归、一定返回、返回常量
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "FunctionAttrs.h"
+#include "ConstInt.h"
+#include "FuncCallInstruction.h"
+#include "GlobalVariable.h"
+#include "GotoInstruction.h"
+
+/// @brief 构造函数，同时设置内置函数的属性
+/// @param _module 符号表
+/// @param _callGraph 调用图
+FunctionAttrs::FunctionAttrs(Module * _module, CallGraph & _callGraph) : module(_module), callGraph(_callGraph)
+{
+    for (auto func: module->getFunctionList()) {
+        if (func->isBuiltin()) {
+            Function::Attributes & attrs = func->getAttributes();
+            attrs.noGlobalReads = true;
+            attrs.noGlobalWrites = true;
+            attrs.noRecurse = true;
+            attrs.willReturn = true;
+        }
+    }
+}
+
+/// @brief 函数内是否有向前的跳转，即可能存在循环
+/// @param func 函数
+/// @return true 有 false 没有
+bool FunctionAttrs::hasBackwardJump(Function * func)
+{
+    std::vector<Instruction *> & insts = func->getInterCode().getInsts();
+    std::unordered_map<Instruction *, size_t> labelPos;
+
+    for (size_t k = 0; k < insts.size(); ++k) {
+
+        Instruction * inst = insts[k];
+
+        if (inst->isDead()) {
+            continue;
+        }
+
+        if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
+            labelPos[inst] = k;
+        } else if (inst->getOp() == IRInstOperator::IRINST_OP_GOTO) {
+
+            // 目标Label已经出现过，说明是向前跳转
+            GotoInstruction * gotoInst = static_cast<GotoInstruction *>(inst);
+            if (labelPos.count(gotoInst->getTarget()) ||
+                (gotoInst->isConditionalBranch() && labelPos.count(gotoInst->getFalseTarget()))) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/// @brief 推导函数是否总是返回同一个常量
+/// @param func 函数
+void FunctionAttrs::computeReturnsConst(Function * func)
+{
+    Function::Attributes & attrs = func->getAttributes();
+    attrs.returnsConst = false;
+
+    LocalVariable * retValue = func->getReturnValue();
+    if (retValue == nullptr) {
+        return;
+    }
+
+    // 出口指令的操作数可能已被常量传播替换为常量
+    for (auto inst: func->getInterCode().getInsts()) {
+        if (!inst->isDead() && inst->getOp() == IRInstOperator::IRINST_OP_EXIT && inst->getOperandsNum() > 0) {
+            Instanceof(constVal, ConstInt *, inst->getOperand(0));
+            if (constVal) {
+                attrs.returnsConst = true;
+                attrs.constValue = constVal->getVal();
+                return;
+            }
+            if (inst->getOperand(0) != retValue) {
+                return;
+            }
+        }
+    }
+
+    bool found = false;
+    int32_t value = 0;
+
+    for (auto inst: func->getInterCode().getInsts()) {
+
+        if (inst->isDead() || inst->getOp() != IRInstOperator::IRINST_OP_ASSIGN || inst->getOperand(0) != retValue) {
+            continue;
+        }
+
+        Instanceof(constVal, ConstInt *, inst->getOperand(1));
+        if (constVal == nullptr || (found && constVal->getVal() != value)) {
+            return;
+        }
+
+        found = true;
+        value = constVal->getVal();
+    }
+
+    attrs.returnsConst = found;
+    attrs.constValue = value;
+}
+
+/// @brief 推导一个强连通分量内函数的属性
+/// @param scc 强连通分量
+void FunctionAttrs::run(std::vector<Function *> & scc)
+{
+    // 分量内的函数可能互相调用，对全局变量的读写与副作用合并计算
+    bool readsGlobals = false;
+    bool writesGlobals = false;
+    bool sideEffects = false;
+
+    for (auto func: scc) {
+        for (auto inst: func->getInterCode().getInsts()) {
+
+            if (inst->isDead()) {
+                continue;
+            }
+
+            if (inst->getOp() == IRInstOperator::IRINST_OP_FUNC_CALL) {
+
+                Function * callee = static_cast<FuncCallInstruction *>(inst)->calledFunction;
+
+                if (std::find(scc.begin(), scc.end(), callee) == scc.end()) {
+                    Function::Attributes & calleeAttrs = callee->getAttributes();
+                    readsGlobals = readsGlobals || !calleeAttrs.noGlobalReads;
+                    writesGlobals = writesGlobals || !calleeAttrs.noGlobalWrites;
+                    sideEffects = sideEffects || !calleeAttrs.pure;
+                }
+            }
+
+            // 赋值指令的第一个操作数是目的操作数，其它都是读取
+            for (int32_t k = 0; k < inst->getOperandsNum(); ++k) {
+                Instanceof(globalVar, GlobalVariable *, inst->getOperand(k));
+                if (globalVar) {
+                    if (k == 0 && inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN) {
+                        writesGlobals = true;
+                    } else {
+                        readsGlobals = true;
+                    }
+                }
+            }
+        }
+    }
+
+    for (auto func: scc) {
+
+        Function::Attributes & attrs = func->getAttributes();
+
+        attrs.noGlobalReads = !readsGlobals;
+        attrs.noGlobalWrites = !writesGlobals;
+        attrs.pure = !readsGlobals && !writesGlobals && !sideEffects;
+        attrs.noRecurse = !callGraph.isRecursive(func);
+
+        // 被调用函数都一定返回，且自身没有循环与递归时一定返回
+        attrs.willReturn = attrs.noRecurse && !hasBackwardJump(func);
+
+        for (auto inst: func->getInterCode().getInsts()) {
+            if (!inst->isDead() && inst->getOp() == IRInstOperator::IRINST_OP_FUNC_CALL &&
+                !static_cast<FuncCallInstruction *>(inst)->calledFunction->getAttributes().willReturn) {
+                attrs.willReturn = false;
+            }
+        }
+
+        computeReturnsConst(func);
+    }
+}
@@ -0,0 +1,68 @@
+///
+/// @file FunctionAttrs.h
+/// @brief 函数属性推导：纯函数、不修改全局变量、不递归、一定返回、返回常量
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <vector>
+
+#include "CallGraph.h"
+#include "Module.h"
+
+///
+/// @brief 函数属性推导。按调用图自底向上，每个强连通分量在其函数优化之后推导，
+/// 分量外的被调用函数已有属性，分量内的函数对全局变量的访问与副作用合并计算。
+/// 内置函数只做输入输出，不访问全局变量
+///
+class FunctionAttrs {
+
+public:
+    ///
+    /// @brief 构造函数，同时设置内置函数的属性
+    /// @param _module 符号表
+    /// @param _callGraph 调用图
+    ///
+    FunctionAttrs(Module * _module, CallGraph & _callGraph);
+
+    ///
+    /// @brief 推导一个强连通分量内函数的属性
+    /// @param scc 强连通分量
+    ///
+    void run(std::vector<Function *> & scc);
+
+private:
+    ///
+    /// @brief 推导函数是否总是返回同一个常量
+    /// @param func 函数
+    ///
+    static void computeReturnsConst(Function * func);
+
+    ///
+    /// @brief 函数内是否有向前的跳转，即可能存在循环
+    /// @param func 函数
+    /// @return true 有 false 没有
+    ///
+    static bool hasBackwardJump(Function * func);
+
+    ///
+    /// @brief 符号表
+    ///
+    Module * module;
+
+    ///
+    /// @brief 调用图
+    ///
+    CallGraph & callGraph;
+};
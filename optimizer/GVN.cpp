@@ -0,0 +1,310 @@
+///
+/// @file GVN.cpp
+/// @brief 基于支配树作用域的全局值编号，消除公共子表达式
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <utility>
+
+#include "GVN.h"
+#include "ConstInt.h"
+#include "OptUtils.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _func 要优化的函数
+GVN::GVN(Module * _module, Function * _func) : FunctionPass(_module, _func), cfg(_func)
+{}
+
+/// @brief 获取操作数的值编号
+/// @param val 操作数
+/// @return int32_t 值编号
+int32_t GVN::getNumber(Value * val)
+{
+    Instanceof(constVal, ConstInt *, val);
+    if (constVal) {
+        auto iter = constNumbers.find(constVal->getVal());
+        if (iter != constNumbers.end()) {
+            return iter->second;
+        }
+        return constNumbers[constVal->getVal()] = nextNumber++;
+    }
+
+    auto instIter = instNumbers.find(val);
+    if (instIter != instNumbers.end()) {
+        return instIter->second;
+    }
+
+    Instanceof(inst, Instruction *, val);
+    if (inst) {
+        // 定值不支配当前位置的指令结果，给一个新编号，不会与其它表达式相同
+        return instNumbers[val] = nextNumber++;
+    }
+
+    // 局部变量、形参与全局变量，第一次遇到时给一个新编号
+    auto varIter = varNumbers.find(val);
+    if (varIter != varNumbers.end()) {
+        return varIter->second;
+    }
+
+    int32_t number = nextNumber++;
+    setVarNumber(val, number);
+
+    return number;
+}
+
+/// @brief 设置变量的值编号，并记录恢复日志
+/// @param var 变量
+/// @param number 值编号
+void GVN::setVarNumber(Value * var, int32_t number)
+{
+    auto iter = varNumbers.find(var);
+    undoLog.push_back(UndoEntry{false, ExprKey{0, 0, 0}, var, nullptr, iter == varNumbers.end() ? -1 : iter->second});
+    varNumbers[var] = number;
+}
+
+/// @brief 构造运算指令的表达式键
+/// @param inst 运算指令
+/// @return ExprKey 表达式键
+GVN::ExprKey GVN::makeKey(Instruction * inst)
+{
+    IRInstOperator op = inst->getOp();
+
+    int32_t lhs = getNumber(inst->getOperand(0));
+    int32_t rhs = -1;
+    if (op != IRInstOperator::IRINST_OP_NEG_I) {
+        rhs = getNumber(inst->getOperand(1));
+    }
+
+    switch (op) {
+        case IRInstOperator::IRINST_OP_ADD_I:
+        case IRInstOperator::IRINST_OP_MUL_I:
+        case IRInstOperator::IRINST_OP_EQ_I:
+        case IRInstOperator::IRINST_OP_NE_I:
+            // 可交换的运算，操作数按编号排序
+            if (lhs > rhs) {
+                std::swap(lhs, rhs);
+            }
+            break;
+        case IRInstOperator::IRINST_OP_GT_I:
+            // a > b 等价于 b < a
+            op = IRInstOperator::IRINST_OP_LT_I;
+            std::swap(lhs, rhs);
+            break;
+        case IRInstOperator::IRINST_OP_GE_I:
+            // a >= b 等价于 b <= a
+            op = IRInstOperator::IRINST_OP_LE_I;
+            std::swap(lhs, rhs);
+            break;
+        default:
+            break;
+    }
+
+    return ExprKey{(int32_t) op, lhs, rhs};
+}
+
+/// @brief 求在直接支配结点与基本块之间的路径上被赋值的变量，这些变量在基本块入口需要重新编号
+/// @param bb 基本块
+/// @param idom 直接支配结点
+void GVN::killOnPaths(BasicBlock * bb, BasicBlock * idom)
+{
+    std::vector<BasicBlock *> & preds = bb->getPreds();
+
+    // 唯一的前驱就是直接支配结点时，路径上没有其它基本块
+    if (preds.size() == 1 && preds[0] == idom) {
+        return;
+    }
+
+    // 从前驱开始反向遍历，不经过直接支配结点，遍历到的基本块都在支配结点到当前基本块的路径上
+    std::vector<char> visited(cfg.getBlocks().size(), 0);
+    std::vector<BasicBlock *> stack;
+    std::unordered_set<Value *> killed;
+    bool hasCall = false;
+
+    for (auto pred: preds) {
+        if (pred != idom && !visited[pred->getIndex()]) {
+            visited[pred->getIndex()] = 1;
+            stack.push_back(pred);
+        }
+    }
+
+    while (!stack.empty()) {
+
+        BasicBlock * cur = stack.back();
+        stack.pop_back();
+
+        killed.insert(blockDefs[cur->getIndex()].begin(), blockDefs[cur->getIndex()].end());
+        hasCall = hasCall || blockHasCall[cur->getIndex()];
+
+        for (auto pred: cur->getPreds()) {
+            if (pred != idom && !visited[pred->getIndex()]) {
+                visited[pred->getIndex()] = 1;
+                stack.push_back(pred);
+            }
+        }
+    }
+
+    if (hasCall) {
+        for (auto global: module->getGlobalVariables()) {
+            killed.insert(global);
+        }
+    }
+
+    for (auto var: killed) {
+        setVarNumber(var, nextNumber++);
+    }
+}
+
+/// @brief 对基本块进行值编号并消除冗余的计算
+/// @param bb 基本块
+void GVN::visitBlock(BasicBlock * bb)
+{
+    for (auto inst: bb->getInsts()) {
+
+        IRInstOperator op = inst->getOp();
+
+        if (op == IRInstOperator::IRINST_OP_ASSIGN) {
+
+            // 赋值后变量的值编号与源操作数相同
+            setVarNumber(inst->getOperand(0), getNumber(inst->getOperand(1)));
+
+        } else if (op == IRInstOperator::IRINST_OP_FUNC_CALL) {
+
+            // 被调函数可能修改全局变量
+            if (callMayWriteGlobals(inst)) {
+                for (auto global: module->getGlobalVariables()) {
+                    setVarNumber(global, nextNumber++);
+                }
+            }
+
+            if (inst->hasResultValue()) {
+                instNumbers[inst] = nextNumber++;
+            }
+
+        } else if (isArithOp(op)) {
+
+            ExprKey key = makeKey(inst);
+
+            auto iter = exprTable.find(key);
+            if (iter != exprTable.end()) {
+
+                // 支配结点中已经计算过，直接使用原来的结果
+                Instruction * prev = iter->second;
+                instNumbers[inst] = instNumbers[prev];
+                inst->replaceAllUsesWith(prev);
+                inst->setDead();
+                removedCount++;
+
+            } else {
+
+                undoLog.push_back(UndoEntry{true, key, nullptr, nullptr, -1});
+                exprTable[key] = inst;
+                instNumbers[inst] = nextNumber++;
+            }
+
+        } else if (inst->hasResultValue()) {
+            instNumbers[inst] = nextNumber++;
+        }
+    }
+}
+
+/// @brief 撤销恢复日志到指定的位置
+/// @param mark 日志位置
+void GVN::undoTo(size_t mark)
+{
+    while (undoLog.size() > mark) {
+
+        UndoEntry & entry = undoLog.back();
+
+        if (entry.isExpr) {
+            if (entry.oldInst) {
+                exprTable[entry.key] = entry.oldInst;
+            } else {
+                exprTable.erase(entry.key);
+            }
+        } else {
+            if (entry.oldNumber == -1) {
+                varNumbers.erase(entry.var);
+            } else {
+                varNumbers[entry.var] = entry.oldNumber;
+            }
+        }
+
+        undoLog.pop_back();
+    }
+}
+
+/// @brief 执行优化
+/// @return true 函数的IR发生了变化 false 没有变化
+bool GVN::run()
+{
+    if (cfg.getBlocks().empty()) {
+        return false;
+    }
+
+    DominatorTree domTree(cfg);
+
+    // 统计各基本块内被赋值的变量以及是否有函数调用
+    blockDefs.assign(cfg.getBlocks().size(), {});
+    blockHasCall.assign(cfg.getBlocks().size(), 0);
+
+    for (auto bb: cfg.getBlocks()) {
+        for (auto inst: bb->getInsts()) {
+            if (inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN) {
+                blockDefs[bb->getIndex()].insert(inst->getOperand(0));
+            } else if (inst->getOp() == IRInstOperator::IRINST_OP_FUNC_CALL && callMayWriteGlobals(inst)) {
+                blockHasCall[bb->getIndex()] = 1;
+            }
+        }
+    }
+
+    // 非递归的支配树先序遍历，离开结点时撤销其作用域内的修改
+    struct Frame {
+        BasicBlock * bb;
+        size_t childPos;
+        size_t mark;
+    };
+
+    std::vector<Frame> stack;
+
+    BasicBlock * entry = cfg.getEntry();
+    stack.push_back(Frame{entry, 0, undoLog.size()});
+    visitBlock(entry);
+
+    while (!stack.empty()) {
+
+        Frame & top = stack.back();
+        std::vector<BasicBlock *> & children = domTree.getChildren(top.bb);
+
+        if (top.childPos < children.size()) {
+
+            BasicBlock * child = children[top.childPos++];
+            BasicBlock * parent = top.bb;
+
+            stack.push_back(Frame{child, 0, undoLog.size()});
+            killOnPaths(child, parent);
+            visitBlock(child);
+
+        } else {
+            undoTo(top.mark);
+            stack.pop_back();
+        }
+    }
+
+    if (removedCount > 0) {
+        cfg.writeBack();
+    }
+
+    return removedCount > 0;
+}
@@ -0,0 +1,194 @@
+///
+/// @file GVN.h
+/// @brief 基于支配树作用域的全局值编号，消除公共子表达式
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ControlFlowGraph.h"
+#include "DominatorTree.h"
+#include "Pass.h"
+
+///
+/// @brief 全局值编号。按照支配树先序遍历，表达式(运算符, 操作数值编号)的哈希表随支配树作用域进出而恢复，
+/// 支配结点中计算过的表达式在被支配的基本块中可直接复用。
+/// IR不是SSA形式，变量的值编号在赋值时更新，在支配结点与当前基本块之间的路径上被赋值的变量需重新编号
+///
+class GVN : public FunctionPass {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    /// @param _func 要优化的函数
+    ///
+    GVN(Module * _module, Function * _func);
+
+    ///
+    /// @brief 执行优化
+    /// @return true 函数的IR发生了变化 false 没有变化
+    ///
+    bool run() override;
+
+private:
+    ///
+    /// @brief 表达式的键：运算符与两个操作数的值编号
+    ///
+    struct ExprKey {
+
+        int32_t op;
+
+        int32_t lhs;
+
+        int32_t rhs;
+
+        bool operator==(const ExprKey & other) const
+        {
+            return op == other.op && lhs == other.lhs && rhs == other.rhs;
+        }
+    };
+
+    ///
+    /// @brief 表达式键的哈希函数
+    ///
+    struct ExprKeyHash {
+        size_t operator()(const ExprKey & key) const
+        {
+            size_t h = (size_t) key.op;
+            h = h * 1000003u ^ (size_t) (uint32_t) key.lhs;
+            h = h * 1000003u ^ (size_t) (uint32_t) key.rhs;
+            return h;
+        }
+    };
+
+    ///
+    /// @brief 作用域恢复日志的记录，离开支配树结点时按逆序撤销
+    ///
+    struct UndoEntry {
+
+        ///
+        /// @brief 为真时恢复表达式表，否则恢复变量的值编号
+        ///
+        bool isExpr;
+
+        ExprKey key;
+
+        Value * var;
+
+        ///
+        /// @brief 原来的表达式结果，为空表示原来不存在
+        ///
+        Instruction * oldInst;
+
+        ///
+        /// @brief 原来变量的值编号，-1表示原来不存在
+        ///
+        int32_t oldNumber;
+    };
+
+    ///
+    /// @brief 获取操作数的值编号
+    /// @param val 操作数
+    /// @return int32_t 值编号
+    ///
+    int32_t getNumber(Value * val);
+
+    ///
+    /// @brief 设置变量的值编号，并记录恢复日志
+    /// @param var 变量
+    /// @param number 值编号
+    ///
+    void setVarNumber(Value * var, int32_t number);
+
+    ///
+    /// @brief 构造运算指令的表达式键，可交换运算的操作数按编号排序，大于类比较转换为小于类比较
+    /// @param inst 运算指令
+    /// @return ExprKey 表达式键
+    ///
+    ExprKey makeKey(Instruction * inst);
+
+    ///
+    /// @brief 求在直接支配结点与基本块之间的路径上被赋值的变量，这些变量在基本块入口需要重新编号
+    /// @param bb 基本块
+    /// @param idom 直接支配结点
+    ///
+    void killOnPaths(BasicBlock * bb, BasicBlock * idom);
+
+    ///
+    /// @brief 对基本块进行值编号并消除冗余的计算
+    /// @param bb 基本块
+    ///
+    void visitBlock(BasicBlock * bb);
+
+    ///
+    /// @brief 撤销恢复日志到指定的位置
+    /// @param mark 日志位置
+    ///
+    void undoTo(size_t mark);
+
+    ///
+    /// @brief 控制流图
+    ///
+    ControlFlowGraph cfg;
+
+    ///
+    /// @brief 下一个可用的值编号
+    ///
+    int32_t nextNumber = 0;
+
+    ///
+    /// @brief 整数常量的值编号
+    ///
+    std::unordered_map<int32_t, int32_t> constNumbers;
+
+    ///
+    /// @brief 指令结果的值编号，指令只定值一次，因此不需要恢复
+    ///
+    std::unordered_map<Value *, int32_t> instNumbers;
+
+    ///
+    /// @brief 变量当前的值编号
+    ///
+    std::unordered_map<Value *, int32_t> varNumbers;
+
+    ///
+    /// @brief 表达式到计算它的指令的映射
+    ///
+    std::unordered_map<ExprKey, Instruction *, ExprKeyHash> exprTable;
+
+    ///
+    /// @brief 作用域恢复日志
+    ///
+    std::vector<UndoEntry> undoLog;
+
+    ///
+    /// @brief 各基本块内被赋值的变量
+    ///
+    std::vector<std::unordered_set<Value *>> blockDefs;
+
+    ///
+    /// @brief 各基本块是否有函数调用，函数调用可能修改全局变量
+    ///
+    std::vector<char> blockHasCall;
+
+    ///
+    /// @brief 被消除的指令数
+    ///
+    int32_t removedCount = 0;
+};
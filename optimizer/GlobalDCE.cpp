@@ -0,0 +1,89 @@
+///
+/// @file GlobalDCE.cpp
+/// @brief 删除从main函数不可达的函数以及没有使用的全局变量
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <unordered_set>
+#include <vector>
+
+#include "GlobalDCE.h"
+#include "CallGraph.h"
+#include "Common.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+GlobalDCE::GlobalDCE(Module * _module) : module(_module)
+{}
+
+/// @brief 执行优化
+/// @return true 删除了函数或全局变量 false 没有变化
+bool GlobalDCE::run()
+{
+    Function * mainFunc = module->findFunction("main");
+    if (mainFunc == nullptr) {
+        return false;
+    }
+
+    // 调用图按当前的IR建立，内联后不再调用的函数不可达
+    CallGraph callGraph(module);
+
+    std::unordered_set<Function *> reachable{mainFunc};
+    std::vector<Function *> worklist{mainFunc};
+
+    while (!worklist.empty()) {
+        Function * func = worklist.back();
+        worklist.pop_back();
+
+        for (auto callee: callGraph.getCallees(func)) {
+            if (reachable.insert(callee).second) {
+                worklist.push_back(callee);
+            }
+        }
+    }
+
+    std::vector<Function *> deadFuncs;
+    for (auto func: module->getFunctionList()) {
+        if (!func->isBuiltin() && !reachable.count(func)) {
+            deadFuncs.push_back(func);
+        }
+    }
+
+    // 函数释放时解除其指令对全局变量的使用
+    for (auto func: deadFuncs) {
+        module->removeFunction(func);
+    }
+
+    std::vector<GlobalVariable *> deadGlobals;
+    for (auto var: module->getGlobalVariables()) {
+        if (var->getUses().empty()) {
+            deadGlobals.push_back(var);
+        }
+    }
+
+    for (auto var: deadGlobals) {
+        module->removeGlobalVariable(var);
+    }
+
+    if (deadFuncs.empty() && deadGlobals.empty()) {
+        return false;
+    }
+
+    minic_log(LOG_INFO,
+              "删除%d个不可达的函数，%d个没有使用的全局变量",
+              (int) deadFuncs.size(),
+              (int) deadGlobals.size());
+
+    return true;
+}
@@ -0,0 +1,45 @@
+///
+/// @file GlobalDCE.h
+/// @brief 删除从main函数不可达的函数以及没有使用的全局变量
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include "Module.h"
+
+///
+/// @brief 模块级的死代码删除。在调用图上从main函数出发，不可达的非内置函数删除，
+/// 之后不再被任何指令使用的全局变量删除。没有main函数时不做处理
+///
+class GlobalDCE {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    ///
+    explicit GlobalDCE(Module * _module);
+
+    ///
+    /// @brief 执行优化
+    /// @return true 删除了函数或全局变量 false 没有变化
+    ///
+    bool run();
+
+private:
+    ///
+    /// @brief 符号表
+    ///
+    Module * module;
+};
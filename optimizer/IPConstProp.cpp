@@ -0,0 +1,94 @@
+///
+/// @file IPConstProp.cpp
+/// @brief 过程间常量传播，所有调用点都传递同一个常量的形参替换为该常量
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <unordered_map>
+#include <vector>
+
+#include "IPConstProp.h"
+#include "Common.h"
+#include "ConstInt.h"
+#include "OptUtils.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _callGraph 调用图
+IPConstProp::IPConstProp(Module * _module, CallGraph & _callGraph) : module(_module), callGraph(_callGraph)
+{}
+
+/// @brief 执行优化
+/// @return true IR发生了变化 false 没有变化
+bool IPConstProp::run()
+{
+    // 收集每个函数的全部调用点
+    std::unordered_map<Function *, std::vector<FuncCallInstruction *>> callSites;
+
+    for (auto func: module->getFunctionList()) {
+        if (!func->isBuiltin()) {
+            for (auto callInst: callGraph.getCallInsts(func)) {
+                callSites[callInst->calledFunction].push_back(callInst);
+            }
+        }
+    }
+
+    int32_t propagatedCount = 0;
+
+    for (auto func: module->getFunctionList()) {
+
+        if (func->isBuiltin() || func->getName() == "main") {
+            continue;
+        }
+
+        auto iter = callSites.find(func);
+        if (iter == callSites.end()) {
+            continue;
+        }
+
+        std::vector<FormalParam *> & params = func->getParams();
+
+        for (int32_t k = 0; k < (int32_t) params.size(); ++k) {
+
+            if (params[k]->getUses().empty()) {
+                continue;
+            }
+
+            ConstInt * value = nullptr;
+            bool same = true;
+
+            for (auto callInst: iter->second) {
+
+                Instanceof(arg, ConstInt *, k < callInst->getOperandsNum() ? callInst->getOperand(k) : nullptr);
+                if (arg == nullptr || (value && arg->getVal() != value->getVal())) {
+                    same = false;
+                    break;
+                }
+
+                value = arg;
+            }
+
+            if (same && value) {
+                params[k]->replaceAllUsesWith(value);
+                propagatedCount++;
+            }
+        }
+    }
+
+    if (propagatedCount > 0) {
+        minic_log(LOG_INFO, "过程间常量传播: %d个形参替换为常量", propagatedCount);
+    }
+
+    return propagatedCount > 0;
+}
@@ -0,0 +1,53 @@
+///
+/// @file IPConstProp.h
+/// @brief 过程间常量传播，所有调用点都传递同一个常量的形参替换为该常量
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include "CallGraph.h"
+#include "Module.h"
+
+///
+/// @brief 过程间常量传播。MiniC只有直接调用，调用图中的调用指令就是全部调用点，
+/// 某个形参在全部调用点的实参都是同一个常量时，函数内对形参的使用替换为该常量。
+/// main函数与没有调用点的函数不处理
+///
+class IPConstProp {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    /// @param _callGraph 调用图
+    ///
+    IPConstProp(Module * _module, CallGraph & _callGraph);
+
+    ///
+    /// @brief 执行优化
+    /// @return true IR发生了变化 false 没有变化
+    ///
+    bool run();
+
+private:
+    ///
+    /// @brief 符号表
+    ///
+    Module * module;
+
+    ///
+    /// @brief 调用图
+    ///
+    CallGraph & callGraph;
+};
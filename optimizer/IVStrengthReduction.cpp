@@ -0,0 +1,433 @@
+///
+/// @file IVStrengthReduction.cpp
+/// @brief 归纳变量的强度削弱、退出值替换与冗余归纳变量删除
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "IVStrengthReduction.h"
+#include "BinaryInstruction.h"
+#include "ConstInt.h"
+#include "DominatorTree.h"
+#include "IntegerType.h"
+#include "MoveInstruction.h"
+#include "OptUtils.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _func 要优化的函数
+IVStrengthReduction::IVStrengthReduction(Module * _module, Function * _func)
+    : FunctionPass(_module, _func), cfg(_func)
+{}
+
+/// @brief 删除指令，并立即解除其对操作数的使用
+/// @param inst 指令
+void IVStrengthReduction::killInst(Instruction * inst)
+{
+    inst->setDead();
+    inst->clearOperands();
+    changed = true;
+}
+
+/// @brief 乘法的结果能否用派生归纳变量代替
+/// @param mulInst 乘法指令
+/// @param iv 基本归纳变量
+/// @param ivInfo 归纳变量分析
+/// @return true 能 false 不能
+bool IVStrengthReduction::canReplaceUses(Instruction * mulInst, BasicIV * iv, InductionVariableInfo & ivInfo)
+{
+    BasicBlock * bb = ivInfo.getBlockOf(mulInst);
+    std::vector<Instruction *> & insts = bb->getInsts();
+
+    auto mulPos = std::find(insts.begin(), insts.end(), mulInst);
+    auto updatePos = iv->updateBlock == bb ? std::find(insts.begin(), insts.end(), iv->update) : insts.end();
+
+    for (auto use: mulInst->getUses()) {
+
+        Instanceof(user, Instruction *, use->getUser());
+        if (user == nullptr || ivInfo.getBlockOf(user) != bb) {
+            return false;
+        }
+
+        // 派生归纳变量在基本归纳变量更新后随之更新，使用处不能在更新之后
+        auto userPos = std::find(insts.begin(), insts.end(), user);
+        if (userPos < mulPos || (updatePos > mulPos && updatePos < userPos)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief 获取或创建派生归纳变量 iv * factor
+/// @param loop 循环
+/// @param iv 基本归纳变量
+/// @param factor 循环不变的乘数
+/// @return LocalVariable* 派生归纳变量
+LocalVariable * IVStrengthReduction::getDerivedIV(Loop * loop, BasicIV * iv, Value * factor)
+{
+    Instanceof(factorConst, ConstInt *, factor);
+
+    for (auto & derived: derivedIVs) {
+
+        if (derived.iv != iv) {
+            continue;
+        }
+
+        Instanceof(otherConst, ConstInt *, derived.factor);
+        if (derived.factor == factor || (factorConst && otherConst && factorConst->getVal() == otherConst->getVal())) {
+            return derived.var;
+        }
+    }
+
+    BasicBlock * preheader = loop->getPreheader();
+    Type * intType = IntegerType::getTypeInt();
+
+    // 前置块中计算初值 iv * factor
+    LocalVariable * var = func->newLocalVarValue(intType);
+
+    BinaryInstruction * initInst =
+        new (func) BinaryInstruction(func, IRInstOperator::IRINST_OP_MUL_I, iv->var, factor, intType);
+    preheader->insertBeforeTerminator(initInst);
+    preheader->insertBeforeTerminator(new (func) MoveInstruction(func, var, initInst));
+
+    // 每次迭代的增量 step * factor，乘数是常量时直接折叠
+    Value * increment;
+
+    if (factorConst) {
+        int32_t result;
+        (void) foldConstant(IRInstOperator::IRINST_OP_MUL_I, iv->step, factorConst->getVal(), result);
+        increment = module->newConstInt(result);
+    } else if (iv->step == 1) {
+        increment = factor;
+    } else {
+        BinaryInstruction * stepInst = new (func) BinaryInstruction(func,
+                                                                    IRInstOperator::IRINST_OP_MUL_I,
+                                                                    factor,
+                                                                    module->newConstInt(iv->step),
+                                                                    intType);
+        preheader->insertBeforeTerminator(stepInst);
+        increment = stepInst;
+    }
+
+    // 紧跟在基本归纳变量的赋值之后更新，保持 var == iv * factor
+    std::vector<Instruction *> & insts = iv->updateBlock->getInsts();
+    auto pos = std::find(insts.begin(), insts.end(), iv->update) + 1;
+
+    BinaryInstruction * addInst =
+        new (func) BinaryInstruction(func, IRInstOperator::IRINST_OP_ADD_I, var, increment, intType);
+    pos = insts.insert(pos, addInst) + 1;
+    insts.insert(pos, new (func) MoveInstruction(func, var, addInst));
+
+    derivedIVs.push_back(DerivedIV{iv, factor, var});
+
+    return var;
+}
+
+/// @brief 把循环内基本归纳变量与循环不变量的乘法改为加法递推
+/// @param loop 循环
+/// @param ivInfo 归纳变量分析
+void IVStrengthReduction::reduceMultiplies(Loop * loop, InductionVariableInfo & ivInfo)
+{
+    derivedIVs.clear();
+
+    std::vector<Instruction *> candidates;
+
+    for (auto bb: loop->getBlocks()) {
+        for (auto inst: bb->getInsts()) {
+            if (!inst->isDead() && inst->getOp() == IRInstOperator::IRINST_OP_MUL_I) {
+                candidates.push_back(inst);
+            }
+        }
+    }
+
+    for (auto mulInst: candidates) {
+
+        BasicIV * iv = ivInfo.getBasicIV(mulInst->getOperand(0));
+        Value * factor = mulInst->getOperand(1);
+
+        if (iv == nullptr) {
+            iv = ivInfo.getBasicIV(mulInst->getOperand(1));
+            factor = mulInst->getOperand(0);
+        }
+
+        if (iv == nullptr || !ivInfo.isInvariant(factor) || !canReplaceUses(mulInst, iv, ivInfo)) {
+            continue;
+        }
+
+        LocalVariable * var = getDerivedIV(loop, iv, factor);
+
+        mulInst->replaceAllUsesWith(var);
+        killInst(mulInst);
+    }
+}
+
+/// @brief 变量在基本块入口是否活跃
+/// @param bb 基本块
+/// @param var 变量
+/// @return true 活跃 false 不活跃
+bool IVStrengthReduction::isLiveAtEntry(BasicBlock * bb, Value * var)
+{
+    std::unordered_set<BasicBlock *> visited;
+    std::vector<BasicBlock *> stack{bb};
+
+    visited.insert(bb);
+
+    while (!stack.empty()) {
+
+        BasicBlock * cur = stack.back();
+        stack.pop_back();
+
+        bool defined = false;
+
+        for (auto inst: cur->getInsts()) {
+
+            if (inst->isDead()) {
+                continue;
+            }
+
+            bool isMove = inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN;
+
+            for (int32_t k = isMove ? 1 : 0; k < inst->getOperandsNum(); ++k) {
+                if (inst->getOperand(k) == var) {
+                    return true;
+                }
+            }
+
+            if (isMove && inst->getOperand(0) == var) {
+                defined = true;
+                break;
+            }
+        }
+
+        if (defined) {
+            continue;
+        }
+
+        for (auto succ: cur->getSuccs()) {
+            if (visited.insert(succ).second) {
+                stack.push_back(succ);
+            }
+        }
+    }
+
+    return false;
+}
+
+/// @brief 变量在循环的出口是否活跃
+/// @param loop 循环
+/// @param var 变量
+/// @return true 活跃 false 不活跃
+bool IVStrengthReduction::isLiveOut(Loop * loop, Value * var)
+{
+    for (auto exit: loop->getExitBlocks()) {
+        if (isLiveAtEntry(exit, var)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// @brief 迭代次数为常量时，在出口块把循环后用到的基本归纳变量赋值为退出值
+/// @param loop 循环
+/// @param ivInfo 归纳变量分析
+void IVStrengthReduction::replaceExitValues(Loop * loop, InductionVariableInfo & ivInfo)
+{
+    LoopExitTest * exitTest = ivInfo.getExitTest();
+    int64_t tripCount;
+
+    if (exitTest == nullptr || !ivInfo.getTripCount(tripCount)) {
+        return;
+    }
+
+    // 出口块只能从循环头进入，否则赋值会影响其它路径
+    BasicBlock * exitBlock = exitTest->exitBlock;
+    if (exitBlock->getPreds().size() != 1 || exitBlock->getLabel() == nullptr) {
+        return;
+    }
+
+    std::vector<Instruction *> & exitInsts = exitBlock->getInsts();
+
+    for (auto & iv: ivInfo.getBasicIVs()) {
+
+        if (!isLiveOut(loop, iv.var)) {
+            continue;
+        }
+
+        // 退出值 init + 更新次数 * step，按32位整数回绕。循环头在退出时多执行一次，其中的更新次数多1
+        int64_t updateCount = iv.updateBlock == loop->getHeader() ? tripCount + 1 : tripCount;
+        int32_t delta = (int32_t) (uint32_t) ((uint64_t) updateCount * (uint64_t) (int64_t) iv.step);
+        int32_t init;
+
+        if (ivInfo.getInitValue(&iv, init)) {
+
+            int32_t exitValue;
+            (void) foldConstant(IRInstOperator::IRINST_OP_ADD_I, init, delta, exitValue);
+            exitInsts.insert(exitInsts.begin() + 1,
+                             new (func) MoveInstruction(func, iv.var, module->newConstInt(exitValue)));
+
+        } else {
+
+            // 初值不是常量时，在前置块保存初值
+            Type * intType = IntegerType::getTypeInt();
+            LocalVariable * initVar = func->newLocalVarValue(intType);
+            loop->getPreheader()->insertBeforeTerminator(new (func) MoveInstruction(func, initVar, iv.var));
+
+            BinaryInstruction * addInst = new (func)
+                BinaryInstruction(func, IRInstOperator::IRINST_OP_ADD_I, initVar, module->newConstInt(delta), intType);
+            auto pos = exitInsts.insert(exitInsts.begin() + 1, addInst) + 1;
+            exitInsts.insert(pos, new (func) MoveInstruction(func, iv.var, addInst));
+        }
+
+        changed = true;
+    }
+}
+
+/// @brief 计算新值的指令是否只被归纳变量的更新使用，其结果还代替了对变量的其它读取时不能删除
+/// @param iv 基本归纳变量
+/// @return true 是 false 还有其它使用
+static bool onlyUsedByUpdate(BasicIV & iv)
+{
+    for (auto use: iv.stepInst->getUses()) {
+        if (use->getUser() != iv.update) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief 删除除了自身更新外不再使用的基本归纳变量，只剩下循环控制时删除整个循环
+/// @param loop 循环
+/// @param ivInfo 归纳变量分析
+void IVStrengthReduction::removeRedundantIVs(Loop * loop, InductionVariableInfo & ivInfo)
+{
+    LoopExitTest * exitTest = ivInfo.getExitTest();
+    BasicIV * controlIV = exitTest ? exitTest->iv : nullptr;
+
+    for (auto & iv: ivInfo.getBasicIVs()) {
+
+        if (iv.stepInst->isDead() || !onlyUsedByUpdate(iv) || isLiveOut(loop, iv.var)) {
+            continue;
+        }
+
+        // 循环内除了计算新值之外没有其它读取
+        bool redundant = true;
+
+        for (auto bb: loop->getBlocks()) {
+            for (auto inst: bb->getInsts()) {
+
+                if (inst->isDead() || inst == iv.stepInst) {
+                    continue;
+                }
+
+                bool isMove = inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN;
+                for (int32_t k = isMove ? 1 : 0; k < inst->getOperandsNum(); ++k) {
+                    redundant = redundant && inst->getOperand(k) != iv.var;
+                }
+            }
+        }
+
+        if (redundant) {
+            killInst(iv.update);
+            killInst(iv.stepInst);
+        }
+    }
+
+    // 迭代次数确定，且循环内只剩下控制变量的更新与比较时，循环没有作用，直接跳转到出口块
+    int64_t tripCount;
+    if (controlIV == nullptr || controlIV->stepInst->isDead() || !onlyUsedByUpdate(*controlIV) ||
+        isLiveOut(loop, controlIV->var) ||
+        !ivInfo.getTripCount(tripCount)) {
+        return;
+    }
+
+    Value * cond = exitTest->branch->getOperand(0);
+
+    for (auto bb: loop->getBlocks()) {
+        for (auto inst: bb->getInsts()) {
+
+            if (inst->isDead() || inst == controlIV->stepInst || inst == controlIV->update ||
+                inst == exitTest->compare) {
+                continue;
+            }
+
+            IRInstOperator op = inst->getOp();
+            if (op == IRInstOperator::IRINST_OP_LABEL || op == IRInstOperator::IRINST_OP_GOTO) {
+                continue;
+            }
+
+            if (op == IRInstOperator::IRINST_OP_ASSIGN && inst->getOperand(0) == cond &&
+                inst->getOperand(1) == exitTest->compare) {
+                continue;
+            }
+
+            return;
+        }
+    }
+
+    if (cond != exitTest->compare && isLiveOut(loop, cond)) {
+        return;
+    }
+
+    BasicBlock * header = loop->getHeader();
+
+    for (auto bb: loop->getBlocks()) {
+        for (auto inst: bb->getInsts()) {
+            if (!inst->isDead() && inst != header->getLabel()) {
+                killInst(inst);
+            }
+        }
+    }
+
+    header->getInsts().push_back(new (func) GotoInstruction(func, exitTest->exitBlock->getLabel()));
+}
+
+/// @brief 执行优化
+/// @return true 函数的IR发生了变化 false 没有变化
+bool IVStrengthReduction::run()
+{
+    if (cfg.getBlocks().empty()) {
+        return false;
+    }
+
+    DominatorTree domTree(cfg);
+    LoopInfo loopInfo(cfg, domTree);
+
+    // 内层循环先处理
+    for (auto loop: loopInfo.getLoops()) {
+
+        if (loop->getPreheader() == nullptr) {
+            continue;
+        }
+
+        InductionVariableInfo ivInfo(loop, loopInfo, domTree);
+        if (ivInfo.getBasicIVs().empty()) {
+            continue;
+        }
+
+        reduceMultiplies(loop, ivInfo);
+        replaceExitValues(loop, ivInfo);
+        removeRedundantIVs(loop, ivInfo);
+    }
+
+    if (changed) {
+        cfg.writeBack();
+    }
+
+    return changed;
+}
@@ -0,0 +1,135 @@
+///
+/// @file IVStrengthReduction.h
+/// @brief 归纳变量的强度削弱、退出值替换与冗余归纳变量删除
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ControlFlowGraph.h"
+#include "InductionVariable.h"
+#include "Pass.h"
+
+///
+/// @brief 归纳变量优化。派生归纳变量 i * k 改为在 i 更新时累加 c * k 的递推；
+/// 迭代次数为常量时，循环后用到的基本归纳变量在出口块直接赋值为退出值；
+/// 除了自身的更新之外不再被使用的归纳变量删除，只剩下循环控制的循环整体删除
+///
+class IVStrengthReduction : public FunctionPass {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    /// @param _func 要优化的函数
+    ///
+    IVStrengthReduction(Module * _module, Function * _func);
+
+    ///
+    /// @brief 执行优化
+    /// @return true 函数的IR发生了变化 false 没有变化
+    ///
+    bool run() override;
+
+private:
+    ///
+    /// @brief 已经创建的派生归纳变量 iv * factor
+    ///
+    struct DerivedIV {
+
+        BasicIV * iv;
+
+        Value * factor;
+
+        LocalVariable * var;
+    };
+
+    ///
+    /// @brief 把循环内基本归纳变量与循环不变量的乘法改为加法递推
+    /// @param loop 循环
+    /// @param ivInfo 归纳变量分析
+    ///
+    void reduceMultiplies(Loop * loop, InductionVariableInfo & ivInfo);
+
+    ///
+    /// @brief 乘法的结果能否用派生归纳变量代替，要求使用都在同一基本块内，且中间没有更新基本归纳变量
+    /// @param mulInst 乘法指令
+    /// @param iv 基本归纳变量
+    /// @param ivInfo 归纳变量分析
+    /// @return true 能 false 不能
+    ///
+    static bool canReplaceUses(Instruction * mulInst, BasicIV * iv, InductionVariableInfo & ivInfo);
+
+    ///
+    /// @brief 获取或创建派生归纳变量 iv * factor
+    /// @param loop 循环
+    /// @param iv 基本归纳变量
+    /// @param factor 循环不变的乘数
+    /// @return LocalVariable* 派生归纳变量
+    ///
+    LocalVariable * getDerivedIV(Loop * loop, BasicIV * iv, Value * factor);
+
+    ///
+    /// @brief 迭代次数为常量时，在出口块把循环后用到的基本归纳变量赋值为退出值
+    /// @param loop 循环
+    /// @param ivInfo 归纳变量分析
+    ///
+    void replaceExitValues(Loop * loop, InductionVariableInfo & ivInfo);
+
+    ///
+    /// @brief 删除除了自身更新外不再使用的基本归纳变量，只剩下循环控制时删除整个循环
+    /// @param loop 循环
+    /// @param ivInfo 归纳变量分析
+    ///
+    void removeRedundantIVs(Loop * loop, InductionVariableInfo & ivInfo);
+
+    ///
+    /// @brief 变量在基本块入口是否活跃，沿着后继正向查找定值前的读取
+    /// @param bb 基本块
+    /// @param var 变量
+    /// @return true 活跃 false 不活跃
+    ///
+    bool isLiveAtEntry(BasicBlock * bb, Value * var);
+
+    ///
+    /// @brief 变量在循环的出口是否活跃
+    /// @param loop 循环
+    /// @param var 变量
+    /// @return true 活跃 false 不活跃
+    ///
+    bool isLiveOut(Loop * loop, Value * var);
+
+    ///
+    /// @brief 删除指令，并立即解除其对操作数的使用
+    /// @param inst 指令
+    ///
+    void killInst(Instruction * inst);
+
+    ///
+    /// @brief 控制流图
+    ///
+    ControlFlowGraph cfg;
+
+    ///
+    /// @brief 当前循环已经创建的派生归纳变量
+    ///
+    std::vector<DerivedIV> derivedIVs;
+
+    ///
+    /// @brief 是否修改了IR
+    ///
+    bool changed = false;
+};
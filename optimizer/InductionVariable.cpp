@@ -0,0 +1,427 @@
+///
+/// @file InductionVariable.cpp
+/// @brief 循环的归纳变量分析与迭代次数计算
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <climits>
+#include <unordered_map>
+
+#include "InductionVariable.h"
+#include "ConstInt.h"
+#include "GlobalVariable.h"
+#include "OptUtils.h"
+
+/// @brief 构造函数，分析循环的基本归纳变量与退出条件
+/// @param _loop 循环
+/// @param loopInfo 循环信息
+/// @param domTree 支配树
+InductionVariableInfo::InductionVariableInfo(Loop * _loop, LoopInfo & loopInfo, DominatorTree & domTree)
+    : loop(_loop)
+{
+    for (auto bb: loop->getBlocks()) {
+        for (auto inst: bb->getInsts()) {
+
+            if (inst->isDead()) {
+                continue;
+            }
+
+            instBlock[inst] = bb;
+
+            if (inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN) {
+                loopDefs.insert(inst->getOperand(0));
+            } else if (inst->getOp() == IRInstOperator::IRINST_OP_FUNC_CALL) {
+                hasCall = true;
+            }
+        }
+    }
+
+    findBasicIVs(loopInfo, domTree);
+    findExitTest();
+}
+
+/// @brief 获取循环内指令所在的基本块
+/// @param inst 指令
+/// @return BasicBlock* 基本块，不在循环内时为空
+BasicBlock * InductionVariableInfo::getBlockOf(Instruction * inst)
+{
+    auto iter = instBlock.find(inst);
+    if (iter == instBlock.end()) {
+        return nullptr;
+    }
+
+    return iter->second;
+}
+
+/// @brief 获取变量对应的基本归纳变量
+/// @param var 变量
+/// @return BasicIV* 基本归纳变量，不是时为空
+BasicIV * InductionVariableInfo::getBasicIV(Value * var)
+{
+    for (auto & iv: basicIVs) {
+        if (iv.var == var) {
+            return &iv;
+        }
+    }
+
+    return nullptr;
+}
+
+/// @brief 值在循环内是否不变
+/// @param val 值
+/// @return true 不变 false 可能变化
+bool InductionVariableInfo::isInvariant(Value * val)
+{
+    Instanceof(constVal, ConstInt *, val);
+    if (constVal) {
+        return true;
+    }
+
+    // 临时变量只定值一次，定值在循环外就不变
+    Instanceof(inst, Instruction *, val);
+    if (inst) {
+        return !isInLoop(inst);
+    }
+
+    if (loopDefs.count(val)) {
+        return false;
+    }
+
+    Instanceof(globalVar, GlobalVariable *, val);
+
+    return globalVar == nullptr || !hasCall;
+}
+
+/// @brief 识别基本归纳变量
+/// @param loopInfo 循环信息
+/// @param domTree 支配树
+void InductionVariableInfo::findBasicIVs(LoopInfo & loopInfo, DominatorTree & domTree)
+{
+    // 统计循环内每个局部变量的赋值指令，只被赋值一次的才可能是基本归纳变量
+    std::unordered_map<Value *, int32_t> defCount;
+    std::vector<Instruction *> moves;
+
+    for (auto bb: loop->getBlocks()) {
+        for (auto inst: bb->getInsts()) {
+            if (!inst->isDead() && inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN &&
+                isLocalVariable(inst->getOperand(0))) {
+                defCount[inst->getOperand(0)]++;
+                moves.push_back(inst);
+            }
+        }
+    }
+
+    for (auto move: moves) {
+
+        Value * var = move->getOperand(0);
+        if (defCount[var] != 1) {
+            continue;
+        }
+
+        // 赋值的源操作数必须是同一基本块内的 var + c、c + var 或 var - c
+        Instanceof(stepInst, Instruction *, move->getOperand(1));
+        if (stepInst == nullptr || getBlockOf(stepInst) != getBlockOf(move)) {
+            continue;
+        }
+
+        IRInstOperator op = stepInst->getOp();
+        if (op != IRInstOperator::IRINST_OP_ADD_I && op != IRInstOperator::IRINST_OP_SUB_I) {
+            continue;
+        }
+
+        Value * lhs = stepInst->getOperand(0);
+        Value * rhs = stepInst->getOperand(1);
+
+        Instanceof(lhsConst, ConstInt *, lhs);
+        Instanceof(rhsConst, ConstInt *, rhs);
+
+        int64_t step;
+        if (lhs == var && rhsConst) {
+            step = op == IRInstOperator::IRINST_OP_ADD_I ? (int64_t) rhsConst->getVal() : -(int64_t) rhsConst->getVal();
+        } else if (rhs == var && lhsConst && op == IRInstOperator::IRINST_OP_ADD_I) {
+            step = lhsConst->getVal();
+        } else {
+            continue;
+        }
+
+        if (step == 0 || step > INT32_MAX || step < INT32_MIN) {
+            continue;
+        }
+
+        // 每次迭代恰好执行一次：不在内层循环中，且支配所有的回边
+        BasicBlock * updateBlock = getBlockOf(move);
+        if (loopInfo.getLoopFor(updateBlock) != loop) {
+            continue;
+        }
+
+        bool everyIteration = true;
+        for (auto latch: loop->getLatches()) {
+            everyIteration = everyIteration && domTree.dominates(updateBlock, latch);
+        }
+
+        if (!everyIteration) {
+            continue;
+        }
+
+        basicIVs.push_back(BasicIV{var, (int32_t) step, stepInst, move, updateBlock});
+    }
+}
+
+/// @brief 识别循环的退出条件
+void InductionVariableInfo::findExitTest()
+{
+    BasicBlock * header = loop->getHeader();
+
+    // 只在循环头退出
+    BasicBlock * exitBlock = nullptr;
+
+    for (auto bb: loop->getBlocks()) {
+        for (auto succ: bb->getSuccs()) {
+            if (!loop->contains(succ)) {
+                if (bb != header || exitBlock != nullptr) {
+                    return;
+                }
+                exitBlock = succ;
+            }
+        }
+    }
+
+    Instruction * term = header->getTerminator();
+    if (exitBlock == nullptr || term == nullptr || term->getOp() != IRInstOperator::IRINST_OP_GOTO) {
+        return;
+    }
+
+    GotoInstruction * branch = static_cast<GotoInstruction *>(term);
+    if (!branch->isConditionalBranch()) {
+        return;
+    }
+
+    // 条件可能是比较的结果，也可能是在循环头内被比较结果赋值的bool变量
+    Value * cond = branch->getOperand(0);
+    Instanceof(compare, Instruction *, cond);
+
+    if (compare == nullptr) {
+
+        std::vector<Instruction *> & insts = header->getInsts();
+
+        for (auto iter = insts.rbegin(); iter != insts.rend(); ++iter) {
+            Instruction * inst = *iter;
+            if (!inst->isDead() && inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN && inst->getOperand(0) == cond) {
+                compare = dyn_cast<Instruction>(inst->getOperand(1));
+                break;
+            }
+        }
+    }
+
+    if (compare == nullptr || !isCompareOp(compare->getOp()) || getBlockOf(compare) != header) {
+        return;
+    }
+
+    IRInstOperator op = compare->getOp();
+    BasicIV * iv = getBasicIV(compare->getOperand(0));
+    Value * bound = compare->getOperand(1);
+
+    if (iv == nullptr) {
+
+        // 归纳变量在右边时交换比较的两边
+        iv = getBasicIV(compare->getOperand(1));
+        bound = compare->getOperand(0);
+
+        switch (op) {
+            case IRInstOperator::IRINST_OP_LT_I:
+                op = IRInstOperator::IRINST_OP_GT_I;
+                break;
+            case IRInstOperator::IRINST_OP_LE_I:
+                op = IRInstOperator::IRINST_OP_GE_I;
+                break;
+            case IRInstOperator::IRINST_OP_GT_I:
+                op = IRInstOperator::IRINST_OP_LT_I;
+                break;
+            case IRInstOperator::IRINST_OP_GE_I:
+                op = IRInstOperator::IRINST_OP_LE_I;
+                break;
+            default:
+                break;
+        }
+    }
+
+    // 循环头内的比较读取的是本次迭代开始时的值，因此要求归纳变量不在循环头内更新
+    if (iv == nullptr || iv->updateBlock == header || !isInvariant(bound)) {
+        return;
+    }
+
+    // 为真时退出循环的，取反得到继续迭代的条件
+    if (!loop->contains(header->getSuccs()[0])) {
+        switch (op) {
+            case IRInstOperator::IRINST_OP_LT_I:
+                op = IRInstOperator::IRINST_OP_GE_I;
+                break;
+            case IRInstOperator::IRINST_OP_LE_I:
+                op = IRInstOperator::IRINST_OP_GT_I;
+                break;
+            case IRInstOperator::IRINST_OP_GT_I:
+                op = IRInstOperator::IRINST_OP_LE_I;
+                break;
+            case IRInstOperator::IRINST_OP_GE_I:
+                op = IRInstOperator::IRINST_OP_LT_I;
+                break;
+            case IRInstOperator::IRINST_OP_EQ_I:
+                op = IRInstOperator::IRINST_OP_NE_I;
+                break;
+            case IRInstOperator::IRINST_OP_NE_I:
+                op = IRInstOperator::IRINST_OP_EQ_I;
+                break;
+            default:
+                break;
+        }
+    }
+
+    exitTest = LoopExitTest{iv, op, bound, compare, branch, exitBlock};
+    hasExitTest = true;
+}
+
+/// @brief 求进入循环时归纳变量的常量初值
+/// @param iv 基本归纳变量
+/// @param value 初值
+/// @return true 初值是常量 false 不能确定
+bool InductionVariableInfo::getInitValue(BasicIV * iv, int32_t & value)
+{
+    BasicBlock * bb = loop->getPreheader();
+    std::unordered_set<BasicBlock *> visited;
+
+    while (bb != nullptr && visited.insert(bb).second) {
+
+        std::vector<Instruction *> & insts = bb->getInsts();
+
+        for (auto iter = insts.rbegin(); iter != insts.rend(); ++iter) {
+
+            Instruction * inst = *iter;
+            if (inst->isDead() || inst->getOp() != IRInstOperator::IRINST_OP_ASSIGN || inst->getOperand(0) != iv->var) {
+                continue;
+            }
+
+            Instanceof(constVal, ConstInt *, inst->getOperand(1));
+            if (constVal == nullptr) {
+                return false;
+            }
+
+            value = constVal->getVal();
+            return true;
+        }
+
+        bb = bb->getPreds().size() == 1 ? bb->getPreds()[0] : nullptr;
+    }
+
+    return false;
+}
+
+/// @brief 根据初值、增量与边界求循环体的执行次数
+/// @param op 继续迭代的比较运算符
+/// @param init 初值
+/// @param step 增量
+/// @param bound 边界
+/// @param count 执行次数
+/// @return true 能确定 false 不能确定，如不会终止或溢出
+bool InductionVariableInfo::computeTripCount(IRInstOperator op,
+                                             int64_t init,
+                                             int64_t step,
+                                             int64_t bound,
+                                             int64_t & count)
+{
+    switch (op) {
+        case IRInstOperator::IRINST_OP_LT_I:
+            if (init >= bound) {
+                count = 0;
+                return true;
+            }
+            if (step <= 0) {
+                return false;
+            }
+            count = (bound - init + step - 1) / step;
+            break;
+        case IRInstOperator::IRINST_OP_LE_I:
+            if (init > bound) {
+                count = 0;
+                return true;
+            }
+            if (step <= 0) {
+                return false;
+            }
+            count = (bound - init) / step + 1;
+            break;
+        case IRInstOperator::IRINST_OP_GT_I:
+            if (init <= bound) {
+                count = 0;
+                return true;
+            }
+            if (step >= 0) {
+                return false;
+            }
+            count = (init - bound - step - 1) / -step;
+            break;
+        case IRInstOperator::IRINST_OP_GE_I:
+            if (init < bound) {
+                count = 0;
+                return true;
+            }
+            if (step >= 0) {
+                return false;
+            }
+            count = (init - bound) / -step + 1;
+            break;
+        case IRInstOperator::IRINST_OP_NE_I:
+            if (init == bound) {
+                count = 0;
+                return true;
+            }
+            if ((bound - init) % step != 0 || (bound - init) / step <= 0) {
+                return false;
+            }
+            count = (bound - init) / step;
+            break;
+        case IRInstOperator::IRINST_OP_EQ_I:
+            if (init != bound) {
+                count = 0;
+                return true;
+            }
+            count = 1;
+            break;
+        default:
+            return false;
+    }
+
+    // 退出时归纳变量的值溢出的话，实际的执行次数与计算的不同
+    int64_t last = init + count * step;
+
+    return last >= INT32_MIN && last <= INT32_MAX;
+}
+
+/// @brief 求循环体的执行次数
+/// @param count 执行次数
+/// @return true 能确定 false 不能确定
+bool InductionVariableInfo::getTripCount(int64_t & count)
+{
+    if (!hasExitTest) {
+        return false;
+    }
+
+    Instanceof(boundConst, ConstInt *, exitTest.bound);
+    int32_t init;
+
+    if (boundConst == nullptr || !getInitValue(exitTest.iv, init)) {
+        return false;
+    }
+
+    return computeTripCount(exitTest.op, init, exitTest.iv->step, boundConst->getVal(), count);
+}
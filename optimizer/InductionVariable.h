@@ -0,0 +1,232 @@
+///
+/// @file InductionVariable.h
+/// @brief 循环的归纳变量分析与迭代次数计算
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "DominatorTree.h"
+#include "GotoInstruction.h"
+#include "LoopInfo.h"
+
+///
+/// @brief 基本归纳变量：循环内唯一的赋值为 i = i + c 或 i = i - c，且每次迭代恰好执行一次
+///
+struct BasicIV {
+
+    ///
+    /// @brief 归纳变量
+    ///
+    Value * var;
+
+    ///
+    /// @brief 每次迭代的增量
+    ///
+    int32_t step;
+
+    ///
+    /// @brief 计算新值的加减法指令
+    ///
+    Instruction * stepInst;
+
+    ///
+    /// @brief 对归纳变量赋值的指令
+    ///
+    Instruction * update;
+
+    ///
+    /// @brief 赋值指令所在的基本块
+    ///
+    BasicBlock * updateBlock;
+};
+
+///
+/// @brief 循环的退出条件：只在循环头退出，且循环头以 iv op bound 的比较决定是否继续迭代
+///
+struct LoopExitTest {
+
+    ///
+    /// @brief 参与比较的基本归纳变量
+    ///
+    BasicIV * iv;
+
+    ///
+    /// @brief 比较运算符，已规范为比较结果为真时继续迭代、归纳变量在左边
+    ///
+    IRInstOperator op;
+
+    ///
+    /// @brief 循环不变的边界
+    ///
+    Value * bound;
+
+    ///
+    /// @brief 比较指令
+    ///
+    Instruction * compare;
+
+    ///
+    /// @brief 循环头的条件跳转指令
+    ///
+    GotoInstruction * branch;
+
+    ///
+    /// @brief 退出循环后进入的基本块
+    ///
+    BasicBlock * exitBlock;
+};
+
+///
+/// @brief 单个循环的归纳变量分析。IR不是SSA形式，这里按照变量在循环内的赋值识别归纳变量，
+/// 类似标量演化中的{init, +, step}递推式。分析结果在修改循环内的指令后失效
+///
+class InductionVariableInfo {
+
+public:
+    ///
+    /// @brief 构造函数，分析循环的基本归纳变量与退出条件
+    /// @param _loop 循环
+    /// @param loopInfo 循环信息
+    /// @param domTree 支配树
+    ///
+    InductionVariableInfo(Loop * _loop, LoopInfo & loopInfo, DominatorTree & domTree);
+
+    ///
+    /// @brief 获取基本归纳变量
+    /// @return std::vector<BasicIV>& 基本归纳变量
+    ///
+    std::vector<BasicIV> & getBasicIVs()
+    {
+        return basicIVs;
+    }
+
+    ///
+    /// @brief 获取变量对应的基本归纳变量
+    /// @param var 变量
+    /// @return BasicIV* 基本归纳变量，不是时为空
+    ///
+    BasicIV * getBasicIV(Value * var);
+
+    ///
+    /// @brief 获取循环的退出条件
+    /// @return LoopExitTest* 退出条件，不能识别时为空
+    ///
+    LoopExitTest * getExitTest()
+    {
+        return hasExitTest ? &exitTest : nullptr;
+    }
+
+    ///
+    /// @brief 值在循环内是否不变
+    /// @param val 值
+    /// @return true 不变 false 可能变化
+    ///
+    bool isInvariant(Value * val);
+
+    ///
+    /// @brief 指令是否在循环内
+    /// @param inst 指令
+    /// @return true 在 false 不在
+    ///
+    bool isInLoop(Instruction * inst)
+    {
+        return instBlock.count(inst) != 0;
+    }
+
+    ///
+    /// @brief 获取循环内指令所在的基本块
+    /// @param inst 指令
+    /// @return BasicBlock* 基本块，不在循环内时为空
+    ///
+    BasicBlock * getBlockOf(Instruction * inst);
+
+    ///
+    /// @brief 求进入循环时归纳变量的常量初值，沿着前置块及唯一前驱反向查找最近的赋值
+    /// @param iv 基本归纳变量
+    /// @param value 初值
+    /// @return true 初值是常量 false 不能确定
+    ///
+    bool getInitValue(BasicIV * iv, int32_t & value);
+
+    ///
+    /// @brief 求循环体的执行次数，要求初值与边界都是常量，且归纳变量不会溢出
+    /// @param count 执行次数
+    /// @return true 能确定 false 不能确定
+    ///
+    bool getTripCount(int64_t & count);
+
+    ///
+    /// @brief 根据初值、增量与边界求循环体的执行次数
+    /// @param op 继续迭代的比较运算符
+    /// @param init 初值
+    /// @param step 增量
+    /// @param bound 边界
+    /// @param count 执行次数
+    /// @return true 能确定 false 不能确定，如不会终止或溢出
+    ///
+    static bool computeTripCount(IRInstOperator op, int64_t init, int64_t step, int64_t bound, int64_t & count);
+
+private:
+    ///
+    /// @brief 识别基本归纳变量
+    /// @param loopInfo 循环信息
+    /// @param domTree 支配树
+    ///
+    void findBasicIVs(LoopInfo & loopInfo, DominatorTree & domTree);
+
+    ///
+    /// @brief 识别循环的退出条件
+    ///
+    void findExitTest();
+
+    ///
+    /// @brief 循环
+    ///
+    Loop * loop;
+
+    ///
+    /// @brief 循环内未删除的指令所在的基本块
+    ///
+    std::unordered_map<Instruction *, BasicBlock *> instBlock;
+
+    ///
+    /// @brief 循环内被赋值的变量
+    ///
+    std::unordered_set<Value *> loopDefs;
+
+    ///
+    /// @brief 循环内是否有函数调用
+    ///
+    bool hasCall = false;
+
+    ///
+    /// @brief 基本归纳变量
+    ///
+    std::vector<BasicIV> basicIVs;
+
+    ///
+    /// @brief 退出条件
+    ///
+    LoopExitTest exitTest{};
+
+    ///
+    /// @brief 是否识别出退出条件
+    ///
+    bool hasExitTest = false;
+};
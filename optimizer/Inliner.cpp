@@ -0,0 +1,326 @@
+///
+/// @file Inliner.cpp
+/// @brief 函数内联，按调用图自底向上处理，用代价模型与模块的增长预算控制代码膨胀
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+
+#include "Inliner.h"
+#include "Common.h"
+#include "ConstInt.h"
+#include "LabelInstruction.h"
+#include "MoveInstruction.h"
+#include "OptUtils.h"
+#include "Profile.h"
+
+/// @brief 调用一个函数的固定开销，包括bl、返回值的传送以及被调用函数的栈帧保护与恢复
+static const int32_t CALL_OVERHEAD = 4;
+
+/// @brief 常量实参每个可折叠的使用带来的收益
+static const int32_t CONST_ARG_BONUS = 2;
+
+/// @brief 内联最后一个调用点后原函数不再需要带来的收益
+static const int32_t LAST_CALL_BONUS = 15;
+
+/// @brief 剖面数据中热的调用点内联带来的收益
+static const int32_t HOT_CALL_BONUS = 30;
+
+/// @brief 剖面数据中冷的调用点内联只增大代码，增加的代价
+static const int32_t COLD_CALL_PENALTY = 30;
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _callGraph 调用图，用于判断递归与统计调用点
+/// @param _optLevel 优化级别
+Inliner::Inliner(Module * _module, CallGraph & _callGraph, int _optLevel) : module(_module), callGraph(_callGraph)
+{
+    // -O1只内联很小的函数，-O2及以上允许模块的规模翻倍
+    threshold = _optLevel >= 2 ? 40 : 10;
+
+    int64_t moduleSize = 0;
+
+    for (auto func: module->getFunctionList()) {
+
+        if (func->isBuiltin()) {
+            continue;
+        }
+
+        moduleSize += getFunctionSize(func);
+
+        for (auto callInst: callGraph.getCallInsts(func)) {
+            callCounts[callInst->calledFunction]++;
+        }
+    }
+
+    growthBudget = std::max<int64_t>(_optLevel >= 2 ? moduleSize : moduleSize / 4, 50);
+}
+
+/// @brief 获取函数的指令数，不含Label、Entry与Exit指令
+/// @param func 函数
+/// @return int32_t 指令数
+int32_t Inliner::getFunctionSize(Function * func)
+{
+    int32_t size = 0;
+
+    for (auto inst: func->getInterCode().getInsts()) {
+
+        if (inst->isDead()) {
+            continue;
+        }
+
+        switch (inst->getOp()) {
+            case IRInstOperator::IRINST_OP_LABEL:
+            case IRInstOperator::IRINST_OP_ENTRY:
+            case IRInstOperator::IRINST_OP_EXIT:
+                break;
+            default:
+                size++;
+                break;
+        }
+    }
+
+    return size;
+}
+
+/// @brief 实参为常量时，形参的使用中可以折叠的指令数
+/// @param callee 被调用的函数
+/// @param param 形参
+/// @return int32_t 指令数
+int32_t Inliner::getFoldableUses(Function * callee, Value * param)
+{
+    int32_t count = 0;
+
+    for (auto use: param->getUses()) {
+
+        Instanceof(user, Instruction *, use->getUser());
+        if (user == nullptr) {
+            continue;
+        }
+
+        if (isArithOp(user->getOp())) {
+            count++;
+        } else if (user->getOp() == IRInstOperator::IRINST_OP_ASSIGN && user->getOperand(1) == param &&
+                   isLocalVariable(user->getOperand(0))) {
+
+            // 入口处形参拷贝到局部变量，局部变量的运算与条件跳转也能折叠
+            for (auto localUse: user->getOperand(0)->getUses()) {
+                Instanceof(localUser, Instruction *, localUse->getUser());
+                if (localUser && (isArithOp(localUser->getOp()) || localUser->getOp() == IRInstOperator::IRINST_OP_GOTO)) {
+                    count++;
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+/// @brief 计算内联的代价
+/// @param callInst 函数调用指令
+/// @param callee 被调用的函数
+/// @param siteCount 剖面数据中调用点的执行次数，-1表示没有剖面数据
+/// @return int32_t 代价，越小越值得内联
+int32_t Inliner::getInlineCost(FuncCallInstruction * callInst, Function * callee, int64_t siteCount)
+{
+    int32_t cost = getFunctionSize(callee);
+
+    // 每个实参需要一条传送指令
+    cost -= CALL_OVERHEAD + (int32_t) callInst->getOperandsNum();
+
+    std::vector<FormalParam *> & params = callee->getParams();
+    for (int32_t k = 0; k < callInst->getOperandsNum() && k < (int32_t) params.size(); ++k) {
+        Instanceof(constArg, ConstInt *, callInst->getOperand(k));
+        if (constArg) {
+            cost -= CONST_ARG_BONUS * getFoldableUses(callee, params[k]);
+        }
+    }
+
+    if (callCounts[callee] == 1 && callee->getName() != "main") {
+        cost -= LAST_CALL_BONUS;
+    }
+
+    // 冷的调用点是最后一个调用点时，内联后原函数可以删除，代码并不增大
+    if (isHotCount(module, siteCount)) {
+        cost -= HOT_CALL_BONUS;
+    } else if (isColdCount(module, siteCount) && callCounts[callee] > 1) {
+        cost += COLD_CALL_PENALTY;
+    }
+
+    return cost;
+}
+
+/// @brief 把函数调用展开为被调用函数的IR
+/// @param caller 调用者
+/// @param callInst 函数调用指令
+/// @param seq 展开后的指令追加到这里
+/// @param siteCount 剖面数据中调用点的执行次数，-1表示没有剖面数据
+void Inliner::inlineCall(Function * caller,
+                         FuncCallInstruction * callInst,
+                         std::vector<Instruction *> & seq,
+                         int64_t siteCount)
+{
+    Function * callee = callInst->calledFunction;
+    std::vector<Instruction *> & calleeInsts = callee->getInterCode().getInsts();
+    std::unordered_map<Value *, Value *> valueMap;
+    size_t first = seq.size();
+
+    // 被赋值的形参，以及可能在被调用函数内被修改的全局变量实参，都要先拷贝到新的局部变量
+    std::vector<FormalParam *> & params = callee->getParams();
+
+    for (int32_t k = 0; k < (int32_t) params.size(); ++k) {
+
+        Value * arg = callInst->getOperand(k);
+
+        bool written = std::any_of(calleeInsts.begin(), calleeInsts.end(), [&params, k](Instruction * inst) {
+            return !inst->isDead() && inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN &&
+                   inst->getOperand(0) == params[k];
+        });
+
+        Instanceof(argInst, Instruction *, arg);
+        if (written || !(isa<ConstInt>(arg) || argInst || isLocalVariable(arg))) {
+            LocalVariable * copy = caller->newLocalVarValue(params[k]->getType());
+            seq.push_back(new (caller) MoveInstruction(caller, copy, arg));
+            arg = copy;
+        }
+
+        valueMap[params[k]] = arg;
+    }
+
+    for (auto var: callee->getVarValues()) {
+        valueMap[var] = caller->newLocalVarValue(var->getType(), var->getName(), var->getScopeLevel());
+    }
+
+    // 跳转可能向后引用Label，先创建全部的Label，剖面数据中的执行次数按调用点占被调用函数执行次数的比例缩放
+    int64_t calleeCount = callee->getEntryCount();
+    for (auto inst: calleeInsts) {
+        if (!inst->isDead() && inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
+            LabelInstruction * newLabel = new (caller) LabelInstruction(caller);
+            int64_t labelCount = static_cast<LabelInstruction *>(inst)->profileCount;
+            if (siteCount >= 0 && labelCount >= 0 && calleeCount > 0) {
+                newLabel->profileCount = labelCount * siteCount / calleeCount;
+            }
+            valueMap[inst] = newLabel;
+        }
+    }
+
+    // 返回值保存到调用者的变量中，出口指令的操作数可能已被常量传播替换为常量
+    Value * result = nullptr;
+    if (callInst->hasResultValue()) {
+        result = callee->getReturnValue() ? valueMap[callee->getReturnValue()]
+                                          : caller->newLocalVarValue(callInst->getType());
+    }
+
+    for (auto inst: calleeInsts) {
+
+        if (inst->isDead() || inst->getOp() == IRInstOperator::IRINST_OP_ENTRY) {
+            continue;
+        }
+
+        if (inst->getOp() == IRInstOperator::IRINST_OP_EXIT) {
+            if (result && inst->getOperandsNum() > 0) {
+                Value * retVal = valueMap.count(inst->getOperand(0)) ? valueMap[inst->getOperand(0)] : inst->getOperand(0);
+                if (retVal != result) {
+                    seq.push_back(new (caller) MoveInstruction(caller, result, retVal));
+                }
+            }
+            continue;
+        }
+
+        Instruction * newInst = cloneInstruction(caller, inst, valueMap);
+        if (newInst == nullptr) {
+            continue;
+        }
+
+        seq.push_back(newInst);
+
+        if (newInst->getOp() == IRInstOperator::IRINST_OP_FUNC_CALL) {
+
+            // 调用者获得了新的函数调用，需要更新栈帧相关的统计
+            caller->setExistFuncCall(true);
+            if (newInst->getOperandsNum() > caller->getMaxFuncCallArgCnt()) {
+                caller->setMaxFuncCallArgCnt(newInst->getOperandsNum());
+            }
+
+            callCounts[static_cast<FuncCallInstruction *>(newInst)->calledFunction]++;
+        }
+    }
+
+    // 线性次序中使用可能在定值之前，全部复制后再按映射表修正
+    remapOperands(seq.begin() + (std::ptrdiff_t) first, seq.end(), valueMap);
+
+    // 出口Label已复制为继续点，调用的结果改为读取返回值变量
+    if (result) {
+        callInst->replaceAllUsesWith(result);
+    }
+
+    callCounts[callee]--;
+}
+
+/// @brief 对函数内的函数调用进行内联，被调用的函数应已处理过
+/// @param caller 调用者
+/// @return true 函数的IR发生了变化 false 没有变化
+bool Inliner::run(Function * caller)
+{
+    std::vector<Instruction *> & insts = caller->getInterCode().getInsts();
+    std::vector<Instruction *> newInsts;
+    int32_t inlinedCount = 0;
+
+    // 当前基本块在剖面数据中的执行次数
+    int64_t blockCount = caller->getEntryCount();
+
+    for (auto inst: insts) {
+
+        if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL) {
+            blockCount = static_cast<LabelInstruction *>(inst)->profileCount;
+        }
+
+        if (inst->isDead() || inst->getOp() != IRInstOperator::IRINST_OP_FUNC_CALL) {
+            newInsts.push_back(inst);
+            continue;
+        }
+
+        FuncCallInstruction * callInst = static_cast<FuncCallInstruction *>(inst);
+        Function * callee = callInst->calledFunction;
+
+        if (callee->isBuiltin() || callee == caller || callGraph.isRecursive(callee) ||
+            callInst->getOperandsNum() != (int32_t) callee->getParams().size()) {
+            newInsts.push_back(inst);
+            continue;
+        }
+
+        int32_t size = getFunctionSize(callee);
+        if (getInlineCost(callInst, callee, blockCount) > threshold || size > growthBudget) {
+            newInsts.push_back(inst);
+            continue;
+        }
+
+        inlineCall(caller, callInst, newInsts, blockCount);
+        growthBudget -= size;
+        inlinedCount++;
+
+        inst->clearOperands();
+        delete inst;
+    }
+
+    if (inlinedCount == 0) {
+        return false;
+    }
+
+    insts.swap(newInsts);
+
+    minic_log(LOG_INFO, "函数%s: 内联%d个函数调用", caller->getName().c_str(), inlinedCount);
+
+    return true;
+}
@@ -0,0 +1,114 @@
+///
+/// @file Inliner.h
+/// @brief 函数内联，按调用图自底向上处理，用代价模型与模块的增长预算控制代码膨胀
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "CallGraph.h"
+#include "FuncCallInstruction.h"
+#include "Function.h"
+#include "Module.h"
+
+///
+/// @brief 函数内联。被调用函数的IR复制到调用处，形参替换为实参，局部变量换成调用者的新变量，
+/// 出口Label作为调用之后的继续点，Exit指令不复制，返回值变量代替调用指令的结果。
+/// 代价为被调用函数的指令数减去调用开销、常量实参可折叠的指令以及最后一个调用点的收益，
+/// 不超过阈值且整个模块的增长不超过预算时内联。递归的函数不内联。
+/// 有剖面数据时热的调用点降低代价，冷的调用点增加代价
+///
+class Inliner {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    /// @param _callGraph 调用图，用于判断递归与统计调用点
+    /// @param _optLevel 优化级别
+    ///
+    Inliner(Module * _module, CallGraph & _callGraph, int _optLevel);
+
+    ///
+    /// @brief 对函数内的函数调用进行内联，被调用的函数应已处理过
+    /// @param caller 调用者
+    /// @return true 函数的IR发生了变化 false 没有变化
+    ///
+    bool run(Function * caller);
+
+private:
+    ///
+    /// @brief 计算内联的代价
+    /// @param callInst 函数调用指令
+    /// @param callee 被调用的函数
+    /// @param siteCount 剖面数据中调用点的执行次数，-1表示没有剖面数据
+    /// @return int32_t 代价，越小越值得内联
+    ///
+    int32_t getInlineCost(FuncCallInstruction * callInst, Function * callee, int64_t siteCount);
+
+    ///
+    /// @brief 获取函数的指令数，不含Label、Entry与Exit指令
+    /// @param func 函数
+    /// @return int32_t 指令数
+    ///
+    static int32_t getFunctionSize(Function * func);
+
+    ///
+    /// @brief 实参为常量时，形参的使用中可以折叠的指令数
+    /// @param callee 被调用的函数
+    /// @param param 形参
+    /// @return int32_t 指令数
+    ///
+    static int32_t getFoldableUses(Function * callee, Value * param);
+
+    ///
+    /// @brief 把函数调用展开为被调用函数的IR
+    /// @param caller 调用者
+    /// @param callInst 函数调用指令
+    /// @param seq 展开后的指令追加到这里
+    /// @param siteCount 剖面数据中调用点的执行次数，-1表示没有剖面数据
+    ///
+    void inlineCall(Function * caller,
+                    FuncCallInstruction * callInst,
+                    std::vector<Instruction *> & seq,
+                    int64_t siteCount);
+
+    ///
+    /// @brief 符号表
+    ///
+    Module * module;
+
+    ///
+    /// @brief 调用图
+    ///
+    CallGraph & callGraph;
+
+    ///
+    /// @brief 内联的代价阈值
+    ///
+    int32_t threshold;
+
+    ///
+    /// @brief 模块剩余的指令增长预算
+    ///
+    int64_t growthBudget = 0;
+
+    ///
+    /// @brief 每个函数剩余的调用点个数
+    ///
+    std::unordered_map<Function *, int32_t> callCounts;
+};
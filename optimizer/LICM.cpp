@@ -0,0 +1,362 @@
+///
+/// @file LICM.cpp
+/// @brief 循环不变量外提与循环内全局变量存储的下沉
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+
+#include "LICM.h"
+#include "ConstInt.h"
+#include "DominatorTree.h"
+#include "GlobalVariable.h"
+#include "GotoInstruction.h"
+#include "MoveInstruction.h"
+#include "OptUtils.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _func 要优化的函数
+LICM::LICM(Module * _module, Function * _func) : FunctionPass(_module, _func), cfg(_func)
+{}
+
+/// @brief 把基本块的部分前驱改为先进入一个新建的空基本块
+/// @param bb 基本块，必须以Label指令开始
+/// @param redirected 改为进入新基本块的前驱
+/// @return true 成功 false 基本块没有Label不能拆分
+bool LICM::splitPredecessors(BasicBlock * bb, std::vector<BasicBlock *> & redirected)
+{
+    LabelInstruction * label = bb->getLabel();
+    if (label == nullptr) {
+        return false;
+    }
+
+    // 新的Label放在原Label之前，被改向的前驱跳转到新的Label
+    LabelInstruction * newLabel = new (func) LabelInstruction(func);
+
+    for (auto pred: redirected) {
+
+        Instruction * term = pred->getTerminator();
+        if (term == nullptr || term->getOp() != IRInstOperator::IRINST_OP_GOTO) {
+            continue;
+        }
+
+        GotoInstruction * gotoInst = static_cast<GotoInstruction *>(term);
+        if (gotoInst->getTarget() == label) {
+            gotoInst->setTarget(newLabel);
+        }
+        if (gotoInst->isConditionalBranch() && gotoInst->getFalseTarget() == label) {
+            gotoInst->setFalseTarget(newLabel);
+        }
+    }
+
+    // 顺序执行进入的前驱若不改向，需要显式跳转到原Label，否则会进入新基本块
+    if (bb->getIndex() > 0) {
+        BasicBlock * prev = cfg.getBlocks()[bb->getIndex() - 1];
+        if (prev->getTerminator() == nullptr &&
+            std::find(redirected.begin(), redirected.end(), prev) == redirected.end()) {
+            prev->getInsts().push_back(new (func) GotoInstruction(func, label));
+        }
+    }
+
+    bb->getInsts().insert(bb->getInsts().begin(), newLabel);
+
+    return true;
+}
+
+/// @brief 规范化循环，创建前置块与专用的出口块
+/// @param loop 循环
+/// @param touched 按基本块序号标记本轮已经拆分过的基本块
+/// @return true 控制流图发生了变化 false 没有变化
+bool LICM::simplifyLoop(Loop * loop, std::vector<char> & touched)
+{
+    bool changed = false;
+
+    BasicBlock * header = loop->getHeader();
+
+    if (loop->getPreheader() == nullptr && !touched[header->getIndex()]) {
+
+        std::vector<BasicBlock *> outsidePreds;
+        for (auto pred: header->getPreds()) {
+            if (!loop->contains(pred)) {
+                outsidePreds.push_back(pred);
+            }
+        }
+
+        if (!outsidePreds.empty() && splitPredecessors(header, outsidePreds)) {
+            touched[header->getIndex()] = 1;
+            changed = true;
+        }
+    }
+
+    // 只有循环内对全局变量赋值且没有函数调用时，才需要在出口块写回全局变量
+    bool writesGlobal = false;
+
+    for (auto bb: loop->getBlocks()) {
+        for (auto inst: bb->getInsts()) {
+            if (inst->isDead()) {
+                continue;
+            }
+            if (inst->getOp() == IRInstOperator::IRINST_OP_FUNC_CALL && callMayAccessGlobals(inst)) {
+                return changed;
+            }
+            if (inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN) {
+                Instanceof(globalVar, GlobalVariable *, inst->getOperand(0));
+                writesGlobal = writesGlobal || globalVar != nullptr;
+            }
+        }
+    }
+
+    if (!writesGlobal) {
+        return changed;
+    }
+
+    for (auto exit: loop->getExitBlocks()) {
+
+        std::vector<BasicBlock *> insidePreds;
+        bool hasOutsidePred = false;
+
+        for (auto pred: exit->getPreds()) {
+            if (loop->contains(pred)) {
+                insidePreds.push_back(pred);
+            } else {
+                hasOutsidePred = true;
+            }
+        }
+
+        if (hasOutsidePred && !touched[exit->getIndex()] && splitPredecessors(exit, insidePreds)) {
+            touched[exit->getIndex()] = 1;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+/// @brief 操作数在循环内是否不变
+/// @param loop 循环
+/// @param val 操作数
+/// @return true 不变 false 可能变化
+bool LICM::isInvariantOperand(Loop * loop, Value * val)
+{
+    Instanceof(constVal, ConstInt *, val);
+    if (constVal) {
+        return true;
+    }
+
+    // 临时变量只定值一次，定值在循环外就不变
+    Instanceof(inst, Instruction *, val);
+    if (inst) {
+        auto iter = instBlock.find(inst);
+        return iter != instBlock.end() && !loop->contains(iter->second);
+    }
+
+    // 变量在循环内没有被赋值，全局变量还要求循环内没有函数调用
+    if (loopDefs.count(val)) {
+        return false;
+    }
+
+    Instanceof(globalVar, GlobalVariable *, val);
+    if (globalVar && loopHasCall) {
+        return false;
+    }
+
+    return true;
+}
+
+/// @brief 指令提前执行是否安全
+/// @param inst 运算指令
+/// @return true 安全 false 不安全
+bool LICM::isSafeToSpeculate(Instruction * inst)
+{
+    IRInstOperator op = inst->getOp();
+    if (op != IRInstOperator::IRINST_OP_DIV_I && op != IRInstOperator::IRINST_OP_MOD_I) {
+        return true;
+    }
+
+    // 除数为0时可能异常，INT_MIN除以-1溢出，都不能外提到可能不执行它的路径上
+    Instanceof(divisor, ConstInt *, inst->getOperand(1));
+
+    return divisor && divisor->getVal() != 0 && divisor->getVal() != -1;
+}
+
+/// @brief 把循环内的不变运算指令外提到前置块中
+/// @param loop 循环
+void LICM::hoistInvariants(Loop * loop)
+{
+    BasicBlock * preheader = loop->getPreheader();
+    if (preheader == nullptr) {
+        return;
+    }
+
+    // 按逆后序处理，操作数的定值先于使用处理，一遍即可外提全部的不变指令
+    for (auto bb: loop->getBlocks()) {
+
+        std::vector<Instruction *> kept;
+
+        for (auto inst: bb->getInsts()) {
+
+            bool invariant = !inst->isDead() && isArithOp(inst->getOp()) && isSafeToSpeculate(inst);
+
+            for (int32_t k = 0; invariant && k < inst->getOperandsNum(); ++k) {
+                invariant = isInvariantOperand(loop, inst->getOperand(k));
+            }
+
+            if (invariant) {
+                preheader->insertBeforeTerminator(inst);
+                instBlock[inst] = preheader;
+                hoistedCount++;
+            } else {
+                kept.push_back(inst);
+            }
+        }
+
+        bb->getInsts().swap(kept);
+    }
+}
+
+/// @brief 把循环内被赋值的全局变量替换为局部变量，在前置块中读入，在出口块中写回
+/// @param loop 循环
+void LICM::promoteGlobals(Loop * loop)
+{
+    BasicBlock * preheader = loop->getPreheader();
+    if (preheader == nullptr) {
+        return;
+    }
+
+    // 被调函数可能读写全局变量
+    for (auto bb: loop->getBlocks()) {
+        for (auto inst: bb->getInsts()) {
+            if (!inst->isDead() && inst->getOp() == IRInstOperator::IRINST_OP_FUNC_CALL && callMayAccessGlobals(inst)) {
+                return;
+            }
+        }
+    }
+
+    // 出口块只能从循环内进入，写回才不会影响其它路径
+    std::vector<BasicBlock *> exits = loop->getExitBlocks();
+    for (auto exit: exits) {
+        for (auto pred: exit->getPreds()) {
+            if (!loop->contains(pred)) {
+                return;
+            }
+        }
+    }
+
+    for (auto global: module->getGlobalVariables()) {
+
+        if (!loopDefs.count(global)) {
+            continue;
+        }
+
+        LocalVariable * shadow = func->newLocalVarValue(global->getType());
+
+        for (auto bb: loop->getBlocks()) {
+            for (auto inst: bb->getInsts()) {
+                for (int32_t k = 0; k < inst->getOperandsNum(); ++k) {
+                    if (inst->getOperand(k) == global) {
+                        inst->setOperand(k, shadow);
+                    }
+                }
+            }
+        }
+
+        preheader->insertBeforeTerminator(new (func) MoveInstruction(func, shadow, global));
+
+        for (auto exit: exits) {
+            std::vector<Instruction *> & insts = exit->getInsts();
+            auto pos = exit->getLabel() ? insts.begin() + 1 : insts.begin();
+            insts.insert(pos, new (func) MoveInstruction(func, global, shadow));
+        }
+
+        loopDefs.erase(global);
+        loopDefs.insert(shadow);
+        promotedCount++;
+    }
+}
+
+/// @brief 执行优化
+/// @return true 函数的IR发生了变化 false 没有变化
+bool LICM::run()
+{
+    if (cfg.getBlocks().empty()) {
+        return false;
+    }
+
+    // 先规范化循环，控制流图变化后重新识别循环，直到不再变化
+    bool changed = false;
+    bool simplified = true;
+
+    while (simplified) {
+
+        simplified = false;
+
+        DominatorTree domTree(cfg);
+        LoopInfo loopInfo(cfg, domTree);
+
+        if (loopInfo.getLoops().empty()) {
+            return false;
+        }
+
+        std::vector<char> touched(cfg.getBlocks().size(), 0);
+
+        for (auto loop: loopInfo.getLoops()) {
+            simplified = simplifyLoop(loop, touched) || simplified;
+        }
+
+        if (simplified) {
+            cfg.writeBack();
+            changed = true;
+        }
+    }
+
+    DominatorTree domTree(cfg);
+    LoopInfo loopInfo(cfg, domTree);
+
+    for (auto bb: cfg.getBlocks()) {
+        for (auto inst: bb->getInsts()) {
+            instBlock[inst] = bb;
+        }
+    }
+
+    // 内层循环先处理，外提到内层前置块的指令可以继续外提到外层循环的前置块
+    for (auto loop: loopInfo.getLoops()) {
+
+        loopDefs.clear();
+        loopHasCall = false;
+
+        for (auto bb: loop->getBlocks()) {
+            for (auto inst: bb->getInsts()) {
+                if (inst->isDead()) {
+                    continue;
+                }
+                if (inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN) {
+                    loopDefs.insert(inst->getOperand(0));
+                } else if (inst->getOp() == IRInstOperator::IRINST_OP_FUNC_CALL && callMayWriteGlobals(inst)) {
+                    loopHasCall = true;
+                }
+            }
+        }
+
+        hoistInvariants(loop);
+        promoteGlobals(loop);
+    }
+
+    if (hoistedCount > 0 || promotedCount > 0) {
+        cfg.writeBack();
+        changed = true;
+    }
+
+    return changed;
+}
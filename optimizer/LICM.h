@@ -0,0 +1,122 @@
+///
+/// @file LICM.h
+/// @brief 循环不变量外提与循环内全局变量存储的下沉
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ControlFlowGraph.h"
+#include "LoopInfo.h"
+#include "Pass.h"
+
+///
+/// @brief 循环不变量外提。识别自然循环并在需要时创建前置块，
+/// 操作数在循环内都不变的运算指令移动到前置块中；
+/// 循环内没有函数调用时，对全局变量的读写改为对局部变量的读写，在前置块读入、在出口块写回
+///
+class LICM : public FunctionPass {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    /// @param _func 要优化的函数
+    ///
+    LICM(Module * _module, Function * _func);
+
+    ///
+    /// @brief 执行优化
+    /// @return true 函数的IR发生了变化 false 没有变化
+    ///
+    bool run() override;
+
+private:
+    ///
+    /// @brief 把基本块的部分前驱改为先进入一个新建的空基本块，再由新基本块顺序执行进入原基本块
+    /// @param bb 基本块，必须以Label指令开始
+    /// @param redirected 改为进入新基本块的前驱
+    /// @return true 成功 false 基本块没有Label不能拆分
+    ///
+    bool splitPredecessors(BasicBlock * bb, std::vector<BasicBlock *> & redirected);
+
+    ///
+    /// @brief 规范化循环：没有前置块时创建前置块；需要写回全局变量时，为有循环外前驱的出口块创建专用的出口块
+    /// @param loop 循环
+    /// @param touched 按基本块序号标记本轮已经拆分过的基本块，同一轮内每个基本块只拆分一次
+    /// @return true 控制流图发生了变化 false 没有变化
+    ///
+    bool simplifyLoop(Loop * loop, std::vector<char> & touched);
+
+    ///
+    /// @brief 把循环内的不变运算指令外提到前置块中
+    /// @param loop 循环
+    ///
+    void hoistInvariants(Loop * loop);
+
+    ///
+    /// @brief 操作数在循环内是否不变
+    /// @param loop 循环
+    /// @param val 操作数
+    /// @return true 不变 false 可能变化
+    ///
+    bool isInvariantOperand(Loop * loop, Value * val);
+
+    ///
+    /// @brief 指令提前执行是否安全，除法与求余要求除数是非0且非-1的常量
+    /// @param inst 运算指令
+    /// @return true 安全 false 不安全
+    ///
+    static bool isSafeToSpeculate(Instruction * inst);
+
+    ///
+    /// @brief 把循环内被赋值的全局变量替换为局部变量，在前置块中读入，在出口块中写回
+    /// @param loop 循环
+    ///
+    void promoteGlobals(Loop * loop);
+
+    ///
+    /// @brief 控制流图
+    ///
+    ControlFlowGraph cfg;
+
+    ///
+    /// @brief 指令所在的基本块，指令外提后随之更新
+    ///
+    std::unordered_map<Instruction *, BasicBlock *> instBlock;
+
+    ///
+    /// @brief 当前处理的循环内被赋值的变量
+    ///
+    std::unordered_set<Value *> loopDefs;
+
+    ///
+    /// @brief 当前处理的循环内是否有可能修改全局变量的函数调用
+    ///
+    bool loopHasCall = false;
+
+    ///
+    /// @brief 外提的指令数
+    ///
+    int32_t hoistedCount = 0;
+
+    ///
+    /// @brief 改为局部变量的全局变量个数
+    ///
+    int32_t promotedCount = 0;
+};
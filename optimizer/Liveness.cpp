@@ -0,0 +1,399 @@
+///
+/// @file Liveness.cpp
+/// @brief 活跃变量分析与活跃区间的构造，供寄存器分配与栈槽分配使用
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+
+#include "Liveness.h"
+#include "Function.h"
+#include "SparseBitSet.h"
+
+/// @brief 加入活跃范围[from, to)，与已有的范围重叠或相邻时合并
+/// @param from 起始位置
+/// @param to 结束位置
+void LiveInterval::addRange(int32_t from, int32_t to)
+{
+    if (from >= to) {
+        return;
+    }
+
+    // 反向扫描时新范围总在最前面，先找到第一个结束位置不小于from的范围
+    auto iter = std::lower_bound(ranges.begin(), ranges.end(), from, [](const LiveRange & range, int32_t pos) {
+        return range.end < pos;
+    });
+
+    // 合并与[from, to)重叠或相邻的范围
+    auto last = iter;
+    while (last != ranges.end() && last->start <= to) {
+        from = std::min(from, last->start);
+        to = std::max(to, last->end);
+        ++last;
+    }
+
+    iter = ranges.erase(iter, last);
+    ranges.insert(iter, LiveRange{from, to});
+}
+
+/// @brief 在定值位置截断第一个范围，值在定值之前不活跃；定值后没有使用时加入长度为1的范围
+/// @param pos 定值位置
+void LiveInterval::setDefinition(int32_t pos)
+{
+    if (ranges.empty() || ranges.front().start > pos) {
+        // 定值后没有使用，只在定值处活跃
+        addRange(pos, pos + 1);
+    } else {
+        // 第一个范围从所在基本块的开始延伸过来，定值之前的部分不活跃
+        ranges.front().start = pos;
+    }
+}
+
+/// @brief 位置上值是否活跃
+/// @param pos 位置
+/// @return true 活跃 false 不活跃或在洞中
+bool LiveInterval::covers(int32_t pos) const
+{
+    auto iter = std::upper_bound(ranges.begin(), ranges.end(), pos, [](int32_t p, const LiveRange & range) {
+        return p < range.end;
+    });
+
+    return iter != ranges.end() && iter->start <= pos;
+}
+
+/// @brief 获取两个区间第一个同时活跃的位置
+/// @param other 另一个区间
+/// @return int32_t 位置，不相交时为-1
+int32_t LiveInterval::firstIntersection(const LiveInterval & other) const
+{
+    auto a = ranges.begin();
+    auto b = other.ranges.begin();
+
+    // 两个有序的范围序列归并比较
+    while (a != ranges.end() && b != other.ranges.end()) {
+        if (a->end <= b->start) {
+            ++a;
+        } else if (b->end <= a->start) {
+            ++b;
+        } else {
+            return std::max(a->start, b->start);
+        }
+    }
+
+    return -1;
+}
+
+/// @brief 在位置pos处把区间分成两部分，pos之前的部分留在本区间，pos及之后的部分作为新的区间返回
+/// @param pos 分裂位置
+/// @return LiveInterval pos及之后的部分
+LiveInterval LiveInterval::splitAt(int32_t pos)
+{
+    LiveInterval tail(value);
+
+    // 第一个结束位置大于pos的范围，跨过pos时一分为二
+    auto iter = std::upper_bound(ranges.begin(), ranges.end(), pos, [](int32_t p, const LiveRange & range) {
+        return p < range.end;
+    });
+
+    if (iter != ranges.end() && iter->start < pos) {
+        tail.ranges.push_back(LiveRange{pos, iter->end});
+        iter->end = pos;
+        ++iter;
+    }
+
+    tail.ranges.insert(tail.ranges.end(), iter, ranges.end());
+    ranges.erase(iter, ranges.end());
+
+    auto refIter = std::lower_bound(references.begin(), references.end(), pos);
+    tail.references.assign(refIter, references.end());
+    references.erase(refIter, references.end());
+
+    return tail;
+}
+
+/// @brief 变换成字符串显示，如[0, 5) [8, 12)
+/// @return std::string 字符串
+std::string LiveInterval::toString() const
+{
+    std::string str;
+
+    for (auto & range: ranges) {
+        if (!str.empty()) {
+            str += " ";
+        }
+        str += "[" + std::to_string(range.start) + ", " + std::to_string(range.end) + ")";
+    }
+
+    return str;
+}
+
+/// @brief 构造函数，完成活跃性分析与活跃区间的构造
+/// @param _cfg 控制流图
+Liveness::Liveness(ControlFlowGraph & _cfg) : cfg(_cfg)
+{
+    numbering();
+    computeLiveSets();
+    buildIntervals();
+}
+
+/// @brief 值是否参与活跃性分析：局部变量、形参以及有结果的指令
+/// @param val 值
+/// @return true 参与 false 不参与
+bool Liveness::isTracked(Value * val)
+{
+    if (isa<LocalVariable>(val) || isa<FormalParam>(val)) {
+        return true;
+    }
+
+    Instanceof(inst, Instruction *, val);
+
+    return inst && inst->hasResultValue();
+}
+
+/// @brief 获取值的序号
+/// @param val 值
+/// @return int32_t 序号，不参与分析时为-1
+int32_t Liveness::getValueIndex(Value * val) const
+{
+    auto iter = valueIndex.find(val);
+
+    return iter == valueIndex.end() ? -1 : iter->second;
+}
+
+/// @brief 获取指令的编号，使用位置为编号，定值位置为编号加1
+/// @param inst 指令
+/// @return int32_t 编号，死指令或不在控制流图中时为-1
+int32_t Liveness::getInstNumber(Instruction * inst) const
+{
+    auto iter = instNumber.find(inst);
+
+    return iter == instNumber.end() ? -1 : iter->second;
+}
+
+/// @brief 获取值的活跃区间
+/// @param val 值
+/// @return LiveInterval* 活跃区间，不参与分析时为空
+LiveInterval * Liveness::getInterval(Value * val)
+{
+    int32_t index = getValueIndex(val);
+
+    return index < 0 ? nullptr : &intervals[index];
+}
+
+/// @brief 值加入序号表，已有序号时忽略
+/// @param val 值
+void Liveness::addValue(Value * val)
+{
+    if (valueIndex.find(val) == valueIndex.end()) {
+        valueIndex.emplace(val, (int32_t) values.size());
+        values.push_back(val);
+    }
+}
+
+/// @brief 获取指令定值的值，无结果的赋值指令定值目的操作数
+/// @param inst 指令
+/// @return Value* 定值的值，没有时为空
+Value * Liveness::getDefinedValue(Instruction * inst)
+{
+    if (inst->hasResultValue()) {
+        return inst;
+    }
+
+    if (inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN && isTracked(inst->getOperand(0))) {
+        return inst->getOperand(0);
+    }
+
+    return nullptr;
+}
+
+/// @brief 获取第一个被使用的操作数的下标，赋值指令的目的操作数不是使用
+/// @param inst 指令
+/// @return int32_t 下标
+int32_t Liveness::firstUseOperand(Instruction * inst)
+{
+    return inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN && !inst->hasResultValue() ? 1 : 0;
+}
+
+/// @brief 给参与分析的值编序号，给指令与基本块编号
+void Liveness::numbering()
+{
+    std::vector<BasicBlock *> & blocks = cfg.getBlocks();
+
+    blockStart.resize(blocks.size());
+    blockEnd.resize(blocks.size());
+
+    // 形参在函数入口定值，先编序号
+    for (auto param: cfg.getFunction()->getParams()) {
+        addValue(param);
+    }
+
+    int32_t pos = 0;
+
+    for (auto bb: blocks) {
+
+        blockStart[bb->getIndex()] = pos;
+
+        for (auto inst: bb->getInsts()) {
+
+            if (inst->isDead()) {
+                continue;
+            }
+
+            instNumber.emplace(inst, pos);
+            numberedInsts.push_back(inst);
+            pos += 2;
+
+            for (int32_t k = 0; k < inst->getOperandsNum(); ++k) {
+                if (isTracked(inst->getOperand(k))) {
+                    addValue(inst->getOperand(k));
+                }
+            }
+
+            if (inst->hasResultValue()) {
+                addValue(inst);
+            }
+        }
+
+        blockEnd[bb->getIndex()] = pos;
+    }
+}
+
+/// @brief 反向数据流迭代求各基本块入口与出口活跃的值
+void Liveness::computeLiveSets()
+{
+    std::vector<BasicBlock *> & blocks = cfg.getBlocks();
+    auto valueNum = (uint32_t) values.size();
+
+    // 各基本块的use与def集合，use为定值前被读取的值。每个基本块只涉及少数几个值，用稀疏位集合，
+    // 空间与基本块引用的值的个数成正比，不随函数内值的总数增长
+    std::vector<SparseBitSet> useSets(blocks.size());
+    std::vector<SparseBitSet> defSets(blocks.size());
+
+    for (auto bb: blocks) {
+
+        SparseBitSet & useSet = useSets[bb->getIndex()];
+        SparseBitSet & defSet = defSets[bb->getIndex()];
+
+        for (auto inst: bb->getInsts()) {
+
+            if (inst->isDead()) {
+                continue;
+            }
+
+            Value * defValue = getDefinedValue(inst);
+
+            // 赋值指令的目的操作数不是使用
+            for (int32_t k = firstUseOperand(inst); k < inst->getOperandsNum(); ++k) {
+                int32_t index = getValueIndex(inst->getOperand(k));
+                if (index >= 0 && !defSet.test(index)) {
+                    useSet.set(index);
+                }
+            }
+
+            if (defValue) {
+                defSet.set(getValueIndex(defValue));
+            }
+        }
+    }
+
+    liveIn.assign(blocks.size(), BitSet(valueNum));
+    liveOut.assign(blocks.size(), BitSet(valueNum));
+
+    // 按逆后序的逆序处理收敛较快
+    std::vector<BasicBlock *> order = cfg.reversePostOrder();
+    std::reverse(order.begin(), order.end());
+
+    // in = use ∪ (out - def)
+    BitSet in(valueNum);
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        for (auto bb: order) {
+
+            BitSet & out = liveOut[bb->getIndex()];
+            for (auto succ: bb->getSuccs()) {
+                out |= liveIn[succ->getIndex()];
+            }
+
+            in = out;
+            for (auto index: defSets[bb->getIndex()]) {
+                in.reset(index);
+            }
+            for (auto index: useSets[bb->getIndex()]) {
+                in.set(index);
+            }
+
+            if (liveIn[bb->getIndex()].unionWith(in)) {
+                changed = true;
+            }
+        }
+    }
+}
+
+/// @brief 反向扫描基本块与指令构造活跃区间
+void Liveness::buildIntervals()
+{
+    intervals.reserve(values.size());
+    for (auto val: values) {
+        intervals.emplace_back(val);
+    }
+
+    std::vector<BasicBlock *> & blocks = cfg.getBlocks();
+
+    for (auto bbIter = blocks.rbegin(); bbIter != blocks.rend(); ++bbIter) {
+
+        BasicBlock * bb = *bbIter;
+        int32_t from = blockStart[bb->getIndex()];
+        int32_t to = blockEnd[bb->getIndex()];
+
+        // 出口活跃的值先假定在整个基本块内活跃，遇到定值时再截断
+        for (auto index: liveOut[bb->getIndex()]) {
+            intervals[index].addRange(from, to);
+        }
+
+        std::vector<Instruction *> & insts = bb->getInsts();
+
+        for (auto iter = insts.rbegin(); iter != insts.rend(); ++iter) {
+
+            Instruction * inst = *iter;
+            if (inst->isDead()) {
+                continue;
+            }
+
+            int32_t pos = instNumber[inst];
+            Value * defValue = getDefinedValue(inst);
+
+            if (defValue) {
+                LiveInterval & interval = intervals[getValueIndex(defValue)];
+                interval.setDefinition(pos + 1);
+                interval.references.push_back(pos + 1);
+            }
+
+            for (int32_t k = firstUseOperand(inst); k < inst->getOperandsNum(); ++k) {
+                int32_t index = getValueIndex(inst->getOperand(k));
+                if (index >= 0) {
+                    intervals[index].addRange(from, pos + 1);
+                    intervals[index].references.push_back(pos);
+                }
+            }
+        }
+    }
+
+    // 反向扫描时位置递减，翻转成升序
+    for (auto & interval: intervals) {
+        std::reverse(interval.references.begin(), interval.references.end());
+    }
+}
@@ -0,0 +1,384 @@
+///
+/// @file Liveness.h
+/// @brief 活跃变量分析与活跃区间的构造，供寄存器分配与栈槽分配使用
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BitSet.h"
+#include "ControlFlowGraph.h"
+
+///
+/// @brief 活跃范围[start, end)，以指令编号为单位
+///
+struct LiveRange {
+
+    ///
+    /// @brief 起始位置，包含
+    ///
+    int32_t start;
+
+    ///
+    /// @brief 结束位置，不包含
+    ///
+    int32_t end;
+};
+
+///
+/// @brief 值的活跃区间，由若干个按位置升序、互不相交也不相邻的活跃范围组成，范围之间的空隙为值不活跃的洞
+///
+class LiveInterval {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _value 值
+    ///
+    explicit LiveInterval(Value * _value) : value(_value)
+    {}
+
+    ///
+    /// @brief 获取区间对应的值
+    /// @return Value* 值
+    ///
+    [[nodiscard]] Value * getValue() const
+    {
+        return value;
+    }
+
+    ///
+    /// @brief 加入活跃范围[from, to)，与已有的范围重叠或相邻时合并
+    /// @param from 起始位置
+    /// @param to 结束位置
+    ///
+    void addRange(int32_t from, int32_t to);
+
+    ///
+    /// @brief 在定值位置截断第一个范围，值在定值之前不活跃；定值后没有使用时加入长度为1的范围
+    /// @param pos 定值位置
+    ///
+    void setDefinition(int32_t pos);
+
+    ///
+    /// @brief 获取活跃范围
+    /// @return const std::vector<LiveRange>& 活跃范围
+    ///
+    [[nodiscard]] const std::vector<LiveRange> & getRanges() const
+    {
+        return ranges;
+    }
+
+    ///
+    /// @brief 获取使用与定值的位置，升序排列
+    /// @return const std::vector<int32_t>& 位置
+    ///
+    [[nodiscard]] const std::vector<int32_t> & getReferences() const
+    {
+        return references;
+    }
+
+    ///
+    /// @brief 区间是否为空
+    /// @return true 空 false 不空
+    ///
+    [[nodiscard]] bool empty() const
+    {
+        return ranges.empty();
+    }
+
+    ///
+    /// @brief 获取区间的起始位置，区间不能为空
+    /// @return int32_t 起始位置
+    ///
+    [[nodiscard]] int32_t start() const
+    {
+        return ranges.front().start;
+    }
+
+    ///
+    /// @brief 获取区间的结束位置，区间不能为空
+    /// @return int32_t 结束位置，不包含
+    ///
+    [[nodiscard]] int32_t end() const
+    {
+        return ranges.back().end;
+    }
+
+    ///
+    /// @brief 位置上值是否活跃
+    /// @param pos 位置
+    /// @return true 活跃 false 不活跃或在洞中
+    ///
+    [[nodiscard]] bool covers(int32_t pos) const;
+
+    ///
+    /// @brief 两个区间是否有同时活跃的位置
+    /// @param other 另一个区间
+    /// @return true 相交 false 不相交
+    ///
+    [[nodiscard]] bool overlaps(const LiveInterval & other) const
+    {
+        return firstIntersection(other) >= 0;
+    }
+
+    ///
+    /// @brief 获取两个区间第一个同时活跃的位置
+    /// @param other 另一个区间
+    /// @return int32_t 位置，不相交时为-1
+    ///
+    [[nodiscard]] int32_t firstIntersection(const LiveInterval & other) const;
+
+    ///
+    /// @brief 在位置pos处把区间分成两部分，pos之前的部分留在本区间，pos及之后的部分作为新的区间返回
+    /// @param pos 分裂位置
+    /// @return LiveInterval pos及之后的部分
+    ///
+    LiveInterval splitAt(int32_t pos);
+
+    ///
+    /// @brief 变换成字符串显示，如[0, 5) [8, 12)
+    /// @return std::string 字符串
+    ///
+    [[nodiscard]] std::string toString() const;
+
+private:
+    ///
+    /// @brief 区间对应的值
+    ///
+    Value * value;
+
+    ///
+    /// @brief 按位置升序排列的活跃范围
+    ///
+    std::vector<LiveRange> ranges;
+
+    ///
+    /// @brief 使用与定值的位置，用于溢出代价的估计
+    ///
+    std::vector<int32_t> references;
+
+    friend class Liveness;
+};
+
+///
+/// @brief 函数内局部变量、形参与临时值的活跃性分析。
+/// 按基本块的布局顺序给指令编号，第k条指令的使用位置为2k、定值位置为2k+1，
+/// 反向数据流迭代求出各基本块入口与出口活跃的值，再反向扫描指令构造每个值的活跃区间。
+/// 只针对指定的控制流图，函数的指令变化后需重新计算
+///
+class Liveness {
+
+public:
+    ///
+    /// @brief 构造函数，完成活跃性分析与活跃区间的构造
+    /// @param _cfg 控制流图
+    ///
+    explicit Liveness(ControlFlowGraph & _cfg);
+
+    ///
+    /// @brief 值是否参与活跃性分析：局部变量、形参以及有结果的指令
+    /// @param val 值
+    /// @return true 参与 false 不参与
+    ///
+    static bool isTracked(Value * val);
+
+    ///
+    /// @brief 获取参与分析的值，下标为值的序号
+    /// @return const std::vector<Value *>& 值
+    ///
+    [[nodiscard]] const std::vector<Value *> & getValues() const
+    {
+        return values;
+    }
+
+    ///
+    /// @brief 获取值的序号
+    /// @param val 值
+    /// @return int32_t 序号，不参与分析时为-1
+    ///
+    [[nodiscard]] int32_t getValueIndex(Value * val) const;
+
+    ///
+    /// @brief 获取基本块入口活跃的值的序号集合
+    /// @param bb 基本块
+    /// @return const BitSet& 集合
+    ///
+    [[nodiscard]] const BitSet & getLiveIn(BasicBlock * bb) const
+    {
+        return liveIn[bb->getIndex()];
+    }
+
+    ///
+    /// @brief 获取基本块出口活跃的值的序号集合
+    /// @param bb 基本块
+    /// @return const BitSet& 集合
+    ///
+    [[nodiscard]] const BitSet & getLiveOut(BasicBlock * bb) const
+    {
+        return liveOut[bb->getIndex()];
+    }
+
+    ///
+    /// @brief 获取指令的编号，使用位置为编号，定值位置为编号加1
+    /// @param inst 指令
+    /// @return int32_t 编号，死指令或不在控制流图中时为-1
+    ///
+    [[nodiscard]] int32_t getInstNumber(Instruction * inst) const;
+
+    ///
+    /// @brief 获取编号对应的指令
+    /// @param pos 位置
+    /// @return Instruction* 指令
+    ///
+    [[nodiscard]] Instruction * getInstAt(int32_t pos) const
+    {
+        return numberedInsts[pos / 2];
+    }
+
+    ///
+    /// @brief 获取基本块第一条指令的编号
+    /// @param bb 基本块
+    /// @return int32_t 编号
+    ///
+    [[nodiscard]] int32_t getBlockStart(BasicBlock * bb) const
+    {
+        return blockStart[bb->getIndex()];
+    }
+
+    ///
+    /// @brief 获取基本块最后一条指令之后的编号
+    /// @param bb 基本块
+    /// @return int32_t 编号
+    ///
+    [[nodiscard]] int32_t getBlockEnd(BasicBlock * bb) const
+    {
+        return blockEnd[bb->getIndex()];
+    }
+
+    ///
+    /// @brief 获取值的活跃区间
+    /// @param val 值
+    /// @return LiveInterval* 活跃区间，不参与分析时为空
+    ///
+    LiveInterval * getInterval(Value * val);
+
+    ///
+    /// @brief 获取全部的活跃区间，下标为值的序号
+    /// @return std::vector<LiveInterval>& 活跃区间
+    ///
+    std::vector<LiveInterval> & getIntervals()
+    {
+        return intervals;
+    }
+
+    ///
+    /// @brief 获取控制流图
+    /// @return ControlFlowGraph& 控制流图
+    ///
+    ControlFlowGraph & getCFG()
+    {
+        return cfg;
+    }
+
+private:
+    ///
+    /// @brief 给参与分析的值编序号，给指令与基本块编号
+    ///
+    void numbering();
+
+    ///
+    /// @brief 反向数据流迭代求各基本块入口与出口活跃的值
+    ///
+    void computeLiveSets();
+
+    ///
+    /// @brief 反向扫描基本块与指令构造活跃区间
+    ///
+    void buildIntervals();
+
+    ///
+    /// @brief 值加入序号表，已有序号时忽略
+    /// @param val 值
+    ///
+    void addValue(Value * val);
+
+    ///
+    /// @brief 获取指令定值的值，无结果的赋值指令定值目的操作数
+    /// @param inst 指令
+    /// @return Value* 定值的值，没有时为空
+    ///
+    static Value * getDefinedValue(Instruction * inst);
+
+    ///
+    /// @brief 获取第一个被使用的操作数的下标，赋值指令的目的操作数不是使用
+    /// @param inst 指令
+    /// @return int32_t 下标
+    ///
+    static int32_t firstUseOperand(Instruction * inst);
+
+    ///
+    /// @brief 控制流图
+    ///
+    ControlFlowGraph & cfg;
+
+    ///
+    /// @brief 参与分析的值
+    ///
+    std::vector<Value *> values;
+
+    ///
+    /// @brief 值到序号的映射
+    ///
+    std::unordered_map<Value *, int32_t> valueIndex;
+
+    ///
+    /// @brief 指令到编号的映射
+    ///
+    std::unordered_map<Instruction *, int32_t> instNumber;
+
+    ///
+    /// @brief 按编号排列的指令，第k个的编号为2k
+    ///
+    std::vector<Instruction *> numberedInsts;
+
+    ///
+    /// @brief 按基本块序号记录第一条指令的编号
+    ///
+    std::vector<int32_t> blockStart;
+
+    ///
+    /// @brief 按基本块序号记录最后一条指令之后的编号
+    ///
+    std::vector<int32_t> blockEnd;
+
+    ///
+    /// @brief 按基本块序号记录入口活跃的值
+    ///
+    std::vector<BitSet> liveIn;
+
+    ///
+    /// @brief 按基本块序号记录出口活跃的值
+    ///
+    std::vector<BitSet> liveOut;
+
+    ///
+    /// @brief 按值的序号排列的活跃区间
+    ///
+    std::vector<LiveInterval> intervals;
+};
@@ -0,0 +1,173 @@
+///
+/// @file LoopInfo.cpp
+/// @brief 自然循环的识别与循环嵌套关系
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+
+#include "LoopInfo.h"
+
+/// @brief 构造函数
+/// @param _header 循环头
+/// @param blockNum 函数内基本块的个数
+Loop::Loop(BasicBlock * _header, size_t blockNum) : header(_header), member(blockNum, 0)
+{}
+
+/// @brief 获取前置块
+/// @return BasicBlock* 前置块，不存在时为空
+BasicBlock * Loop::getPreheader()
+{
+    BasicBlock * preheader = nullptr;
+
+    for (auto pred: header->getPreds()) {
+        if (contains(pred)) {
+            continue;
+        }
+        if (preheader != nullptr) {
+            return nullptr;
+        }
+        preheader = pred;
+    }
+
+    if (preheader == nullptr || preheader->getSuccs().size() != 1) {
+        return nullptr;
+    }
+
+    return preheader;
+}
+
+/// @brief 获取出口块
+/// @return std::vector<BasicBlock *> 出口块
+std::vector<BasicBlock *> Loop::getExitBlocks()
+{
+    std::vector<BasicBlock *> exits;
+
+    for (auto bb: blocks) {
+        for (auto succ: bb->getSuccs()) {
+            if (!contains(succ) && std::find(exits.begin(), exits.end(), succ) == exits.end()) {
+                exits.push_back(succ);
+            }
+        }
+    }
+
+    return exits;
+}
+
+/// @brief 获取循环嵌套深度
+/// @return int32_t 深度
+int32_t Loop::getDepth()
+{
+    int32_t depth = 0;
+
+    for (Loop * loop = this; loop != nullptr; loop = loop->parent) {
+        depth++;
+    }
+
+    return depth;
+}
+
+/// @brief 构造函数，识别控制流图中的自然循环
+/// @param cfg 控制流图
+/// @param domTree 支配树
+LoopInfo::LoopInfo(ControlFlowGraph & cfg, DominatorTree & domTree)
+{
+    size_t blockNum = cfg.getBlocks().size();
+    std::vector<BasicBlock *> & rpo = domTree.getReversePostOrder();
+
+    loopOfBlock.assign(blockNum, nullptr);
+
+    // 按逆后序找循环头，后继支配自身的边是回边
+    std::vector<Loop *> headerLoop(blockNum, nullptr);
+
+    for (auto bb: rpo) {
+        for (auto succ: bb->getSuccs()) {
+
+            if (!domTree.dominates(succ, bb)) {
+                continue;
+            }
+
+            Loop * loop = headerLoop[succ->getIndex()];
+            if (loop == nullptr) {
+                loop = new Loop(succ, blockNum);
+                loop->member[succ->getIndex()] = 1;
+                headerLoop[succ->getIndex()] = loop;
+                loops.push_back(loop);
+            }
+            loop->latches.push_back(bb);
+
+            // 从回边的源反向遍历到循环头，经过的基本块都在循环内
+            std::vector<BasicBlock *> stack;
+            if (!loop->member[bb->getIndex()]) {
+                loop->member[bb->getIndex()] = 1;
+                stack.push_back(bb);
+            }
+
+            while (!stack.empty()) {
+
+                BasicBlock * cur = stack.back();
+                stack.pop_back();
+
+                for (auto pred: cur->getPreds()) {
+                    if (domTree.isReachable(pred) && !loop->member[pred->getIndex()]) {
+                        loop->member[pred->getIndex()] = 1;
+                        stack.push_back(pred);
+                    }
+                }
+            }
+        }
+    }
+
+    for (auto loop: loops) {
+        for (auto bb: rpo) {
+            if (loop->member[bb->getIndex()]) {
+                loop->blocks.push_back(bb);
+            }
+        }
+    }
+
+    // 内层循环的基本块是外层循环的真子集，按大小排序后内层循环在前
+    std::stable_sort(loops.begin(), loops.end(), [](Loop * a, Loop * b) {
+        return a->blocks.size() < b->blocks.size();
+    });
+
+    for (size_t k = 0; k < loops.size(); ++k) {
+
+        Loop * loop = loops[k];
+
+        for (auto bb: loop->blocks) {
+            if (loopOfBlock[bb->getIndex()] == nullptr) {
+                loopOfBlock[bb->getIndex()] = loop;
+            }
+        }
+
+        // 外层循环是包含循环头的最小的其它循环
+        for (size_t j = k + 1; j < loops.size(); ++j) {
+            if (loops[j]->contains(loop->header)) {
+                loop->parent = loops[j];
+                loops[j]->subLoops.push_back(loop);
+                break;
+            }
+        }
+    }
+}
+
+/// @brief 析构函数，释放循环
+LoopInfo::~LoopInfo()
+{
+    for (auto loop: loops) {
+        delete loop;
+    }
+    loops.clear();
+}
@@ -0,0 +1,192 @@
+///
+/// @file LoopInfo.h
+/// @brief 自然循环的识别与循环嵌套关系
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "ControlFlowGraph.h"
+#include "DominatorTree.h"
+
+///
+/// @brief 自然循环。由回边(latch -> header，header支配latch)确定，同一个循环头的多条回边合并为一个循环
+///
+class Loop {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _header 循环头
+    /// @param blockNum 函数内基本块的个数
+    ///
+    Loop(BasicBlock * _header, size_t blockNum);
+
+    ///
+    /// @brief 获取循环头
+    /// @return BasicBlock* 循环头
+    ///
+    BasicBlock * getHeader()
+    {
+        return header;
+    }
+
+    ///
+    /// @brief 获取循环内的基本块，按逆后序排列，第一个为循环头
+    /// @return std::vector<BasicBlock *>& 基本块
+    ///
+    std::vector<BasicBlock *> & getBlocks()
+    {
+        return blocks;
+    }
+
+    ///
+    /// @brief 获取回边的源基本块
+    /// @return std::vector<BasicBlock *>& 基本块
+    ///
+    std::vector<BasicBlock *> & getLatches()
+    {
+        return latches;
+    }
+
+    ///
+    /// @brief 基本块是否在循环内
+    /// @param bb 基本块
+    /// @return true 在 false 不在
+    ///
+    bool contains(BasicBlock * bb)
+    {
+        return member[bb->getIndex()] != 0;
+    }
+
+    ///
+    /// @brief 获取前置块：循环外唯一的前驱，且其唯一的后继是循环头
+    /// @return BasicBlock* 前置块，不存在时为空
+    ///
+    BasicBlock * getPreheader();
+
+    ///
+    /// @brief 获取出口块：不在循环内但有循环内的前驱的基本块
+    /// @return std::vector<BasicBlock *> 出口块
+    ///
+    std::vector<BasicBlock *> getExitBlocks();
+
+    ///
+    /// @brief 获取外层循环
+    /// @return Loop* 外层循环，最外层循环为空
+    ///
+    Loop * getParent()
+    {
+        return parent;
+    }
+
+    ///
+    /// @brief 获取直接内嵌的循环
+    /// @return std::vector<Loop *>& 内层循环
+    ///
+    std::vector<Loop *> & getSubLoops()
+    {
+        return subLoops;
+    }
+
+    ///
+    /// @brief 获取循环嵌套深度，最外层为1
+    /// @return int32_t 深度
+    ///
+    int32_t getDepth();
+
+private:
+    ///
+    /// @brief 循环头
+    ///
+    BasicBlock * header;
+
+    ///
+    /// @brief 循环内的基本块
+    ///
+    std::vector<BasicBlock *> blocks;
+
+    ///
+    /// @brief 回边的源基本块
+    ///
+    std::vector<BasicBlock *> latches;
+
+    ///
+    /// @brief 按基本块序号标记是否在循环内
+    ///
+    std::vector<char> member;
+
+    ///
+    /// @brief 外层循环
+    ///
+    Loop * parent = nullptr;
+
+    ///
+    /// @brief 内层循环
+    ///
+    std::vector<Loop *> subLoops;
+
+    friend class LoopInfo;
+};
+
+///
+/// @brief 函数内全部的自然循环。控制流图变化后需重新计算
+///
+class LoopInfo {
+
+public:
+    ///
+    /// @brief 构造函数，识别控制流图中的自然循环
+    /// @param cfg 控制流图
+    /// @param domTree 支配树
+    ///
+    LoopInfo(ControlFlowGraph & cfg, DominatorTree & domTree);
+
+    ///
+    /// @brief 析构函数，释放循环
+    ///
+    ~LoopInfo();
+
+    ///
+    /// @brief 获取全部的循环，内层循环排在外层循环的前面
+    /// @return std::vector<Loop *>& 循环
+    ///
+    std::vector<Loop *> & getLoops()
+    {
+        return loops;
+    }
+
+    ///
+    /// @brief 获取包含基本块的最内层循环
+    /// @param bb 基本块
+    /// @return Loop* 循环，不在任何循环内时为空
+    ///
+    Loop * getLoopFor(BasicBlock * bb)
+    {
+        return loopOfBlock[bb->getIndex()];
+    }
+
+private:
+    ///
+    /// @brief 全部的循环
+    ///
+    std::vector<Loop *> loops;
+
+    ///
+    /// @brief 按基本块序号记录所在的最内层循环
+    ///
+    std::vector<Loop *> loopOfBlock;
+};
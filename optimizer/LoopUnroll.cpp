@@ -0,0 +1,476 @@
+///
+/// @file LoopUnroll.cpp
+/// @brief 循环展开，迭代次数为小常量时完全展开，否则按2/4/8倍部分展开并保留余数循环
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+#include <climits>
+
+#include "LoopUnroll.h"
+#include "BinaryInstruction.h"
+#include "ConstInt.h"
+#include "DominatorTree.h"
+#include "IntegerType.h"
+#include "OptUtils.h"
+#include "Profile.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _func 要优化的函数
+/// @param _optLevel 优化级别
+/// @param _threshold 展开后循环的最大指令数，小于0时按优化级别取缺省值，0时不展开
+LoopUnroll::LoopUnroll(Module * _module, Function * _func, int _optLevel, int _threshold)
+    : FunctionPass(_module, _func), cfg(_func), optLevel(_optLevel), threshold(_threshold)
+{
+    if (threshold < 0) {
+        threshold = optLevel >= 2 ? 200 : 100;
+    }
+}
+
+/// @brief 获取循环的指令数，不含Label指令
+/// @param loop 循环
+/// @return int32_t 指令数
+int32_t LoopUnroll::getLoopSize(Loop * loop)
+{
+    int32_t size = 0;
+
+    for (auto bb: loop->getBlocks()) {
+        for (auto inst: bb->getInsts()) {
+            if (!inst->isDead() && inst->getOp() != IRInstOperator::IRINST_OP_LABEL) {
+                size++;
+            }
+        }
+    }
+
+    return size;
+}
+
+/// @brief 循环内指令的结果是否在循环外使用，展开后这些使用无法对应到复制的指令
+/// @param loop 循环
+/// @return true 有 false 没有
+bool LoopUnroll::hasUsesOutside(Loop * loop)
+{
+    for (auto bb: loop->getBlocks()) {
+        for (auto inst: bb->getInsts()) {
+
+            if (inst->isDead()) {
+                continue;
+            }
+
+            for (auto use: inst->getUses()) {
+                Instanceof(user, Instruction *, use->getUser());
+                BasicBlock * userBlock = user ? cfg.getBlockOfInst(user) : nullptr;
+                if (userBlock == nullptr || !loop->contains(userBlock)) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+/// @brief 获取循环头以外的循环基本块，按线性IR的次序排列
+/// @param loop 循环
+/// @return std::vector<BasicBlock *> 基本块
+std::vector<BasicBlock *> LoopUnroll::getBodyBlocks(Loop * loop)
+{
+    std::vector<BasicBlock *> body;
+
+    for (auto bb: cfg.getBlocks()) {
+        if (bb != loop->getHeader() && loop->contains(bb)) {
+            body.push_back(bb);
+        }
+    }
+
+    return body;
+}
+
+/// @brief 复制一组基本块，跳转到映射表之外的Label保持不变。线性次序中使用可能在定值之前，
+/// 如回边所在的基本块排在循环体之前，因此全部复制后再按映射表修正操作数
+/// @param blocks 按线性次序排列的基本块
+/// @param valueMap 值的映射表，需要预先放入跳转目标的映射
+/// @param seq 复制后的指令追加到这里
+void LoopUnroll::cloneBlocks(std::vector<BasicBlock *> & blocks,
+                             std::unordered_map<Value *, Value *> & valueMap,
+                             std::vector<Instruction *> & seq)
+{
+    // 先创建全部的Label，后面的跳转可能向前引用
+    for (auto bb: blocks) {
+        LabelInstruction * label = bb->getLabel();
+        if (label && !valueMap.count(label)) {
+            LabelInstruction * newLabel = new (func) LabelInstruction(func);
+            newLabel->profileCount = label->profileCount;
+            valueMap[label] = newLabel;
+        }
+    }
+
+    size_t first = seq.size();
+
+    for (size_t k = 0; k < blocks.size(); ++k) {
+
+        BasicBlock * bb = blocks[k];
+
+        for (auto inst: bb->getInsts()) {
+            if (!inst->isDead()) {
+                seq.push_back(cloneInstruction(func, inst, valueMap));
+            }
+        }
+
+        // 顺序执行进入的后继若不是下一个复制的基本块，需要显式跳转
+        if (bb->getTerminator() == nullptr && !bb->getSuccs().empty()) {
+            BasicBlock * succ = bb->getSuccs()[0];
+            if (k + 1 == blocks.size() || blocks[k + 1] != succ) {
+                Value * target = valueMap[succ->getLabel()];
+                seq.push_back(new (func) GotoInstruction(func, static_cast<Instruction *>(target)));
+            }
+        }
+    }
+
+    remapOperands(seq.begin() + (std::ptrdiff_t) first, seq.end(), valueMap);
+}
+
+/// @brief 删除紧跟着目标Label的无条件跳转
+/// @param seq 指令序列
+void LoopUnroll::removeJumpsToNext(std::vector<Instruction *> & seq)
+{
+    std::vector<Instruction *> result;
+
+    for (size_t k = 0; k < seq.size(); ++k) {
+
+        Instruction * inst = seq[k];
+
+        if (inst->getOp() == IRInstOperator::IRINST_OP_GOTO && k + 1 < seq.size()) {
+            GotoInstruction * gotoInst = static_cast<GotoInstruction *>(inst);
+            if (!gotoInst->isConditionalBranch() && gotoInst->getTarget() == seq[k + 1]) {
+                delete inst;
+                continue;
+            }
+        }
+
+        result.push_back(inst);
+    }
+
+    seq.swap(result);
+}
+
+/// @brief 完全展开迭代次数为常量的循环
+/// @param loop 循环
+/// @param exitTest 退出条件
+/// @param tripCount 迭代次数
+void LoopUnroll::fullyUnroll(Loop * loop, LoopExitTest * exitTest, int64_t tripCount)
+{
+    BasicBlock * header = loop->getHeader();
+    LabelInstruction * headerLabel = header->getLabel();
+    std::vector<BasicBlock *> body = getBodyBlocks(loop);
+
+    BasicBlock * bodyEntry = loop->contains(header->getSuccs()[0]) ? header->getSuccs()[0] : header->getSuccs()[1];
+
+    // 每次迭代复制一份循环头与循环体，循环头的条件跳转改为无条件跳转，最后一份循环头跳转到出口
+    std::vector<Instruction *> seq;
+    Instruction * nextHeader = nullptr;
+
+    for (int64_t k = 0; k <= tripCount; ++k) {
+
+        std::unordered_map<Value *, Value *> valueMap;
+
+        if (k > 0) {
+            seq.push_back(nextHeader);
+        }
+
+        for (auto inst: header->getInsts()) {
+            if (!inst->isDead() && inst != headerLabel && inst != exitTest->branch) {
+                seq.push_back(cloneInstruction(func, inst, valueMap));
+            }
+        }
+
+        if (k == tripCount) {
+            seq.push_back(new (func) GotoInstruction(func, exitTest->exitBlock->getLabel()));
+            break;
+        }
+
+        nextHeader = new (func) LabelInstruction(func);
+        valueMap[headerLabel] = nextHeader;
+
+        LabelInstruction * entryLabel = new (func) LabelInstruction(func);
+        valueMap[bodyEntry->getLabel()] = entryLabel;
+        seq.push_back(new (func) GotoInstruction(func, entryLabel));
+
+        cloneBlocks(body, valueMap, seq);
+    }
+
+    removeJumpsToNext(seq);
+
+    // 原来的循环删除，只保留循环头的Label作为入口
+    for (auto bb: loop->getBlocks()) {
+        for (auto inst: bb->getInsts()) {
+            if (!inst->isDead() && inst != headerLabel) {
+                inst->setDead();
+                inst->clearOperands();
+            }
+        }
+    }
+
+    std::vector<Instruction *> & insts = header->getInsts();
+    insts.insert(std::find(insts.begin(), insts.end(), headerLabel) + 1, seq.begin(), seq.end());
+}
+
+/// @brief 按倍数展开循环，原循环作为余数循环
+/// @param loop 循环
+/// @param exitTest 退出条件
+/// @param factor 展开倍数
+/// @return true 成功 false 不能展开
+bool LoopUnroll::partiallyUnroll(Loop * loop, LoopExitTest * exitTest, int32_t factor)
+{
+    BasicBlock * header = loop->getHeader();
+    BasicBlock * preheader = loop->getPreheader();
+    LabelInstruction * headerLabel = header->getLabel();
+    Value * cond = exitTest->branch->getOperand(0);
+
+    // 展开的循环体中不执行循环头，因此要求循环头只计算退出条件，且条件变量只用于跳转
+    for (auto inst: header->getInsts()) {
+        if (inst->isDead() || inst == headerLabel || inst == exitTest->compare || inst == exitTest->branch) {
+            continue;
+        }
+        if (inst->getOp() != IRInstOperator::IRINST_OP_ASSIGN || inst->getOperand(0) != cond ||
+            inst->getOperand(1) != exitTest->compare) {
+            return false;
+        }
+    }
+
+    if (cond != exitTest->compare) {
+        for (auto use: cond->getUses()) {
+            Instanceof(user, Instruction *, use->getUser());
+            if (user != exitTest->branch &&
+                (user->getOp() != IRInstOperator::IRINST_OP_ASSIGN || user->getOperand(0) != cond)) {
+                return false;
+            }
+        }
+    }
+
+    // 剩余的迭代至少还有factor次，等价于 iv op bound -/+ (factor - 1) * |step|
+    IRInstOperator op = exitTest->op;
+    int64_t step = exitTest->iv->step;
+    bool up;
+
+    if (op == IRInstOperator::IRINST_OP_LT_I || op == IRInstOperator::IRINST_OP_LE_I) {
+        up = true;
+    } else if (op == IRInstOperator::IRINST_OP_GT_I || op == IRInstOperator::IRINST_OP_GE_I) {
+        up = false;
+    } else {
+        return false;
+    }
+
+    if (up != (step > 0)) {
+        return false;
+    }
+
+    int64_t distance = (int64_t) (factor - 1) * (up ? step : -step);
+    if (distance > INT32_MAX) {
+        return false;
+    }
+
+    Type * intType = IntegerType::getTypeInt();
+    Type * boolType = IntegerType::getTypeBool();
+
+    Value * limit;
+    std::vector<Instruction *> limitInsts;
+    Instruction * enoughTest = nullptr;
+
+    Instanceof(boundConst, ConstInt *, exitTest->bound);
+    if (boundConst) {
+
+        int64_t value = up ? (int64_t) boundConst->getVal() - distance : (int64_t) boundConst->getVal() + distance;
+        if (value < INT32_MIN || value > INT32_MAX) {
+            return false;
+        }
+        limit = module->newConstInt((int32_t) value);
+
+    } else {
+
+        // 边界不是常量时，在前置块计算新的边界，溢出时新边界越过了原边界，直接进入余数循环
+        BinaryInstruction * limitInst = new (func) BinaryInstruction(func,
+                                                                     up ? IRInstOperator::IRINST_OP_SUB_I
+                                                                        : IRInstOperator::IRINST_OP_ADD_I,
+                                                                     exitTest->bound,
+                                                                     module->newConstInt((int32_t) distance),
+                                                                     intType);
+        enoughTest = new (func) BinaryInstruction(func,
+                                                  up ? IRInstOperator::IRINST_OP_LT_I : IRInstOperator::IRINST_OP_GT_I,
+                                                  limitInst,
+                                                  exitTest->bound,
+                                                  boolType);
+        limitInsts.push_back(limitInst);
+        limitInsts.push_back(enoughTest);
+        limit = limitInst;
+    }
+
+    std::vector<BasicBlock *> body = getBodyBlocks(loop);
+    BasicBlock * bodyEntry = loop->contains(header->getSuccs()[0]) ? header->getSuccs()[0] : header->getSuccs()[1];
+
+    // 每份循环体的Label预先创建，第k份的回边跳转到第k+1份，最后一份跳转到展开循环的循环头
+    // 剖面数据中的执行次数按展开倍数分摊到每份循环体
+    LabelInstruction * unrolledLabel = new (func) LabelInstruction(func);
+    int64_t headerCount = header->getLabel()->profileCount;
+    unrolledLabel->profileCount = headerCount < 0 ? -1 : headerCount / factor;
+    std::vector<std::unordered_map<Value *, Value *>> valueMaps(factor);
+
+    for (int32_t k = 0; k < factor; ++k) {
+        for (auto bb: body) {
+            LabelInstruction * label = bb->getLabel();
+            if (label) {
+                LabelInstruction * newLabel = new (func) LabelInstruction(func);
+                newLabel->profileCount = label->profileCount < 0 ? -1 : label->profileCount / factor;
+                valueMaps[k][label] = newLabel;
+            }
+        }
+    }
+
+    for (int32_t k = 0; k < factor; ++k) {
+        valueMaps[k][headerLabel] = k + 1 < factor ? valueMaps[k + 1][bodyEntry->getLabel()] : unrolledLabel;
+    }
+
+    std::vector<Instruction *> seq;
+
+    BinaryInstruction * unrolledTest = new (func) BinaryInstruction(func, op, exitTest->iv->var, limit, boolType);
+    seq.push_back(unrolledLabel);
+    seq.push_back(unrolledTest);
+    seq.push_back(new (func) GotoInstruction(func,
+                                             unrolledTest,
+                                             static_cast<Instruction *>(valueMaps[0][bodyEntry->getLabel()]),
+                                             headerLabel));
+
+    for (int32_t k = 0; k < factor; ++k) {
+        cloneBlocks(body, valueMaps[k], seq);
+    }
+
+    removeJumpsToNext(seq);
+
+    // 循环头之前顺序执行进入的前驱若不是前置块，需显式跳转到余数循环
+    if (header->getIndex() > 0) {
+        BasicBlock * prev = cfg.getBlocks()[header->getIndex() - 1];
+        if (prev != preheader && prev->getTerminator() == nullptr) {
+            prev->getInsts().push_back(new (func) GotoInstruction(func, headerLabel));
+        }
+    }
+
+    // 前置块改为进入展开的循环
+    Instruction * term = preheader->getTerminator();
+
+    if (enoughTest) {
+        for (auto inst: limitInsts) {
+            preheader->insertBeforeTerminator(inst);
+        }
+        if (term) {
+            term->setDead();
+        }
+        preheader->getInsts().push_back(new (func) GotoInstruction(func, enoughTest, unrolledLabel, headerLabel));
+    } else if (term) {
+        static_cast<GotoInstruction *>(term)->setTarget(unrolledLabel);
+    }
+
+    header->getInsts().insert(header->getInsts().begin(), seq.begin(), seq.end());
+
+    doneHeaders.insert(unrolledLabel);
+
+    return true;
+}
+
+/// @brief 在当前的控制流图中找一个循环进行展开
+/// @return true 展开了一个循环 false 没有可展开的循环
+bool LoopUnroll::unrollOneLoop()
+{
+    DominatorTree domTree(cfg);
+    LoopInfo loopInfo(cfg, domTree);
+
+    for (auto loop: loopInfo.getLoops()) {
+
+        LabelInstruction * headerLabel = loop->getHeader()->getLabel();
+
+        if (!loop->getSubLoops().empty() || headerLabel == nullptr || doneHeaders.count(headerLabel) ||
+            loop->getPreheader() == nullptr) {
+            continue;
+        }
+
+        // 不论能否展开，同一个循环只尝试一次
+        doneHeaders.insert(headerLabel);
+
+        InductionVariableInfo ivInfo(loop, loopInfo, domTree);
+        LoopExitTest * exitTest = ivInfo.getExitTest();
+        if (exitTest == nullptr || exitTest->exitBlock->getLabel() == nullptr || hasUsesOutside(loop)) {
+            continue;
+        }
+
+        // 剖面数据表明几乎不执行的循环，展开只会增大代码
+        int64_t headerCount = headerLabel->profileCount;
+        if (isColdCount(module, headerCount)) {
+            continue;
+        }
+
+        // 内层循环执行的更频繁，允许展开得更多，剖面数据中热的循环再加倍
+        int64_t size = getLoopSize(loop);
+        int64_t budget = (int64_t) threshold << (std::min(loop->getDepth(), 3) - 1);
+        if (isHotCount(module, headerCount)) {
+            budget *= 2;
+        }
+
+        // 循环头每次进入循环多执行一次退出判断，由剖面数据得到平均迭代次数
+        int64_t avgTripCount = -1;
+        int64_t entryCount = getBlockCount(func, loop->getPreheader());
+        if (headerCount >= entryCount && entryCount > 0) {
+            avgTripCount = (headerCount - entryCount) / entryCount;
+        }
+
+        int64_t tripCount;
+        bool constTrip = ivInfo.getTripCount(tripCount);
+
+        if (constTrip && (tripCount + 1) * size <= budget) {
+            fullyUnroll(loop, exitTest, tripCount);
+            return true;
+        }
+
+        if (optLevel < 2) {
+            continue;
+        }
+
+        int32_t factor = 8;
+        while (factor >= 2 && (factor * size > budget || (constTrip && factor > tripCount) ||
+                               (avgTripCount >= 0 && factor > avgTripCount))) {
+            factor /= 2;
+        }
+
+        if (factor >= 2 && partiallyUnroll(loop, exitTest, factor)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// @brief 执行优化
+/// @return true 函数的IR发生了变化 false 没有变化
+bool LoopUnroll::run()
+{
+    if (threshold == 0 || cfg.getBlocks().empty()) {
+        return false;
+    }
+
+    while (unrollOneLoop()) {
+        cfg.writeBack();
+        unrolledCount++;
+    }
+
+    return unrolledCount > 0;
+}
@@ -0,0 +1,137 @@
+///
+/// @file LoopUnroll.h
+/// @brief 循环展开，迭代次数为小常量时完全展开，否则按2/4/8倍部分展开并保留余数循环
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ControlFlowGraph.h"
+#include "InductionVariable.h"
+#include "Pass.h"
+
+///
+/// @brief 循环展开。只处理最内层、只在循环头退出的循环。
+/// 展开后的指令数不超过阈值，阈值随循环嵌套深度增大；
+/// 迭代次数为常量时完全展开，-O2及以上对其它循环按2/4/8倍展开，剩余的迭代由原来的循环执行。
+/// 有剖面数据时冷的循环不展开，热的循环阈值加倍，展开倍数不超过平均迭代次数
+///
+class LoopUnroll : public FunctionPass {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    /// @param _func 要优化的函数
+    /// @param _optLevel 优化级别
+    /// @param _threshold 展开后循环的最大指令数，小于0时按优化级别取缺省值，0时不展开
+    ///
+    LoopUnroll(Module * _module, Function * _func, int _optLevel, int _threshold);
+
+    ///
+    /// @brief 执行优化
+    /// @return true 函数的IR发生了变化 false 没有变化
+    ///
+    bool run() override;
+
+private:
+    ///
+    /// @brief 在当前的控制流图中找一个循环进行展开
+    /// @return true 展开了一个循环 false 没有可展开的循环
+    ///
+    bool unrollOneLoop();
+
+    ///
+    /// @brief 完全展开迭代次数为常量的循环
+    /// @param loop 循环
+    /// @param exitTest 退出条件
+    /// @param tripCount 迭代次数
+    ///
+    void fullyUnroll(Loop * loop, LoopExitTest * exitTest, int64_t tripCount);
+
+    ///
+    /// @brief 按倍数展开循环，原循环作为余数循环
+    /// @param loop 循环
+    /// @param exitTest 退出条件
+    /// @param factor 展开倍数
+    /// @return true 成功 false 边界计算可能溢出等原因不能展开
+    ///
+    bool partiallyUnroll(Loop * loop, LoopExitTest * exitTest, int32_t factor);
+
+    ///
+    /// @brief 复制一组基本块，跳转到映射表之外的Label保持不变，全部复制后再按映射表修正操作数
+    /// @param blocks 按线性次序排列的基本块
+    /// @param valueMap 值的映射表，需要预先放入跳转目标的映射
+    /// @param seq 复制后的指令追加到这里
+    ///
+    void cloneBlocks(std::vector<BasicBlock *> & blocks,
+                     std::unordered_map<Value *, Value *> & valueMap,
+                     std::vector<Instruction *> & seq);
+
+    ///
+    /// @brief 获取循环的指令数，不含Label指令
+    /// @param loop 循环
+    /// @return int32_t 指令数
+    ///
+    static int32_t getLoopSize(Loop * loop);
+
+    ///
+    /// @brief 循环内指令的结果是否在循环外使用，展开后这些使用无法对应到复制的指令
+    /// @param loop 循环
+    /// @return true 有 false 没有
+    ///
+    bool hasUsesOutside(Loop * loop);
+
+    ///
+    /// @brief 获取循环头以外的循环基本块，按线性IR的次序排列
+    /// @param loop 循环
+    /// @return std::vector<BasicBlock *> 基本块
+    ///
+    std::vector<BasicBlock *> getBodyBlocks(Loop * loop);
+
+    ///
+    /// @brief 删除紧跟着目标Label的无条件跳转
+    /// @param seq 指令序列
+    ///
+    static void removeJumpsToNext(std::vector<Instruction *> & seq);
+
+    ///
+    /// @brief 控制流图
+    ///
+    ControlFlowGraph cfg;
+
+    ///
+    /// @brief 优化级别
+    ///
+    int optLevel;
+
+    ///
+    /// @brief 展开后循环的最大指令数
+    ///
+    int threshold;
+
+    ///
+    /// @brief 已经展开过的循环的循环头，不再重复展开
+    ///
+    std::unordered_set<Instruction *> doneHeaders;
+
+    ///
+    /// @brief 展开的循环个数
+    ///
+    int32_t unrolledCount = 0;
+};
@@ -0,0 +1,359 @@
+///
+/// @file OptUtils.cpp
+/// @brief 优化遍共用的辅助函数
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "BinaryInstruction.h"
+#include "FuncCallInstruction.h"
+#include "GotoInstruction.h"
+#include "LabelInstruction.h"
+#include "LocalVariable.h"
+#include "MoveInstruction.h"
+#include "OptUtils.h"
+#include "Type.h"
+
+/// @brief 是否是算术或关系运算的指令
+/// @param op 指令操作码
+/// @return true 是 false 不是
+bool isArithOp(IRInstOperator op)
+{
+    switch (op) {
+        case IRInstOperator::IRINST_OP_ADD_I:
+        case IRInstOperator::IRINST_OP_SUB_I:
+        case IRInstOperator::IRINST_OP_MUL_I:
+        case IRInstOperator::IRINST_OP_DIV_I:
+        case IRInstOperator::IRINST_OP_MOD_I:
+        case IRInstOperator::IRINST_OP_NEG_I:
+            return true;
+        default:
+            return isCompareOp(op);
+    }
+}
+
+/// @brief 是否是关系运算的指令
+/// @param op 指令操作码
+/// @return true 是 false 不是
+bool isCompareOp(IRInstOperator op)
+{
+    switch (op) {
+        case IRInstOperator::IRINST_OP_LT_I:
+        case IRInstOperator::IRINST_OP_GT_I:
+        case IRInstOperator::IRINST_OP_LE_I:
+        case IRInstOperator::IRINST_OP_GE_I:
+        case IRInstOperator::IRINST_OP_EQ_I:
+        case IRInstOperator::IRINST_OP_NE_I:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// @brief 交换两个操作数后等价的比较运算符
+/// @param op 比较运算符
+/// @return IRInstOperator 交换后的比较运算符
+IRInstOperator swapCompareOp(IRInstOperator op)
+{
+    switch (op) {
+        case IRInstOperator::IRINST_OP_LT_I:
+            return IRInstOperator::IRINST_OP_GT_I;
+        case IRInstOperator::IRINST_OP_GT_I:
+            return IRInstOperator::IRINST_OP_LT_I;
+        case IRInstOperator::IRINST_OP_LE_I:
+            return IRInstOperator::IRINST_OP_GE_I;
+        case IRInstOperator::IRINST_OP_GE_I:
+            return IRInstOperator::IRINST_OP_LE_I;
+        default:
+            return op;
+    }
+}
+
+/// @brief 比较结果取反后的比较运算符
+/// @param op 比较运算符
+/// @return IRInstOperator 取反后的比较运算符
+IRInstOperator negateCompareOp(IRInstOperator op)
+{
+    switch (op) {
+        case IRInstOperator::IRINST_OP_LT_I:
+            return IRInstOperator::IRINST_OP_GE_I;
+        case IRInstOperator::IRINST_OP_GT_I:
+            return IRInstOperator::IRINST_OP_LE_I;
+        case IRInstOperator::IRINST_OP_LE_I:
+            return IRInstOperator::IRINST_OP_GT_I;
+        case IRInstOperator::IRINST_OP_GE_I:
+            return IRInstOperator::IRINST_OP_LT_I;
+        case IRInstOperator::IRINST_OP_EQ_I:
+            return IRInstOperator::IRINST_OP_NE_I;
+        case IRInstOperator::IRINST_OP_NE_I:
+            return IRInstOperator::IRINST_OP_EQ_I;
+        default:
+            return op;
+    }
+}
+
+/// @brief 对整数运算进行常量折叠
+/// @param op 指令操作码
+/// @param a 第一个操作数
+/// @param b 第二个操作数，单目运算时忽略
+/// @param result 折叠后的结果
+/// @return true 折叠成功 false 不能折叠
+bool foldConstant(IRInstOperator op, int32_t a, int32_t b, int32_t & result)
+{
+    // 加减乘按32位补码回绕计算，避免有符号溢出的未定义行为
+    uint32_t ua = (uint32_t) a, ub = (uint32_t) b;
+
+    switch (op) {
+        case IRInstOperator::IRINST_OP_ADD_I:
+            result = (int32_t) (ua + ub);
+            break;
+        case IRInstOperator::IRINST_OP_SUB_I:
+            result = (int32_t) (ua - ub);
+            break;
+        case IRInstOperator::IRINST_OP_MUL_I:
+            result = (int32_t) (ua * ub);
+            break;
+        case IRInstOperator::IRINST_OP_NEG_I:
+            result = (int32_t) (0u - ua);
+            break;
+        case IRInstOperator::IRINST_OP_DIV_I:
+            if (b == 0) {
+                return false;
+            }
+            // INT32_MIN / -1 在ARM32的sdiv下结果为INT32_MIN
+            result = (b == -1) ? (int32_t) (0u - ua) : a / b;
+            break;
+        case IRInstOperator::IRINST_OP_MOD_I:
+            if (b == 0) {
+                return false;
+            }
+            result = (b == -1) ? 0 : a % b;
+            break;
+        case IRInstOperator::IRINST_OP_LT_I:
+            result = a < b;
+            break;
+        case IRInstOperator::IRINST_OP_GT_I:
+            result = a > b;
+            break;
+        case IRInstOperator::IRINST_OP_LE_I:
+            result = a <= b;
+            break;
+        case IRInstOperator::IRINST_OP_GE_I:
+            result = a >= b;
+            break;
+        case IRInstOperator::IRINST_OP_EQ_I:
+            result = a == b;
+            break;
+        case IRInstOperator::IRINST_OP_NE_I:
+            result = a != b;
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+/// @brief 是否是函数内的局部变量
+/// @param val 值
+/// @return true 是 false 不是
+bool isLocalVariable(Value * val)
+{
+    Instanceof(localVar, LocalVariable *, val);
+    return localVar != nullptr;
+}
+
+/// @brief 复制指令，操作数与跳转目标按照映射表替换
+/// @param func 新指令所属的函数
+/// @param inst 被复制的指令
+/// @param valueMap 值的映射表
+/// @return Instruction* 新指令，不能复制的指令返回空
+Instruction * cloneInstruction(Function * func, Instruction * inst, std::unordered_map<Value *, Value *> & valueMap)
+{
+    auto mapped = [&valueMap](Value * val) -> Value * {
+        auto iter = valueMap.find(val);
+        return iter == valueMap.end() ? val : iter->second;
+    };
+
+    Instruction * newInst = nullptr;
+
+    switch (inst->getOp()) {
+        case IRInstOperator::IRINST_OP_LABEL: {
+            auto iter = valueMap.find(inst);
+            if (iter != valueMap.end()) {
+                return static_cast<Instruction *>(iter->second);
+            }
+            newInst = new (func) LabelInstruction(func);
+            static_cast<LabelInstruction *>(newInst)->profileCount = static_cast<LabelInstruction *>(inst)->profileCount;
+            break;
+        }
+        case IRInstOperator::IRINST_OP_GOTO: {
+            GotoInstruction * gotoInst = static_cast<GotoInstruction *>(inst);
+            Instruction * target = static_cast<Instruction *>(mapped(gotoInst->getTarget()));
+            if (gotoInst->isConditionalBranch()) {
+                Instruction * falseTarget = static_cast<Instruction *>(mapped(gotoInst->getFalseTarget()));
+                newInst = new (func) GotoInstruction(func, mapped(gotoInst->getOperand(0)), target, falseTarget);
+            } else {
+                newInst = new (func) GotoInstruction(func, target);
+            }
+            break;
+        }
+        case IRInstOperator::IRINST_OP_ASSIGN:
+            newInst = new (func) MoveInstruction(func, mapped(inst->getOperand(0)), mapped(inst->getOperand(1)));
+            break;
+        case IRInstOperator::IRINST_OP_FUNC_CALL: {
+            std::vector<Value *> args;
+            for (auto operand: inst->getOperandsValue()) {
+                args.push_back(mapped(operand));
+            }
+            Function * callee = static_cast<FuncCallInstruction *>(inst)->calledFunction;
+            newInst = new (func) FuncCallInstruction(func, callee, args, inst->getType());
+            break;
+        }
+        default:
+            if (!isArithOp(inst->getOp())) {
+                return nullptr;
+            }
+            newInst = new (func) BinaryInstruction(func,
+                                                   inst->getOp(),
+                                                   mapped(inst->getOperand(0)),
+                                                   inst->getOperandsNum() > 1 ? mapped(inst->getOperand(1)) : nullptr,
+                                                   inst->getType());
+            break;
+    }
+
+    if (inst->getOp() == IRInstOperator::IRINST_OP_LABEL || inst->hasResultValue()) {
+        valueMap[inst] = newInst;
+    }
+
+    return newInst;
+}
+
+/// @brief 一组指令全部复制后，把新指令中仍引用原指令的操作数与跳转目标按映射表替换
+/// @param first 第一条新指令
+/// @param last 最后一条新指令之后的位置
+/// @param valueMap 值的映射表，包含这组指令的全部映射
+void remapOperands(std::vector<Instruction *>::iterator first,
+                   std::vector<Instruction *>::iterator last,
+                   std::unordered_map<Value *, Value *> & valueMap)
+{
+    for (auto iter = first; iter != last; ++iter) {
+
+        Instruction * inst = *iter;
+
+        for (int32_t k = 0; k < inst->getOperandsNum(); ++k) {
+            auto mapIter = valueMap.find(inst->getOperand(k));
+            if (mapIter != valueMap.end()) {
+                inst->setOperand(k, mapIter->second);
+            }
+        }
+
+        Instanceof(gotoInst, GotoInstruction *, inst);
+        if (gotoInst == nullptr) {
+            continue;
+        }
+
+        auto mapIter = valueMap.find(gotoInst->getTarget());
+        if (mapIter != valueMap.end()) {
+            gotoInst->setTarget(static_cast<LabelInstruction *>(mapIter->second));
+        }
+
+        if (gotoInst->isConditionalBranch()) {
+            mapIter = valueMap.find(gotoInst->getFalseTarget());
+            if (mapIter != valueMap.end()) {
+                gotoInst->setFalseTarget(static_cast<LabelInstruction *>(mapIter->second));
+            }
+        }
+    }
+}
+
+/// @brief 函数调用是否是尾调用，即调用之后只经过Label、无条件跳转以及把调用结果赋值给返回值变量的指令就到达出口。
+/// 有返回值的函数要求调用结果赋值给返回值变量
+/// @param func 调用者
+/// @param callInst 函数调用指令
+/// @param retMove 把调用结果赋值给返回值变量的指令，没有时为空
+/// @return true 是尾调用 false 不是
+bool isTailCall(Function * func, Instruction * callInst, Instruction *& retMove)
+{
+    std::vector<Instruction *> & insts = func->getInterCode().getInsts();
+    LocalVariable * retValue = func->getReturnValue();
+
+    retMove = nullptr;
+
+    auto iter = std::find(insts.begin(), insts.end(), callInst);
+    if (iter == insts.end()) {
+        return false;
+    }
+
+    // 沿着顺序执行与无条件跳转前进，跳转过的goto指令记录下来，避免死循环
+    std::unordered_set<Instruction *> visited;
+
+    for (++iter; iter != insts.end(); ++iter) {
+
+        Instruction * inst = *iter;
+
+        if (inst->isDead()) {
+            continue;
+        }
+
+        switch (inst->getOp()) {
+            case IRInstOperator::IRINST_OP_EXIT:
+                return retValue == nullptr || retMove != nullptr;
+            case IRInstOperator::IRINST_OP_LABEL:
+                break;
+            case IRInstOperator::IRINST_OP_GOTO: {
+                GotoInstruction * gotoInst = static_cast<GotoInstruction *>(inst);
+                if (gotoInst->isConditionalBranch() || !visited.insert(inst).second) {
+                    return false;
+                }
+                iter = std::find(insts.begin(), insts.end(), gotoInst->getTarget());
+                if (iter == insts.end()) {
+                    return false;
+                }
+                break;
+            }
+            case IRInstOperator::IRINST_OP_ASSIGN:
+                if (retMove || retValue == nullptr || inst->getOperand(0) != retValue || inst->getOperand(1) != callInst) {
+                    return false;
+                }
+                retMove = inst;
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return false;
+}
+
+/// @brief 函数调用是否可能修改全局变量，根据被调用函数的属性判断
+/// @param callInst 函数调用指令
+/// @return true 可能 false 不会
+bool callMayWriteGlobals(Instruction * callInst)
+{
+    return !static_cast<FuncCallInstruction *>(callInst)->calledFunction->getAttributes().noGlobalWrites;
+}
+
+/// @brief 函数调用是否可能读取或修改全局变量，根据被调用函数的属性判断
+/// @param callInst 函数调用指令
+/// @return true 可能 false 不会
+bool callMayAccessGlobals(Instruction * callInst)
+{
+    Function::Attributes & attrs = static_cast<FuncCallInstruction *>(callInst)->calledFunction->getAttributes();
+    return !(attrs.noGlobalReads && attrs.noGlobalWrites);
+}
@@ -0,0 +1,116 @@
+///
+/// @file OptUtils.h
+/// @brief 优化遍共用的辅助函数
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Function.h"
+#include "Instruction.h"
+#include "Value.h"
+
+///
+/// @brief 是否是算术或关系运算的指令，即BinaryInstruction对应的运算符
+/// @param op 指令操作码
+/// @return true 是 false 不是
+///
+bool isArithOp(IRInstOperator op);
+
+///
+/// @brief 是否是关系运算的指令
+/// @param op 指令操作码
+/// @return true 是 false 不是
+///
+bool isCompareOp(IRInstOperator op);
+
+///
+/// @brief 交换两个操作数后等价的比较运算符，如 a < b 等价于 b > a
+/// @param op 比较运算符
+/// @return IRInstOperator 交换后的比较运算符
+///
+IRInstOperator swapCompareOp(IRInstOperator op);
+
+///
+/// @brief 比较结果取反后的比较运算符，如 !(a < b) 等价于 a >= b
+/// @param op 比较运算符
+/// @return IRInstOperator 取反后的比较运算符
+///
+IRInstOperator negateCompareOp(IRInstOperator op);
+
+///
+/// @brief 对整数运算进行常量折叠，语义与ARM32的32位整数运算一致
+/// @param op 指令操作码
+/// @param a 第一个操作数
+/// @param b 第二个操作数，单目运算时忽略
+/// @param result 折叠后的结果
+/// @return true 折叠成功 false 不能折叠，如除数为0
+///
+bool foldConstant(IRInstOperator op, int32_t a, int32_t b, int32_t & result);
+
+///
+/// @brief 是否是函数内的局部变量，不含形参、全局变量与临时变量
+/// @param val 值
+/// @return true 是 false 不是
+///
+bool isLocalVariable(Value * val);
+
+///
+/// @brief 复制指令，操作数与跳转目标按照映射表替换，不在映射表中的保持不变。
+/// 有结果的指令与Label指令复制后加入映射表，已在映射表中的Label指令直接返回映射的Label。
+/// 线性次序中使用可能出现在定值之前，复制完一组指令后需调用remapOperands修正
+/// @param func 新指令所属的函数
+/// @param inst 被复制的指令
+/// @param valueMap 值的映射表
+/// @return Instruction* 新指令，入口、出口等不能复制的指令返回空
+///
+Instruction * cloneInstruction(Function * func, Instruction * inst, std::unordered_map<Value *, Value *> & valueMap);
+
+///
+/// @brief 一组指令全部复制后，把新指令中仍引用原指令的操作数与跳转目标按映射表替换。
+/// 逐条复制时，出现在定值之前的使用还没有映射，会保留对原指令的引用
+/// @param first 第一条新指令
+/// @param last 最后一条新指令之后的位置
+/// @param valueMap 值的映射表，包含这组指令的全部映射
+///
+void remapOperands(std::vector<Instruction *>::iterator first,
+                   std::vector<Instruction *>::iterator last,
+                   std::unordered_map<Value *, Value *> & valueMap);
+
+///
+/// @brief 函数调用是否是尾调用，即调用之后只经过Label、无条件跳转以及把调用结果赋值给返回值变量的指令就到达出口。
+/// 有返回值的函数要求调用结果赋值给返回值变量
+/// @param func 调用者
+/// @param callInst 函数调用指令
+/// @param retMove 把调用结果赋值给返回值变量的指令，没有时为空
+/// @return true 是尾调用 false 不是
+///
+bool isTailCall(Function * func, Instruction * callInst, Instruction *& retMove);
+
+///
+/// @brief 函数调用是否可能修改全局变量，根据被调用函数的属性判断
+/// @param callInst 函数调用指令
+/// @return true 可能 false 不会
+///
+bool callMayWriteGlobals(Instruction * callInst);
+
+///
+/// @brief 函数调用是否可能读取或修改全局变量，根据被调用函数的属性判断
+/// @param callInst 函数调用指令
+/// @return true 可能 false 不会
+///
+bool callMayAccessGlobals(Instruction * callInst);
@@ -0,0 +1,131 @@
+///
+/// @file Optimizer.cpp
+/// @brief 中间IR优化的管理器，根据优化级别依次执行各优化遍
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include "Optimizer.h"
+#include "CallGraph.h"
+#include "CopyPropagation.h"
+#include "DeadCodeElimination.h"
+#include "FunctionAttrs.h"
+#include "GVN.h"
+#include "GlobalDCE.h"
+#include "IPConstProp.h"
+#include "IVStrengthReduction.h"
+#include "Inliner.h"
+#include "LICM.h"
+#include "LoopUnroll.h"
+#include "RangeSimplify.h"
+#include "SCCP.h"
+#include "SimplifyCFG.h"
+#include "TailRecursion.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _optLevel 优化级别，即-O后面的数字
+/// @param _unrollThreshold 循环展开的阈值，-1表示按优化级别取缺省值
+Optimizer::Optimizer(Module * _module, int _optLevel, int _unrollThreshold)
+    : module(_module), optLevel(_optLevel), unrollThreshold(_unrollThreshold)
+{}
+
+/// @brief 对单个函数执行函数级的优化遍
+/// @param func 函数
+void Optimizer::optimizeFunction(Function * func)
+{
+    // 自身的尾调用改为循环，后面的循环优化可以继续处理
+    TailRecursionElimination tre(module, func);
+    (void) tre.run();
+
+    // 条件常量传播，删除不可达的分支
+    SCCP sccp(module, func);
+    (void) sccp.run();
+
+    // 合并IR生成时产生的跳转链，循环优化看到更规整的控制流
+    SimplifyCFG simplifyCfg(module, func);
+    (void) simplifyCfg.run();
+
+    // 复制传播，参数传递与内联产生的复制改为直接使用源操作数
+    CopyPropagation copyProp(module, func);
+    (void) copyProp.run();
+
+    // 全局值编号，消除公共子表达式
+    GVN gvn(module, func);
+    (void) gvn.run();
+
+    // 循环不变量外提
+    LICM licm(module, func);
+    (void) licm.run();
+
+    // 归纳变量的强度削弱与退出值替换
+    IVStrengthReduction ivsr(module, func);
+    bool loopChanged = ivsr.run();
+
+    // 循环展开
+    LoopUnroll unroll(module, func, optLevel, unrollThreshold);
+    loopChanged = unroll.run() || loopChanged;
+
+    if (loopChanged) {
+        // 退出值替换与完全展开后常量增多，再进行一次常量传播
+        SCCP postLoopSccp(module, func);
+        (void) postLoopSccp.run();
+    }
+
+    // 值范围化简，折叠由循环边界与分支条件确定的比较，非负数除以2的幂改为移位
+    RangeSimplify rangeSimplify(module, func);
+    (void) rangeSimplify.run();
+
+    // 删除没有使用的指令与死存储
+    DeadCodeElimination dce(module, func);
+    (void) dce.run();
+
+    // 删除指令后可能出现新的空基本块，循环展开后也留下跳转链
+    SimplifyCFG postSimplifyCfg(module, func);
+    (void) postSimplifyCfg.run();
+}
+
+/// @brief 执行优化
+/// @return true 成功 false 失败
+bool Optimizer::run()
+{
+    if (optLevel <= 0) {
+        return true;
+    }
+
+    // 按调用图自底向上处理，内联时被调用的函数已经优化过。调用图不包含内置函数
+    CallGraph callGraph(module);
+
+    // 所有调用点都传递同一个常量的形参替换为常量
+    IPConstProp ipcp(module, callGraph);
+    (void) ipcp.run();
+
+    Inliner inliner(module, callGraph, optLevel);
+    FunctionAttrs functionAttrs(module, callGraph);
+
+    for (auto & scc: callGraph.getSCCs()) {
+        for (auto func: scc) {
+            (void) inliner.run(func);
+            optimizeFunction(func);
+        }
+
+        // 优化后推导函数属性，调用者优化时使用
+        functionAttrs.run(scc);
+    }
+
+    // 删除不可达的函数与没有使用的全局变量
+    GlobalDCE globalDce(module);
+    (void) globalDce.run();
+
+    return true;
+}
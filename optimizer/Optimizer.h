@@ -0,0 +1,62 @@
+///
+/// @file Optimizer.h
+/// @brief 中间IR优化的管理器，根据优化级别依次执行各优化遍
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include "Module.h"
+
+///
+/// @brief 中间IR优化的管理器
+///
+class Optimizer {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    /// @param _optLevel 优化级别，即-O后面的数字
+    /// @param _unrollThreshold 循环展开的阈值，-1表示按优化级别取缺省值
+    ///
+    Optimizer(Module * _module, int _optLevel, int _unrollThreshold = -1);
+
+    ///
+    /// @brief 执行优化
+    /// @return true 成功 false 失败
+    ///
+    bool run();
+
+private:
+    ///
+    /// @brief 对单个函数执行函数级的优化遍
+    /// @param func 函数
+    ///
+    void optimizeFunction(Function * func);
+
+    ///
+    /// @brief 符号表
+    ///
+    Module * module;
+
+    ///
+    /// @brief 优化级别
+    ///
+    int optLevel;
+
+    ///
+    /// @brief 循环展开的阈值
+    ///
+    int unrollThreshold;
+};
@@ -0,0 +1,57 @@
+///
+/// @file Pass.h
+/// @brief 中间IR优化遍的基类
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include "Function.h"
+#include "Module.h"
+
+///
+/// @brief 以函数为单位的优化遍，每个优化遍处理一个函数的线性IR
+///
+class FunctionPass {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表，用于创建常量等
+    /// @param _func 要优化的函数
+    ///
+    FunctionPass(Module * _module, Function * _func) : module(_module), func(_func)
+    {}
+
+    ///
+    /// @brief 析构函数
+    ///
+    virtual ~FunctionPass() = default;
+
+    ///
+    /// @brief 执行优化
+    /// @return true 函数的IR发生了变化 false 没有变化
+    ///
+    virtual bool run() = 0;
+
+protected:
+    ///
+    /// @brief 符号表
+    ///
+    Module * module;
+
+    ///
+    /// @brief 要优化的函数
+    ///
+    Function * func;
+};
@@ -0,0 +1,285 @@
+///
+/// @file Profile.cpp
+/// @brief 基于基本块计数的剖面数据：插桩、读取与冷热判断
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+#include "Profile.h"
+#include "BinaryInstruction.h"
+#include "Common.h"
+#include "DominatorTree.h"
+#include "FuncCallInstruction.h"
+#include "IntegerType.h"
+#include "LoopInfo.h"
+#include "MoveInstruction.h"
+#include "VoidType.h"
+
+/// @brief 输出计数器的运行时函数名
+static const char * PROFILE_DUMP_FUNC = "__minic_profile_dump";
+
+/// @brief 计数器全局变量名的前缀，后面是计数器的编号
+static const char * PROFILE_COUNTER_PREFIX = "__minic_prof_";
+
+/// @brief 热基本块的执行次数不小于最大执行次数的1/HOT_RATIO
+static const int64_t HOT_RATIO = 10;
+
+/// @brief 冷基本块的执行次数小于最大执行次数的1/COLD_RATIO
+static const int64_t COLD_RATIO = 1000;
+
+/// @brief 获取需要计数的基本块，即入口基本块以及以Label开始的基本块，插桩与读取必须一致
+/// @param cfg 控制流图
+/// @return std::vector<BasicBlock *> 基本块，次序即编号的次序
+static std::vector<BasicBlock *> getCountedBlocks(ControlFlowGraph & cfg)
+{
+    std::vector<BasicBlock *> counted;
+
+    for (auto bb: cfg.getBlocks()) {
+        // 跳转之后没有Label的基本块不可达，不需要计数
+        if (bb->getIndex() == 0 || bb->getLabel()) {
+            counted.push_back(bb);
+        }
+    }
+
+    return counted;
+}
+
+/// @brief 构造函数
+/// @param _module 符号表
+ProfileInstrumenter::ProfileInstrumenter(Module * _module) : module(_module)
+{}
+
+/// @brief 执行插桩
+/// @return true 成功 false 没有main函数
+bool ProfileInstrumenter::run()
+{
+    Function * mainFunc = module->findFunction("main");
+    if (mainFunc == nullptr || mainFunc->isBuiltin()) {
+        return false;
+    }
+
+    Function * dumpFunc = module->findFunction(PROFILE_DUMP_FUNC);
+    if (dumpFunc == nullptr) {
+        dumpFunc = module->newFunction(PROFILE_DUMP_FUNC,
+                                       VoidType::getType(),
+                                       {new FormalParam{IntegerType::getTypeInt(), ""},
+                                        new FormalParam{IntegerType::getTypeInt(), ""}},
+                                       true);
+    }
+
+    std::vector<GlobalVariable *> counters;
+
+    for (auto func: module->getFunctionList()) {
+
+        if (func->isBuiltin()) {
+            continue;
+        }
+
+        ControlFlowGraph cfg(func);
+
+        for (auto bb: getCountedBlocks(cfg)) {
+
+            GlobalVariable * counter = module->newGlobalVariable(IntegerType::getTypeInt(),
+                                                                 PROFILE_COUNTER_PREFIX +
+                                                                     std::to_string(counters.size()));
+
+            // 计数器加1，放在结束指令之前，这样出口基本块也能计数
+            BinaryInstruction * inc = new (func) BinaryInstruction(func,
+                                                                   IRInstOperator::IRINST_OP_ADD_I,
+                                                                   counter,
+                                                                   module->newConstInt(1),
+                                                                   IntegerType::getTypeInt());
+            bb->insertBeforeTerminator(inc);
+            bb->insertBeforeTerminator(new (func) MoveInstruction(func, counter, inc));
+
+            counters.push_back(counter);
+        }
+
+        cfg.writeBack();
+    }
+
+    // main函数返回之前输出全部的计数器
+    ControlFlowGraph mainCfg(mainFunc);
+    BasicBlock * exitBlock = mainCfg.getBlockOfLabel(mainFunc->getExitLabel());
+    if (exitBlock == nullptr) {
+        return false;
+    }
+
+    for (int32_t k = 0; k < (int32_t) counters.size(); ++k) {
+        std::vector<Value *> args = {module->newConstInt(k), counters[k]};
+        exitBlock->insertBeforeTerminator(
+            new (mainFunc) FuncCallInstruction(mainFunc, dumpFunc, args, VoidType::getType()));
+    }
+
+    mainCfg.writeBack();
+
+    mainFunc->setExistFuncCall(true);
+    if (mainFunc->getMaxFuncCallArgCnt() < 2) {
+        mainFunc->setMaxFuncCallArgCnt(2);
+    }
+
+    minic_log(LOG_INFO, "剖面插桩: %d个基本块计数器", (int32_t) counters.size());
+
+    return true;
+}
+
+/// @brief 构造函数
+/// @param _module 符号表
+ProfileLoader::ProfileLoader(Module * _module) : module(_module)
+{}
+
+/// @brief 读取剖面数据文件，每行为计数器的编号与计数
+/// @param fileName 文件名
+/// @return true 成功 false 文件打不开或者没有有效的计数
+bool ProfileLoader::load(const std::string & fileName)
+{
+    std::ifstream in(fileName);
+    if (!in) {
+        return false;
+    }
+
+    std::unordered_map<int64_t, int64_t> counts;
+    int64_t id, count;
+    while (in >> id >> count) {
+        counts[id] = count;
+    }
+
+    if (counts.empty()) {
+        return false;
+    }
+
+    int64_t nextId = 0;
+    int64_t maxCount = 0;
+    int32_t loadedCount = 0;
+
+    for (auto func: module->getFunctionList()) {
+
+        if (func->isBuiltin()) {
+            continue;
+        }
+
+        ControlFlowGraph cfg(func);
+
+        for (auto bb: getCountedBlocks(cfg)) {
+
+            auto iter = counts.find(nextId++);
+            if (iter == counts.end() || iter->second < 0) {
+                continue;
+            }
+
+            if (bb->getIndex() == 0) {
+                func->setEntryCount(iter->second);
+            } else {
+                bb->getLabel()->profileCount = iter->second;
+            }
+
+            maxCount = std::max(maxCount, iter->second);
+            loadedCount++;
+        }
+    }
+
+    if (loadedCount == 0) {
+        return false;
+    }
+
+    module->setProfileMaxCount(maxCount);
+
+    minic_log(LOG_INFO, "读取剖面数据: %d个基本块计数，最大执行次数%lld", loadedCount, (long long) maxCount);
+
+    return true;
+}
+
+/// @brief 获取基本块的执行次数，入口基本块取函数的执行次数，其它取开始Label的计数
+/// @param func 基本块所属的函数
+/// @param bb 基本块
+/// @return int64_t 执行次数，-1表示没有剖面数据
+int64_t getBlockCount(Function * func, BasicBlock * bb)
+{
+    if (bb->getIndex() == 0) {
+        return func->getEntryCount();
+    }
+
+    LabelInstruction * label = bb->getLabel();
+
+    return label ? label->profileCount : -1;
+}
+
+/// @brief 估计各基本块的执行频度，供寄存器分配计算溢出代价。有剖面数据时用执行次数，
+/// 剖面数据中没有的基本块按函数入口次数与循环深度估计；没有剖面数据时按循环深度每层乘10
+/// @param func 函数
+/// @param cfg 函数的控制流图
+/// @return std::vector<double> 按基本块序号排列的执行频度
+std::vector<double> getBlockFrequencies(Function * func, ControlFlowGraph & cfg)
+{
+    DominatorTree domTree(cfg);
+    LoopInfo loopInfo(cfg, domTree);
+
+    int64_t entryCount = func->getEntryCount();
+
+    std::vector<double> frequency(cfg.getBlocks().size(), 1);
+
+    for (auto bb: cfg.getBlocks()) {
+
+        double freq = 1;
+
+        Loop * loop = loopInfo.getLoopFor(bb);
+        for (int32_t depth = loop ? loop->getDepth() : 0; depth > 0; --depth) {
+            freq *= 10;
+        }
+
+        if (entryCount >= 0) {
+            int64_t count = getBlockCount(func, bb);
+            freq = count >= 0 ? (double) count : (double) entryCount * freq;
+        }
+
+        frequency[bb->getIndex()] = freq;
+    }
+
+    return frequency;
+}
+
+/// @brief 执行次数是否是热的，即不小于模块内最大执行次数的1/10
+/// @param module 符号表
+/// @param count 执行次数
+/// @return true 热 false 不热或者没有剖面数据
+bool isHotCount(Module * module, int64_t count)
+{
+    int64_t maxCount = module->getProfileMaxCount();
+
+    return maxCount > 0 && count > 0 && count * HOT_RATIO >= maxCount;
+}
+
+/// @brief 相对于给定的最大执行次数，执行次数是否是冷的，即小于最大执行次数的1/1000
+/// @param count 执行次数
+/// @param maxCount 最大执行次数
+/// @return true 冷 false 不冷或者没有剖面数据
+bool isColdCount(int64_t count, int64_t maxCount)
+{
+    return maxCount >= 0 && count >= 0 && count * COLD_RATIO < maxCount;
+}
+
+/// @brief 执行次数是否是冷的，即小于模块内最大执行次数的1/1000，从未执行的一定是冷的
+/// @param module 符号表
+/// @param count 执行次数
+/// @return true 冷 false 不冷或者没有剖面数据
+bool isColdCount(Module * module, int64_t count)
+{
+    int64_t maxCount = module->getProfileMaxCount();
+
+    return maxCount >= 0 && (count == 0 || isColdCount(count, maxCount));
+}
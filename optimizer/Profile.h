@@ -0,0 +1,120 @@
+///
+/// @file Profile.h
+/// @brief 基于基本块计数的剖面数据：插桩、读取与冷热判断
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ControlFlowGraph.h"
+#include "Module.h"
+
+///
+/// @brief 剖面插桩。IR生成之后、优化之前，按模块内函数的次序、函数内基本块的次序，
+/// 对入口基本块以及以Label开始的基本块依次编号，每个基本块对应一个全局计数器，
+/// 基本块的结束指令之前把计数器加1。main函数的出口调用运行时函数__minic_profile_dump
+/// 逐个输出计数器的编号与值，运行时函数在tests/profile.c中实现
+///
+class ProfileInstrumenter {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    ///
+    explicit ProfileInstrumenter(Module * _module);
+
+    ///
+    /// @brief 执行插桩
+    /// @return true 成功 false 没有main函数
+    ///
+    bool run();
+
+private:
+    ///
+    /// @brief 符号表
+    ///
+    Module * module;
+};
+
+///
+/// @brief 剖面数据的读取。按照与插桩相同的编号，把计数写入入口基本块所属的函数以及基本块开始的Label，
+/// 要求在IR生成之后、优化之前执行，并且源程序与插桩时一致。优化中新建的Label没有计数
+///
+class ProfileLoader {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    ///
+    explicit ProfileLoader(Module * _module);
+
+    ///
+    /// @brief 读取剖面数据文件，每行为计数器的编号与计数
+    /// @param fileName 文件名
+    /// @return true 成功 false 文件打不开或者没有有效的计数
+    ///
+    bool load(const std::string & fileName);
+
+private:
+    ///
+    /// @brief 符号表
+    ///
+    Module * module;
+};
+
+///
+/// @brief 获取基本块的执行次数，入口基本块取函数的执行次数，其它取开始Label的计数
+/// @param func 基本块所属的函数
+/// @param bb 基本块
+/// @return int64_t 执行次数，-1表示没有剖面数据
+///
+int64_t getBlockCount(Function * func, BasicBlock * bb);
+
+///
+/// @brief 估计各基本块的执行频度，供寄存器分配计算溢出代价。有剖面数据时用执行次数，
+/// 剖面数据中没有的基本块按函数入口次数与循环深度估计；没有剖面数据时按循环深度每层乘10
+/// @param func 函数
+/// @param cfg 函数的控制流图
+/// @return std::vector<double> 按基本块序号排列的执行频度
+///
+std::vector<double> getBlockFrequencies(Function * func, ControlFlowGraph & cfg);
+
+///
+/// @brief 执行次数是否是热的，即不小于模块内最大执行次数的1/10
+/// @param module 符号表
+/// @param count 执行次数
+/// @return true 热 false 不热或者没有剖面数据
+///
+bool isHotCount(Module * module, int64_t count);
+
+///
+/// @brief 相对于给定的最大执行次数，执行次数是否是冷的，即小于最大执行次数的1/1000
+/// @param count 执行次数
+/// @param maxCount 最大执行次数
+/// @return true 冷 false 不冷或者没有剖面数据
+///
+bool isColdCount(int64_t count, int64_t maxCount);
+
+///
+/// @brief 执行次数是否是冷的，即小于模块内最大执行次数的1/1000，从未执行的一定是冷的
+/// @param module 符号表
+/// @param count 执行次数
+/// @return true 冷 false 不冷或者没有剖面数据
+///
+bool isColdCount(Module * module, int64_t count);
@@ -0,0 +1,192 @@
+///
+/// @file RangeSimplify.cpp
+/// @brief 基于值范围分析的比较折叠与除法、求余化简
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <vector>
+
+#include "RangeSimplify.h"
+#include "BinaryInstruction.h"
+#include "Common.h"
+#include "ConstInt.h"
+#include "GotoInstruction.h"
+#include "OptUtils.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _func 要优化的函数
+RangeSimplify::RangeSimplify(Module * _module, Function * _func) : FunctionPass(_module, _func), cfg(_func)
+{}
+
+/// @brief 根据操作数的区间化简除法与求余
+/// @param inst 除法或求余指令
+/// @param ranges 值范围分析的结果
+/// @return true 有化简 false 没有
+bool RangeSimplify::simplifyDivMod(Instruction * inst, ValueRangeAnalysis & ranges)
+{
+    ValueRange dividend = ranges.getOperandRange(inst, 0);
+    ValueRange divisor = ranges.getOperandRange(inst, 1);
+
+    if (!dividend.isNonNegative() || !divisor.isConstant() || divisor.lo <= 0) {
+        return false;
+    }
+
+    bool isDiv = inst->getOp() == IRInstOperator::IRINST_OP_DIV_I;
+
+    // 被除数小于除数时商为0，余数为被除数。变量可能在之后被重新赋值，因此只替换为常量或指令的结果
+    Value * src = inst->getOperand(0);
+    if (dividend.hi < divisor.lo && (isDiv || isa<Instruction>(src) || isa<ConstInt>(src))) {
+        inst->replaceAllUsesWith(isDiv ? module->newConstInt(0) : src);
+        inst->setDead();
+        divModCount++;
+        return true;
+    }
+
+    int64_t val = divisor.lo;
+    if (val < 2 || (val & (val - 1)) != 0) {
+        return false;
+    }
+
+    // 除数在这里一定是该常量，后端需要常量操作数才能使用移位
+    Instanceof(divisorConst, ConstInt *, inst->getOperand(1));
+    if (divisorConst == nullptr) {
+        inst->setOperand(1, module->newConstInt((int32_t) val));
+    }
+
+    BinaryInstruction * binaryInst = static_cast<BinaryInstruction *>(inst);
+    if (binaryInst->nonNegativeDividend && divisorConst) {
+        return false;
+    }
+
+    binaryInst->nonNegativeDividend = true;
+    divModCount++;
+    return true;
+}
+
+/// @brief 结果确定的比较的条件跳转改为无条件跳转，其它使用替换为常量
+/// @param decided 结果确定的比较及其结果
+/// @return true 有改写 false 没有
+bool RangeSimplify::foldCompares(std::unordered_map<Instruction *, int32_t> & decided)
+{
+    bool changed = false;
+
+    for (auto bb: cfg.getBlocks()) {
+
+        Instruction * term = bb->getTerminator();
+        if (term == nullptr || term->getOp() != IRInstOperator::IRINST_OP_GOTO ||
+            !static_cast<GotoInstruction *>(term)->isConditionalBranch()) {
+            continue;
+        }
+
+        GotoInstruction * gotoInst = static_cast<GotoInstruction *>(term);
+        Instanceof(cond, Instruction *, gotoInst->getOperand(0));
+
+        auto iter = decided.find(cond);
+        if (iter == decided.end()) {
+            continue;
+        }
+
+        // 条件确定，改为无条件跳转，原来的指令保留在基本块中，写回时释放
+        LabelInstruction * target = iter->second ? gotoInst->getTarget() : gotoInst->getFalseTarget();
+
+        std::vector<Instruction *> & insts = bb->getInsts();
+        for (auto & inst: insts) {
+            if (inst == gotoInst) {
+                inst = new (func) GotoInstruction(func, target);
+                break;
+            }
+        }
+        insts.push_back(gotoInst);
+        gotoInst->setDead();
+        gotoInst->clearOperands();
+        changed = true;
+    }
+
+    for (auto & [compare, result]: decided) {
+
+        // 常量为i32类型，不能赋值给bool型变量
+        for (auto use: compare->getUses()) {
+            Instanceof(userInst, Instruction *, use->getUser());
+            if (userInst->getOp() != IRInstOperator::IRINST_OP_ASSIGN ||
+                !userInst->getOperand(0)->getType()->isInt1Byte()) {
+                use->setUsee(module->newConstInt(result));
+            }
+        }
+
+        if (compare->getUses().empty()) {
+            compare->setDead();
+        }
+
+        foldedCount++;
+        changed = true;
+    }
+
+    return changed;
+}
+
+/// @brief 执行优化
+/// @return true 函数的IR发生了变化 false 没有变化
+bool RangeSimplify::run()
+{
+    if (cfg.getBlocks().empty()) {
+        return false;
+    }
+
+    ValueRangeAnalysis ranges(cfg);
+
+    bool changed = false;
+    std::unordered_map<Instruction *, int32_t> decided;
+
+    for (auto bb: cfg.getBlocks()) {
+
+        if (!ranges.isReachable(bb)) {
+            continue;
+        }
+
+        for (auto inst: bb->getInsts()) {
+
+            if (inst->isDead()) {
+                continue;
+            }
+
+            IRInstOperator op = inst->getOp();
+
+            if (isCompareOp(op)) {
+                int32_t result = ValueRangeAnalysis::evaluateCompare(op,
+                                                                     ranges.getOperandRange(inst, 0),
+                                                                     ranges.getOperandRange(inst, 1));
+                if (result >= 0) {
+                    decided[inst] = result;
+                }
+            } else if (op == IRInstOperator::IRINST_OP_DIV_I || op == IRInstOperator::IRINST_OP_MOD_I) {
+                changed = simplifyDivMod(inst, ranges) || changed;
+            }
+        }
+    }
+
+    changed = foldCompares(decided) || changed;
+
+    if (changed) {
+        cfg.writeBack();
+
+        minic_log(LOG_INFO,
+                  "函数%s: 值范围化简折叠%d处比较，化简%d处除法与求余",
+                  func->getName().c_str(),
+                  foldedCount,
+                  divModCount);
+    }
+
+    return changed;
+}
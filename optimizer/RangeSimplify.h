@@ -0,0 +1,77 @@
+///
+/// @file RangeSimplify.h
+/// @brief 基于值范围分析的比较折叠与除法、求余化简
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "ControlFlowGraph.h"
+#include "Pass.h"
+#include "ValueRange.h"
+
+///
+/// @brief 值范围化简。根据值范围分析的结果，结果确定的比较折叠为常量，其条件跳转改为无条件跳转，
+/// 不再执行的分支由控制流化简删除；被除数非负且小于除数的除法与求余直接得到结果，
+/// 被除数非负、除数为2的幂的除法与求余标记后由后端翻译为移位与按位与
+///
+class RangeSimplify : public FunctionPass {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    /// @param _func 要优化的函数
+    ///
+    RangeSimplify(Module * _module, Function * _func);
+
+    ///
+    /// @brief 执行优化
+    /// @return true 函数的IR发生了变化 false 没有变化
+    ///
+    bool run() override;
+
+private:
+    ///
+    /// @brief 根据操作数的区间化简除法与求余
+    /// @param inst 除法或求余指令
+    /// @param ranges 值范围分析的结果
+    /// @return true 有化简 false 没有
+    ///
+    bool simplifyDivMod(Instruction * inst, ValueRangeAnalysis & ranges);
+
+    ///
+    /// @brief 结果确定的比较的条件跳转改为无条件跳转，其它使用替换为常量
+    /// @param decided 结果确定的比较及其结果
+    /// @return true 有改写 false 没有
+    ///
+    bool foldCompares(std::unordered_map<Instruction *, int32_t> & decided);
+
+    ///
+    /// @brief 控制流图
+    ///
+    ControlFlowGraph cfg;
+
+    ///
+    /// @brief 折叠的比较数
+    ///
+    int32_t foldedCount = 0;
+
+    ///
+    /// @brief 化简的除法与求余数
+    ///
+    int32_t divModCount = 0;
+};
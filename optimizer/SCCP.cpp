@@ -0,0 +1,446 @@
+///
+/// @file SCCP.cpp
+/// @brief 稀疏条件常量传播，同时删除不可达的分支
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include "SCCP.h"
+#include "ConstInt.h"
+#include "FuncCallInstruction.h"
+#include "GlobalVariable.h"
+#include "GotoInstruction.h"
+#include "OptUtils.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _func 要优化的函数
+SCCP::SCCP(Module * _module, Function * _func) : FunctionPass(_module, _func), cfg(_func)
+{}
+
+/// @brief 两个格值的交汇
+/// @param a 格值
+/// @param b 格值
+/// @return LatticeValue 交汇后的格值
+SCCP::LatticeValue SCCP::meet(const LatticeValue & a, const LatticeValue & b)
+{
+    if (a.kind == LatticeValue::TOP) {
+        return b;
+    }
+
+    if (b.kind == LatticeValue::TOP) {
+        return a;
+    }
+
+    if (a.kind == LatticeValue::CONST && b.kind == LatticeValue::CONST && a.val == b.val) {
+        return a;
+    }
+
+    return LatticeValue{LatticeValue::BOTTOM, 0};
+}
+
+/// @brief 收集整个模块内从来没有被赋值的全局变量，MiniC的全局变量没有初值，因此恒为0
+void SCCP::collectConstGlobals()
+{
+    for (auto global: module->getGlobalVariables()) {
+        constGlobals.insert(global);
+    }
+
+    for (auto function: module->getFunctionList()) {
+        for (auto inst: function->getInterCode().getInsts()) {
+            if (inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN) {
+                constGlobals.erase(inst->getOperand(0));
+            }
+        }
+    }
+}
+
+/// @brief 求值，获取Value在当前状态下的格值
+/// @param val Value
+/// @param state 局部变量的格值
+/// @return LatticeValue 格值
+SCCP::LatticeValue SCCP::evaluate(Value * val, VarState & state)
+{
+    Instanceof(constVal, ConstInt *, val);
+    if (constVal) {
+        return LatticeValue{LatticeValue::CONST, constVal->getVal()};
+    }
+
+    auto varIter = varIndex.find(val);
+    if (varIter != varIndex.end()) {
+        return state[varIter->second];
+    }
+
+    Instanceof(inst, Instruction *, val);
+    if (inst) {
+        auto instIter = instValues.find(inst);
+        if (instIter == instValues.end()) {
+            return LatticeValue{LatticeValue::TOP, 0};
+        }
+        return instIter->second;
+    }
+
+    if (constGlobals.count(val)) {
+        return LatticeValue{LatticeValue::CONST, 0};
+    }
+
+    // 形参、被赋值过的全局变量等
+    return LatticeValue{LatticeValue::BOTTOM, 0};
+}
+
+/// @brief 对运算指令进行求值
+/// @param inst 运算指令
+/// @param state 局部变量的格值
+/// @return LatticeValue 格值
+SCCP::LatticeValue SCCP::evaluateArith(Instruction * inst, VarState & state)
+{
+    IRInstOperator op = inst->getOp();
+
+    LatticeValue a = evaluate(inst->getOperand(0), state);
+    LatticeValue b = LatticeValue{LatticeValue::CONST, 0};
+    if (op != IRInstOperator::IRINST_OP_NEG_I) {
+        b = evaluate(inst->getOperand(1), state);
+    }
+
+    // 乘以0时，即使另一个操作数不是常量结果也是0
+    if (op == IRInstOperator::IRINST_OP_MUL_I) {
+        if ((a.kind == LatticeValue::CONST && a.val == 0) || (b.kind == LatticeValue::CONST && b.val == 0)) {
+            return LatticeValue{LatticeValue::CONST, 0};
+        }
+    }
+
+    if (a.kind == LatticeValue::BOTTOM || b.kind == LatticeValue::BOTTOM) {
+        return LatticeValue{LatticeValue::BOTTOM, 0};
+    }
+
+    if (a.kind == LatticeValue::TOP || b.kind == LatticeValue::TOP) {
+        return LatticeValue{LatticeValue::TOP, 0};
+    }
+
+    int32_t result;
+    if (!foldConstant(op, a.val, b.val, result)) {
+        // 除数为0等情况不折叠，留给运行时
+        return LatticeValue{LatticeValue::BOTTOM, 0};
+    }
+
+    return LatticeValue{LatticeValue::CONST, result};
+}
+
+/// @brief 把基本块加入到工作表中
+/// @param bb 基本块
+void SCCP::pushBlock(BasicBlock * bb)
+{
+    if (!inWorklist[bb->getIndex()]) {
+        inWorklist[bb->getIndex()] = 1;
+        worklist.push_back(bb);
+    }
+}
+
+/// @brief 标记边为可执行，后继基本块需要重新计算
+/// @param from 前驱基本块
+/// @param to 后继基本块
+void SCCP::markEdge(BasicBlock * from, BasicBlock * to)
+{
+    // 新的可执行边，后继需要重新计算入口状态
+    if (executableEdges.insert({from->getIndex(), to->getIndex()}).second) {
+        pushBlock(to);
+    }
+}
+
+/// @brief 计算基本块的入口状态
+/// @param bb 基本块
+/// @return true 入口状态发生了变化 false 没有变化
+bool SCCP::computeInState(BasicBlock * bb)
+{
+    VarState newState(varIndex.size(), LatticeValue{LatticeValue::TOP, 0});
+
+    if (bb == cfg.getEntry()) {
+        // 入口处局部变量未赋值，保守地认为不是常量
+        for (auto & v: newState) {
+            v.kind = LatticeValue::BOTTOM;
+        }
+    }
+
+    for (auto pred: bb->getPreds()) {
+        if (!executableEdges.count({pred->getIndex(), bb->getIndex()})) {
+            continue;
+        }
+        VarState & predOut = outStates[pred->getIndex()];
+        for (size_t k = 0; k < newState.size(); ++k) {
+            newState[k] = meet(newState[k], predOut[k]);
+        }
+    }
+
+    if (newState == inStates[bb->getIndex()]) {
+        return false;
+    }
+
+    inStates[bb->getIndex()] = newState;
+
+    return true;
+}
+
+/// @brief 按照基本块的入口状态模拟执行基本块，更新出口状态，并标记可执行的边
+/// @param bb 基本块
+void SCCP::visitBlock(BasicBlock * bb)
+{
+    VarState state = inStates[bb->getIndex()];
+
+    for (auto inst: bb->getInsts()) {
+
+        IRInstOperator op = inst->getOp();
+
+        if (op == IRInstOperator::IRINST_OP_ASSIGN) {
+
+            auto varIter = varIndex.find(inst->getOperand(0));
+            if (varIter != varIndex.end()) {
+                state[varIter->second] = evaluate(inst->getOperand(1), state);
+            }
+
+        } else if (inst->hasResultValue()) {
+
+            LatticeValue newVal{LatticeValue::BOTTOM, 0};
+            if (isArithOp(op)) {
+                newVal = evaluateArith(inst, state);
+            } else if (op == IRInstOperator::IRINST_OP_FUNC_CALL) {
+
+                // 被调用函数总是返回同一个常量
+                Function::Attributes & attrs = static_cast<FuncCallInstruction *>(inst)->calledFunction->getAttributes();
+                if (attrs.returnsConst) {
+                    newVal = LatticeValue{LatticeValue::CONST, attrs.constValue};
+                }
+            }
+
+            // 与原来的格值交汇，保证格值单调下降
+            LatticeValue & oldVal = instValues[inst];
+            newVal = meet(oldVal, newVal);
+            if (newVal != oldVal) {
+                oldVal = newVal;
+
+                // 其它基本块中的使用需要重新计算
+                for (auto use: inst->getUses()) {
+                    Instanceof(userInst, Instruction *, use->getUser());
+                    BasicBlock * userBlock = cfg.getBlockOfInst(userInst);
+                    if (userBlock && userBlock != bb && executable[userBlock->getIndex()]) {
+                        pushBlock(userBlock);
+                    }
+                }
+            }
+        }
+    }
+
+    // 出口状态变化时，已经可执行的后继需要重新计算
+    std::vector<BasicBlock *> & succs = bb->getSuccs();
+    if (state != outStates[bb->getIndex()]) {
+        outStates[bb->getIndex()] = state;
+        for (auto succ: succs) {
+            if (executableEdges.count({bb->getIndex(), succ->getIndex()})) {
+                pushBlock(succ);
+            }
+        }
+    }
+
+    // 标记可执行的出边
+    Instruction * term = bb->getTerminator();
+
+    if (term && term->getOp() == IRInstOperator::IRINST_OP_GOTO) {
+
+        GotoInstruction * gotoInst = static_cast<GotoInstruction *>(term);
+
+        if (gotoInst->isConditionalBranch()) {
+
+            LatticeValue cond = evaluate(gotoInst->getOperand(0), state);
+            BasicBlock * trueBlock = cfg.getBlockOfLabel(gotoInst->getTarget());
+            BasicBlock * falseBlock = cfg.getBlockOfLabel(gotoInst->getFalseTarget());
+
+            if (cond.kind == LatticeValue::CONST) {
+                markEdge(bb, cond.val != 0 ? trueBlock : falseBlock);
+            } else if (cond.kind == LatticeValue::BOTTOM) {
+                markEdge(bb, trueBlock);
+                markEdge(bb, falseBlock);
+            }
+        } else {
+            for (auto succ: succs) {
+                markEdge(bb, succ);
+            }
+        }
+    } else {
+        // 出口指令没有后继，顺序执行时只有一个后继
+        for (auto succ: succs) {
+            markEdge(bb, succ);
+        }
+    }
+}
+
+/// @brief 指令的源操作数能否替换为整型常量。常量为i32类型，赋值给bool型变量时类型不一致，不能替换
+/// @param inst 使用者指令
+/// @return true 能 false 不能
+bool SCCP::canUseConstant(Instruction * inst)
+{
+    if (inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN) {
+        return !inst->getOperand(0)->getType()->isInt1Byte();
+    }
+
+    return true;
+}
+
+/// @brief 根据分析结果改写IR
+/// @return true 发生了改写 false 没有
+bool SCCP::rewrite()
+{
+    bool changed = false;
+
+    for (auto bb: cfg.getBlocks()) {
+
+        std::vector<Instruction *> & insts = bb->getInsts();
+
+        if (!executable[bb->getIndex()]) {
+
+            // 函数出口所在的基本块保留，其它不可达的基本块删除
+            bool hasExit = false;
+            for (auto inst: insts) {
+                if (inst->getOp() == IRInstOperator::IRINST_OP_EXIT) {
+                    hasExit = true;
+                }
+            }
+
+            if (!hasExit) {
+                for (auto inst: insts) {
+                    inst->setDead();
+                }
+                changed = true;
+            }
+
+            continue;
+        }
+
+        VarState state = inStates[bb->getIndex()];
+
+        for (size_t pos = 0; pos < insts.size(); ++pos) {
+
+            Instruction * inst = insts[pos];
+            IRInstOperator op = inst->getOp();
+
+            // 把值为常量的局部变量与全局变量的使用替换为常量，赋值指令的目的操作数除外
+            int32_t firstSrc = (op == IRInstOperator::IRINST_OP_ASSIGN) ? 1 : 0;
+            for (int32_t k = firstSrc; k < inst->getOperandsNum(); ++k) {
+                Value * src = inst->getOperand(k);
+                if ((varIndex.count(src) || constGlobals.count(src)) && canUseConstant(inst)) {
+                    LatticeValue v = evaluate(src, state);
+                    if (v.kind == LatticeValue::CONST) {
+                        inst->setOperand(k, module->newConstInt(v.val));
+                        changed = true;
+                    }
+                }
+            }
+
+            if (op == IRInstOperator::IRINST_OP_ASSIGN) {
+                auto varIter = varIndex.find(inst->getOperand(0));
+                if (varIter != varIndex.end()) {
+                    state[varIter->second] = evaluate(inst->getOperand(1), state);
+                }
+            } else if (op == IRInstOperator::IRINST_OP_GOTO) {
+
+                GotoInstruction * gotoInst = static_cast<GotoInstruction *>(inst);
+
+                if (gotoInst->isConditionalBranch()) {
+                    LatticeValue cond = evaluate(gotoInst->getOperand(0), state);
+                    if (cond.kind == LatticeValue::CONST) {
+                        // 条件确定，改为无条件跳转
+                        LabelInstruction * target = cond.val ? gotoInst->getTarget() : gotoInst->getFalseTarget();
+                        insts[pos] = new (func) GotoInstruction(func, target);
+                        insts.push_back(gotoInst);
+                        gotoInst->setDead();
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // 值为常量的运算指令与函数调用，其使用替换为常量，运算指令全部替换后删除，函数调用可能有副作用而保留
+    for (auto & [inst, v]: instValues) {
+
+        if (v.kind != LatticeValue::CONST || inst->isDead()) {
+            continue;
+        }
+
+        bool isCall = inst->getOp() == IRInstOperator::IRINST_OP_FUNC_CALL;
+        if (!isArithOp(inst->getOp()) && !isCall) {
+            continue;
+        }
+
+        // 遍历时可以修改当前的Use
+        for (auto use: inst->getUses()) {
+            Instanceof(userInst, Instruction *, use->getUser());
+            if (canUseConstant(userInst)) {
+                use->setUsee(module->newConstInt(v.val));
+                changed = true;
+            }
+        }
+
+        if (!isCall && inst->getUses().empty()) {
+            inst->setDead();
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+/// @brief 执行优化
+/// @return true 函数的IR发生了变化 false 没有变化
+bool SCCP::run()
+{
+    if (cfg.getBlocks().empty()) {
+        return false;
+    }
+
+    collectConstGlobals();
+
+    for (auto var: func->getVarValues()) {
+        varIndex[var] = (int32_t) varIndex.size();
+    }
+
+    size_t blockNum = cfg.getBlocks().size();
+
+    inStates.assign(blockNum, VarState(varIndex.size()));
+    outStates.assign(blockNum, VarState(varIndex.size()));
+    executable.assign(blockNum, 0);
+    inWorklist.assign(blockNum, 0);
+
+    pushBlock(cfg.getEntry());
+
+    while (!worklist.empty()) {
+
+        BasicBlock * bb = worklist.front();
+        worklist.pop_front();
+        inWorklist[bb->getIndex()] = 0;
+
+        // 基本块只有在新的入边可执行、前驱出口状态变化或者使用的指令结果变化时才会加入工作表，
+        // 格值单调下降，因此一定会终止
+        (void) computeInState(bb);
+        executable[bb->getIndex()] = 1;
+
+        visitBlock(bb);
+    }
+
+    bool changed = rewrite();
+
+    if (changed) {
+        cfg.writeBack();
+    }
+
+    return changed;
+}
@@ -0,0 +1,196 @@
+///
+/// @file SCCP.h
+/// @brief 稀疏条件常量传播，同时删除不可达的分支
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "ControlFlowGraph.h"
+#include "Pass.h"
+
+///
+/// @brief 条件常量传播。IR不是SSA形式，局部变量可多次赋值，因此局部变量的格值按基本块的入口与出口维护，
+/// 而指令的结果(临时变量)只定值一次，按指令维护一个全局的格值。
+/// 只沿着可执行的边传播，条件为常量的跳转改为无条件跳转，不可达的基本块被删除
+///
+class SCCP : public FunctionPass {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    /// @param _func 要优化的函数
+    ///
+    SCCP(Module * _module, Function * _func);
+
+    ///
+    /// @brief 执行优化
+    /// @return true 函数的IR发生了变化 false 没有变化
+    ///
+    bool run() override;
+
+private:
+    ///
+    /// @brief 格值：TOP表示还未确定，CONST表示常量，BOTTOM表示不是常量
+    ///
+    struct LatticeValue {
+
+        enum Kind : std::int8_t { TOP, CONST, BOTTOM };
+
+        Kind kind = TOP;
+
+        int32_t val = 0;
+
+        bool operator==(const LatticeValue & other) const
+        {
+            return kind == other.kind && (kind != CONST || val == other.val);
+        }
+
+        bool operator!=(const LatticeValue & other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    ///
+    /// @brief 局部变量的格值，下标为局部变量的编号
+    ///
+    using VarState = std::vector<LatticeValue>;
+
+    ///
+    /// @brief 两个格值的交汇
+    /// @param a 格值
+    /// @param b 格值
+    /// @return LatticeValue 交汇后的格值
+    ///
+    static LatticeValue meet(const LatticeValue & a, const LatticeValue & b);
+
+    ///
+    /// @brief 求值，获取Value在当前状态下的格值
+    /// @param val Value
+    /// @param state 局部变量的格值
+    /// @return LatticeValue 格值
+    ///
+    LatticeValue evaluate(Value * val, VarState & state);
+
+    ///
+    /// @brief 对运算指令进行求值
+    /// @param inst 运算指令
+    /// @param state 局部变量的格值
+    /// @return LatticeValue 格值
+    ///
+    LatticeValue evaluateArith(Instruction * inst, VarState & state);
+
+    ///
+    /// @brief 按照基本块的入口状态模拟执行基本块，更新出口状态，并标记可执行的边
+    /// @param bb 基本块
+    ///
+    void visitBlock(BasicBlock * bb);
+
+    ///
+    /// @brief 标记边为可执行，后继基本块需要重新计算
+    /// @param from 前驱基本块
+    /// @param to 后继基本块
+    ///
+    void markEdge(BasicBlock * from, BasicBlock * to);
+
+    ///
+    /// @brief 计算基本块的入口状态，即所有可执行前驱边的出口状态的交汇
+    /// @param bb 基本块
+    /// @return true 入口状态发生了变化 false 没有变化
+    ///
+    bool computeInState(BasicBlock * bb);
+
+    ///
+    /// @brief 把基本块加入到工作表中
+    /// @param bb 基本块
+    ///
+    void pushBlock(BasicBlock * bb);
+
+    ///
+    /// @brief 指令的源操作数能否替换为整型常量
+    /// @param inst 使用者指令
+    /// @return true 能 false 不能
+    ///
+    static bool canUseConstant(Instruction * inst);
+
+    ///
+    /// @brief 根据分析结果改写IR
+    /// @return true 发生了改写 false 没有
+    ///
+    bool rewrite();
+
+    ///
+    /// @brief 收集整个模块内从来没有被赋值的全局变量，其值恒为0
+    ///
+    void collectConstGlobals();
+
+    ///
+    /// @brief 控制流图
+    ///
+    ControlFlowGraph cfg;
+
+    ///
+    /// @brief 局部变量到编号的映射
+    ///
+    std::unordered_map<Value *, int32_t> varIndex;
+
+    ///
+    /// @brief 各基本块入口处局部变量的格值
+    ///
+    std::vector<VarState> inStates;
+
+    ///
+    /// @brief 各基本块出口处局部变量的格值
+    ///
+    std::vector<VarState> outStates;
+
+    ///
+    /// @brief 基本块是否可执行
+    ///
+    std::vector<char> executable;
+
+    ///
+    /// @brief 可执行的边
+    ///
+    std::set<std::pair<int32_t, int32_t>> executableEdges;
+
+    ///
+    /// @brief 指令结果的格值
+    ///
+    std::unordered_map<Instruction *, LatticeValue> instValues;
+
+    ///
+    /// @brief 待处理的基本块
+    ///
+    std::deque<BasicBlock *> worklist;
+
+    ///
+    /// @brief 基本块是否在工作表中
+    ///
+    std::vector<char> inWorklist;
+
+    ///
+    /// @brief 从来没有被赋值的全局变量
+    ///
+    std::unordered_set<Value *> constGlobals;
+};
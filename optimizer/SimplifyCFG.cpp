@@ -0,0 +1,313 @@
+///
+/// @file SimplifyCFG.cpp
+/// @brief 控制流图化简：跳转穿透、分支折叠、基本块合并与多余跳转删除
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <unordered_set>
+#include <vector>
+
+#include "SimplifyCFG.h"
+#include "Common.h"
+#include "ConstInt.h"
+#include "GotoInstruction.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _func 要优化的函数
+SimplifyCFG::SimplifyCFG(Module * _module, Function * _func) : FunctionPass(_module, _func), cfg(_func)
+{}
+
+/// @brief 删除指令，并立即解除其对操作数的使用
+/// @param inst 指令
+void SimplifyCFG::killInst(Instruction * inst)
+{
+    inst->setDead();
+    inst->clearOperands();
+}
+
+/// @brief 删除从入口不可达的基本块，出口Label所在的基本块保留
+/// @return true 有删除 false 没有
+bool SimplifyCFG::removeUnreachableBlocks()
+{
+    std::vector<char> reachable(cfg.getBlocks().size(), 0);
+    for (auto bb: cfg.reversePostOrder()) {
+        reachable[bb->getIndex()] = 1;
+    }
+
+    bool changed = false;
+
+    for (auto bb: cfg.getBlocks()) {
+
+        if (reachable[bb->getIndex()] || (bb->getLabel() && bb->getLabel() == func->getExitLabel())) {
+            continue;
+        }
+
+        bool removed = false;
+        for (auto inst: bb->getInsts()) {
+            if (!inst->isDead()) {
+                killInst(inst);
+                removed = true;
+            }
+        }
+
+        if (removed) {
+            removedBlockCount++;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+/// @brief 沿着空的基本块以及条件已知的条件跳转块查找最终的跳转目标
+/// @param label 跳转目标
+/// @param cond 入边所在的条件跳转的条件，无条件跳转时为空
+/// @param condValue 沿该入边时条件的值
+/// @return LabelInstruction* 最终的跳转目标
+LabelInstruction * SimplifyCFG::resolveTarget(LabelInstruction * label, Value * cond, bool condValue)
+{
+    std::vector<BasicBlock *> & blocks = cfg.getBlocks();
+
+    // 空循环时跳转链成环，记录走过的Label
+    std::unordered_set<LabelInstruction *> visited{label};
+
+    while (label != func->getExitLabel()) {
+
+        BasicBlock * bb = cfg.getBlockOfLabel(label);
+        if (bb == nullptr) {
+            break;
+        }
+
+        // 基本块内除Label外只能有一条跳转指令
+        Instruction * only = nullptr;
+        int32_t count = 0;
+        for (auto inst: bb->getInsts()) {
+            if (!inst->isDead() && inst != label) {
+                only = inst;
+                count++;
+            }
+        }
+
+        LabelInstruction * next = nullptr;
+
+        if (count == 0) {
+
+            // 空的基本块顺序执行到下一个基本块
+            size_t nextIndex = bb->getIndex() + 1;
+            if (nextIndex < blocks.size()) {
+                next = blocks[nextIndex]->getLabel();
+            }
+        } else if (count == 1 && only->getOp() == IRInstOperator::IRINST_OP_GOTO) {
+
+            GotoInstruction * gotoInst = static_cast<GotoInstruction *>(only);
+
+            if (!gotoInst->isConditionalBranch() || gotoInst->getTarget() == gotoInst->getFalseTarget()) {
+                next = gotoInst->getTarget();
+            } else if (cond != nullptr && gotoInst->getOperand(0) == cond) {
+                // 中间没有执行任何指令，条件的值与入边上的相同
+                next = condValue ? gotoInst->getTarget() : gotoInst->getFalseTarget();
+            }
+        }
+
+        if (next == nullptr || !visited.insert(next).second) {
+            break;
+        }
+
+        label = next;
+    }
+
+    return label;
+}
+
+/// @brief 跳转穿透与分支折叠
+/// @return true 有变化 false 没有
+bool SimplifyCFG::threadJumps()
+{
+    bool changed = false;
+
+    for (auto bb: cfg.getBlocks()) {
+
+        Instruction * term = bb->getTerminator();
+        if (term == nullptr || term->getOp() != IRInstOperator::IRINST_OP_GOTO) {
+            continue;
+        }
+
+        GotoInstruction * gotoInst = static_cast<GotoInstruction *>(term);
+        Value * cond = gotoInst->isConditionalBranch() ? gotoInst->getOperand(0) : nullptr;
+
+        LabelInstruction * target = resolveTarget(gotoInst->getTarget(), cond, true);
+        if (target != gotoInst->getTarget()) {
+            gotoInst->setTarget(target);
+            threadedCount++;
+            changed = true;
+        }
+
+        if (cond == nullptr) {
+            continue;
+        }
+
+        LabelInstruction * falseTarget = resolveTarget(gotoInst->getFalseTarget(), cond, false);
+        if (falseTarget != gotoInst->getFalseTarget()) {
+            gotoInst->setFalseTarget(falseTarget);
+            threadedCount++;
+            changed = true;
+        }
+
+        // 真假目标相同或条件为常量时改为无条件跳转
+        Instanceof(constCond, ConstInt *, cond);
+        if (target == falseTarget || constCond) {
+
+            LabelInstruction * newTarget = (constCond && constCond->getVal() == 0) ? falseTarget : target;
+
+            std::vector<Instruction *> & insts = bb->getInsts();
+            for (auto & inst: insts) {
+                if (inst == gotoInst) {
+                    inst = new (func) GotoInstruction(func, newTarget);
+                    break;
+                }
+            }
+
+            // 保留在基本块中，写回时释放
+            insts.push_back(gotoInst);
+            killInst(gotoInst);
+            threadedCount++;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+/// @brief 以无条件跳转进入且只有一个前驱的基本块合并到前驱的末尾
+/// @return true 有合并 false 没有
+bool SimplifyCFG::mergeBlocks()
+{
+    std::unordered_set<BasicBlock *> touched;
+
+    for (auto bb: cfg.getBlocks()) {
+
+        LabelInstruction * label = bb->getLabel();
+        if (label == nullptr || label == func->getExitLabel() || bb->getPreds().size() != 1) {
+            continue;
+        }
+
+        // 合并后基本块的位置变化，因此要求基本块不会顺序执行到下一个基本块
+        BasicBlock * pred = bb->getPreds().front();
+        if (pred == bb || bb->getTerminator() == nullptr || touched.count(pred) || touched.count(bb)) {
+            continue;
+        }
+
+        Instruction * predTerm = pred->getTerminator();
+        if (predTerm == nullptr || predTerm->getOp() != IRInstOperator::IRINST_OP_GOTO ||
+            static_cast<GotoInstruction *>(predTerm)->isConditionalBranch()) {
+            continue;
+        }
+
+        killInst(predTerm);
+        killInst(label);
+
+        std::vector<Instruction *> & predInsts = pred->getInsts();
+        std::vector<Instruction *> & insts = bb->getInsts();
+
+        predInsts.insert(predInsts.end(), insts.begin(), insts.end());
+        insts.clear();
+
+        touched.insert(pred);
+        touched.insert(bb);
+        removedBlockCount++;
+    }
+
+    return !touched.empty();
+}
+
+/// @brief 删除跳转到下一个基本块的goto以及没有跳转到的Label
+/// @return true 有删除 false 没有
+bool SimplifyCFG::removeRedundantJumps()
+{
+    std::vector<BasicBlock *> & blocks = cfg.getBlocks();
+    std::unordered_set<Instruction *> targets;
+
+    bool changed = false;
+
+    for (size_t k = 0; k < blocks.size(); ++k) {
+
+        Instruction * term = blocks[k]->getTerminator();
+        if (term == nullptr || term->getOp() != IRInstOperator::IRINST_OP_GOTO) {
+            continue;
+        }
+
+        GotoInstruction * gotoInst = static_cast<GotoInstruction *>(term);
+
+        if (!gotoInst->isConditionalBranch() && k + 1 < blocks.size() &&
+            gotoInst->getTarget() == blocks[k + 1]->getLabel()) {
+
+            // 顺序执行即可到达
+            killInst(gotoInst);
+            threadedCount++;
+            changed = true;
+            continue;
+        }
+
+        targets.insert(gotoInst->getTarget());
+        if (gotoInst->isConditionalBranch()) {
+            targets.insert(gotoInst->getFalseTarget());
+        }
+    }
+
+    // 没有跳转到的Label删除后，基本块与前面顺序执行进入的基本块合并
+    for (auto bb: blocks) {
+        LabelInstruction * label = bb->getLabel();
+        if (label && !label->isDead() && label != func->getExitLabel() && !targets.count(label)) {
+            killInst(label);
+            removedBlockCount++;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+/// @brief 执行优化
+/// @return true 函数的IR发生了变化 false 没有变化
+bool SimplifyCFG::run()
+{
+    if (cfg.getBlocks().empty()) {
+        return false;
+    }
+
+    bool changed = false;
+
+    // 每一步都可能为其它步骤创造机会，一步有变化时写回并重建控制流图
+    for (;;) {
+
+        bool roundChanged = removeUnreachableBlocks() || threadJumps() || mergeBlocks() || removeRedundantJumps();
+        if (!roundChanged) {
+            break;
+        }
+
+        cfg.writeBack();
+        changed = true;
+    }
+
+    if (changed) {
+        minic_log(LOG_INFO,
+                  "函数%s: 控制流化简修改%d处跳转，删除%d个基本块",
+                  func->getName().c_str(),
+                  threadedCount,
+                  removedBlockCount);
+    }
+
+    return changed;
+}
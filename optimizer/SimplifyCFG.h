@@ -0,0 +1,100 @@
+///
+/// @file SimplifyCFG.h
+/// @brief 控制流图化简：跳转穿透、分支折叠、基本块合并与多余跳转删除
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+
+#include "ControlFlowGraph.h"
+#include "Pass.h"
+
+///
+/// @brief 控制流图化简。IR生成时if、while、break与continue产生大量Label到Label的跳转链，
+/// 这里删除不可达的基本块，跳转穿过空的基本块以及在入边上条件已知的条件跳转块，
+/// 真假目标相同或条件为常量的条件跳转改为无条件跳转，只有一个前驱的基本块合并到前驱，
+/// 跳转到下一个基本块的goto与没有跳转到的Label删除。各步骤交替执行到不动点
+///
+class SimplifyCFG : public FunctionPass {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    /// @param _func 要优化的函数
+    ///
+    SimplifyCFG(Module * _module, Function * _func);
+
+    ///
+    /// @brief 执行优化
+    /// @return true 函数的IR发生了变化 false 没有变化
+    ///
+    bool run() override;
+
+private:
+    ///
+    /// @brief 删除指令，并立即解除其对操作数的使用
+    /// @param inst 指令
+    ///
+    void killInst(Instruction * inst);
+
+    ///
+    /// @brief 删除从入口不可达的基本块，出口Label所在的基本块保留
+    /// @return true 有删除 false 没有
+    ///
+    bool removeUnreachableBlocks();
+
+    ///
+    /// @brief 沿着空的基本块以及条件已知的条件跳转块查找最终的跳转目标
+    /// @param label 跳转目标
+    /// @param cond 入边所在的条件跳转的条件，无条件跳转时为空
+    /// @param condValue 沿该入边时条件的值
+    /// @return LabelInstruction* 最终的跳转目标
+    ///
+    LabelInstruction * resolveTarget(LabelInstruction * label, Value * cond, bool condValue);
+
+    ///
+    /// @brief 跳转穿透与分支折叠
+    /// @return true 有变化 false 没有
+    ///
+    bool threadJumps();
+
+    ///
+    /// @brief 以无条件跳转进入且只有一个前驱的基本块合并到前驱的末尾
+    /// @return true 有合并 false 没有
+    ///
+    bool mergeBlocks();
+
+    ///
+    /// @brief 删除跳转到下一个基本块的goto以及没有跳转到的Label
+    /// @return true 有删除 false 没有
+    ///
+    bool removeRedundantJumps();
+
+    ///
+    /// @brief 控制流图
+    ///
+    ControlFlowGraph cfg;
+
+    ///
+    /// @brief 修改的跳转数
+    ///
+    int32_t threadedCount = 0;
+
+    ///
+    /// @brief 合并或删除的基本块数
+    ///
+    int32_t removedBlockCount = 0;
+};
@@ -0,0 +1,145 @@
+///
+/// @file TailRecursion.cpp
+/// @brief 尾递归消除，自身的尾调用改为形参重新赋值后跳回函数开始处
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+
+#include "TailRecursion.h"
+#include "Common.h"
+#include "FuncCallInstruction.h"
+#include "GotoInstruction.h"
+#include "LabelInstruction.h"
+#include "MoveInstruction.h"
+#include "OptUtils.h"
+
+/// @brief 构造函数
+/// @param _module 符号表
+/// @param _func 要优化的函数
+TailRecursionElimination::TailRecursionElimination(Module * _module, Function * _func) : FunctionPass(_module, _func)
+{}
+
+/// @brief 并行赋值转换为顺序的赋值指令，出现循环依赖时借助临时的局部变量
+/// @param moves 并行的赋值，first为目的，second为源
+/// @param seq 产生的赋值指令追加到这里
+void TailRecursionElimination::sequentializeMoves(std::vector<std::pair<Value *, Value *>> moves,
+                                                  std::vector<Instruction *> & seq)
+{
+    moves.erase(std::remove_if(moves.begin(),
+                               moves.end(),
+                               [](const std::pair<Value *, Value *> & move) { return move.first == move.second; }),
+                moves.end());
+
+    while (!moves.empty()) {
+
+        // 目的变量不再被其它赋值读取的赋值可以先执行
+        auto ready = std::find_if(moves.begin(), moves.end(), [&moves](const std::pair<Value *, Value *> & move) {
+            return std::none_of(moves.begin(), moves.end(), [&move](const std::pair<Value *, Value *> & other) {
+                return other.second == move.first;
+            });
+        });
+
+        if (ready != moves.end()) {
+            seq.push_back(new (func) MoveInstruction(func, ready->first, ready->second));
+            moves.erase(ready);
+            continue;
+        }
+
+        // 剩下的都在循环依赖中，先保存一个目的变量的旧值，其读取改为读取保存的值
+        Value * dst = moves.front().first;
+        LocalVariable * saved = func->newLocalVarValue(dst->getType());
+        seq.push_back(new (func) MoveInstruction(func, saved, dst));
+
+        for (auto & move: moves) {
+            if (move.second == dst) {
+                move.second = saved;
+            }
+        }
+    }
+}
+
+/// @brief 执行优化
+/// @return true 函数的IR发生了变化 false 没有变化
+bool TailRecursionElimination::run()
+{
+    std::vector<Instruction *> & insts = func->getInterCode().getInsts();
+
+    std::vector<std::pair<FuncCallInstruction *, Instruction *>> tailCalls;
+
+    for (auto inst: insts) {
+
+        if (inst->isDead() || inst->getOp() != IRInstOperator::IRINST_OP_FUNC_CALL) {
+            continue;
+        }
+
+        FuncCallInstruction * callInst = static_cast<FuncCallInstruction *>(inst);
+        Instruction * retMove;
+
+        if (callInst->calledFunction == func &&
+            callInst->getOperandsNum() == (int32_t) func->getParams().size() && isTailCall(func, inst, retMove)) {
+            tailCalls.emplace_back(callInst, retMove);
+        }
+    }
+
+    if (tailCalls.empty() || insts.empty() || insts[0]->getOp() != IRInstOperator::IRINST_OP_ENTRY) {
+        return false;
+    }
+
+    // 形参只在入口处读取一次，函数体内改为读取对应的局部变量，尾调用时给这些局部变量重新赋值
+    std::vector<Instruction *> prologue;
+    std::vector<Value *> paramVars;
+
+    for (auto param: func->getParams()) {
+        LocalVariable * paramVar = func->newLocalVarValue(param->getType());
+        param->replaceAllUsesWith(paramVar);
+        prologue.push_back(new (func) MoveInstruction(func, paramVar, param));
+        paramVars.push_back(paramVar);
+    }
+
+    LabelInstruction * headerLabel = new (func) LabelInstruction(func);
+    prologue.push_back(headerLabel);
+
+    insts.insert(insts.begin() + 1, prologue.begin(), prologue.end());
+
+    for (auto & tailCall: tailCalls) {
+
+        FuncCallInstruction * callInst = tailCall.first;
+
+        std::vector<std::pair<Value *, Value *>> moves;
+        for (size_t k = 0; k < paramVars.size(); ++k) {
+            moves.emplace_back(paramVars[k], callInst->getOperand((int32_t) k));
+        }
+
+        std::vector<Instruction *> seq;
+        sequentializeMoves(moves, seq);
+        seq.push_back(new (func) GotoInstruction(func, headerLabel));
+
+        if (tailCall.second) {
+            tailCall.second->setDead();
+            tailCall.second->clearOperands();
+        }
+
+        auto pos = std::find(insts.begin(), insts.end(), callInst);
+        pos = insts.erase(pos);
+        insts.insert(pos, seq.begin(), seq.end());
+
+        callInst->clearOperands();
+        delete callInst;
+    }
+
+    minic_log(LOG_INFO, "函数%s: 消除%d处尾递归", func->getName().c_str(), (int) tailCalls.size());
+
+    return true;
+}
@@ -0,0 +1,51 @@
+///
+/// @file TailRecursion.h
+/// @brief 尾递归消除，自身的尾调用改为形参重新赋值后跳回函数开始处
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "Pass.h"
+
+///
+/// @brief 尾递归消除。形参的使用改为新的局部变量，入口处把形参赋值给这些变量，之后是循环头Label；
+/// 自身的尾调用改为把实参并行赋值给这些变量，然后跳转到循环头
+///
+class TailRecursionElimination : public FunctionPass {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _module 符号表
+    /// @param _func 要优化的函数
+    ///
+    TailRecursionElimination(Module * _module, Function * _func);
+
+    ///
+    /// @brief 执行优化
+    /// @return true 函数的IR发生了变化 false 没有变化
+    ///
+    bool run() override;
+
+private:
+    ///
+    /// @brief 并行赋值转换为顺序的赋值指令，出现循环依赖时借助临时的局部变量
+    /// @param moves 并行的赋值，first为目的，second为源
+    /// @param seq 产生的赋值指令追加到这里
+    ///
+    void sequentializeMoves(std::vector<std::pair<Value *, Value *>> moves, std::vector<Instruction *> & seq);
+};
@@ -0,0 +1,636 @@
+///
+/// @file ValueRange.cpp
+/// @brief 值范围分析，求整数值在各程序点的取值区间
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "ValueRange.h"
+#include "ConstInt.h"
+#include "FuncCallInstruction.h"
+#include "GotoInstruction.h"
+#include "OptUtils.h"
+
+/// @brief 循环头的入口状态变化超过该次数后加宽
+static const int32_t WIDEN_THRESHOLD = 3;
+
+/// @brief 加宽到达不动点后收窄的遍数
+static const int32_t NARROW_PASSES = 2;
+
+/// @brief 两个区间的并
+/// @param other 另一个区间
+/// @return ValueRange 包含两者的最小区间
+ValueRange ValueRange::join(const ValueRange & other) const
+{
+    if (isEmpty()) {
+        return other;
+    }
+
+    if (other.isEmpty()) {
+        return *this;
+    }
+
+    return ValueRange{std::min(lo, other.lo), std::max(hi, other.hi)};
+}
+
+/// @brief 两个区间的交
+/// @param other 另一个区间
+/// @return ValueRange 交集，可能为空
+ValueRange ValueRange::intersect(const ValueRange & other) const
+{
+    return ValueRange{std::max(lo, other.lo), std::min(hi, other.hi)};
+}
+
+/// @brief 构造函数，对控制流图进行值范围分析
+/// @param _cfg 控制流图
+ValueRangeAnalysis::ValueRangeAnalysis(ControlFlowGraph & _cfg) : cfg(_cfg), func(_cfg.getFunction())
+{
+    std::vector<BasicBlock *> & blocks = cfg.getBlocks();
+    if (blocks.empty()) {
+        return;
+    }
+
+    for (auto var: func->getVarValues()) {
+        varIndex[var] = (int32_t) varIndex.size();
+    }
+
+    // 条件跳转中参与比较的临时变量也按基本块维护，用于记录出边上收紧的区间
+    for (auto bb: blocks) {
+        Instruction * term = bb->getTerminator();
+        if (term == nullptr || term->getOp() != IRInstOperator::IRINST_OP_GOTO ||
+            !static_cast<GotoInstruction *>(term)->isConditionalBranch()) {
+            continue;
+        }
+
+        Instanceof(compare, Instruction *, term->getOperand(0));
+        if (compare == nullptr || !isCompareOp(compare->getOp())) {
+            continue;
+        }
+
+        for (int32_t k = 0; k < 2; ++k) {
+            Instanceof(temp, Instruction *, compare->getOperand(k));
+            if (temp && temp->hasResultValue() && !varIndex.count(temp)) {
+                varIndex[temp] = (int32_t) varIndex.size();
+            }
+        }
+    }
+
+    size_t blockNum = blocks.size();
+
+    inStates.assign(blockNum, VarState(varIndex.size()));
+    edgeStates.resize(blockNum);
+    edgeReachable.resize(blockNum);
+    for (auto bb: blocks) {
+        edgeStates[bb->getIndex()].assign(bb->getSuccs().size(), VarState(varIndex.size()));
+        edgeReachable[bb->getIndex()].assign(bb->getSuccs().size(), 0);
+    }
+    reached.assign(blockNum, 0);
+    visitCount.assign(blockNum, 0);
+    inWorklist.assign(blockNum, 0);
+
+    // 逆后序中从后面跳回来的边的目标是循环头，环路上至少有一个循环头，只在循环头加宽即可保证终止
+    std::vector<BasicBlock *> order = cfg.reversePostOrder();
+    std::vector<int32_t> orderIndex(blockNum, -1);
+    for (size_t k = 0; k < order.size(); ++k) {
+        orderIndex[order[k]->getIndex()] = (int32_t) k;
+    }
+
+    loopHead.assign(blockNum, 0);
+    for (auto bb: order) {
+        for (auto pred: bb->getPreds()) {
+            if (orderIndex[pred->getIndex()] >= orderIndex[bb->getIndex()]) {
+                loopHead[bb->getIndex()] = 1;
+            }
+        }
+    }
+
+    pushBlock(cfg.getEntry());
+
+    while (!worklist.empty()) {
+
+        BasicBlock * bb = worklist.front();
+        worklist.pop_front();
+        inWorklist[bb->getIndex()] = 0;
+
+        (void) computeInState(bb, false);
+        if (reached[bb->getIndex()]) {
+            visitBlock(bb, false);
+        }
+    }
+
+    // 加宽得到的是不动点之上的安全结果，按逆后序不加宽地再迭代，结果仍然安全且更精确
+    for (int32_t pass = 0; pass < NARROW_PASSES; ++pass) {
+        for (auto bb: order) {
+            (void) computeInState(bb, true);
+            if (reached[bb->getIndex()]) {
+                visitBlock(bb, true);
+            } else {
+                std::fill(edgeReachable[bb->getIndex()].begin(), edgeReachable[bb->getIndex()].end(), 0);
+            }
+        }
+    }
+
+    recordOperandRanges();
+}
+
+/// @brief 把基本块加入到工作表中
+/// @param bb 基本块
+void ValueRangeAnalysis::pushBlock(BasicBlock * bb)
+{
+    if (!inWorklist[bb->getIndex()]) {
+        inWorklist[bb->getIndex()] = 1;
+        worklist.push_back(bb);
+    }
+}
+
+/// @brief 区间增大的边界直接加宽到32位的边界
+/// @param oldRange 原来的区间
+/// @param newRange 新的区间
+/// @return ValueRange 加宽后的区间
+ValueRange ValueRangeAnalysis::widen(const ValueRange & oldRange, const ValueRange & newRange)
+{
+    if (oldRange.isEmpty() || newRange.isEmpty()) {
+        return newRange.join(oldRange);
+    }
+
+    int64_t lo = newRange.lo < oldRange.lo ? INT32_MIN : oldRange.lo;
+    int64_t hi = newRange.hi > oldRange.hi ? INT32_MAX : oldRange.hi;
+
+    return ValueRange{lo, hi};
+}
+
+/// @brief 求值，获取Value在当前状态下的区间
+/// @param val Value
+/// @param state 局部变量的区间
+/// @return ValueRange 区间
+ValueRange ValueRangeAnalysis::evaluate(Value * val, VarState & state)
+{
+    Instanceof(constVal, ConstInt *, val);
+    if (constVal) {
+        return ValueRange::constant(constVal->getVal());
+    }
+
+    auto varIter = varIndex.find(val);
+
+    Instanceof(inst, Instruction *, val);
+    if (inst) {
+        auto instIter = instRanges.find(inst);
+        if (instIter == instRanges.end()) {
+            return ValueRange{};
+        }
+
+        // 临时变量在条件跳转的出边上可能被收紧
+        return varIter == varIndex.end() ? instIter->second : instIter->second.intersect(state[varIter->second]);
+    }
+
+    if (varIter != varIndex.end()) {
+        return state[varIter->second];
+    }
+
+    // 形参、全局变量等
+    return ValueRange::full();
+}
+
+/// @brief 根据两个操作数的区间判断比较的结果
+/// @param op 比较运算符
+/// @param a 左操作数的区间
+/// @param b 右操作数的区间
+/// @return int32_t 1 总是成立 0 总是不成立 -1 不能确定
+int32_t ValueRangeAnalysis::evaluateCompare(IRInstOperator op, const ValueRange & a, const ValueRange & b)
+{
+    if (a.isEmpty() || b.isEmpty()) {
+        return -1;
+    }
+
+    switch (op) {
+        case IRInstOperator::IRINST_OP_LT_I:
+            return a.hi < b.lo ? 1 : (a.lo >= b.hi ? 0 : -1);
+        case IRInstOperator::IRINST_OP_LE_I:
+            return a.hi <= b.lo ? 1 : (a.lo > b.hi ? 0 : -1);
+        case IRInstOperator::IRINST_OP_GT_I:
+            return a.lo > b.hi ? 1 : (a.hi <= b.lo ? 0 : -1);
+        case IRInstOperator::IRINST_OP_GE_I:
+            return a.lo >= b.hi ? 1 : (a.hi < b.lo ? 0 : -1);
+        case IRInstOperator::IRINST_OP_EQ_I:
+            if (a.isConstant() && b.isConstant() && a.lo == b.lo) {
+                return 1;
+            }
+            return a.intersect(b).isEmpty() ? 0 : -1;
+        case IRInstOperator::IRINST_OP_NE_I: {
+            int32_t eq = evaluateCompare(IRInstOperator::IRINST_OP_EQ_I, a, b);
+            return eq < 0 ? eq : 1 - eq;
+        }
+        default:
+            return -1;
+    }
+}
+
+/// @brief 对运算指令求结果的区间，可能溢出时为全部整数
+/// @param inst 运算指令
+/// @param state 局部变量的区间
+/// @return ValueRange 区间
+ValueRange ValueRangeAnalysis::evaluateArith(Instruction * inst, VarState & state)
+{
+    IRInstOperator op = inst->getOp();
+
+    ValueRange a = evaluate(inst->getOperand(0), state);
+    ValueRange b = ValueRange::constant(0);
+    if (op != IRInstOperator::IRINST_OP_NEG_I) {
+        b = evaluate(inst->getOperand(1), state);
+    }
+
+    // 操作数还没有计算过
+    if (a.isEmpty() || b.isEmpty()) {
+        return ValueRange{};
+    }
+
+    if (isCompareOp(op)) {
+        int32_t result = evaluateCompare(op, a, b);
+        return result < 0 ? ValueRange{0, 1} : ValueRange::constant(result);
+    }
+
+    switch (op) {
+        case IRInstOperator::IRINST_OP_ADD_I:
+            return ValueRange::make(a.lo + b.lo, a.hi + b.hi);
+        case IRInstOperator::IRINST_OP_SUB_I:
+            return ValueRange::make(a.lo - b.hi, a.hi - b.lo);
+        case IRInstOperator::IRINST_OP_NEG_I:
+            return ValueRange::make(-a.hi, -a.lo);
+        case IRInstOperator::IRINST_OP_MUL_I:
+        case IRInstOperator::IRINST_OP_DIV_I: {
+
+            // 除数可能为0时不能确定
+            if (op == IRInstOperator::IRINST_OP_DIV_I && b.contains(0)) {
+                return ValueRange::full();
+            }
+
+            // 除数符号确定时商对两个操作数都是单调的，与乘法一样极值在端点处取得
+            int64_t corners[4];
+            if (op == IRInstOperator::IRINST_OP_MUL_I) {
+                corners[0] = a.lo * b.lo;
+                corners[1] = a.lo * b.hi;
+                corners[2] = a.hi * b.lo;
+                corners[3] = a.hi * b.hi;
+            } else {
+                corners[0] = a.lo / b.lo;
+                corners[1] = a.lo / b.hi;
+                corners[2] = a.hi / b.lo;
+                corners[3] = a.hi / b.hi;
+            }
+
+            return ValueRange::make(*std::min_element(corners, corners + 4), *std::max_element(corners, corners + 4));
+        }
+        case IRInstOperator::IRINST_OP_MOD_I: {
+
+            if (b.contains(0)) {
+                return ValueRange::full();
+            }
+
+            // 余数的符号与被除数相同，绝对值小于除数的绝对值
+            int64_t m = std::max(std::abs(b.lo), std::abs(b.hi)) - 1;
+            int64_t lo = a.lo >= 0 ? 0 : std::max(a.lo, -m);
+            int64_t hi = a.hi <= 0 ? 0 : std::min(a.hi, m);
+            return ValueRange{lo, hi};
+        }
+        default:
+            return ValueRange::full();
+    }
+}
+
+/// @brief 根据比较成立收紧左操作数的区间
+/// @param op 比较运算符
+/// @param x 左操作数的区间
+/// @param y 右操作数的区间
+/// @return ValueRange 收紧后的区间，为空时比较不可能成立
+ValueRange ValueRangeAnalysis::refine(IRInstOperator op, const ValueRange & x, const ValueRange & y)
+{
+    if (x.isEmpty() || y.isEmpty()) {
+        return x;
+    }
+
+    switch (op) {
+        case IRInstOperator::IRINST_OP_LT_I:
+            return ValueRange{x.lo, std::min(x.hi, y.hi - 1)};
+        case IRInstOperator::IRINST_OP_LE_I:
+            return ValueRange{x.lo, std::min(x.hi, y.hi)};
+        case IRInstOperator::IRINST_OP_GT_I:
+            return ValueRange{std::max(x.lo, y.lo + 1), x.hi};
+        case IRInstOperator::IRINST_OP_GE_I:
+            return ValueRange{std::max(x.lo, y.lo), x.hi};
+        case IRInstOperator::IRINST_OP_EQ_I:
+            return x.intersect(y);
+        case IRInstOperator::IRINST_OP_NE_I:
+            // 只有不等于区间的端点时才能收紧
+            if (y.isConstant()) {
+                return ValueRange{x.lo == y.lo ? x.lo + 1 : x.lo, x.hi == y.lo ? x.hi - 1 : x.hi};
+            }
+            return x;
+        default:
+            return x;
+    }
+}
+
+/// @brief 条件跳转的出边上收紧参与比较的局部变量
+/// @param bb 以条件跳转结束的基本块
+/// @param compare 比较指令
+/// @param taken 比较成立的出边时为真
+/// @param state 出口处局部变量的区间，就地修改
+/// @return true 出边可能执行 false 比较的结果在该出边上不可能出现
+bool ValueRangeAnalysis::refineEdge(BasicBlock * bb, Instruction * compare, bool taken, VarState & state)
+{
+    if (cfg.getBlockOfInst(compare) != bb) {
+        return true;
+    }
+
+    Value * a = compare->getOperand(0);
+    Value * b = compare->getOperand(1);
+
+    // 比较之后参与比较的变量又被赋值时，出边上的值与比较时不同
+    bool afterCompare = false;
+    for (auto inst: bb->getInsts()) {
+        if (inst == compare) {
+            afterCompare = true;
+        } else if (afterCompare && !inst->isDead() && inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN &&
+                   (inst->getOperand(0) == a || inst->getOperand(0) == b)) {
+            return true;
+        }
+    }
+
+    IRInstOperator op = taken ? compare->getOp() : negateCompareOp(compare->getOp());
+
+    ValueRange ra = evaluate(a, state);
+    ValueRange rb = evaluate(b, state);
+
+    auto aIter = varIndex.find(a);
+    if (aIter != varIndex.end()) {
+        ra = refine(op, ra, rb);
+        if (ra.isEmpty()) {
+            return false;
+        }
+        state[aIter->second] = ra;
+    }
+
+    auto bIter = varIndex.find(b);
+    if (bIter != varIndex.end()) {
+        rb = refine(swapCompareOp(op), rb, ra);
+        if (rb.isEmpty()) {
+            return false;
+        }
+        state[bIter->second] = rb;
+    }
+
+    return evaluateCompare(op, ra, rb) != 0;
+}
+
+/// @brief 计算基本块的入口状态，即所有可能执行的前驱出边状态的并
+/// @param bb 基本块
+/// @param narrowing 是否处于收窄阶段，收窄时不与原来的状态合并
+/// @return true 入口状态发生了变化 false 没有变化
+bool ValueRangeAnalysis::computeInState(BasicBlock * bb, bool narrowing)
+{
+    int32_t index = bb->getIndex();
+    bool isEntry = bb == cfg.getEntry();
+
+    // 入口处局部变量未赋值，可以是任意值
+    VarState newState(varIndex.size(), isEntry ? ValueRange::full() : ValueRange{});
+    bool reachable = isEntry;
+
+    for (auto pred: bb->getPreds()) {
+        std::vector<BasicBlock *> & succs = pred->getSuccs();
+        for (size_t k = 0; k < succs.size(); ++k) {
+            if (succs[k] != bb || !edgeReachable[pred->getIndex()][k]) {
+                continue;
+            }
+            reachable = true;
+            VarState & predState = edgeStates[pred->getIndex()][k];
+            for (size_t v = 0; v < newState.size(); ++v) {
+                newState[v] = newState[v].join(predState[v]);
+            }
+        }
+    }
+
+    if (!reachable) {
+        if (narrowing) {
+            reached[index] = 0;
+        }
+        return false;
+    }
+
+    VarState & oldState = inStates[index];
+
+    if (!narrowing) {
+        for (size_t v = 0; v < newState.size(); ++v) {
+            ValueRange merged = oldState[v].join(newState[v]);
+            bool needWiden = loopHead[index] && visitCount[index] >= WIDEN_THRESHOLD;
+            newState[v] = needWiden ? widen(oldState[v], merged) : merged;
+        }
+    }
+
+    bool changed = !reached[index] || newState != oldState;
+
+    oldState = newState;
+    reached[index] = 1;
+
+    if (changed && !narrowing) {
+        visitCount[index]++;
+    }
+
+    return changed;
+}
+
+/// @brief 按照入口状态模拟执行基本块，更新指令结果与出边的状态
+/// @param bb 基本块
+/// @param narrowing 是否处于收窄阶段，收窄时指令结果直接取新值
+void ValueRangeAnalysis::visitBlock(BasicBlock * bb, bool narrowing)
+{
+    int32_t index = bb->getIndex();
+    VarState state = inStates[index];
+
+    for (auto inst: bb->getInsts()) {
+
+        if (inst->isDead()) {
+            continue;
+        }
+
+        IRInstOperator op = inst->getOp();
+
+        if (op == IRInstOperator::IRINST_OP_ASSIGN) {
+
+            auto varIter = varIndex.find(inst->getOperand(0));
+            if (varIter != varIndex.end()) {
+                state[varIter->second] = evaluate(inst->getOperand(1), state);
+            }
+
+        } else if (inst->hasResultValue()) {
+
+            ValueRange newRange = ValueRange::full();
+            if (isArithOp(op)) {
+                newRange = evaluateArith(inst, state);
+            } else if (op == IRInstOperator::IRINST_OP_FUNC_CALL) {
+                Function::Attributes & attrs = static_cast<FuncCallInstruction *>(inst)->calledFunction->getAttributes();
+                if (attrs.returnsConst) {
+                    newRange = ValueRange::constant(attrs.constValue);
+                }
+            }
+
+            // 重新定值后之前收紧的区间不再有效
+            auto varIter = varIndex.find(inst);
+            if (varIter != varIndex.end()) {
+                state[varIter->second] = ValueRange::full();
+            }
+
+            if (narrowing) {
+                instRanges[inst] = newRange;
+                continue;
+            }
+
+            // 指令结果只依赖所在基本块的入口状态与之前的指令结果，循环头加宽后也会稳定
+            ValueRange & oldRange = instRanges[inst];
+            ValueRange merged = oldRange.join(newRange);
+
+            if (merged != oldRange) {
+                oldRange = merged;
+
+                // 其它基本块中的使用需要重新计算
+                for (auto use: inst->getUses()) {
+                    Instanceof(userInst, Instruction *, use->getUser());
+                    BasicBlock * userBlock = cfg.getBlockOfInst(userInst);
+                    if (userBlock && userBlock != bb && reached[userBlock->getIndex()]) {
+                        pushBlock(userBlock);
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<BasicBlock *> & succs = bb->getSuccs();
+    std::vector<VarState> newEdges(succs.size(), state);
+    std::vector<char> newReachable(succs.size(), 1);
+
+    Instruction * term = bb->getTerminator();
+    if (term && term->getOp() == IRInstOperator::IRINST_OP_GOTO && succs.size() == 2 && succs[0] != succs[1]) {
+
+        GotoInstruction * gotoInst = static_cast<GotoInstruction *>(term);
+        Value * cond = gotoInst->getOperand(0);
+        ValueRange condRange = evaluate(cond, state);
+
+        Instanceof(compare, Instruction *, cond);
+        bool isCompare = compare && isCompareOp(compare->getOp());
+
+        // 第一个后继为真分支
+        for (size_t k = 0; k < 2; ++k) {
+
+            bool taken = k == 0;
+            if (condRange.isConstant() && (condRange.lo != 0) != taken) {
+                newReachable[k] = 0;
+            } else if (isCompare && !refineEdge(bb, compare, taken, newEdges[k])) {
+                newReachable[k] = 0;
+            }
+
+            if (!newReachable[k]) {
+                newEdges[k].assign(varIndex.size(), ValueRange{});
+            }
+        }
+    }
+
+    for (size_t k = 0; k < succs.size(); ++k) {
+
+        if (newReachable[k] == edgeReachable[index][k] && newEdges[k] == edgeStates[index][k]) {
+            continue;
+        }
+
+        edgeReachable[index][k] = newReachable[k];
+        edgeStates[index][k] = newEdges[k];
+
+        if (!narrowing) {
+            pushBlock(succs[k]);
+        }
+    }
+}
+
+/// @brief 记录分析结果中各指令执行时源操作数的区间
+void ValueRangeAnalysis::recordOperandRanges()
+{
+    for (auto bb: cfg.getBlocks()) {
+
+        if (!reached[bb->getIndex()]) {
+            continue;
+        }
+
+        VarState state = inStates[bb->getIndex()];
+
+        for (auto inst: bb->getInsts()) {
+
+            if (inst->isDead()) {
+                continue;
+            }
+
+            std::vector<ValueRange> & ranges = operandRanges[inst];
+            for (int32_t k = 0; k < inst->getOperandsNum(); ++k) {
+                ranges.push_back(evaluate(inst->getOperand(k), state));
+            }
+
+            if (inst->getOp() == IRInstOperator::IRINST_OP_ASSIGN) {
+                auto varIter = varIndex.find(inst->getOperand(0));
+                if (varIter != varIndex.end()) {
+                    state[varIter->second] = ranges[1];
+                }
+            } else {
+                auto varIter = varIndex.find(inst);
+                if (varIter != varIndex.end()) {
+                    state[varIter->second] = ValueRange::full();
+                }
+            }
+        }
+    }
+}
+
+/// @brief 获取常量或指令结果的区间，局部变量等在函数内可变的值返回全部整数
+/// @param val 值
+/// @return ValueRange 区间，指令不可达时为空区间
+ValueRange ValueRangeAnalysis::getRange(Value * val)
+{
+    Instanceof(constVal, ConstInt *, val);
+    if (constVal) {
+        return ValueRange::constant(constVal->getVal());
+    }
+
+    Instanceof(inst, Instruction *, val);
+    if (inst && inst->hasResultValue()) {
+        auto iter = instRanges.find(inst);
+        return iter == instRanges.end() ? ValueRange{} : iter->second;
+    }
+
+    return ValueRange::full();
+}
+
+/// @brief 获取指令执行时某个源操作数的区间
+/// @param inst 指令
+/// @param index 操作数的序号
+/// @return ValueRange 区间，指令不可达时为空区间
+ValueRange ValueRangeAnalysis::getOperandRange(Instruction * inst, int32_t index)
+{
+    auto iter = operandRanges.find(inst);
+    if (iter == operandRanges.end()) {
+        return ValueRange{};
+    }
+
+    if (index < 0 || index >= (int32_t) iter->second.size()) {
+        return ValueRange::full();
+    }
+
+    return iter->second[index];
+}
@@ -0,0 +1,328 @@
+///
+/// @file ValueRange.h
+/// @brief 值范围分析，求整数值在各程序点的取值区间
+///
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "ControlFlowGraph.h"
+
+///
+/// @brief 32位有符号整数的取值区间[lo, hi]，lo大于hi时为空区间，表示不可达或还未计算。
+/// 边界用64位保存，运算时可以直接判断是否超出32位的范围
+///
+struct ValueRange {
+
+    ///
+    /// @brief 下界
+    ///
+    int64_t lo = 1;
+
+    ///
+    /// @brief 上界
+    ///
+    int64_t hi = 0;
+
+    ///
+    /// @brief 全部32位整数
+    /// @return ValueRange 区间
+    ///
+    static ValueRange full()
+    {
+        return ValueRange{INT32_MIN, INT32_MAX};
+    }
+
+    ///
+    /// @brief 单个常量
+    /// @param val 常量
+    /// @return ValueRange 区间
+    ///
+    static ValueRange constant(int64_t val)
+    {
+        return ValueRange{val, val};
+    }
+
+    ///
+    /// @brief 按照给定的边界构造区间，超出32位范围时为全部整数，即按照溢出回绕处理
+    /// @param lo 下界
+    /// @param hi 上界
+    /// @return ValueRange 区间
+    ///
+    static ValueRange make(int64_t lo, int64_t hi)
+    {
+        if (lo < INT32_MIN || hi > INT32_MAX) {
+            return full();
+        }
+
+        return ValueRange{lo, hi};
+    }
+
+    ///
+    /// @brief 是否是空区间
+    /// @return true 空 false 非空
+    ///
+    [[nodiscard]] bool isEmpty() const
+    {
+        return lo > hi;
+    }
+
+    ///
+    /// @brief 是否只有一个值
+    /// @return true 是 false 不是
+    ///
+    [[nodiscard]] bool isConstant() const
+    {
+        return lo == hi;
+    }
+
+    ///
+    /// @brief 是否非空且都不小于0
+    /// @return true 是 false 不是
+    ///
+    [[nodiscard]] bool isNonNegative() const
+    {
+        return !isEmpty() && lo >= 0;
+    }
+
+    ///
+    /// @brief 是否包含某个值
+    /// @param val 值
+    /// @return true 包含 false 不包含
+    ///
+    [[nodiscard]] bool contains(int64_t val) const
+    {
+        return lo <= val && val <= hi;
+    }
+
+    ///
+    /// @brief 两个区间的并
+    /// @param other 另一个区间
+    /// @return ValueRange 包含两者的最小区间
+    ///
+    [[nodiscard]] ValueRange join(const ValueRange & other) const;
+
+    ///
+    /// @brief 两个区间的交
+    /// @param other 另一个区间
+    /// @return ValueRange 交集，可能为空
+    ///
+    [[nodiscard]] ValueRange intersect(const ValueRange & other) const;
+
+    bool operator==(const ValueRange & other) const
+    {
+        return (isEmpty() && other.isEmpty()) || (lo == other.lo && hi == other.hi);
+    }
+
+    bool operator!=(const ValueRange & other) const
+    {
+        return !(*this == other);
+    }
+};
+
+///
+/// @brief 值范围分析。与条件常量传播一样，局部变量的区间按基本块维护，指令的结果只定值一次，维护一个全局的区间。
+/// 条件跳转的真假出边上根据比较的结果收紧参与比较的局部变量的区间，条件确定的出边不可达。
+/// 循环头的入口状态多次变化后区间加宽到32位的边界以保证终止，之后再按不加宽的方式迭代两遍收窄。
+/// 分析结果在修改指令后失效
+///
+class ValueRangeAnalysis {
+
+public:
+    ///
+    /// @brief 构造函数，对控制流图进行值范围分析
+    /// @param _cfg 控制流图
+    ///
+    explicit ValueRangeAnalysis(ControlFlowGraph & _cfg);
+
+    ///
+    /// @brief 获取常量或指令结果的区间，局部变量等在函数内可变的值返回全部整数
+    /// @param val 值
+    /// @return ValueRange 区间，指令不可达时为空区间
+    ///
+    ValueRange getRange(Value * val);
+
+    ///
+    /// @brief 获取指令执行时某个源操作数的区间
+    /// @param inst 指令
+    /// @param index 操作数的序号
+    /// @return ValueRange 区间，指令不可达时为空区间
+    ///
+    ValueRange getOperandRange(Instruction * inst, int32_t index);
+
+    ///
+    /// @brief 基本块是否可达
+    /// @param bb 基本块
+    /// @return true 可达 false 分析证明不可达
+    ///
+    bool isReachable(BasicBlock * bb)
+    {
+        return reached[bb->getIndex()] != 0;
+    }
+
+    ///
+    /// @brief 根据两个操作数的区间判断比较的结果
+    /// @param op 比较运算符
+    /// @param a 左操作数的区间
+    /// @param b 右操作数的区间
+    /// @return int32_t 1 总是成立 0 总是不成立 -1 不能确定
+    ///
+    static int32_t evaluateCompare(IRInstOperator op, const ValueRange & a, const ValueRange & b);
+
+private:
+    ///
+    /// @brief 局部变量的区间，下标为局部变量的编号
+    ///
+    using VarState = std::vector<ValueRange>;
+
+    ///
+    /// @brief 求值，获取Value在当前状态下的区间
+    /// @param val Value
+    /// @param state 局部变量的区间
+    /// @return ValueRange 区间
+    ///
+    ValueRange evaluate(Value * val, VarState & state);
+
+    ///
+    /// @brief 对运算指令求结果的区间
+    /// @param inst 运算指令
+    /// @param state 局部变量的区间
+    /// @return ValueRange 区间
+    ///
+    ValueRange evaluateArith(Instruction * inst, VarState & state);
+
+    ///
+    /// @brief 根据比较成立收紧左操作数的区间
+    /// @param op 比较运算符
+    /// @param x 左操作数的区间
+    /// @param y 右操作数的区间
+    /// @return ValueRange 收紧后的区间，为空时比较不可能成立
+    ///
+    static ValueRange refine(IRInstOperator op, const ValueRange & x, const ValueRange & y);
+
+    ///
+    /// @brief 条件跳转的出边上收紧参与比较的局部变量
+    /// @param bb 以条件跳转结束的基本块
+    /// @param compare 比较指令
+    /// @param taken 比较成立的出边时为真
+    /// @param state 出口处局部变量的区间，就地修改
+    /// @return true 出边可能执行 false 比较的结果在该出边上不可能出现
+    ///
+    bool refineEdge(BasicBlock * bb, Instruction * compare, bool taken, VarState & state);
+
+    ///
+    /// @brief 按照入口状态模拟执行基本块，更新指令结果与出边的状态
+    /// @param bb 基本块
+    /// @param narrowing 是否处于收窄阶段，收窄时指令结果直接取新值
+    ///
+    void visitBlock(BasicBlock * bb, bool narrowing);
+
+    ///
+    /// @brief 计算基本块的入口状态，即所有前驱出边状态的并
+    /// @param bb 基本块
+    /// @param narrowing 是否处于收窄阶段，收窄时不与原来的状态合并
+    /// @return true 入口状态发生了变化 false 没有变化
+    ///
+    bool computeInState(BasicBlock * bb, bool narrowing);
+
+    ///
+    /// @brief 把基本块加入到工作表中
+    /// @param bb 基本块
+    ///
+    void pushBlock(BasicBlock * bb);
+
+    ///
+    /// @brief 区间增大的边界直接加宽到32位的边界
+    /// @param oldRange 原来的区间
+    /// @param newRange 新的区间
+    /// @return ValueRange 加宽后的区间
+    ///
+    static ValueRange widen(const ValueRange & oldRange, const ValueRange & newRange);
+
+    ///
+    /// @brief 记录分析结果中各指令执行时源操作数的区间
+    ///
+    void recordOperandRanges();
+
+    ///
+    /// @brief 控制流图
+    ///
+    ControlFlowGraph & cfg;
+
+    ///
+    /// @brief 所属函数
+    ///
+    Function * func;
+
+    ///
+    /// @brief 局部变量以及条件跳转中参与比较的临时变量到编号的映射，
+    /// 临时变量在状态中记录的是出边上收紧后的约束，与其全局的区间求交得到当前的区间
+    ///
+    std::unordered_map<Value *, int32_t> varIndex;
+
+    ///
+    /// @brief 各基本块入口处局部变量的区间
+    ///
+    std::vector<VarState> inStates;
+
+    ///
+    /// @brief 各基本块每条出边上局部变量的区间，次序与后继一致
+    ///
+    std::vector<std::vector<VarState>> edgeStates;
+
+    ///
+    /// @brief 各基本块的出边是否可能执行，次序与后继一致
+    ///
+    std::vector<std::vector<char>> edgeReachable;
+
+    ///
+    /// @brief 基本块是否已经到达过
+    ///
+    std::vector<char> reached;
+
+    ///
+    /// @brief 基本块入口状态变化的次数，循环头超过阈值后加宽
+    ///
+    std::vector<int32_t> visitCount;
+
+    ///
+    /// @brief 基本块是否是循环头，即逆后序中有从后面跳回来的边
+    ///
+    std::vector<char> loopHead;
+
+    ///
+    /// @brief 指令结果的区间
+    ///
+    std::unordered_map<Instruction *, ValueRange> instRanges;
+
+
+    ///
+    /// @brief 指令执行时各源操作数的区间
+    ///
+    std::unordered_map<Instruction *, std::vector<ValueRange>> operandRanges;
+
+    ///
+    /// @brief 待处理的基本块
+    ///
+    std::deque<BasicBlock *> worklist;
+
+    ///
+    /// @brief 基本块是否在工作表中
+    ///
+    std::vector<char> inWorklist;
+};
@@ -13,6 +13,8 @@
 /// <tr><td>2024-09-29 <td>1.0     <td>zenglj  <td>新建
 /// </table>
 ///
+#include <algorithm>
+
 #include "Module.h"
 
 #include "ScopeStack.h"
@@ -174,6 +176,27 @@ void Module::insertFunctionDirectly(Function * func)
     funcVector.emplace_back(func);
 }
 
+/// @brief 从函数列表中删除函数并释放，要求已经没有对该函数的调用
+/// @param func 要删除的函数
+void Module::removeFunction(Function * func)
+{
+    funcMap.erase(func->getName());
+    funcVector.erase(std::remove(funcVector.begin(), funcVector.end(), func), funcVector.end());
+
+    delete func;
+}
+
+/// @brief 删除全局变量并释放，要求已经没有对该变量的使用
+/// @param var 要删除的全局变量
+void Module::removeGlobalVariable(GlobalVariable * var)
+{
+    globalVariableMap.erase(var->getName());
+    globalVariableVector.erase(std::remove(globalVariableVector.begin(), globalVariableVector.end(), var),
+                               globalVariableVector.end());
+
+    delete var;
+}
+
 /// @brief Value直接插入到符号表中的全局变量中
 /// @param name Value的名称
 /// @param val Value信息
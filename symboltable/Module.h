@@ -15,6 +15,7 @@
 ///
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -105,6 +106,14 @@ public:
         return funcVector;
     }
 
+    /// @brief 从函数列表中删除函数并释放，要求已经没有对该函数的调用
+    /// @param func 要删除的函数
+    void removeFunction(Function * func);
+
+    /// @brief 删除全局变量并释放，要求已经没有对该变量的使用
+    /// @param var 要删除的全局变量
+    void removeGlobalVariable(GlobalVariable * var);
+
     /// @brief 新建一个整型数值的Value，并加入到符号表，用于后续释放空间
     /// \param intVal 整数值
     /// \return 临时Value
@@ -134,12 +143,6 @@ public:
     ///
     void renameIR();
 
-protected:
-    /// @brief 根据整数值获取当前符号
-    /// \param name 变量名
-    /// \return 变量对应的值
-    ConstInt * findConstInt(int32_t val);
-
     ///
     /// @brief 新建全局变量，要求name必须有效，并且加入到全局符号表中。
     /// @param type 类型
@@ -148,6 +151,30 @@ protected:
     ///
     GlobalVariable * newGlobalVariable(Type * type, std::string name);
 
+    ///
+    /// @brief 获取剖面数据中基本块的最大执行次数，用于判断基本块的冷热
+    /// @return int64_t 最大执行次数，-1表示没有剖面数据
+    ///
+    int64_t getProfileMaxCount()
+    {
+        return profileMaxCount;
+    }
+
+    ///
+    /// @brief 设置剖面数据中基本块的最大执行次数
+    /// @param count 最大执行次数
+    ///
+    void setProfileMaxCount(int64_t count)
+    {
+        profileMaxCount = count;
+    }
+
+protected:
+    /// @brief 根据整数值获取当前符号
+    /// \param name 变量名
+    /// \return 变量对应的值
+    ConstInt * findConstInt(int32_t val);
+
     /// @brief 根据变量名获取当前符号（只管理全局变量）
     /// \param name 变量名
     /// \return 变量对应的值
@@ -196,4 +223,7 @@ private:
 
     /// @brief 常量表
     std::unordered_map<int32_t, ConstInt *> constIntMap;
+
+    /// @brief 剖面数据中基本块的最大执行次数，-1表示没有剖面数据
+    int64_t profileMaxCount = -1;
 };
\ No newline at end of file
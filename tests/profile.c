@@ -0,0 +1,51 @@
+///
+/// @file profile.c
+/// @brief -fprofile-generate插桩程序的运行时函数，与std.c一起链接
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新做
+/// </table>
+///
+#include <stdio.h>
+#include <stdlib.h>
+
+/// 剖面数据文件，环境变量MINIC_PROFILE_FILE没有指定时用缺省的文件名
+static FILE * profileFile = NULL;
+
+static void closeProfileFile()
+{
+    if (profileFile) {
+        fclose(profileFile);
+        profileFile = NULL;
+    }
+}
+
+/// 插桩的main函数返回前对每个基本块计数器调用一次，输出计数器的编号与值，
+/// 编译时用-fprofile-use=文件名读取
+void __minic_profile_dump(int id, int count)
+{
+    if (profileFile == NULL) {
+
+        const char * fileName = getenv("MINIC_PROFILE_FILE");
+        if (fileName == NULL) {
+            fileName = "minic.profdata";
+        }
+
+        profileFile = fopen(fileName, "w");
+        if (profileFile == NULL) {
+            return;
+        }
+
+        atexit(closeProfileFile);
+    }
+
+    // 计数器是32位的，按无符号数输出
+    fprintf(profileFile, "%d %u\n", id, (unsigned) count);
+}
@@ -0,0 +1,31 @@
+// 循环展开：内层循环的回边基本块排在循环体之前，回边中使用循环体内计算的值，应输出400
+int g0;
+int g2;
+
+int f0()
+{
+    int x, y;
+    x = 0;
+    y = 4;
+    int c0;
+    c0 = 0;
+    while (c0 < 10) {
+        c0 = c0 + 1;
+        int c1;
+        c1 = 0;
+        while (c1 < 10) {
+            c1 = c1 + 1;
+            y = g2;
+            g0 = (13 % ((8 + g2 - (10 / (c1 % 7 + 8))) % 7 + 8));
+        }
+    }
+    return y * 100 + g0;
+}
+
+int main()
+{
+    g0 = 5;
+    g2 = 4;
+    putint(f0());
+    return 0;
+}
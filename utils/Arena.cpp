@@ -0,0 +1,70 @@
+///
+/// @file Arena.cpp
+/// @brief 顺序分配的内存区，分配只移动指针，释放时整体归还
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include "Arena.h"
+
+/// @brief 构造函数
+/// @param _blockSize 每次申请的块大小
+Arena::Arena(std::size_t _blockSize) : blockSize(_blockSize)
+{}
+
+/// @brief 析构函数，归还所有的块
+Arena::~Arena()
+{
+    release();
+}
+
+/// @brief 分配内存
+/// @param size 字节数
+/// @param align 对齐字节数，必须是2的幂
+/// @return void* 内存地址
+void * Arena::allocate(std::size_t size, std::size_t align)
+{
+    allocatedBytes += size;
+
+    // 大的请求单独申请一块，不影响当前块的继续分配
+    if (size > blockSize / 2) {
+        char * block = static_cast<char *>(::operator new(size));
+        blocks.push_back(block);
+        return block;
+    }
+
+    uintptr_t pos = ((uintptr_t) cur + align - 1) & ~(uintptr_t) (align - 1);
+
+    if (cur == nullptr || pos + size > (uintptr_t) end) {
+        char * block = static_cast<char *>(::operator new(blockSize));
+        blocks.push_back(block);
+        end = block + blockSize;
+        pos = ((uintptr_t) block + align - 1) & ~(uintptr_t) (align - 1);
+    }
+
+    cur = (char *) (pos + size);
+
+    return (void *) pos;
+}
+
+/// @brief 归还所有的块，之前分配的内存全部失效
+void Arena::release()
+{
+    for (auto block: blocks) {
+        ::operator delete(block);
+    }
+
+    blocks.clear();
+    cur = nullptr;
+    end = nullptr;
+    allocatedBytes = 0;
+}
@@ -0,0 +1,192 @@
+///
+/// @file Arena.h
+/// @brief 顺序分配的内存区，分配只移动指针，释放时整体归还
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///
+/// @brief 内存区。按块向系统申请内存，块内顺序分配，不支持单个对象的释放，
+/// 所有的内存在release或者析构时一次归还。超过块大小一半的请求单独申请一块
+///
+class Arena {
+
+public:
+    ///
+    /// @brief 构造函数
+    /// @param _blockSize 每次申请的块大小
+    ///
+    explicit Arena(std::size_t _blockSize = 16 * 1024);
+
+    ///
+    /// @brief 析构函数，归还所有的块
+    ///
+    ~Arena();
+
+    Arena(const Arena &) = delete;
+    Arena & operator=(const Arena &) = delete;
+
+    ///
+    /// @brief 分配内存
+    /// @param size 字节数
+    /// @param align 对齐字节数，必须是2的幂
+    /// @return void* 内存地址
+    ///
+    void * allocate(std::size_t size, std::size_t align = alignof(std::max_align_t));
+
+    ///
+    /// @brief 归还所有的块，之前分配的内存全部失效
+    ///
+    void release();
+
+    ///
+    /// @brief 获取已分配的字节数
+    /// @return std::size_t 字节数
+    ///
+    [[nodiscard]] std::size_t getAllocatedBytes() const
+    {
+        return allocatedBytes;
+    }
+
+private:
+    ///
+    /// @brief 已申请的块
+    ///
+    std::vector<char *> blocks;
+
+    ///
+    /// @brief 当前块内下一个可分配的位置
+    ///
+    char * cur = nullptr;
+
+    ///
+    /// @brief 当前块的结束位置
+    ///
+    char * end = nullptr;
+
+    ///
+    /// @brief 块大小
+    ///
+    std::size_t blockSize;
+
+    ///
+    /// @brief 已分配的字节数
+    ///
+    std::size_t allocatedBytes = 0;
+};
+
+///
+/// @brief 从内存区分配的标准库分配器，没有指定内存区时使用全局的new与delete。
+/// 用于内存区中对象的成员容器，这样对象的全部内存都随内存区一起释放
+/// @tparam T 元素类型
+///
+template <typename T>
+class ArenaAllocator {
+
+public:
+    using value_type = T;
+
+    ///
+    /// @brief 构造函数
+    /// @param _arena 内存区，为空时使用全局的new与delete
+    ///
+    ArenaAllocator(Arena * _arena = nullptr) noexcept : arena(_arena)
+    {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> & other) noexcept : arena(other.getArena())
+    {}
+
+    ///
+    /// @brief 分配n个元素的内存
+    /// @param n 元素个数
+    /// @return T* 内存地址
+    ///
+    T * allocate(std::size_t n)
+    {
+        if (arena) {
+            return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    ///
+    /// @brief 释放内存，内存区中的内存不单独释放
+    /// @param p 内存地址
+    ///
+    void deallocate(T * p, std::size_t)
+    {
+        if (arena == nullptr) {
+            ::operator delete(p);
+        }
+    }
+
+    ///
+    /// @brief 获取内存区
+    /// @return Arena* 内存区，可能为空
+    ///
+    [[nodiscard]] Arena * getArena() const noexcept
+    {
+        return arena;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> & other) const noexcept
+    {
+        return arena == other.getArena();
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> & other) const noexcept
+    {
+        return arena != other.getArena();
+    }
+
+private:
+    ///
+    /// @brief 内存区
+    ///
+    Arena * arena;
+};
+
+///
+/// @brief 内存区中的字符串
+///
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+///
+/// @brief 在内存区中创建的对象的基类，只能用new (arena) T(...)创建。
+/// delete只执行析构函数，内存随内存区一起释放
+///
+class ArenaObject {
+
+public:
+    static void * operator new(std::size_t size, Arena & arena)
+    {
+        return arena.allocate(size);
+    }
+
+    /// @brief 构造函数抛出异常时调用，内存随内存区一起释放
+    static void operator delete(void *, Arena &) noexcept
+    {}
+
+    /// @brief 内存随内存区一起释放
+    static void operator delete(void *) noexcept
+    {}
+};
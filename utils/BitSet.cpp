@@ -0,0 +1,256 @@
+///
+/// @file BitSet.cpp
+/// @brief 按64位字存放的稠密位集合，用于数据流分析
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <cassert>
+
+#include "BitSet.h"
+#include "BitUtils.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/// @brief 逐字运算dst = op(dst, src)，开启AVX2时每次处理4个字
+/// @param dst 目的字数组
+/// @param src 源字数组
+/// @param n 字数
+/// @param op 单个字的运算
+/// @param vecOp 4个字的向量运算
+/// @return true 目的有变化 false 没有变化
+template <typename Op, typename VecOp>
+static bool applyWords(uint64_t * dst, const uint64_t * src, size_t n, Op op, VecOp vecOp)
+{
+    size_t k = 0;
+    uint64_t diff = 0;
+
+#ifdef __AVX2__
+    __m256i vecDiff = _mm256_setzero_si256();
+
+    for (; k + 4 <= n; k += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i *) (dst + k));
+        __m256i b = _mm256_loadu_si256((const __m256i *) (src + k));
+        __m256i r = vecOp(a, b);
+        vecDiff = _mm256_or_si256(vecDiff, _mm256_xor_si256(a, r));
+        _mm256_storeu_si256((__m256i *) (dst + k), r);
+    }
+
+    diff = !_mm256_testz_si256(vecDiff, vecDiff);
+#else
+    (void) vecOp;
+#endif
+
+    for (; k < n; ++k) {
+        uint64_t r = op(dst[k], src[k]);
+        diff |= dst[k] ^ r;
+        dst[k] = r;
+    }
+
+    return diff != 0;
+}
+
+#ifdef __AVX2__
+#define VEC_OP(expr) [](__m256i a, __m256i b) { return expr; }
+#else
+#define VEC_OP(expr) 0
+#endif
+
+/// @brief 构造函数
+/// @param _set 位集合
+/// @param _wordIndex 当前字的下标
+/// @param _word 当前字中还没有取出的位
+BitSet::const_iterator::const_iterator(const BitSet * _set, uint32_t _wordIndex, uint64_t _word)
+    : set(_set), wordIndex(_wordIndex), word(_word)
+{
+    skipEmptyWords();
+}
+
+/// @brief 取得当前元素
+/// @return uint32_t 元素
+uint32_t BitSet::const_iterator::operator*() const
+{
+    return wordIndex * WORD_BITS + countTrailingZeros(word);
+}
+
+/// @brief 移到下一个元素
+/// @return const_iterator& 自身
+BitSet::const_iterator & BitSet::const_iterator::operator++()
+{
+    // 清除最低位的1
+    word &= word - 1;
+    skipEmptyWords();
+
+    return *this;
+}
+
+/// @brief 跳过全0的字，停在有元素的字或者结束位置
+void BitSet::const_iterator::skipEmptyWords()
+{
+    uint32_t wordNum = (uint32_t) set->words.size();
+
+    while (word == 0 && wordIndex < wordNum) {
+        if (++wordIndex < wordNum) {
+            word = set->words[wordIndex];
+        }
+    }
+}
+
+/// @brief 构造函数
+/// @param _size 元素个数的上限
+/// @param val true则初始为全集，false则为空集
+BitSet::BitSet(uint32_t _size, bool val)
+{
+    resize(_size, val);
+}
+
+/// @brief 改变元素个数的上限，新增的元素按val设置
+/// @param _size 元素个数的上限
+/// @param val 新增元素是否在集合中
+void BitSet::resize(uint32_t _size, bool val)
+{
+    uint32_t oldBits = numBits;
+
+    numBits = _size;
+    words.resize((_size + WORD_BITS - 1) / WORD_BITS, val ? ~(uint64_t) 0 : 0);
+
+    // 原来最后一个字中超出上限的位
+    if (val && oldBits < _size && oldBits % WORD_BITS != 0) {
+        words[oldBits / WORD_BITS] |= ~(uint64_t) 0 << (oldBits % WORD_BITS);
+    }
+
+    clearUnusedBits();
+}
+
+/// @brief 全集时最后一个字中超出上限的位清零，保证相等比较与计数正确
+void BitSet::clearUnusedBits()
+{
+    if (numBits % WORD_BITS != 0) {
+        words.back() &= ~(~(uint64_t) 0 << (numBits % WORD_BITS));
+    }
+}
+
+/// @brief 设置为全集
+void BitSet::setAll()
+{
+    words.assign(words.size(), ~(uint64_t) 0);
+    clearUnusedBits();
+}
+
+/// @brief 设置为空集
+void BitSet::clear()
+{
+    words.assign(words.size(), 0);
+}
+
+/// @brief 判断是否是空集
+/// @return true 空 false 不空
+bool BitSet::empty() const
+{
+    for (auto word: words) {
+        if (word) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief 获取元素个数
+/// @return uint32_t 元素个数
+uint32_t BitSet::count() const
+{
+    uint32_t num = 0;
+
+    for (auto word: words) {
+        num += popCount(word);
+    }
+
+    return num;
+}
+
+/// @brief 并集运算，加入val中的元素
+/// @param val 参与运算的集合
+/// @return true 集合有变化 false 没有变化
+bool BitSet::unionWith(const BitSet & val)
+{
+    assert(numBits == val.numBits);
+
+    return applyWords(
+        words.data(),
+        val.words.data(),
+        words.size(),
+        [](uint64_t a, uint64_t b) { return a | b; },
+        VEC_OP(_mm256_or_si256(a, b)));
+}
+
+/// @brief 交集运算，只保留val中也有的元素
+/// @param val 参与运算的集合
+/// @return true 集合有变化 false 没有变化
+bool BitSet::intersectWith(const BitSet & val)
+{
+    assert(numBits == val.numBits);
+
+    return applyWords(
+        words.data(),
+        val.words.data(),
+        words.size(),
+        [](uint64_t a, uint64_t b) { return a & b; },
+        VEC_OP(_mm256_and_si256(a, b)));
+}
+
+/// @brief 差集运算，删除val中的元素
+/// @param val 参与运算的集合
+/// @return true 集合有变化 false 没有变化
+bool BitSet::subtract(const BitSet & val)
+{
+    assert(numBits == val.numBits);
+
+    return applyWords(
+        words.data(),
+        val.words.data(),
+        words.size(),
+        [](uint64_t a, uint64_t b) { return a & ~b; },
+        VEC_OP(_mm256_andnot_si256(b, a)));
+}
+
+/// @brief 第一个元素的迭代器
+/// @return const_iterator 迭代器
+BitSet::const_iterator BitSet::begin() const
+{
+    return words.empty() ? end() : const_iterator(this, 0, words[0]);
+}
+
+/// @brief 结束位置的迭代器
+/// @return const_iterator 迭代器
+BitSet::const_iterator BitSet::end() const
+{
+    return const_iterator(this, (uint32_t) words.size(), 0);
+}
+
+/// @brief 变换成字符串显示，如{1, 5, 7}
+/// @return std::string 字符串
+std::string BitSet::toString() const
+{
+    std::string str = "{";
+
+    for (auto n: *this) {
+        if (str.size() > 1) {
+            str += ", ";
+        }
+        str += std::to_string(n);
+    }
+
+    return str + "}";
+}
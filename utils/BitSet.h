@@ -0,0 +1,264 @@
+///
+/// @file BitSet.h
+/// @brief 按64位字存放的稠密位集合，用于数据流分析
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+///
+/// @brief 稠密位集合，元素为[0, size)内的整数，每个字存放64个元素。
+/// 集合运算逐字进行，CMake选项USE_AVX2开启时每次处理4个字。参与运算的两个集合大小必须相同
+///
+class BitSet {
+
+public:
+    ///
+    /// @brief 元素的迭代器，用最低位的1逐个取出元素，跳过全0的字
+    ///
+    class const_iterator {
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const uint32_t *;
+        using reference = uint32_t;
+
+        ///
+        /// @brief 构造函数
+        /// @param _set 位集合
+        /// @param _wordIndex 当前字的下标
+        /// @param _word 当前字中还没有取出的位
+        ///
+        const_iterator(const BitSet * _set, uint32_t _wordIndex, uint64_t _word);
+
+        ///
+        /// @brief 取得当前元素
+        /// @return uint32_t 元素
+        ///
+        uint32_t operator*() const;
+
+        ///
+        /// @brief 移到下一个元素
+        /// @return const_iterator& 自身
+        ///
+        const_iterator & operator++();
+
+        bool operator==(const const_iterator & other) const
+        {
+            return wordIndex == other.wordIndex && word == other.word;
+        }
+
+        bool operator!=(const const_iterator & other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        ///
+        /// @brief 跳过全0的字，停在有元素的字或者结束位置
+        ///
+        void skipEmptyWords();
+
+        /// @brief 位集合
+        const BitSet * set;
+
+        /// @brief 当前字的下标
+        uint32_t wordIndex;
+
+        /// @brief 当前字中还没有取出的位
+        uint64_t word;
+    };
+
+    ///
+    /// @brief 构造函数
+    /// @param _size 元素个数的上限
+    /// @param val true则初始为全集，false则为空集
+    ///
+    explicit BitSet(uint32_t _size = 0, bool val = false);
+
+    ///
+    /// @brief 改变元素个数的上限，新增的元素按val设置
+    /// @param _size 元素个数的上限
+    /// @param val 新增元素是否在集合中
+    ///
+    void resize(uint32_t _size, bool val = false);
+
+    ///
+    /// @brief 获取元素个数的上限
+    /// @return uint32_t 上限
+    ///
+    [[nodiscard]] uint32_t size() const
+    {
+        return numBits;
+    }
+
+    ///
+    /// @brief 判断元素是否在集合中
+    /// @param n 元素
+    /// @return true 在 false 不在
+    ///
+    [[nodiscard]] bool test(uint32_t n) const
+    {
+        return (words[n / WORD_BITS] >> (n % WORD_BITS)) & 1;
+    }
+
+    ///
+    /// @brief 加入元素
+    /// @param n 元素
+    ///
+    void set(uint32_t n)
+    {
+        words[n / WORD_BITS] |= (uint64_t) 1 << (n % WORD_BITS);
+    }
+
+    ///
+    /// @brief 删除元素
+    /// @param n 元素
+    ///
+    void reset(uint32_t n)
+    {
+        words[n / WORD_BITS] &= ~((uint64_t) 1 << (n % WORD_BITS));
+    }
+
+    ///
+    /// @brief 设置为全集
+    ///
+    void setAll();
+
+    ///
+    /// @brief 设置为空集
+    ///
+    void clear();
+
+    ///
+    /// @brief 判断是否是空集
+    /// @return true 空 false 不空
+    ///
+    [[nodiscard]] bool empty() const;
+
+    ///
+    /// @brief 获取元素个数
+    /// @return uint32_t 元素个数
+    ///
+    [[nodiscard]] uint32_t count() const;
+
+    ///
+    /// @brief 并集运算，加入val中的元素
+    /// @param val 参与运算的集合
+    /// @return true 集合有变化 false 没有变化
+    ///
+    bool unionWith(const BitSet & val);
+
+    ///
+    /// @brief 交集运算，只保留val中也有的元素
+    /// @param val 参与运算的集合
+    /// @return true 集合有变化 false 没有变化
+    ///
+    bool intersectWith(const BitSet & val);
+
+    ///
+    /// @brief 差集运算，删除val中的元素
+    /// @param val 参与运算的集合
+    /// @return true 集合有变化 false 没有变化
+    ///
+    bool subtract(const BitSet & val);
+
+    ///
+    /// @brief 并集运算
+    /// @param val 参与运算的集合
+    /// @return BitSet& 自身
+    ///
+    BitSet & operator|=(const BitSet & val)
+    {
+        unionWith(val);
+        return *this;
+    }
+
+    ///
+    /// @brief 交集运算
+    /// @param val 参与运算的集合
+    /// @return BitSet& 自身
+    ///
+    BitSet & operator&=(const BitSet & val)
+    {
+        intersectWith(val);
+        return *this;
+    }
+
+    ///
+    /// @brief 差集运算
+    /// @param val 参与运算的集合
+    /// @return BitSet& 自身
+    ///
+    BitSet & operator-=(const BitSet & val)
+    {
+        subtract(val);
+        return *this;
+    }
+
+    bool operator==(const BitSet & val) const
+    {
+        return numBits == val.numBits && words == val.words;
+    }
+
+    bool operator!=(const BitSet & val) const
+    {
+        return !(*this == val);
+    }
+
+    ///
+    /// @brief 第一个元素的迭代器
+    /// @return const_iterator 迭代器
+    ///
+    [[nodiscard]] const_iterator begin() const;
+
+    ///
+    /// @brief 结束位置的迭代器
+    /// @return const_iterator 迭代器
+    ///
+    [[nodiscard]] const_iterator end() const;
+
+    ///
+    /// @brief 变换成字符串显示，如{1, 5, 7}
+    /// @return std::string 字符串
+    ///
+    [[nodiscard]] std::string toString() const;
+
+private:
+    ///
+    /// @brief 每个字的位数
+    ///
+    static constexpr uint32_t WORD_BITS = 64;
+
+    ///
+    /// @brief 全集时最后一个字中超出上限的位清零，保证相等比较与计数正确
+    ///
+    void clearUnusedBits();
+
+    ///
+    /// @brief 存放元素的字，元素n在第n/64个字的第n%64位
+    ///
+    std::vector<uint64_t> words;
+
+    ///
+    /// @brief 元素个数的上限
+    ///
+    uint32_t numBits = 0;
+};
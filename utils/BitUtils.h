@@ -0,0 +1,52 @@
+///
+/// @file BitUtils.h
+/// @brief 64位字的位运算：1的个数与最低位1的位置
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+///
+/// @brief 获取字中1的个数
+/// @param word 字
+/// @return uint32_t 1的个数
+///
+inline uint32_t popCount(uint64_t word)
+{
+#ifdef _MSC_VER
+    return (uint32_t) __popcnt64(word);
+#else
+    return (uint32_t) __builtin_popcountll(word);
+#endif
+}
+
+///
+/// @brief 获取字中最低位的1的位置，字不能为0
+/// @param word 字
+/// @return uint32_t 位置
+///
+inline uint32_t countTrailingZeros(uint64_t word)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (uint32_t) index;
+#else
+    return (uint32_t) __builtin_ctzll(word);
+#endif
+}
@@ -0,0 +1,80 @@
+///
+/// @file Casting.h
+/// @brief 基于类型标记的isa/cast/dyn_cast，代替dynamic_cast
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cassert>
+#include <type_traits>
+
+///
+/// @brief 判断对象是否是To类型，要求To提供静态函数classof，根据基类中的类型标记判断，
+/// 即一次整数比较，不需要RTTI
+/// @tparam To 目标类型
+/// @tparam From 源类型
+/// @param val 对象，不能为空
+/// @return true 是 false 不是
+///
+template <typename To, typename From>
+inline bool isa(const From * val)
+{
+    assert(val && "isa<> used on a null pointer");
+    return To::classof(val);
+}
+
+///
+/// @brief 转换为To类型，要求对象一定是To类型
+/// @tparam To 目标类型
+/// @tparam From 源类型
+/// @param val 对象，不能为空
+/// @return To* 转换后的指针
+///
+template <typename To, typename From>
+inline To * cast(From * val)
+{
+    assert(isa<To>(val) && "cast<Ty>() argument of incompatible type!");
+    return static_cast<To *>(val);
+}
+
+template <typename To, typename From>
+inline const To * cast(const From * val)
+{
+    assert(isa<To>(val) && "cast<Ty>() argument of incompatible type!");
+    return static_cast<const To *>(val);
+}
+
+///
+/// @brief 对象是To类型时转换，否则返回空指针，对象可以为空
+/// @tparam To 目标类型
+/// @tparam From 源类型
+/// @param val 对象
+/// @return To* 转换后的指针，不是To类型时为空
+///
+template <typename To, typename From>
+inline To * dyn_cast(From * val)
+{
+    return val && To::classof(val) ? static_cast<To *>(val) : nullptr;
+}
+
+template <typename To, typename From>
+inline const To * dyn_cast(const From * val)
+{
+    return val && To::classof(val) ? static_cast<const To *>(val) : nullptr;
+}
+
+///
+/// @brief 检查var是否是type类型，是则转换，否则为空指针。type为指针类型，可带const
+///
+#define Instanceof(res, type, var) \
+    auto res = dyn_cast<std::remove_cv_t<std::remove_pointer_t<type>>>(var)
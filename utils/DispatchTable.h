@@ -0,0 +1,58 @@
+///
+/// @file DispatchTable.h
+/// @brief 以枚举值为下标的处理函数表，编译期构造与检查
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+///
+/// @brief 处理函数表缺少枚举值时调用。不是constexpr函数，编译期构造处理函数表时调用到这里即编译失败
+///
+inline void dispatchTableEntryMissing()
+{}
+
+///
+/// @brief 根据枚举值与处理函数的对应关系构造处理函数表，下标为枚举值。
+/// 枚举值必须从0开始连续编号，N为枚举值的个数，每个枚举值都要给出处理函数，
+/// 表按constexpr变量构造时缺少的枚举值导致编译失败。
+/// 完整性按给出的枚举值检查，不比较成员函数指针，开启UBSan时成员函数指针的比较不是常量表达式
+/// @tparam Enum 枚举类型
+/// @tparam Handler 处理函数类型，一般为成员函数指针
+/// @tparam N 表的大小
+/// @param entries 枚举值与处理函数的对应关系
+/// @return std::array<Handler, N> 处理函数表
+///
+template <typename Enum, typename Handler, std::size_t N>
+constexpr std::array<Handler, N> makeDispatchTable(std::initializer_list<std::pair<Enum, Handler>> entries)
+{
+    std::array<Handler, N> table{};
+    std::array<bool, N> filled{};
+
+    for (auto & entry: entries) {
+        table[static_cast<std::size_t>(entry.first)] = entry.second;
+        filled[static_cast<std::size_t>(entry.first)] = true;
+    }
+
+    for (std::size_t k = 0; k < N; ++k) {
+        if (!filled[k]) {
+            dispatchTableEntryMissing();
+        }
+    }
+
+    return table;
+}
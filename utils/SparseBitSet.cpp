@@ -0,0 +1,235 @@
+///
+/// @file SparseBitSet.cpp
+/// @brief 稀疏位集合，只存放非0的64位字
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+
+#include <algorithm>
+
+#include "SparseBitSet.h"
+#include "BitUtils.h"
+
+/// @brief 取得当前元素
+/// @return uint32_t 元素
+uint32_t SparseBitSet::const_iterator::operator*() const
+{
+    return iter->index * WORD_BITS + countTrailingZeros(bits);
+}
+
+/// @brief 移到下一个元素
+/// @return const_iterator& 自身
+SparseBitSet::const_iterator & SparseBitSet::const_iterator::operator++()
+{
+    // 清除最低位的1，当前字取完后移到下一个字，存放的字都不为0
+    bits &= bits - 1;
+    if (bits == 0 && ++iter != last) {
+        bits = iter->bits;
+    }
+
+    return *this;
+}
+
+/// @brief 查找字下标不小于index的第一个字
+/// @param index 字下标
+/// @return std::vector<Element>::iterator 位置
+std::vector<SparseBitSet::Element>::iterator SparseBitSet::lowerBound(uint32_t index)
+{
+    return std::lower_bound(elements.begin(), elements.end(), index, [](const Element & elem, uint32_t k) {
+        return elem.index < k;
+    });
+}
+
+/// @brief 判断元素是否在集合中
+/// @param n 元素
+/// @return true 在 false 不在
+bool SparseBitSet::test(uint32_t n) const
+{
+    uint32_t index = n / WORD_BITS;
+
+    auto iter = std::lower_bound(elements.begin(), elements.end(), index, [](const Element & elem, uint32_t k) {
+        return elem.index < k;
+    });
+
+    return iter != elements.end() && iter->index == index && ((iter->bits >> (n % WORD_BITS)) & 1);
+}
+
+/// @brief 加入元素
+/// @param n 元素
+void SparseBitSet::set(uint32_t n)
+{
+    uint32_t index = n / WORD_BITS;
+    uint64_t bit = (uint64_t) 1 << (n % WORD_BITS);
+
+    auto iter = lowerBound(index);
+    if (iter != elements.end() && iter->index == index) {
+        iter->bits |= bit;
+    } else {
+        elements.insert(iter, Element{index, bit});
+    }
+}
+
+/// @brief 删除元素
+/// @param n 元素
+void SparseBitSet::reset(uint32_t n)
+{
+    uint32_t index = n / WORD_BITS;
+
+    auto iter = lowerBound(index);
+    if (iter != elements.end() && iter->index == index) {
+        iter->bits &= ~((uint64_t) 1 << (n % WORD_BITS));
+        if (iter->bits == 0) {
+            elements.erase(iter);
+        }
+    }
+}
+
+/// @brief 获取元素个数
+/// @return uint32_t 元素个数
+uint32_t SparseBitSet::count() const
+{
+    uint32_t num = 0;
+
+    for (auto & elem: elements) {
+        num += popCount(elem.bits);
+    }
+
+    return num;
+}
+
+/// @brief 并集运算，加入val中的元素
+/// @param val 参与运算的集合
+/// @return true 集合有变化 false 没有变化
+bool SparseBitSet::unionWith(const SparseBitSet & val)
+{
+    bool changed = false;
+    bool needInsert = false;
+
+    // 先原地合并下标相同的字，只有val中有新的字时才归并到新的数组
+    size_t k = 0;
+    for (auto & other: val.elements) {
+
+        while (k < elements.size() && elements[k].index < other.index) {
+            k++;
+        }
+
+        if (k < elements.size() && elements[k].index == other.index) {
+            uint64_t bits = elements[k].bits | other.bits;
+            changed = changed || bits != elements[k].bits;
+            elements[k].bits = bits;
+        } else {
+            needInsert = true;
+        }
+    }
+
+    if (!needInsert) {
+        return changed;
+    }
+
+    std::vector<Element> merged;
+    merged.reserve(elements.size() + val.elements.size());
+
+    std::set_union(elements.begin(),
+                   elements.end(),
+                   val.elements.begin(),
+                   val.elements.end(),
+                   std::back_inserter(merged),
+                   [](const Element & a, const Element & b) { return a.index < b.index; });
+
+    elements.swap(merged);
+
+    return true;
+}
+
+/// @brief 交集运算，只保留val中也有的元素
+/// @param val 参与运算的集合
+/// @return true 集合有变化 false 没有变化
+bool SparseBitSet::intersectWith(const SparseBitSet & val)
+{
+    bool changed = false;
+    size_t out = 0;
+    size_t j = 0;
+
+    for (size_t k = 0; k < elements.size(); ++k) {
+
+        while (j < val.elements.size() && val.elements[j].index < elements[k].index) {
+            j++;
+        }
+
+        uint64_t bits = 0;
+        if (j < val.elements.size() && val.elements[j].index == elements[k].index) {
+            bits = elements[k].bits & val.elements[j].bits;
+        }
+
+        if (bits != elements[k].bits) {
+            changed = true;
+        }
+
+        if (bits != 0) {
+            elements[out++] = Element{elements[k].index, bits};
+        }
+    }
+
+    elements.resize(out);
+
+    return changed;
+}
+
+/// @brief 差集运算，删除val中的元素
+/// @param val 参与运算的集合
+/// @return true 集合有变化 false 没有变化
+bool SparseBitSet::subtract(const SparseBitSet & val)
+{
+    bool changed = false;
+    size_t out = 0;
+    size_t j = 0;
+
+    for (size_t k = 0; k < elements.size(); ++k) {
+
+        while (j < val.elements.size() && val.elements[j].index < elements[k].index) {
+            j++;
+        }
+
+        uint64_t bits = elements[k].bits;
+        if (j < val.elements.size() && val.elements[j].index == elements[k].index) {
+            bits &= ~val.elements[j].bits;
+        }
+
+        if (bits != elements[k].bits) {
+            changed = true;
+        }
+
+        if (bits != 0) {
+            elements[out++] = Element{elements[k].index, bits};
+        }
+    }
+
+    elements.resize(out);
+
+    return changed;
+}
+
+/// @brief 变换成字符串显示，如{1, 5, 7}
+/// @return std::string 字符串
+std::string SparseBitSet::toString() const
+{
+    std::string str = "{";
+
+    for (auto n: *this) {
+        if (str.size() > 1) {
+            str += ", ";
+        }
+        str += std::to_string(n);
+    }
+
+    return str + "}";
+}
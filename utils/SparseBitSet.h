@@ -0,0 +1,249 @@
+///
+/// @file SparseBitSet.h
+/// @brief 稀疏位集合，只存放非0的64位字
+/// @author zenglj (zenglj@live.com)
+/// @version 1.0
+/// @date 2026-10-16
+///
+/// @copyright Copyright (c) 2024
+///
+/// @par 修改日志:
+/// <table>
+/// <tr><th>Date       <th>Version <th>Author  <th>Description
+/// <tr><td>2026-10-16 <td>1.0     <td>zenglj  <td>新建
+/// </table>
+///
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+///
+/// @brief 稀疏位集合，元素没有上限。按字下标升序存放非0的字，
+/// 适合元素范围大但每个集合中元素很少的情况，集合运算按字下标归并
+///
+class SparseBitSet {
+
+    ///
+    /// @brief 非0的字
+    ///
+    struct Element {
+
+        /// @brief 字下标，字中第k位代表元素index*64+k
+        uint32_t index;
+
+        /// @brief 字的内容
+        uint64_t bits;
+
+        bool operator==(const Element & other) const
+        {
+            return index == other.index && bits == other.bits;
+        }
+    };
+
+public:
+    ///
+    /// @brief 元素的迭代器
+    ///
+    class const_iterator {
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const uint32_t *;
+        using reference = uint32_t;
+
+        ///
+        /// @brief 构造函数
+        /// @param _iter 当前字
+        /// @param _last 最后一个字之后的位置
+        ///
+        const_iterator(std::vector<Element>::const_iterator _iter, std::vector<Element>::const_iterator _last)
+            : iter(_iter), last(_last), bits(_iter == _last ? 0 : _iter->bits)
+        {}
+
+        ///
+        /// @brief 取得当前元素
+        /// @return uint32_t 元素
+        ///
+        uint32_t operator*() const;
+
+        ///
+        /// @brief 移到下一个元素
+        /// @return const_iterator& 自身
+        ///
+        const_iterator & operator++();
+
+        bool operator==(const const_iterator & other) const
+        {
+            return iter == other.iter && bits == other.bits;
+        }
+
+        bool operator!=(const const_iterator & other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        /// @brief 当前字
+        std::vector<Element>::const_iterator iter;
+
+        /// @brief 最后一个字之后的位置
+        std::vector<Element>::const_iterator last;
+
+        /// @brief 当前字中还没有取出的位，取完后移到下一个字
+        uint64_t bits;
+    };
+
+    ///
+    /// @brief 判断元素是否在集合中
+    /// @param n 元素
+    /// @return true 在 false 不在
+    ///
+    [[nodiscard]] bool test(uint32_t n) const;
+
+    ///
+    /// @brief 加入元素
+    /// @param n 元素
+    ///
+    void set(uint32_t n);
+
+    ///
+    /// @brief 删除元素
+    /// @param n 元素
+    ///
+    void reset(uint32_t n);
+
+    ///
+    /// @brief 设置为空集
+    ///
+    void clear()
+    {
+        elements.clear();
+    }
+
+    ///
+    /// @brief 判断是否是空集
+    /// @return true 空 false 不空
+    ///
+    [[nodiscard]] bool empty() const
+    {
+        return elements.empty();
+    }
+
+    ///
+    /// @brief 获取元素个数
+    /// @return uint32_t 元素个数
+    ///
+    [[nodiscard]] uint32_t count() const;
+
+    ///
+    /// @brief 并集运算，加入val中的元素
+    /// @param val 参与运算的集合
+    /// @return true 集合有变化 false 没有变化
+    ///
+    bool unionWith(const SparseBitSet & val);
+
+    ///
+    /// @brief 交集运算，只保留val中也有的元素
+    /// @param val 参与运算的集合
+    /// @return true 集合有变化 false 没有变化
+    ///
+    bool intersectWith(const SparseBitSet & val);
+
+    ///
+    /// @brief 差集运算，删除val中的元素
+    /// @param val 参与运算的集合
+    /// @return true 集合有变化 false 没有变化
+    ///
+    bool subtract(const SparseBitSet & val);
+
+    ///
+    /// @brief 并集运算
+    /// @param val 参与运算的集合
+    /// @return SparseBitSet& 自身
+    ///
+    SparseBitSet & operator|=(const SparseBitSet & val)
+    {
+        unionWith(val);
+        return *this;
+    }
+
+    ///
+    /// @brief 交集运算
+    /// @param val 参与运算的集合
+    /// @return SparseBitSet& 自身
+    ///
+    SparseBitSet & operator&=(const SparseBitSet & val)
+    {
+        intersectWith(val);
+        return *this;
+    }
+
+    ///
+    /// @brief 差集运算
+    /// @param val 参与运算的集合
+    /// @return SparseBitSet& 自身
+    ///
+    SparseBitSet & operator-=(const SparseBitSet & val)
+    {
+        subtract(val);
+        return *this;
+    }
+
+    bool operator==(const SparseBitSet & val) const
+    {
+        return elements == val.elements;
+    }
+
+    bool operator!=(const SparseBitSet & val) const
+    {
+        return !(*this == val);
+    }
+
+    ///
+    /// @brief 第一个元素的迭代器
+    /// @return const_iterator 迭代器
+    ///
+    [[nodiscard]] const_iterator begin() const
+    {
+        return const_iterator(elements.begin(), elements.end());
+    }
+
+    ///
+    /// @brief 结束位置的迭代器
+    /// @return const_iterator 迭代器
+    ///
+    [[nodiscard]] const_iterator end() const
+    {
+        return const_iterator(elements.end(), elements.end());
+    }
+
+    ///
+    /// @brief 变换成字符串显示，如{1, 5, 7}
+    /// @return std::string 字符串
+    ///
+    [[nodiscard]] std::string toString() const;
+
+private:
+    ///
+    /// @brief 每个字的位数
+    ///
+    static constexpr uint32_t WORD_BITS = 64;
+
+    ///
+    /// @brief 查找字下标不小于index的第一个字
+    /// @param index 字下标
+    /// @return std::vector<Element>::iterator 位置
+    ///
+    std::vector<Element>::iterator lowerBound(uint32_t index);
+
+    ///
+    /// @brief 按字下标升序存放的非0的字
+    ///
+    std::vector<Element> elements;
+};